@@ -29,10 +29,13 @@
 
 #include "utils/shading.glsl"
 #include "colortools.glsl"
+#include "utils/pickingutils.glsl"
 
-// Same as geometryrendering.frag with the exception of picking
-uniform vec3 pickingColor;
-uniform bool highlight;
+// Same as geometryrendering.frag with the exception of picking. Merged glyph meshes store the
+// number of the glyph of each vertex in the x texture coordinate, other meshes hold one glyph.
+uniform uint pickingOffset;
+uniform bool mergedGlyphs;
+uniform int selectedGlyph;
 
 uniform LightParameters light;
 uniform CameraParameters camera;
@@ -51,13 +54,15 @@ void main() {
     hl_color *= vec3(1.0, 0.25, 1.2);
     hl_color = hcl2rgb(hl_color);
 
+    uint glyph = mergedGlyphs ? uint(texCoord_.x + 0.5) : 0u;
+
     vec4 color;
-    color = highlight ? vec4(hl_color, 1.0) : color_;
+    color = int(glyph) == selectedGlyph ? vec4(hl_color, 1.0) : color_;
     
     fragColor.rgb = APPLY_LIGHTING(light, color.rgb, color.rgb, vec3(1.0f), worldPosition_.xyz,
                                    normalize(normal_), normalize(toCameraDir_));
     
     FragData0 = fragColor;
 
-    PickingData = vec4(pickingColor, 1.0);
+    PickingData = vec4(pickingIndexToColor(pickingOffset + glyph), 1.0);
 }
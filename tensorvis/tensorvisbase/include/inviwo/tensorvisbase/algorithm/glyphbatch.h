@@ -0,0 +1,124 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/geometry/basicmesh.h>
+
+#include <functional>
+
+namespace inviwo {
+
+namespace tensorutil {
+
+/**
+ * Number of vertices and indices of a single glyph.
+ */
+struct GlyphExtent {
+    size_t vertices = 0;
+    size_t indices = 0;
+};
+
+/**
+ * Part of the buffers of a GlyphBatch that belongs to one glyph. Positions and normals are written
+ * in world space. Indices are relative to the first vertex of the glyph.
+ */
+struct GlyphSlot {
+    vec3* positions;
+    vec3* normals;
+    vec4* colors;
+    std::uint32_t* indices;
+    GlyphExtent extent;
+};
+
+/**
+ * \brief Glyphs merged into a single mesh that can be drawn in one call.
+ *
+ * The glyphs are stored back to back: glyph i occupies the vertices
+ * [vertexOffsets[i], vertexOffsets[i + 1]) and the indices [indexOffsets[i], indexOffsets[i + 1])
+ * of the mesh. The x texture coordinate of every vertex holds the number of its glyph, which is
+ * used for picking individual glyphs. It is exact as a float for up to maxGlyphs glyphs. The
+ * number of glyphs is also stored as meta data of the mesh under glyphCountKey.
+ */
+struct IVW_MODULE_TENSORVISBASE_API GlyphBatch {
+    static const std::string glyphCountKey;
+    // Largest number of glyphs whose numbers are exact in the float texture coordinate, 2^24
+    static constexpr size_t maxGlyphs = size_t{1} << 24;
+
+    std::shared_ptr<BasicMesh> mesh;
+    std::vector<size_t> vertexOffsets;
+    std::vector<size_t> indexOffsets;
+
+    size_t size() const { return vertexOffsets.empty() ? 0 : vertexOffsets.size() - 1; }
+
+    /**
+     * Number of the glyph that contains the given vertex.
+     */
+    size_t glyphOfVertex(size_t vertex) const;
+
+    /**
+     * Copies the given glyph into a mesh of its own.
+     */
+    std::shared_ptr<BasicMesh> extract(size_t glyph) const;
+};
+
+/**
+ * Creates a batch with pre-sized buffers for glyphs of the given extents and fills it by calling
+ * write for every glyph. The glyphs are written in parallel, write has to be safe to call
+ * concurrently and must not throw. Throws an Exception if there are more than
+ * GlyphBatch::maxGlyphs glyphs, or if the glyphs need more vertices than a 32 bit index can
+ * address. If cancelled returns true, the remaining glyphs are skipped and an empty batch without
+ * mesh is returned.
+ */
+IVW_MODULE_TENSORVISBASE_API GlyphBatch
+batchGlyphs(const std::vector<GlyphExtent>& extents,
+            const std::function<void(size_t glyph, GlyphSlot& slot)>& write,
+            const std::function<bool()>& cancelled = nullptr);
+
+/**
+ * Vertex and index count of the triangles of the given mesh, summed over all its index buffers.
+ */
+IVW_MODULE_TENSORVISBASE_API GlyphExtent glyphExtent(const BasicMesh& glyph);
+
+/**
+ * Writes the given mesh into a slot with the extent glyphExtent(glyph). The model and world
+ * matrices of the mesh are applied to the positions and normals.
+ */
+IVW_MODULE_TENSORVISBASE_API void writeGlyph(const BasicMesh& glyph, GlyphSlot& slot);
+
+/**
+ * Transforms the positions and normals of the glyph in the slot from data to world space.
+ */
+IVW_MODULE_TENSORVISBASE_API void transformGlyph(const mat4& dataToWorld, GlyphSlot& slot);
+
+}  // namespace tensorutil
+
+}  // namespace inviwo
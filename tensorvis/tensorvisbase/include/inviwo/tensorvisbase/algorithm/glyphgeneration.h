@@ -0,0 +1,71 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/tensorvisbase/algorithm/glyphplacement.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace inviwo {
+
+class TensorGlyphProperty;
+
+namespace tensorutil {
+
+struct GeneratedGlyphs {
+    std::shared_ptr<std::vector<std::shared_ptr<Mesh>>> meshes =
+        std::make_shared<std::vector<std::shared_ptr<Mesh>>>();
+    size_t culled = 0;               // Glyphs skipped by the level of detail
+    size_t triangles = 0;            // Triangles of the generated glyphs
+    size_t fullDetailTriangles = 0;  // Triangles of the placed glyphs at full detail
+};
+
+/**
+ * Places the glyphs, assigns their levels of detail and generates them, either as one merged mesh
+ * per level or as one mesh per glyph. Within a level the glyphs are written in parallel, every
+ * glyph into its own slot or mesh, so the order of the glyphs does not depend on the threads.
+ * Returns nothing if cancelled. Throws an Exception if the glyphs cannot be placed, see
+ * placeGlyphs().
+ */
+IVW_MODULE_TENSORVISBASE_API std::optional<GeneratedGlyphs> generateGlyphs(
+    std::shared_ptr<const TensorField3D> tensorField, const TensorGlyphProperty& glyphParameters,
+    bool merged, const GlyphPlacementSettings& placement, const GlyphLodSettings& lod,
+    const std::function<bool()>& cancelled = nullptr);
+
+}  // namespace tensorutil
+
+}  // namespace inviwo
@@ -0,0 +1,134 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+class Column;
+
+namespace tensorutil {
+
+enum class GlyphPlacement {
+    Regular,      // One glyph every stride voxels
+    Jittered,     // One glyph at a random position in every cell of stride voxels
+    PoissonDisk,  // Glyphs at defined voxels at least radius voxels apart
+    Importance    // count glyphs, drawn with a probability proportional to a meta data column
+};
+
+struct GlyphPlacementSettings {
+    GlyphPlacement placement = GlyphPlacement::Regular;
+    size3_t stride{1};   // Regular and Jittered
+    float radius = 1.0f;  // PoissonDisk, in voxels
+    size_t count = 1000;  // Importance
+    // Importance, a scalar column with one non-negative weight per voxel, e.g. Anisotropy
+    std::shared_ptr<const Column> importance;
+    // Importance, name of the column if importance is not set, see scalarAttribute()
+    std::string importanceAttribute;
+    std::uint64_t seed = 0;  // Jittered, PoissonDisk and Importance
+};
+
+/**
+ * Voxels at which glyphs are placed, together with the world space positions of the glyphs.
+ * Glyph i shows the tensor at voxel indices[i], positions[i] may lie in between voxels for
+ * jittered placement.
+ */
+struct GlyphPositions {
+    std::vector<size_t> indices;
+    std::vector<vec3> positions;
+
+    size_t size() const { return indices.size(); }
+};
+
+/**
+ * Places glyphs in the field according to the settings. Only voxels that are defined by the mask
+ * and hold a non-zero tensor get a glyph. The random placements are deterministic for a given
+ * seed, independent of the number of threads. Throws an Exception if importance sampling is
+ * requested without a scalar column of the size of the field.
+ */
+IVW_MODULE_TENSORVISBASE_API GlyphPositions placeGlyphs(const TensorField3D& tensorField,
+                                                        const GlyphPlacementSettings& settings);
+
+/**
+ * Names of the scalar columns of the meta data of the field, followed by the scalar attributes
+ * (see attributes.h) that are not part of the meta data.
+ */
+IVW_MODULE_TENSORVISBASE_API std::vector<std::string> scalarAttributes(
+    const TensorField3D& tensorField);
+
+/**
+ * The scalar meta data column with the given name. Scalar attributes that are not part of the
+ * meta data are computed, and cached in the field for MetaDataPolicy::Lazy. Returns nullptr if
+ * there is no such column or attribute.
+ */
+IVW_MODULE_TENSORVISBASE_API std::shared_ptr<const Column> scalarAttribute(
+    const TensorField3D& tensorField, const std::string& name);
+
+struct GlyphLodSettings {
+    size_t levels = 1;           // Number of levels of detail, level 0 is the full resolution
+    float detailSize = 1.0f;     // World space glyph size from which on level 0 is used
+    bool scaleByNorm = false;    // Scale glyphs by their Frobenius norm relative to the maximum
+    float minNorm = 0.0f;        // Cull glyphs below this fraction of the maximum Frobenius norm
+    float minAnisotropy = 0.0f;  // Cull glyphs below this fraction of the maximum anisotropy
+};
+
+/**
+ * Glyphs grouped by level of detail. levels[l] holds the numbers of the glyphs, i.e. indices into
+ * GlyphPositions, that are drawn at level l, in placement order, and sizes[l] their world space
+ * sizes.
+ */
+struct GlyphLevels {
+    std::vector<std::vector<size_t>> levels;
+    std::vector<std::vector<float>> sizes;
+    size_t culled = 0;
+};
+
+/**
+ * Assigns every placed glyph a level of detail from its world space size, which is size, scaled
+ * by the relative Frobenius norm of the tensor if requested. Every halving of the size below
+ * settings.detailSize moves a glyph one level down, the last level takes all glyphs smaller than
+ * that. Glyphs below the norm or anisotropy threshold are culled, both thresholds are relative to
+ * the maximum over the whole field. The Frobenius norm and the anisotropy are taken from the meta
+ * data of the field if available and computed otherwise.
+ */
+IVW_MODULE_TENSORVISBASE_API GlyphLevels selectGlyphLevels(const TensorField3D& tensorField,
+                                                           const GlyphPositions& glyphs,
+                                                           float size,
+                                                           const GlyphLodSettings& settings);
+
+}  // namespace tensorutil
+
+}  // namespace inviwo
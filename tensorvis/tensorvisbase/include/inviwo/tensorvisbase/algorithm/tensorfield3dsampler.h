@@ -0,0 +1,111 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+#include <inviwo/tensorvisbase/algorithm/tensorfieldsampling.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/util/spatialsampler.h>
+
+#include <array>
+
+namespace inviwo {
+
+/**
+ * \brief Sampler for 3D tensor fields.
+ *
+ * Interpolates the tensors of a TensorField3D on its grid. The index strides and the clamped
+ * upper corner are computed once at construction so a sample reduces to eight gathers and a
+ * weighted sum. sampleTensors() evaluates many positions per call, computing the trilinear
+ * weights for a block of positions at a time in plain arrays the compiler can vectorize, and
+ * distributes the blocks over the available threads. Fields with TensorStorage::PackedSymmetric
+ * are sampled from the packed tensors, six components per tensor.
+ *
+ * As a SpatialSampler<3, 3, double> the sampler returns one of the eigenvectors of the
+ * interpolated tensor, which makes it usable as input for the HyperStreamLineTracer.
+ * Positions are in data space ([0,1]^3) unless another coordinate space is given. Barycentric
+ * interpolation is not defined for 3D fields and falls back to linear interpolation.
+ */
+class IVW_MODULE_TENSORVISBASE_API TensorField3DSampler : public SpatialSampler<3, 3, double> {
+public:
+    enum class EigenVector { Major, Intermediate, Minor };
+
+    TensorField3DSampler(std::shared_ptr<const TensorField3D> tensorField,
+                         EigenVector eigenVector = EigenVector::Major,
+                         tensorutil::InterpolationMethod method =
+                             tensorutil::InterpolationMethod::Linear,
+                         CoordinateSpace space = CoordinateSpace::Data);
+    virtual ~TensorField3DSampler() = default;
+
+    /**
+     * Interpolated tensor at position, given in the coordinate space of the sampler.
+     */
+    dmat3 sampleTensor(const dvec3& position) const;
+
+    /**
+     * Interpolates the tensors at all positions, given in the coordinate space of the sampler.
+     * tensors is resized to positions.size(). Reusing the output vector between calls avoids
+     * the allocation.
+     */
+    void sampleTensors(const std::vector<dvec3>& positions, std::vector<dmat3>& tensors) const;
+    std::vector<dmat3> sampleTensors(const std::vector<dvec3>& positions) const;
+
+    /**
+     * Same as above for count positions starting at positions, writing to tensors.
+     */
+    void sampleTensors(const dvec3* positions, size_t count, dmat3* tensors) const;
+
+    std::shared_ptr<const TensorField3D> getTensorField() const { return tensorField_; }
+    EigenVector getEigenVector() const { return eigenVector_; }
+    tensorutil::InterpolationMethod getInterpolationMethod() const { return method_; }
+
+protected:
+    virtual dvec3 sampleDataSpace(const dvec3& pos) const override;
+    virtual bool withinBoundsDataSpace(const dvec3& pos) const override;
+
+private:
+    dmat3 sampleTensorDataSpace(const dvec3& pos) const;
+    void sampleBlockDataSpace(const dvec3* positions, size_t count, dmat3* tensors) const;
+
+    std::shared_ptr<const TensorField3D> tensorField_;
+    std::shared_ptr<const std::vector<mat3>> tensors_;  // nullptr for packed storage
+    std::shared_ptr<const std::vector<TensorField3D::packedN>> packedTensors_;
+    EigenVector eigenVector_;
+    tensorutil::InterpolationMethod method_;
+    dmat4 toDataSpace_;  // from the coordinate space of the sampler
+
+    dvec3 bounds_;      // dimensions - 1, index space extent of [0,1]
+    size3_t maxLower_;  // largest valid lower corner of a cell
+    size3_t strides_;   // linear index step along x, y and z
+    std::array<size_t, 8> corners_;  // offsets of the cell corners from the lower corner
+};
+
+}  // namespace inviwo
@@ -31,6 +31,7 @@
 
 #include <inviwo/tensorvisbase/datastructures/tensorfield2d.h>
 #include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+#include <inviwo/tensorvisbase/datastructures/brickedtensorfield3d.h>
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
 
@@ -127,19 +128,12 @@ IVW_MODULE_TENSORVISBASE_API dmat2 sample(std::shared_ptr<const TensorField2D> t
                                           const dvec2& position,
                                           const tensorutil::InterpolationMethod method);
 
-/**
- * Returns a pair of a glm::uint8 and dmat3.
- * The dmat3 is the tensor. Since the field stores tensors at every position
- * it has a mask defining where it is actually defined and where not. It is 1
- * if there is data at this position and 0 if not. If the mask value is zero,
- * the tensor will be a 0 tensor. If the mask is not set for the tensor field,
- * the mask value return will always be 0.
- */
-template <tensorutil::InterpolationMethod method>
-std::pair<glm::uint8, dmat3> sample(std::shared_ptr<const TensorField3D> tensorField,
-                                    const dvec3& position) {
+namespace detail {
+// Field is a const TensorField3D or a BrickedTensorField3D::Accessor, whose at() is not const
+template <tensorutil::InterpolationMethod method, typename Field>
+std::pair<glm::uint8, dmat3> sample3D(Field& tensorField, const dvec3& position) {
     // Position is in texture space [0,1], translate to index space
-    const auto bounds = tensorField->getBounds<double>();
+    const auto bounds = tensorField.template getBounds<double>();
     const auto indexPosition = position * bounds;
 
     dmat3 val{0.0};
@@ -158,23 +152,23 @@ std::pair<glm::uint8, dmat3> sample(std::shared_ptr<const TensorField3D> tensorF
         const auto zFrac = glm::fract(position.z * bounds.z);
 
         // Upper layer
-        const auto& tensor010 = tensorField->at(size3_t(xm, yp, zm));
-        const auto& tensor011 = tensorField->at(size3_t(xm, yp, zp));
+        const auto& tensor010 = tensorField.at(size3_t(xm, yp, zm));
+        const auto& tensor011 = tensorField.at(size3_t(xm, yp, zp));
         const auto tensorUpperLeft = glm::mix(tensor010, tensor011, zFrac);
 
-        const auto& tensor111 = tensorField->at(size3_t(xp, yp, zp));
-        const auto& tensor110 = tensorField->at(size3_t(xp, yp, zm));
+        const auto& tensor111 = tensorField.at(size3_t(xp, yp, zp));
+        const auto& tensor110 = tensorField.at(size3_t(xp, yp, zm));
         const auto tensorUpperRight = glm::mix(tensor110, tensor111, zFrac);
 
         const auto tensorUpper = glm::mix(tensorUpperLeft, tensorUpperRight, xFrac);
 
         // Lower layer
-        const auto& tensor000 = tensorField->at(size3_t(xm, ym, zm));
-        const auto& tensor001 = tensorField->at(size3_t(xm, ym, zp));
+        const auto& tensor000 = tensorField.at(size3_t(xm, ym, zm));
+        const auto& tensor001 = tensorField.at(size3_t(xm, ym, zp));
         const auto tensorLowerLeft = glm::mix(tensor000, tensor001, zFrac);
 
-        const auto& tensor100 = tensorField->at(size3_t(xp, ym, zm));
-        const auto& tensor101 = tensorField->at(size3_t(xp, ym, zp));
+        const auto& tensor100 = tensorField.at(size3_t(xp, ym, zm));
+        const auto& tensor101 = tensorField.at(size3_t(xp, ym, zp));
         const auto tensorLowerRight = glm::mix(tensor100, tensor101, zFrac);
 
         const auto tensorLower = glm::mix(tensorLowerLeft, tensorLowerRight, xFrac);
@@ -182,11 +176,49 @@ std::pair<glm::uint8, dmat3> sample(std::shared_ptr<const TensorField3D> tensorF
         val = glm::mix(tensorLower, tensorUpper, yFrac);
     } else {
         if constexpr (method == tensorutil::InterpolationMethod::Nearest) {
-            val = tensorField->at(size3_t(glm::round(indexPosition)));
+            val = tensorField.at(size3_t(glm::round(indexPosition)));
         }
     }
     return std::pair<glm::uint8, dmat3>(glm::uint8{1}, val);
 }
+}  // namespace detail
+
+/**
+ * Returns a pair of a glm::uint8 and dmat3.
+ * The dmat3 is the tensor. Since the field stores tensors at every position
+ * it has a mask defining where it is actually defined and where not. It is 1
+ * if there is data at this position and 0 if not. If the mask value is zero,
+ * the tensor will be a 0 tensor. If the mask is not set for the tensor field,
+ * the mask value return will always be 0.
+ */
+template <tensorutil::InterpolationMethod method>
+std::pair<glm::uint8, dmat3> sample(std::shared_ptr<const TensorField3D> tensorField,
+                                    const dvec3& position) {
+    return detail::sample3D<method>(*tensorField, position);
+}
+
+/**
+ * Samples a bricked tensor field through the given accessor, see
+ * sample(std::shared_ptr<const TensorField3D>, const dvec3&). Only the bricks containing the
+ * sample positions are decoded. Keep one accessor per thread when sampling many positions, the
+ * brick cache is then only consulted when the samples move to another brick.
+ */
+template <tensorutil::InterpolationMethod method>
+std::pair<glm::uint8, dmat3> sample(BrickedTensorField3D::Accessor& accessor,
+                                    const dvec3& position) {
+    return detail::sample3D<method>(accessor, position);
+}
+
+/**
+ * Samples a bricked tensor field with a temporary accessor, see
+ * sample(BrickedTensorField3D::Accessor&, const dvec3&).
+ */
+template <tensorutil::InterpolationMethod method>
+std::pair<glm::uint8, dmat3> sample(std::shared_ptr<const BrickedTensorField3D> tensorField,
+                                    const dvec3& position) {
+    auto accessor = tensorField->accessor();
+    return detail::sample3D<method>(accessor, position);
+}
 
 /**
  * Returns a pair of a glm::uint8 and dmat3.
@@ -199,4 +231,12 @@ std::pair<glm::uint8, dmat3> sample(std::shared_ptr<const TensorField3D> tensorF
 IVW_MODULE_TENSORVISBASE_API std::pair<glm::uint8, dmat3> sample(
     std::shared_ptr<const TensorField3D> tensorField, const dvec3& position,
     const tensorutil::InterpolationMethod method);
+
+IVW_MODULE_TENSORVISBASE_API std::pair<glm::uint8, dmat3> sample(
+    std::shared_ptr<const BrickedTensorField3D> tensorField, const dvec3& position,
+    const tensorutil::InterpolationMethod method);
+
+IVW_MODULE_TENSORVISBASE_API std::pair<glm::uint8, dmat3> sample(
+    BrickedTensorField3D::Accessor& accessor, const dvec3& position,
+    const tensorutil::InterpolationMethod method);
 }  // namespace inviwo
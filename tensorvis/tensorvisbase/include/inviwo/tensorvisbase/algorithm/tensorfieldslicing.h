@@ -36,6 +36,79 @@
 #include <inviwo/core/datastructures/geometry/geometrytype.h>
 
 namespace inviwo {
+
+/**
+ * \brief Axis aligned slice of a TensorField3D that refers to the tensors of the field.
+ *
+ * Creating a view does not copy any tensors, it only records the offset of the slice and the
+ * strides of its two in-plane axes within the storage of the field. The tensors can be read
+ * directly through at() and projectedAt(). materialize2D() and materialize3D() create a field of
+ * the slice when one is needed, copying row by row in parallel.
+ *
+ * The slice dimensions are ordered as in getSlice2D(), i.e. (y,z) for the x axis, (x,z) for the y
+ * axis and (x,y) for the z axis.
+ */
+class IVW_MODULE_TENSORVISBASE_API TensorField3DSliceView {
+public:
+    TensorField3DSliceView(std::shared_ptr<const TensorField3D> tensorField,
+                           CartesianCoordinateAxis axis, size_t sliceNumber);
+
+    std::shared_ptr<const TensorField3D> getTensorField() const { return tensorField_; }
+    CartesianCoordinateAxis getAxis() const { return axis_; }
+    size_t getSliceNumber() const { return sliceNumber_; }
+
+    size2_t getDimensions() const { return dimensions_; }
+    size_t getSize() const { return dimensions_.x * dimensions_.y; }
+
+    /**
+     * Linear index into the tensor field of the given position in the slice.
+     */
+    size_t index(const size2_t& position) const {
+        return offset_ + position.x * strides_.x + position.y * strides_.y;
+    }
+
+    /**
+     * The tensor of the field at the given position in the slice.
+     */
+    mat3 at(const size2_t& position) const {
+        return tensors_ ? (*tensors_)[index(position)]
+                        : TensorField3D::unpack((*packedTensors_)[index(position)]);
+    }
+
+    /**
+     * The tensor at the given position in the slice projected onto the slice plane, see
+     * tensorutil::getProjectedTensor.
+     */
+    mat2 projectedAt(const size2_t& position) const { return project(at(position)); }
+
+    std::shared_ptr<TensorField2D> materialize2D() const;
+    std::shared_ptr<TensorField3D> materialize3D() const;
+
+private:
+    mat2 project(const mat3& tensor) const {
+        const auto a = static_cast<glm::length_t>(projection_.x);
+        const auto b = static_cast<glm::length_t>(projection_.y);
+        mat2 projected;
+        projected[0][0] = tensor[a][a];
+        projected[1][0] = tensor[b][a];
+        projected[0][1] = tensor[a][b];
+        projected[1][1] = tensor[b][b];
+        return projected;
+    }
+
+    std::shared_ptr<const TensorField3D> tensorField_;
+    // Exactly one of these is set, depending on the storage of the field
+    std::shared_ptr<const std::vector<mat3>> tensors_;
+    std::shared_ptr<const std::vector<TensorField3D::packedN>> packedTensors_;
+
+    CartesianCoordinateAxis axis_;
+    size_t sliceNumber_;
+    size2_t dimensions_;
+    size_t offset_;       // index of the first tensor of the slice
+    size2_t strides_;     // index step along the two in-plane axes
+    size2_t projection_;  // field axes spanning the slice plane
+};
+
 namespace detail {
 IVW_MODULE_TENSORVISBASE_API std::shared_ptr<TensorField2D> getSlice2D(
     std::shared_ptr<const TensorField3D> inTensorField, const CartesianCoordinateAxis axis,
@@ -0,0 +1,120 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfield2d.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+#include <inviwo/core/common/inviwo.h>
+
+namespace inviwo {
+
+/**
+ * \brief Axis aligned sub-box of a TensorField3D that refers to the tensors of the field.
+ *
+ * Creating a view does not copy any tensors. The tensors and the mask of the sub-box can be read
+ * directly through at() and isDefined(), positions are given relative to the origin of the box.
+ * materialize() creates a field of the sub-box when one is needed, see tensorutil::subset().
+ */
+class IVW_MODULE_TENSORVISBASE_API TensorField3DSubsetView {
+public:
+    /**
+     * Throws an Exception if the box is empty or does not fit into the field.
+     */
+    TensorField3DSubsetView(std::shared_ptr<const TensorField3D> tensorField,
+                            const size3_t& origin, const size3_t& dimensions);
+
+    std::shared_ptr<const TensorField3D> getTensorField() const { return tensorField_; }
+    size3_t getOrigin() const { return origin_; }
+    size3_t getDimensions() const { return dimensions_; }
+    size_t getSize() const { return glm::compMul(dimensions_); }
+
+    /**
+     * Linear index into the tensor field of the given position in the sub-box.
+     */
+    size_t index(const size3_t& position) const {
+        return offset_ + position.x + position.y * strides_.y + position.z * strides_.z;
+    }
+
+    mat3 at(const size3_t& position) const {
+        return tensors_ ? (*tensors_)[index(position)]
+                        : TensorField3D::unpack((*packedTensors_)[index(position)]);
+    }
+
+    /**
+     * Mask value at the given position in the sub-box, true if the field has no mask.
+     */
+    bool isDefined(const size3_t& position) const {
+        return !mask_ || (*mask_)[index(position)] != 0;
+    }
+
+    /**
+     * Copies the sub-box into a new field, keeping the storage, mask, meta data policy and every
+     * meta data column of the field. The basis and offset are set such that the sub-box keeps its
+     * position in space.
+     */
+    std::shared_ptr<TensorField3D> materialize() const;
+
+private:
+    std::shared_ptr<const TensorField3D> tensorField_;
+    // Exactly one of these is set, depending on the storage of the field
+    std::shared_ptr<const std::vector<mat3>> tensors_;
+    std::shared_ptr<const std::vector<TensorField3D::packedN>> packedTensors_;
+    std::shared_ptr<const std::vector<glm::uint8>> mask_;
+
+    size3_t origin_;
+    size3_t dimensions_;
+    size_t offset_;    // index of the first tensor of the box
+    size3_t strides_;  // index step along the axes of the field
+};
+
+namespace tensorutil {
+
+/**
+ * Copies the given sub-box of the field. Rows along x are copied as a whole and in parallel. The
+ * storage, mask and every per-tensor meta data column of the field are carried over for the
+ * sub-box, so that no meta data needs to be recomputed. Throws an Exception if the box is empty
+ * or does not fit into the field.
+ */
+IVW_MODULE_TENSORVISBASE_API std::shared_ptr<TensorField2D> subset(
+    std::shared_ptr<const TensorField2D> tensorField, const size2_t& origin,
+    const size2_t& dimensions);
+
+/**
+ * \see subset(std::shared_ptr<const TensorField2D>, const size2_t&, const size2_t&)
+ * \see TensorField3DSubsetView for reading a sub-box without copying it.
+ */
+IVW_MODULE_TENSORVISBASE_API std::shared_ptr<TensorField3D> subset(
+    std::shared_ptr<const TensorField3D> tensorField, const size3_t& origin,
+    const size3_t& dimensions);
+
+}  // namespace tensorutil
+
+}  // namespace inviwo
@@ -30,6 +30,13 @@
 #pragma once
 
 #include <string_view>
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <numeric>
+#include <tuple>
+#include <utility>
+#include <inviwo/core/util/constexprhash.h>
 #include <inviwo/dataframe/datastructures/dataframe.h>
 #include <inviwo/tensorvisbase/util/tensorutil.h>
 
@@ -47,10 +54,29 @@ template <typename T>
 struct TypedAttributeBase : AttributeBase {
     using value_type = T;
     using scalar_type = typename util::value_type<T>::type;
+
+    /**
+     * Whether evaluate() reads the eigen system of the DecomposedTensor. If none of the requested
+     * attributes does, the eigen decomposition is skipped altogether.
+     */
+    static constexpr bool usesEigenSystem = false;
 };
 
 using ScalarBase = TypedAttributeBase<float>;
 
+/**
+ * A tensor together with its eigen system, sorted in descending order of the eigen values, and
+ * the absolute eigen values sorted in descending order. This is computed once per tensor and
+ * shared by the evaluate() methods of all attributes, see calculate() below.
+ */
+template <glm::length_t N, typename T>
+struct DecomposedTensor {
+    glm::mat<N, N, T> tensor;
+    std::array<T, N> eigenValues{};
+    std::array<glm::vec<N, T>, N> eigenVectors{};
+    std::array<T, N> absEigenValues{};
+};
+
 template <glm::length_t N, typename T = float>
 struct VectorBase : TypedAttributeBase<glm::vec<N, T>> {
     static constexpr glm::length_t extent = N;
@@ -63,6 +89,9 @@ struct Trace : ScalarBase {
     static std::vector<value_type> calculate(
         std::shared_ptr<const std::vector<glm::mat<N, N, scalar_type>>> tensors,
         std::shared_ptr<const DataFrame> metaData);
+
+    template <glm::length_t N>
+    static value_type evaluate(const DecomposedTensor<N, scalar_type>& tensor);
 };
 
 struct Norm : ScalarBase {
@@ -72,63 +101,90 @@ struct Norm : ScalarBase {
     static std::vector<value_type> calculate(
         std::shared_ptr<const std::vector<glm::mat<N, N, scalar_type>>> tensors,
         std::shared_ptr<const DataFrame> metaData);
+
+    template <glm::length_t N>
+    static value_type evaluate(const DecomposedTensor<N, scalar_type>& tensor);
 };
 
 struct MajorEigenValue : ScalarBase {
     static constexpr inline std::string_view identifier{"Major Eigenvalue"};
+    static constexpr bool usesEigenSystem = true;
 
     template <glm::length_t N>
     static std::vector<value_type> calculate(
         std::shared_ptr<const std::vector<glm::mat<N, N, scalar_type>>> tensors,
         std::shared_ptr<const DataFrame> metaData);
+
+    template <glm::length_t N>
+    static value_type evaluate(const DecomposedTensor<N, scalar_type>& tensor);
 };
 
 struct IntermediateEigenValue : ScalarBase {
     static constexpr inline std::string_view identifier{"Intermediate Eigenvalue"};
+    static constexpr bool usesEigenSystem = true;
 
     template <glm::length_t N>
     static std::vector<value_type> calculate(
         std::shared_ptr<const std::vector<glm::mat<N, N, scalar_type>>> tensors,
         std::shared_ptr<const DataFrame> metaData);
+
+    template <glm::length_t N>
+    static value_type evaluate(const DecomposedTensor<N, scalar_type>& tensor);
 };
 
 struct MinorEigenValue : ScalarBase {
     static constexpr inline std::string_view identifier{"Minor Eigenvalue"};
+    static constexpr bool usesEigenSystem = true;
 
     template <glm::length_t N>
     static std::vector<value_type> calculate(
         std::shared_ptr<const std::vector<glm::mat<N, N, scalar_type>>> tensors,
         std::shared_ptr<const DataFrame> metaData);
+
+    template <glm::length_t N>
+    static value_type evaluate(const DecomposedTensor<N, scalar_type>& tensor);
 };
 
 template <glm::length_t N>
 struct MajorEigenVector : VectorBase<N> {
     static constexpr inline std::string_view identifier{"Major Eigenvector"};
+    static constexpr bool usesEigenSystem = true;
 
     static std::vector<typename VectorBase<N>::value_type> calculate(
         std::shared_ptr<const std::vector<glm::mat<N, N, typename VectorBase<N>::scalar_type>>>
             tensors,
         std::shared_ptr<const DataFrame> metaData);
+
+    static typename VectorBase<N>::value_type evaluate(
+        const DecomposedTensor<N, typename VectorBase<N>::scalar_type>& tensor);
 };
 
 template <glm::length_t N>
 struct IntermediateEigenVector : VectorBase<N> {
     static constexpr inline std::string_view identifier{"Intermediate Eigenvector"};
+    static constexpr bool usesEigenSystem = true;
 
     static std::vector<typename VectorBase<N>::value_type> calculate(
         std::shared_ptr<const std::vector<glm::mat<N, N, typename VectorBase<N>::scalar_type>>>
             tensors,
         std::shared_ptr<const DataFrame> metaData);
+
+    static typename VectorBase<N>::value_type evaluate(
+        const DecomposedTensor<N, typename VectorBase<N>::scalar_type>& tensor);
 };
 
 template <glm::length_t N>
 struct MinorEigenVector : VectorBase<N> {
     static constexpr inline std::string_view identifier{"Minor Eigenvector"};
+    static constexpr bool usesEigenSystem = true;
 
     static std::vector<typename VectorBase<N>::value_type> calculate(
         std::shared_ptr<const std::vector<glm::mat<N, N, typename VectorBase<N>::scalar_type>>>
             tensors,
         std::shared_ptr<const DataFrame> metaData);
+
+    static typename VectorBase<N>::value_type evaluate(
+        const DecomposedTensor<N, typename VectorBase<N>::scalar_type>& tensor);
 };
 
 struct I1 : ScalarBase {
@@ -138,6 +194,9 @@ struct I1 : ScalarBase {
     static std::vector<value_type> calculate(
         std::shared_ptr<const std::vector<glm::mat<N, N, scalar_type>>> tensors,
         std::shared_ptr<const DataFrame> metaData);
+
+    template <glm::length_t N>
+    static value_type evaluate(const DecomposedTensor<N, scalar_type>& tensor);
 };
 
 struct I2 : ScalarBase {
@@ -147,6 +206,9 @@ struct I2 : ScalarBase {
     static std::vector<value_type> calculate(
         std::shared_ptr<const std::vector<glm::mat<N, N, scalar_type>>> tensors,
         std::shared_ptr<const DataFrame> metaData);
+
+    template <glm::length_t N>
+    static value_type evaluate(const DecomposedTensor<N, scalar_type>& tensor);
 };
 
 struct I3 : ScalarBase {
@@ -156,6 +218,9 @@ struct I3 : ScalarBase {
     static std::vector<value_type> calculate(
         std::shared_ptr<const std::vector<glm::mat<N, N, scalar_type>>> tensors,
         std::shared_ptr<const DataFrame> metaData);
+
+    template <glm::length_t N>
+    static value_type evaluate(const DecomposedTensor<N, scalar_type>& tensor);
 };
 
 struct J1 : ScalarBase {
@@ -165,6 +230,9 @@ struct J1 : ScalarBase {
     static std::vector<value_type> calculate(
         std::shared_ptr<const std::vector<glm::mat<N, N, scalar_type>>> tensors,
         std::shared_ptr<const DataFrame> metaData);
+
+    template <glm::length_t N>
+    static value_type evaluate(const DecomposedTensor<N, scalar_type>& tensor);
 };
 
 struct J2 : ScalarBase {
@@ -174,6 +242,9 @@ struct J2 : ScalarBase {
     static std::vector<value_type> calculate(
         std::shared_ptr<const std::vector<glm::mat<N, N, scalar_type>>> tensors,
         std::shared_ptr<const DataFrame> metaData);
+
+    template <glm::length_t N>
+    static value_type evaluate(const DecomposedTensor<N, scalar_type>& tensor);
 };
 
 struct J3 : ScalarBase {
@@ -183,6 +254,9 @@ struct J3 : ScalarBase {
     static std::vector<value_type> calculate(
         std::shared_ptr<const std::vector<glm::mat<N, N, scalar_type>>> tensors,
         std::shared_ptr<const DataFrame> metaData);
+
+    template <glm::length_t N>
+    static value_type evaluate(const DecomposedTensor<N, scalar_type>& tensor);
 };
 
 struct LodeAngle : ScalarBase {
@@ -192,42 +266,61 @@ struct LodeAngle : ScalarBase {
     static std::vector<value_type> calculate(
         std::shared_ptr<const std::vector<glm::mat<N, N, scalar_type>>> tensors,
         std::shared_ptr<const DataFrame> metaData);
+
+    template <glm::length_t N>
+    static value_type evaluate(const DecomposedTensor<N, scalar_type>& tensor);
 };
 
 struct Anisotropy : ScalarBase {
     static constexpr inline std::string_view identifier{"Anisotropy"};
+    static constexpr bool usesEigenSystem = true;
 
     template <glm::length_t N>
     static std::vector<value_type> calculate(
         std::shared_ptr<const std::vector<glm::mat<N, N, scalar_type>>> tensors,
         std::shared_ptr<const DataFrame> metaData);
+
+    template <glm::length_t N>
+    static value_type evaluate(const DecomposedTensor<N, scalar_type>& tensor);
 };
 
 struct LinearAnisotropy : ScalarBase {
     static constexpr inline std::string_view identifier{"Linear anisotropy"};
+    static constexpr bool usesEigenSystem = true;
 
     template <glm::length_t N>
     static std::vector<value_type> calculate(
         std::shared_ptr<const std::vector<glm::mat<N, N, scalar_type>>> tensors,
         std::shared_ptr<const DataFrame> metaData);
+
+    template <glm::length_t N>
+    static value_type evaluate(const DecomposedTensor<N, scalar_type>& tensor);
 };
 
 struct PlanarAnisotropy : ScalarBase {
     static constexpr inline std::string_view identifier{"Planar anisotropy"};
+    static constexpr bool usesEigenSystem = true;
 
     template <glm::length_t N>
     static std::vector<value_type> calculate(
         std::shared_ptr<const std::vector<glm::mat<N, N, scalar_type>>> tensors,
         std::shared_ptr<const DataFrame> metaData);
+
+    template <glm::length_t N>
+    static value_type evaluate(const DecomposedTensor<N, scalar_type>& tensor);
 };
 
 struct SphericalAnisotropy : ScalarBase {
     static constexpr inline std::string_view identifier{"Spherical anisotropy"};
+    static constexpr bool usesEigenSystem = true;
 
     template <glm::length_t N>
     static std::vector<value_type> calculate(
         std::shared_ptr<const std::vector<glm::mat<N, N, scalar_type>>> tensors,
         std::shared_ptr<const DataFrame> metaData);
+
+    template <glm::length_t N>
+    static value_type evaluate(const DecomposedTensor<N, scalar_type>& tensor);
 };
 
 struct FrobeniusNorm : ScalarBase {
@@ -237,6 +330,9 @@ struct FrobeniusNorm : ScalarBase {
     static std::vector<value_type> calculate(
         std::shared_ptr<const std::vector<glm::mat<N, N, scalar_type>>> tensors,
         std::shared_ptr<const DataFrame> metaData);
+
+    template <glm::length_t N>
+    static value_type evaluate(const DecomposedTensor<N, scalar_type>& tensor);
 };
 
 // Aliases for different domain languages
@@ -293,6 +389,32 @@ using types2D =
     > ;
 // clang-format on
 
+/**
+ * Decomposes the tensor. The eigen system is only computed if withEigenSystem is set, the zero
+ * tensor yields zero eigen values and eigen vectors.
+ */
+template <glm::length_t N, typename T>
+DecomposedTensor<N, T> decompose(const glm::mat<N, N, T>& tensor, bool withEigenSystem = true);
+
+/**
+ * Fused calculation of several attributes. Each tensor is decomposed once and all attributes of
+ * Types whose identifier hash (see util::constexpr_hash) is contained in ids are derived from it
+ * in the same parallel pass, writing directly into pre-sized column buffers. Returns one column
+ * per requested attribute, in the order of Types.
+ */
+template <typename Types, glm::length_t N, typename T>
+std::vector<std::shared_ptr<Column>> calculate(const std::vector<glm::mat<N, N, T>>& tensors,
+                                               const std::vector<size_t>& ids);
+
+/**
+ * \see calculate(const std::vector<glm::mat<N, N, T>>&, const std::vector<size_t>&)
+ * Reads the size tensors through tensorAt(i) instead, e.g. to unpack packed tensors one at a time.
+ * tensorAt is called concurrently.
+ */
+template <typename Types, typename TensorAt>
+std::vector<std::shared_ptr<Column>> calculate(size_t size, const TensorAt& tensorAt,
+                                               const std::vector<size_t>& ids);
+
 }  // namespace attributes
 }  // namespace inviwo
 
@@ -31,384 +31,467 @@
 
 namespace inviwo {
 namespace attributes {
+namespace detail {
+template <typename F, size_t... Is>
+void forEachIndex(F&& f, std::index_sequence<Is...>) {
+    (f(std::integral_constant<size_t, Is>{}), ...);
+}
+
+/**
+ * Column buffers of the requested attributes of Types and raw pointers into them for the parallel
+ * pass. Attributes that were not requested have a nullptr.
+ */
+template <typename Types>
+struct ColumnData;
+
+template <typename... Ts>
+struct ColumnData<std::tuple<Ts...>> {
+    std::tuple<std::shared_ptr<Buffer<typename Ts::value_type>>...> buffers;
+    std::tuple<typename Ts::value_type*...> data{};
+};
+
+template <typename A, glm::length_t N, typename T>
+std::vector<typename A::value_type> calculateSingle(const std::vector<glm::mat<N, N, T>>& tensors) {
+    std::vector<typename A::value_type> result(tensors.size());
+
+#pragma omp parallel for
+    for (int i = 0; i < static_cast<int>(tensors.size()); ++i) {
+        result[i] = A::evaluate(decompose(tensors[i], A::usesEigenSystem));
+    }
+    return result;
+}
+
+template <typename T, size_t N>
+T anisotropyDenominator(const std::array<T, N>& absEigenValues) {
+    const auto denominator = std::accumulate(absEigenValues.begin(), absEigenValues.end(), T(0));
+    return std::max(denominator, std::numeric_limits<T>::epsilon());
+}
+}  // namespace detail
+
+template <glm::length_t N, typename T>
+inline DecomposedTensor<N, T> decompose(const glm::mat<N, N, T>& tensor, bool withEigenSystem) {
+    DecomposedTensor<N, T> decomposed{tensor};
+    decomposed.eigenVectors.fill(glm::vec<N, T>(0));
+
+    if (!withEigenSystem || tensor == glm::mat<N, N, T>(0)) {
+        return decomposed;
+    }
+
+    if constexpr (N == 3) {
+        const auto eigenSystem = tensorutil::calculateEigenValuesAndEigenVectors(dmat3(tensor));
+        for (glm::length_t i = 0; i < N; ++i) {
+            decomposed.eigenValues[i] = static_cast<T>(eigenSystem[i].first);
+            decomposed.eigenVectors[i] = glm::vec<N, T>(eigenSystem[i].second);
+        }
+    } else {
+        Eigen::EigenSolver<Eigen::Matrix<T, N, N>> solver(util::glm2eigen(tensor));
+
+        std::array<std::pair<T, glm::vec<N, T>>, N> sortable;
+        for (glm::length_t i = 0; i < N; ++i) {
+            sortable[i].first = solver.eigenvalues().col(0)[i].real();
+            for (glm::length_t j = 0; j < N; ++j) {
+                sortable[i].second[j] = solver.eigenvectors().col(i).real()[j];
+            }
+        }
+        std::sort(sortable.begin(), sortable.end(),
+                  [](const auto& a, const auto& b) { return a.first > b.first; });
+
+        for (glm::length_t i = 0; i < N; ++i) {
+            decomposed.eigenValues[i] = sortable[i].first;
+            decomposed.eigenVectors[i] = sortable[i].second;
+        }
+    }
+
+    std::transform(decomposed.eigenValues.begin(), decomposed.eigenValues.end(),
+                   decomposed.absEigenValues.begin(), [](const T& val) { return std::abs(val); });
+    std::sort(decomposed.absEigenValues.begin(), decomposed.absEigenValues.end(), std::greater<T>());
+
+    return decomposed;
+}
+
+template <typename Types, glm::length_t N, typename T>
+inline std::vector<std::shared_ptr<Column>> calculate(const std::vector<glm::mat<N, N, T>>& tensors,
+                                                      const std::vector<size_t>& ids) {
+    return calculate<Types>(
+        tensors.size(), [&tensors](size_t i) -> const glm::mat<N, N, T>& { return tensors[i]; },
+        ids);
+}
+
+template <typename Types, typename TensorAt>
+inline std::vector<std::shared_ptr<Column>> calculate(size_t size, const TensorAt& tensorAt,
+                                                      const std::vector<size_t>& ids) {
+    using Indices = std::make_index_sequence<std::tuple_size_v<Types>>;
+
+    detail::ColumnData<Types> columns;
+    bool requested = false;
+    bool usesEigenSystem = false;
+
+    detail::forEachIndex(
+        [&](auto I) {
+            constexpr auto index = decltype(I)::value;
+            using A = std::tuple_element_t<index, Types>;
+
+            if (std::find(ids.begin(), ids.end(), util::constexpr_hash(A::identifier)) ==
+                ids.end()) {
+                return;
+            }
+
+            auto buffer = std::make_shared<Buffer<typename A::value_type>>(size);
+            std::get<index>(columns.data) =
+                buffer->getEditableRAMRepresentation()->getDataContainer().data();
+            std::get<index>(columns.buffers) = buffer;
+
+            requested = true;
+            usesEigenSystem = usesEigenSystem || A::usesEigenSystem;
+        },
+        Indices{});
+
+    if (!requested) return {};
+
+#pragma omp parallel for
+    for (int i = 0; i < static_cast<int>(size); ++i) {
+        const auto decomposed = decompose(tensorAt(static_cast<size_t>(i)), usesEigenSystem);
+
+        detail::forEachIndex(
+            [&](auto I) {
+                constexpr auto index = decltype(I)::value;
+                if (auto data = std::get<index>(columns.data)) {
+                    data[i] = std::tuple_element_t<index, Types>::evaluate(decomposed);
+                }
+            },
+            Indices{});
+    }
+
+    std::vector<std::shared_ptr<Column>> result;
+    detail::forEachIndex(
+        [&](auto I) {
+            constexpr auto index = decltype(I)::value;
+            using A = std::tuple_element_t<index, Types>;
+
+            if (auto buffer = std::get<index>(columns.buffers)) {
+                result.push_back(std::make_shared<TemplateColumn<typename A::value_type>>(
+                    std::string(A::identifier), buffer));
+            }
+        },
+        Indices{});
+
+    return result;
+}
+
 template <glm::length_t N>
 inline std::vector<typename Trace::value_type> Trace::calculate(
     std::shared_ptr<const std::vector<glm::mat<N, N, typename Trace::scalar_type>>> tensors,
-    std::shared_ptr<const DataFrame> metaData) {
-    std::vector<typename Trace::value_type> trace{};
-    for (const auto& tensor : *tensors) {
-        trace.emplace_back(util::trace(tensor));
-    }
-    return trace;
+    std::shared_ptr<const DataFrame>) {
+    return detail::calculateSingle<Trace>(*tensors);
+}
+
+template <glm::length_t N>
+inline typename Trace::value_type Trace::evaluate(
+    const DecomposedTensor<N, typename Trace::scalar_type>& tensor) {
+    return util::trace(tensor.tensor);
 }
 
 template <glm::length_t N>
 inline std::vector<typename Norm::value_type> Norm::calculate(
     std::shared_ptr<const std::vector<glm::mat<N, N, typename Norm::scalar_type>>> tensors,
-    std::shared_ptr<const DataFrame> metaData) {
-    std::vector<typename Norm::value_type> norm{};
-    for (const auto& tensor : *tensors) {
-        typename Norm::value_type sum{0};
-        for (unsigned int i{0}; i < N; ++i) {
-            for (unsigned int j{0}; j < N; ++j) {
-                sum += tensor[i][j] * tensor[i][j];
-            }
+    std::shared_ptr<const DataFrame>) {
+    return detail::calculateSingle<Norm>(*tensors);
+}
+
+template <glm::length_t N>
+inline typename Norm::value_type Norm::evaluate(
+    const DecomposedTensor<N, typename Norm::scalar_type>& tensor) {
+    typename Norm::value_type sum{0};
+    for (unsigned int i{0}; i < N; ++i) {
+        for (unsigned int j{0}; j < N; ++j) {
+            sum += tensor.tensor[i][j] * tensor.tensor[i][j];
         }
-        norm.push_back(std::sqrt(sum));
     }
-    return norm;
+    return std::sqrt(sum);
 }
 
 template <glm::length_t N>
 inline std::vector<typename MajorEigenValue::value_type> MajorEigenValue::calculate(
     std::shared_ptr<const std::vector<glm::mat<N, N, typename MajorEigenValue::scalar_type>>>
         tensors,
-    std::shared_ptr<const DataFrame> metaData) {
-    std::vector<typename MajorEigenValue::value_type> l1{};
-    for (const auto& tensor : *tensors) {
-        l1.emplace_back(util::eigenvalue<0>(tensor));
-    }
-    return l1;
+    std::shared_ptr<const DataFrame>) {
+    return detail::calculateSingle<MajorEigenValue>(*tensors);
+}
+
+template <glm::length_t N>
+inline typename MajorEigenValue::value_type MajorEigenValue::evaluate(
+    const DecomposedTensor<N, typename MajorEigenValue::scalar_type>& tensor) {
+    return tensor.eigenValues[0];
 }
 
 template <glm::length_t N>
 inline std::vector<typename IntermediateEigenValue::value_type> IntermediateEigenValue::calculate(
     std::shared_ptr<const std::vector<glm::mat<N, N, typename IntermediateEigenValue::scalar_type>>>
-    tensors,
-    std::shared_ptr<const DataFrame> metaData) {
-    if constexpr (N % 2) {
-        std::vector<typename IntermediateEigenValue::value_type> l2{};
-        for (const auto& tensor : *tensors) {
-            l2.emplace_back(util::eigenvalue<N / 2>(tensor));
-        }
-        return l2;
-    }
+        tensors,
+    std::shared_ptr<const DataFrame>) {
+    return detail::calculateSingle<IntermediateEigenValue>(*tensors);
+}
+
+template <glm::length_t N>
+inline typename IntermediateEigenValue::value_type IntermediateEigenValue::evaluate(
+    const DecomposedTensor<N, typename IntermediateEigenValue::scalar_type>& tensor) {
+    return tensor.eigenValues[N / 2];
 }
 
 template <glm::length_t N>
 inline std::vector<typename MinorEigenValue::value_type> MinorEigenValue::calculate(
     std::shared_ptr<const std::vector<glm::mat<N, N, typename MinorEigenValue::scalar_type>>>
-    tensors,
-    std::shared_ptr<const DataFrame> metaData) {
-    std::vector<typename MinorEigenValue::value_type> ln{};
-    for (const auto& tensor : *tensors) {
-        ln.emplace_back(util::eigenvalue<N - 1>(tensor));
-    }
-    return ln;
+        tensors,
+    std::shared_ptr<const DataFrame>) {
+    return detail::calculateSingle<MinorEigenValue>(*tensors);
+}
+
+template <glm::length_t N>
+inline typename MinorEigenValue::value_type MinorEigenValue::evaluate(
+    const DecomposedTensor<N, typename MinorEigenValue::scalar_type>& tensor) {
+    return tensor.eigenValues[N - 1];
 }
 
 template <glm::length_t N>
 inline std::vector<typename VectorBase<N>::value_type> MajorEigenVector<N>::calculate(
     std::shared_ptr<const std::vector<glm::mat<N, N, typename VectorBase<N>::scalar_type>>>
-    tensors,
-    std::shared_ptr<const DataFrame> metaData) {
-    std::vector<typename VectorBase<N>::value_type> ev{};
-    for (const auto& tensor : *tensors) {
-        ev.emplace_back(util::eigenvector<0>(tensor));
-    }
-    return ev;
+        tensors,
+    std::shared_ptr<const DataFrame>) {
+    return detail::calculateSingle<MajorEigenVector<N>>(*tensors);
+}
+
+template <glm::length_t N>
+inline typename VectorBase<N>::value_type MajorEigenVector<N>::evaluate(
+    const DecomposedTensor<N, typename VectorBase<N>::scalar_type>& tensor) {
+    return tensor.eigenVectors[0];
 }
 
 template <glm::length_t N>
 inline std::vector<typename VectorBase<N>::value_type> IntermediateEigenVector<N>::calculate(
     std::shared_ptr<const std::vector<glm::mat<N, N, typename VectorBase<N>::scalar_type>>>
-    tensors,
-    std::shared_ptr<const DataFrame> metaData) {
-    if constexpr (N % 2) {
-        std::vector<typename VectorBase<N>::value_type> ev{};
-        for (const auto& tensor : *tensors) {
-            ev.emplace_back(util::eigenvector<N / 2>(tensor));
-        }
-        return ev;
-    }
+        tensors,
+    std::shared_ptr<const DataFrame>) {
+    return detail::calculateSingle<IntermediateEigenVector<N>>(*tensors);
+}
+
+template <glm::length_t N>
+inline typename VectorBase<N>::value_type IntermediateEigenVector<N>::evaluate(
+    const DecomposedTensor<N, typename VectorBase<N>::scalar_type>& tensor) {
+    return tensor.eigenVectors[N / 2];
 }
 
 template <glm::length_t N>
 inline std::vector<typename VectorBase<N>::value_type> MinorEigenVector<N>::calculate(
     std::shared_ptr<const std::vector<glm::mat<N, N, typename VectorBase<N>::scalar_type>>>
-    tensors,
-    std::shared_ptr<const DataFrame> metaData) {
-    std::vector<typename VectorBase<N>::value_type> ev{};
-    for (const auto& tensor : *tensors) {
-        ev.emplace_back(util::eigenvector<N - 1>(tensor));
-    }
-    return ev;
+        tensors,
+    std::shared_ptr<const DataFrame>) {
+    return detail::calculateSingle<MinorEigenVector<N>>(*tensors);
 }
 
-//template <glm::length_t N>
-//inline std::vector<typename XXX::value_type> XXX::calculate(
-//    std::shared_ptr<const std::vector<glm::mat<N, N, typename XXX::scalar_type>>>
-//    tensors,
-//    std::shared_ptr<const DataFrame> metaData) {
-//    std::vector<typename XXX::value_type> YYY{};
-//    for (const auto& tensor : *tensors) {
-//        ;
-//    }
-//    return YYY;
-//}
+template <glm::length_t N>
+inline typename VectorBase<N>::value_type MinorEigenVector<N>::evaluate(
+    const DecomposedTensor<N, typename VectorBase<N>::scalar_type>& tensor) {
+    return tensor.eigenVectors[N - 1];
+}
 
 template <glm::length_t N>
 inline std::vector<typename I1::value_type> I1::calculate(
-    std::shared_ptr<const std::vector<glm::mat<N, N, typename I1::scalar_type>>>
-    tensors,
-    std::shared_ptr<const DataFrame> metaData) {
-        auto i1 = std::vector<value_type>();
-        i1.reserve(tensors->size());
-        for (const auto& tensor : *tensors) {
-            i1.emplace_back(util::trace(tensor));
-        }
-        return i1;
-    }
+    std::shared_ptr<const std::vector<glm::mat<N, N, typename I1::scalar_type>>> tensors,
+    std::shared_ptr<const DataFrame>) {
+    return detail::calculateSingle<I1>(*tensors);
+}
+
+template <glm::length_t N>
+inline typename I1::value_type I1::evaluate(
+    const DecomposedTensor<N, typename I1::scalar_type>& tensor) {
+    return util::trace(tensor.tensor);
+}
 
 template <glm::length_t N>
 inline std::vector<typename I2::value_type> I2::calculate(
-    std::shared_ptr<const std::vector<glm::mat<N, N, typename I2::scalar_type>>>
-    tensors,
-    std::shared_ptr<const DataFrame> metaData) {
-        if constexpr (N == 3) {
-            auto i2 = std::vector<value_type>();
-            for (const auto& tensor : *tensors) {
-                i2.emplace_back(tensor[0][0] * tensor[1][1] + tensor[1][1] * tensor[2][2] +
-                                tensor[0][0] * tensor[2][2] - tensor[0][1] * tensor[0][1] -
-                                tensor[1][2] * tensor[1][2] - tensor[2][0] * tensor[2][0]);
-            }
-            return i2;
-        }
+    std::shared_ptr<const std::vector<glm::mat<N, N, typename I2::scalar_type>>> tensors,
+    std::shared_ptr<const DataFrame>) {
+    return detail::calculateSingle<I2>(*tensors);
+}
+
+template <glm::length_t N>
+inline typename I2::value_type I2::evaluate(
+    const DecomposedTensor<N, typename I2::scalar_type>& tensor) {
+    if constexpr (N == 3) {
+        const auto& t = tensor.tensor;
+        return t[0][0] * t[1][1] + t[1][1] * t[2][2] + t[0][0] * t[2][2] - t[0][1] * t[0][1] -
+               t[1][2] * t[1][2] - t[2][0] * t[2][0];
+    } else {
+        return value_type(0);
     }
+}
 
 template <glm::length_t N>
 inline std::vector<typename I3::value_type> I3::calculate(
-    std::shared_ptr<const std::vector<glm::mat<N, N, typename I3::scalar_type>>>
-    tensors,
-    std::shared_ptr<const DataFrame> metaData) {
-        if constexpr (N == 3) {
-            auto i3 = std::vector<value_type>();
-            for (const auto& tensor : *tensors) {
-                i3.emplace_back(tensor[0][0] * tensor[1][1] * tensor[2][2] +
-                                value_type(2) * tensor[0][1] * tensor[1][2] * tensor[2][0] -
-                                tensor[0][1] * tensor[0][1] * tensor[2][2] -
-                                tensor[1][2] * tensor[1][2] * tensor[0][0] -
-                                tensor[2][0] * tensor[2][0] * tensor[1][1]);
-            }
-            return i3;
-        }
+    std::shared_ptr<const std::vector<glm::mat<N, N, typename I3::scalar_type>>> tensors,
+    std::shared_ptr<const DataFrame>) {
+    return detail::calculateSingle<I3>(*tensors);
+}
+
+template <glm::length_t N>
+inline typename I3::value_type I3::evaluate(
+    const DecomposedTensor<N, typename I3::scalar_type>& tensor) {
+    if constexpr (N == 3) {
+        const auto& t = tensor.tensor;
+        return t[0][0] * t[1][1] * t[2][2] + value_type(2) * t[0][1] * t[1][2] * t[2][0] -
+               t[0][1] * t[0][1] * t[2][2] - t[1][2] * t[1][2] * t[0][0] -
+               t[2][0] * t[2][0] * t[1][1];
+    } else {
+        return value_type(0);
     }
+}
 
 template <glm::length_t N>
 inline std::vector<typename J1::value_type> J1::calculate(
-    std::shared_ptr<const std::vector<glm::mat<N, N, typename J1::scalar_type>>>
-    tensors,
-    std::shared_ptr<const DataFrame> metaData) {
-        auto j1 = std::vector<value_type>(tensors->size());
-        std::fill(j1.begin(), j1.end(), value_type(0));
-        return j1;
-    }
+    std::shared_ptr<const std::vector<glm::mat<N, N, typename J1::scalar_type>>> tensors,
+    std::shared_ptr<const DataFrame>) {
+    return std::vector<value_type>(tensors->size(), value_type(0));
+}
 
+/**
+ * The first invariant of the deviatoric tensor, its trace, vanishes by definition.
+ */
 template <glm::length_t N>
-inline std::vector<typename J2::value_type> J2::calculate(
-    std::shared_ptr<const std::vector<glm::mat<N, N, typename J2::scalar_type>>>
-    tensors,
-    std::shared_ptr<const DataFrame> metaData) {
-        if constexpr (N == 3) {
-            auto j2 = std::vector<value_type>();
-            const auto i1 = I1::calculate(tensors, metaData);
-            const auto i2 = I2::calculate(tensors, metaData);
-            for (size_t i{0}; i < tensors->size(); ++i) {
-                j2.emplace_back((value_type(1. / 3.)) * i1[i] * i1[i] - i2[i]);
-            }
-            return j2;
-        }
-    }
+inline typename J1::value_type J1::evaluate(const DecomposedTensor<N, typename J1::scalar_type>&) {
+    return value_type(0);
+}
 
 template <glm::length_t N>
-inline std::vector<typename J3::value_type> J3::calculate(
-    std::shared_ptr<const std::vector<glm::mat<N, N, typename J3::scalar_type>>>
-    tensors,
-    std::shared_ptr<const DataFrame> metaData) {
-        if constexpr (N == 3) {
-            auto j3 = std::vector<value_type>();
-            const auto i1 = I1::calculate(tensors, metaData);
-            const auto i2 = I2::calculate(tensors, metaData);
-            const auto i3 = I3::calculate(tensors, metaData);
-
-            for (size_t i{0}; i < tensors->size(); ++i) {
-                j3.emplace_back(value_type(2.0 / 27.0) * i1[i] * i1[i] * i1[i] -
-                                value_type(1.0 / 3.0) * i1[i] * i2[i] + i3[i]);
-            }
-            return j3;
-        }
-    }
+inline std::vector<typename J2::value_type> J2::calculate(
+    std::shared_ptr<const std::vector<glm::mat<N, N, typename J2::scalar_type>>> tensors,
+    std::shared_ptr<const DataFrame>) {
+    return detail::calculateSingle<J2>(*tensors);
+}
 
 template <glm::length_t N>
-inline std::vector<typename LodeAngle::value_type> LodeAngle::calculate(
-    std::shared_ptr<const std::vector<glm::mat<N, N, typename LodeAngle::scalar_type>>>
-    tensors,
-    std::shared_ptr<const DataFrame> metaData) {
-        if constexpr (N == 3) {
-            auto lodeAngle = std::vector<value_type>();
-            constexpr auto a =
-                (value_type(3.0) * util::constexpr_sqrt(value_type(3.0))) * value_type(0.5);
-            constexpr auto third = value_type(1.0 / 3.0);
-
-            const auto j2 = J2::calculate(tensors, metaData);
-            const auto j3 = J3::calculate(tensors, metaData);
-
-            for (size_t i{0}; i < tensors->size(); ++i) {
-                const auto b = j3[i] / std::pow(j2[i], value_type(1.5));
-
-                lodeAngle.emplace_back(third * std::acos(a * b));
-            }
-            return lodeAngle;
-        }
-    }
+inline typename J2::value_type J2::evaluate(
+    const DecomposedTensor<N, typename J2::scalar_type>& tensor) {
+    const auto i1 = I1::evaluate(tensor);
+    const auto i2 = I2::evaluate(tensor);
+    return value_type(1. / 3.) * i1 * i1 - i2;
+}
 
-namespace {
-template <glm::length_t N, typename T>
-std::vector<std::array<T, N>> sortedEigenValues(
-    std::shared_ptr<const std::vector<glm::mat<N, N, T>>> tensors,
-    std::shared_ptr<const DataFrame> metaData) {
+template <glm::length_t N>
+inline std::vector<typename J3::value_type> J3::calculate(
+    std::shared_ptr<const std::vector<glm::mat<N, N, typename J3::scalar_type>>> tensors,
+    std::shared_ptr<const DataFrame>) {
+    return detail::calculateSingle<J3>(*tensors);
+}
 
-    std::vector<T> mae;
-    std::vector<T> ine;
-    std::vector<T> mie;
+template <glm::length_t N>
+inline typename J3::value_type J3::evaluate(
+    const DecomposedTensor<N, typename J3::scalar_type>& tensor) {
+    const auto i1 = I1::evaluate(tensor);
+    const auto i2 = I2::evaluate(tensor);
+    const auto i3 = I3::evaluate(tensor);
+    return value_type(2.0 / 27.0) * i1 * i1 * i1 - value_type(1.0 / 3.0) * i1 * i2 + i3;
+}
 
-    if (!metaData->getColumn(std::string(MajorEigenValue::identifier))) {
-        mae = MajorEigenValue::calculate(tensors, metaData);
-    }
-    if (!metaData->getColumn(std::string(IntermediateEigenValue::identifier))) {
-        ine = IntermediateEigenValue::calculate(tensors, metaData);
-    }
-    if (!metaData->getColumn(std::string(MinorEigenValue::identifier))) {
-        mie = MinorEigenValue::calculate(tensors, metaData);
-    }
+template <glm::length_t N>
+inline std::vector<typename LodeAngle::value_type> LodeAngle::calculate(
+    std::shared_ptr<const std::vector<glm::mat<N, N, typename LodeAngle::scalar_type>>> tensors,
+    std::shared_ptr<const DataFrame>) {
+    return detail::calculateSingle<LodeAngle>(*tensors);
+}
 
-    const auto& majorEigenValues =
-        mae.empty() ? std::dynamic_pointer_cast<const TemplateColumn<T>>(
-                          metaData->getColumn(std::string(MajorEigenValue::identifier)))
-                          ->getTypedBuffer()
-                          ->getRAMRepresentation()
-                          ->getDataContainer()
-                    : mae;
-    const auto& intermediateEigenValues =
-        ine.empty() ? std::dynamic_pointer_cast<const TemplateColumn<T>>(
-                          metaData->getColumn(std::string(IntermediateEigenValue::identifier)))
-                          ->getTypedBuffer()
-                          ->getRAMRepresentation()
-                          ->getDataContainer()
-                    : ine;
-    const auto& minorEigenValues =
-        mie.empty() ? std::dynamic_pointer_cast<const TemplateColumn<T>>(
-                          metaData->getColumn(std::string(MinorEigenValue::identifier)))
-                          ->getTypedBuffer()
-                          ->getRAMRepresentation()
-                          ->getDataContainer()
-                    : mie;
-
-    auto ev = std::vector<std::array<T, N>>{};
-
-    for (size_t i = 0; i < majorEigenValues.size(); i++) {
-        std::array<T, N> eigenValues{majorEigenValues[i], intermediateEigenValues[i],
-                                     minorEigenValues[i]};
-
-        std::transform(eigenValues.begin(), eigenValues.end(), eigenValues.begin(),
-                       [](const T& val) { return glm::abs(val); });
-
-        std::sort(eigenValues.begin(), eigenValues.end(),
-                  [](const T& valA, const T& valB) { return valA > valB; });
-
-        ev.push_back(eigenValues);
-    }
+template <glm::length_t N>
+inline typename LodeAngle::value_type LodeAngle::evaluate(
+    const DecomposedTensor<N, typename LodeAngle::scalar_type>& tensor) {
+    constexpr auto a = (value_type(3.0) * util::constexpr_sqrt(value_type(3.0))) * value_type(0.5);
+    constexpr auto third = value_type(1.0 / 3.0);
 
-    return ev;
+    const auto b = J3::evaluate(tensor) / std::pow(J2::evaluate(tensor), value_type(1.5));
+    return third * std::acos(a * b);
 }
-}  // namespace
 
 template <glm::length_t N>
 inline std::vector<typename Anisotropy::value_type> Anisotropy::calculate(
-    std::shared_ptr<const std::vector<glm::mat<N, N, typename Anisotropy::scalar_type>>>
-    tensors,
-    std::shared_ptr<const DataFrame> metaData) {
-        if constexpr (N == 3) {
-            std::vector<scalar_type> anisotropy{};
-            auto ev = sortedEigenValues(tensors, metaData);
-            for (const auto& eigenValues : ev) {
-                auto denominator = eigenValues[0] + eigenValues[N / 2] + eigenValues[N - 1];
-                if (denominator < std::numeric_limits<scalar_type>::epsilon())
-                    denominator = std::numeric_limits<scalar_type>::epsilon();
-
-                anisotropy.emplace_back(std::abs(eigenValues[0] - eigenValues[2]));
-            }
-            return anisotropy;
-        }
-    }
+    std::shared_ptr<const std::vector<glm::mat<N, N, typename Anisotropy::scalar_type>>> tensors,
+    std::shared_ptr<const DataFrame>) {
+    return detail::calculateSingle<Anisotropy>(*tensors);
+}
+
+template <glm::length_t N>
+inline typename Anisotropy::value_type Anisotropy::evaluate(
+    const DecomposedTensor<N, typename Anisotropy::scalar_type>& tensor) {
+    return std::abs(tensor.absEigenValues[0] - tensor.absEigenValues[N - 1]);
+}
 
 template <glm::length_t N>
 inline std::vector<typename LinearAnisotropy::value_type> LinearAnisotropy::calculate(
     std::shared_ptr<const std::vector<glm::mat<N, N, typename LinearAnisotropy::scalar_type>>>
-    tensors,
-    std::shared_ptr<const DataFrame> metaData) {
-        if constexpr (N == 3) {
-            std::vector<scalar_type> linearAnisotropy{};
-            auto ev = sortedEigenValues(tensors, metaData);
-            for (const auto& eigenValues : ev) {
-                auto denominator = eigenValues[0] + eigenValues[N / 2] + eigenValues[N - 1];
-                if (denominator < std::numeric_limits<scalar_type>::epsilon())
-                    denominator = std::numeric_limits<scalar_type>::epsilon();
-
-                linearAnisotropy.emplace_back((eigenValues[0] - eigenValues[1]) / denominator);
-            }
-            return linearAnisotropy;
-        }
+        tensors,
+    std::shared_ptr<const DataFrame>) {
+    return detail::calculateSingle<LinearAnisotropy>(*tensors);
+}
+
+template <glm::length_t N>
+inline typename LinearAnisotropy::value_type LinearAnisotropy::evaluate(
+    const DecomposedTensor<N, typename LinearAnisotropy::scalar_type>& tensor) {
+    if constexpr (N == 3) {
+        const auto& ev = tensor.absEigenValues;
+        return (ev[0] - ev[1]) / detail::anisotropyDenominator(ev);
+    } else {
+        return value_type(0);
     }
+}
 
 template <glm::length_t N>
 inline std::vector<typename PlanarAnisotropy::value_type> PlanarAnisotropy::calculate(
     std::shared_ptr<const std::vector<glm::mat<N, N, typename PlanarAnisotropy::scalar_type>>>
-    tensors,
-    std::shared_ptr<const DataFrame> metaData) {
-        if constexpr (N == 3) {
-            std::vector<scalar_type> planarAnisotropy{};
-            auto ev = sortedEigenValues(tensors, metaData);
-            for (const auto& eigenValues : ev) {
-                auto denominator = eigenValues[0] + eigenValues[N / 2] + eigenValues[N - 1];
-                if (denominator < std::numeric_limits<scalar_type>::epsilon())
-                    denominator = std::numeric_limits<scalar_type>::epsilon();
-
-                planarAnisotropy.emplace_back((scalar_type(2) * (eigenValues[1] - eigenValues[2])) /
-                                              denominator);
-            }
-            return planarAnisotropy;
-        }
+        tensors,
+    std::shared_ptr<const DataFrame>) {
+    return detail::calculateSingle<PlanarAnisotropy>(*tensors);
+}
+
+template <glm::length_t N>
+inline typename PlanarAnisotropy::value_type PlanarAnisotropy::evaluate(
+    const DecomposedTensor<N, typename PlanarAnisotropy::scalar_type>& tensor) {
+    if constexpr (N == 3) {
+        const auto& ev = tensor.absEigenValues;
+        return (scalar_type(2) * (ev[1] - ev[2])) / detail::anisotropyDenominator(ev);
+    } else {
+        return value_type(0);
     }
+}
 
 template <glm::length_t N>
 inline std::vector<typename SphericalAnisotropy::value_type> SphericalAnisotropy::calculate(
     std::shared_ptr<const std::vector<glm::mat<N, N, typename SphericalAnisotropy::scalar_type>>>
-    tensors,
-    std::shared_ptr<const DataFrame> metaData) {
-        if constexpr (N == 3) {
-            std::vector<scalar_type> sphericalAnisotropy{};
-            auto ev = sortedEigenValues(tensors, metaData);
-            for (const auto& eigenValues : ev) {
-                auto denominator = eigenValues[0] + eigenValues[N / 2] + eigenValues[N - 1];
-                if (denominator < std::numeric_limits<scalar_type>::epsilon())
-                    denominator = std::numeric_limits<scalar_type>::epsilon();
-
-                sphericalAnisotropy.emplace_back((scalar_type(3) * eigenValues[2]) / denominator);
-            }
-            return sphericalAnisotropy;
-        }
+        tensors,
+    std::shared_ptr<const DataFrame>) {
+    return detail::calculateSingle<SphericalAnisotropy>(*tensors);
+}
+
+template <glm::length_t N>
+inline typename SphericalAnisotropy::value_type SphericalAnisotropy::evaluate(
+    const DecomposedTensor<N, typename SphericalAnisotropy::scalar_type>& tensor) {
+    if constexpr (N == 3) {
+        const auto& ev = tensor.absEigenValues;
+        return (scalar_type(3) * ev[2]) / detail::anisotropyDenominator(ev);
+    } else {
+        return value_type(0);
     }
+}
 
 template <glm::length_t N>
 inline std::vector<typename FrobeniusNorm::value_type> FrobeniusNorm::calculate(
     std::shared_ptr<const std::vector<glm::mat<N, N, typename FrobeniusNorm::scalar_type>>>
-    tensors,
-    std::shared_ptr<const DataFrame> metaData) {
-        std::vector<value_type> ret;
-        ret.resize(tensors->size());
-        return ret;
-    }
+        tensors,
+    std::shared_ptr<const DataFrame>) {
+    return detail::calculateSingle<FrobeniusNorm>(*tensors);
+}
+
+template <glm::length_t N>
+inline typename FrobeniusNorm::value_type FrobeniusNorm::evaluate(
+    const DecomposedTensor<N, typename FrobeniusNorm::scalar_type>& tensor) {
+    return Norm::evaluate(tensor);
+}
 
 }  // namespace attributes
 }  // namespace inviwo
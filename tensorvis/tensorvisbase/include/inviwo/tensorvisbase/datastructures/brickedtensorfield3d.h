@@ -0,0 +1,238 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/spatialdata.h>
+#include <inviwo/core/util/indexmapper.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \class BrickedTensorField3D
+ * \brief Out-of-core 3D tensor field, stored in fixed-size bricks in a memory mapped file.
+ *
+ * The bricks are decoded on access and kept in an LRU cache of getCacheSize() bricks, shared
+ * between shallow copies of the field. Only the bricks in use have to fit into memory, hence
+ * fields larger than memory can be processed brick by brick with forEachBrick(), or region by
+ * region with extract(). Per-voxel access goes through an Accessor, which holds on to the brick
+ * it last accessed and only consults the cache when leaving it. at() and sample() are thread safe.
+ *
+ * Bricks are written with write(), either from a TensorField3D or streamed from a BrickSource.
+ */
+class IVW_MODULE_TENSORVISBASE_API BrickedTensorField3D : public StructuredGridEntity<3> {
+public:
+    using matN = TensorField3D::matN;
+    using value_type = TensorField3D::value_type;
+
+    static constexpr size_t defaultBrickSize = 32;
+    static constexpr size_t defaultCacheSize = 256;
+
+    /**
+     * A brick of the field. The tensors are stored with a stride of the brick size of the field,
+     * bricks at the upper boundary only have the first dimensions tensors along each axis defined.
+     */
+    struct Brick {
+        size3_t index;
+        size3_t origin;
+        size3_t dimensions;
+        size_t brickSize;
+        std::shared_ptr<const std::vector<matN>> tensors;
+
+        /**
+         * Tensor at the given position relative to the origin of the brick
+         */
+        const matN& at(const size3_t& position) const {
+            return (*tensors)[position.x + brickSize * (position.y + brickSize * position.z)];
+        }
+    };
+
+    /**
+     * Per-voxel access through a brick handle. The brick containing the accessed voxel is fetched
+     * from the cache, which takes its lock, only when the previous access was in another brick.
+     * Neighbouring accesses, e.g. the corners of an interpolation, therefore do not lock. An
+     * accessor is not thread safe, use one per thread.
+     */
+    class Accessor {
+    public:
+        explicit Accessor(const BrickedTensorField3D& tensorField) : tensorField_(&tensorField) {}
+
+        /**
+         * Returns the tensor by value, the brick it is stored in might be released by the next
+         * access
+         */
+        matN at(const size3_t& position);
+        matN at(size_t index) { return at(tensorField_->indexMapper_(index)); }
+
+        template <typename T = size_t>
+        glm::vec<3, T> getBounds() const {
+            return tensorField_->getBounds<T>();
+        }
+
+        const BrickedTensorField3D& tensorField() const { return *tensorField_; }
+
+    private:
+        const BrickedTensorField3D* tensorField_;
+        Brick brick_{};
+    };
+
+    /**
+     * Fills out with the tensors of the box [origin, origin + dimensions), x fastest. Called once
+     * per brick, in order.
+     */
+    using BrickSource =
+        std::function<void(const size3_t& origin, const size3_t& dimensions, matN* out)>;
+
+    /**
+     * Opens the brick file at path. Throws a FileException if the file cannot be read.
+     */
+    explicit BrickedTensorField3D(const std::string& path, size_t cacheSize = defaultCacheSize);
+
+    /**
+     * NOTE: Creates a shallow copy, the copy shares the file and the brick cache.
+     */
+    BrickedTensorField3D(const BrickedTensorField3D& rhs) = default;
+    BrickedTensorField3D& operator=(const BrickedTensorField3D&) = delete;
+    virtual ~BrickedTensorField3D() = default;
+
+    virtual BrickedTensorField3D* clone() const override;
+
+    std::string getDataInfo() const;
+
+    virtual size3_t getDimensions() const final;
+    size_t getSize() const;
+    TensorStorage storage() const;
+
+    template <typename T = float>
+    glm::vec<3, T> getExtents() const;
+    template <typename T = size_t>
+    glm::vec<3, T> getBounds() const;
+    template <typename T = float>
+    glm::vec<3, T> getSpacing() const;
+
+    size_t getBrickSize() const;
+    size3_t getNumberOfBricks() const;
+
+    size_t getCacheSize() const;
+    /**
+     * Maximum number of decoded bricks kept in memory. Bricks still referenced elsewhere stay
+     * alive until released.
+     */
+    void setCacheSize(size_t cacheSize);
+
+    /**
+     * Looks up the brick in the cache on every call, use an Accessor for repeated access.
+     */
+    matN at(const size3_t& position) const;
+    matN at(size_t index) const;
+
+    Accessor accessor() const { return Accessor(*this); }
+
+    /**
+     * Returns the brick with the given brick index, decoding it if it is not cached.
+     */
+    Brick getBrick(const size3_t& brickIndex) const;
+
+    /**
+     * Calls func for every brick, in parallel. Each brick is only referenced while func runs on
+     * it, so the field is streamed through the cache. func must be thread safe and not throw.
+     */
+    void forEachBrick(const std::function<void(const Brick&)>& func) const;
+
+    /**
+     * Copies the box [min, max] of the field into a new in-memory tensor field, with extents and
+     * offset set accordingly.
+     */
+    std::shared_ptr<TensorField3D> extract(const size3_t& min, const size3_t& max,
+                                           MetaDataPolicy policy = MetaDataPolicy::Lazy) const;
+
+    /**
+     * Writes a brick file with the given layout. Symmetric tensors are stored packed for
+     * TensorStorage::PackedSymmetric. Throws a FileException if the file cannot be written.
+     */
+    static void write(const std::string& path, const size3_t& dimensions, const mat3& basis,
+                      const vec3& offset, TensorStorage storage, const BrickSource& source,
+                      size_t brickSize = defaultBrickSize);
+    static void write(const std::string& path, const TensorField3D& tensorField,
+                      size_t brickSize = defaultBrickSize);
+
+private:
+    struct Storage;
+
+    std::shared_ptr<const std::vector<matN>> brickTensors(size_t brickIndex) const;
+
+    std::shared_ptr<Storage> storage_;
+    size3_t dimensions_;
+    size_t brickSize_;
+    size3_t numBricks_;
+    util::IndexMapper3D indexMapper_;
+    util::IndexMapper3D brickMapper_;
+};
+
+inline BrickedTensorField3D::matN BrickedTensorField3D::Accessor::at(const size3_t& position) {
+    if (!brick_.tensors || glm::any(glm::lessThan(position, brick_.origin)) ||
+        glm::any(glm::greaterThanEqual(position, brick_.origin + size3_t(brick_.brickSize)))) {
+        brick_ = tensorField_->getBrick(position / size3_t(tensorField_->brickSize_));
+    }
+    return brick_.at(position - brick_.origin);
+}
+
+template <typename T>
+glm::vec<3, T> BrickedTensorField3D::getExtents() const {
+    const auto basis = this->getBasis();
+
+    glm::vec<3, T> extents{};
+
+    for (unsigned int i{0}; i < 3; ++i) {
+        extents[i] = glm::length(basis[i]);
+    }
+
+    return extents;
+}
+
+template <typename T>
+glm::vec<3, T> BrickedTensorField3D::getBounds() const {
+    const auto b = this->getDimensions() - size3_t(1);
+    return glm::vec<3, T>(glm::max(b, size3_t(1)));
+}
+
+template <typename T>
+glm::vec<3, T> BrickedTensorField3D::getSpacing() const {
+    return getExtents<T>() / getBounds<T>();
+}
+
+}  // namespace inviwo
@@ -32,6 +32,7 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
 #include <inviwo/core/datastructures/geometry/basicmesh.h>
+#include <inviwo/tensorvisbase/datastructures/glyphtemplate.h>
 #include <functional>
 
 namespace inviwo {
@@ -53,10 +54,9 @@ public:
     std::shared_ptr<BasicMesh> getGeometry();
 
 private:
-    std::vector<size3_t> faces_;
+    std::shared_ptr<const GlyphTemplate> template_;
     std::shared_ptr<BasicMesh> mesh_;
 
-    void createCube(const vec4& color);
     void calculateNormals();
 };
 
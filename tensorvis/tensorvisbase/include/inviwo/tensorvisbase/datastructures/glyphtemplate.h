@@ -0,0 +1,102 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/geometry/basicmesh.h>
+
+namespace inviwo {
+
+/**
+ * \class GlyphTemplate
+ * \brief Tessellation of an undeformed glyph shape, shared by all glyphs of the same shape and
+ * resolution.
+ *
+ * Only the vertex positions of a glyph depend on its tensor. Glyph generators copy the positions
+ * of the template, deform them and recompute the normals with computeNormals(), while the
+ * topology is created once per shape and resolution, see get(). Sphere templates also hold the
+ * sines and cosines of the spherical coordinates of their vertices for superquadric glyphs.
+ */
+class IVW_MODULE_TENSORVISBASE_API GlyphTemplate {
+public:
+    enum class Shape { Sphere, Cube, Cylinder };
+
+    /**
+     * Returns the cached template of the given shape and resolution and creates it if needed. A
+     * template stays cached only as long as it is referenced, so glyph generators should hold on
+     * to it for all their glyphs rather than calling get() per glyph. The resolution is ignored
+     * for cubes and numPhi is ignored for cylinders. Safe to call concurrently.
+     */
+    static std::shared_ptr<const GlyphTemplate> get(Shape shape, size_t numTheta = 0,
+                                                    size_t numPhi = 0);
+
+    GlyphTemplate(Shape shape, size_t numTheta, size_t numPhi);
+
+    Shape getShape() const { return shape_; }
+    size_t getNumVertices() const { return positions_.size(); }
+    size_t getNumIndices() const { return indices_.size(); }
+
+    const std::vector<vec3>& getPositions() const { return positions_; }
+    const std::vector<vec3>& getNormals() const { return normals_; }
+    const std::vector<vec3>& getTexCoords() const { return texCoords_; }
+    const std::vector<std::uint32_t>& getIndices() const { return indices_; }
+
+    /**
+     * (sin(phi), cos(phi), sin(theta), cos(theta)) of the spherical coordinates of every vertex.
+     * Only available for spheres, empty otherwise.
+     */
+    const std::vector<vec4>& getSphericalTable() const { return sphericalTable_; }
+
+    /**
+     * Computes the vertex normals of the deformed positions of a glyph from the faces of the
+     * template. Both arrays have getNumVertices() elements.
+     */
+    void computeNormals(const vec3* positions, vec3* normals) const;
+
+    /**
+     * Creates a mesh of the undeformed template with the given color.
+     */
+    std::shared_ptr<BasicMesh> createMesh(const vec4& color = vec4(1.0f)) const;
+
+private:
+    void createSphere(size_t numTheta, size_t numPhi);
+    void createCube();
+    void createCylinder(size_t numTheta);
+
+    Shape shape_;
+    std::vector<vec3> positions_;
+    std::vector<vec3> normals_;
+    std::vector<vec3> texCoords_;
+    std::vector<std::uint32_t> indices_;
+    std::vector<vec4> sphericalTable_;
+};
+
+}  // namespace inviwo
@@ -0,0 +1,248 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/spatialdata.h>
+#include <inviwo/core/util/indexmapper.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \class SparseTensorField3D
+ * \brief 3D tensor field that only stores its defined tensors.
+ *
+ * Fields embedded in a bounding grid, e.g. finite element meshes, leave most voxels undefined.
+ * The sparse field keeps the tensors of the active voxels in a compact array ordered by linear
+ * index, and a run-length encoded mask that maps voxels to entries of the compact array. Inactive
+ * voxels read as zero tensors.
+ *
+ * The meta data only holds rows for the active voxels, in the order of the compact array, and
+ * the eigen systems are only computed for those tensors.
+ */
+class IVW_MODULE_TENSORVISBASE_API SparseTensorField3D : public StructuredGridEntity<3> {
+public:
+    using matN = TensorField3D::matN;
+    using packedN = TensorField3D::packedN;
+    using value_type = TensorField3D::value_type;
+
+    /**
+     * The active voxels [begin, begin + length), stored at [entry, entry + length) in the compact
+     * array.
+     */
+    struct Run {
+        size_t begin;
+        size_t length;
+        size_t entry;
+    };
+
+    /**
+     * Creates a sparse copy of the active voxels of tensorField. If the field has a mask, voxels
+     * with a non-zero mask value are active, otherwise voxels with a non-zero tensor. Packed
+     * storage stays packed. With MetaDataPolicy::Lazy the eigen systems are computed on the first
+     * call to metaData().
+     */
+    explicit SparseTensorField3D(const TensorField3D& tensorField,
+                                 MetaDataPolicy policy = MetaDataPolicy::Eager);
+
+    /**
+     * Creates a sparse field from the tensors of the active voxels alone, e.g. when reading them
+     * from a file, without creating a dense field first. tensors holds one tensor per active voxel
+     * in the order of the runs. Throws an Exception if the runs are not ordered, overlap, exceed
+     * the grid, have non-consecutive entries or do not match the number of tensors.
+     */
+    SparseTensorField3D(const size3_t& dimensions, std::vector<Run> runs,
+                        std::shared_ptr<const std::vector<matN>> tensors,
+                        MetaDataPolicy policy = MetaDataPolicy::Eager);
+    SparseTensorField3D(const size3_t& dimensions, std::vector<Run> runs,
+                        std::shared_ptr<const std::vector<packedN>> tensors,
+                        MetaDataPolicy policy = MetaDataPolicy::Eager);
+
+    /**
+     * NOTE: Creates a shallow copy, the copy shares the tensors, runs and meta data.
+     */
+    SparseTensorField3D(const SparseTensorField3D& rhs) = default;
+    SparseTensorField3D& operator=(const SparseTensorField3D&) = delete;
+    virtual ~SparseTensorField3D() = default;
+
+    virtual SparseTensorField3D* clone() const override;
+
+    std::string getDataInfo() const;
+
+    virtual size3_t getDimensions() const final { return dimensions_; }
+    /**
+     * Number of voxels of the grid, see getNumberOfActive() for the number of stored tensors.
+     */
+    size_t getSize() const { return glm::compMul(dimensions_); }
+    size_t getNumberOfActive() const { return numActive_; }
+    TensorStorage storage() const {
+        return packedTensors_ ? TensorStorage::PackedSymmetric : TensorStorage::Full;
+    }
+
+    template <typename T = float>
+    glm::vec<3, T> getExtents() const;
+    template <typename T = size_t>
+    glm::vec<3, T> getBounds() const;
+    template <typename T = float>
+    glm::vec<3, T> getSpacing() const;
+
+    const std::vector<Run>& runs() const { return *runs_; }
+
+    /**
+     * Entry of the voxel with the given linear index in the compact array, std::nullopt if the
+     * voxel is not active. O(log(number of runs)).
+     */
+    std::optional<size_t> entry(size_t index) const;
+    bool isActive(size_t index) const { return entry(index).has_value(); }
+
+    matN at(const size3_t& position) const { return at(indexMapper_(position)); }
+    matN at(size_t index) const;
+
+    /**
+     * Tensor at the given entry of the compact array.
+     */
+    matN entryAt(size_t entry) const {
+        return packedTensors_ ? TensorField3D::unpack((*packedTensors_)[entry])
+                              : (*tensors_)[entry];
+    }
+
+    /**
+     * Calls func(index, entry) for every active voxel, with the linear index of the voxel and its
+     * entry in the compact array. Runs are processed in parallel, func must be thread safe.
+     */
+    template <typename F>
+    void forEachActive(F func) const;
+
+    /**
+     * Eigen values and eigen vectors of the active tensors, and the linear index of their voxels
+     * in the column "Voxel".
+     */
+    std::shared_ptr<const DataFrame> metaData() const;
+
+    /**
+     * Creates a dense field with zero tensors at the inactive voxels and a mask marking the active
+     * ones.
+     */
+    std::shared_ptr<TensorField3D> toDense(MetaDataPolicy policy = MetaDataPolicy::Lazy) const;
+
+    /**
+     * Run-length encoding of the non-zero entries of a mask, with consecutive entries.
+     */
+    static std::vector<Run> findRuns(const std::vector<glm::uint8>& mask);
+
+    /**
+     * Run-length encoding of the voxels [0, size) for which isActive(index) returns true, with
+     * consecutive entries. The voxels are visited in order.
+     */
+    template <typename IsActive>
+    static std::vector<Run> findRunsIf(size_t size, IsActive isActive);
+
+private:
+    struct LazyMetaData {
+        std::once_flag once;
+        std::shared_ptr<const DataFrame> dataFrame;
+    };
+
+    std::shared_ptr<const DataFrame> computeMetaData() const;
+    void setRuns(std::vector<Run> runs, size_t numTensors);
+
+    size3_t dimensions_;
+    util::IndexMapper3D indexMapper_;
+    size_t numActive_;
+    std::shared_ptr<const std::vector<Run>> runs_;
+    // Exactly one of these is set, depending on the storage of the source field
+    std::shared_ptr<const std::vector<matN>> tensors_;
+    std::shared_ptr<const std::vector<packedN>> packedTensors_;
+    std::shared_ptr<LazyMetaData> metaData_;
+};
+
+template <typename T>
+glm::vec<3, T> SparseTensorField3D::getExtents() const {
+    const auto basis = this->getBasis();
+
+    glm::vec<3, T> extents{};
+
+    for (unsigned int i{0}; i < 3; ++i) {
+        extents[i] = glm::length(basis[i]);
+    }
+
+    return extents;
+}
+
+template <typename T>
+glm::vec<3, T> SparseTensorField3D::getBounds() const {
+    const auto b = this->getDimensions() - size3_t(1);
+    return glm::vec<3, T>(glm::max(b, size3_t(1)));
+}
+
+template <typename T>
+glm::vec<3, T> SparseTensorField3D::getSpacing() const {
+    return getExtents<T>() / getBounds<T>();
+}
+
+template <typename IsActive>
+std::vector<SparseTensorField3D::Run> SparseTensorField3D::findRunsIf(size_t size,
+                                                                     IsActive isActive) {
+    std::vector<Run> runs;
+    size_t entry = 0;
+    for (size_t i = 0; i < size;) {
+        if (!isActive(i)) {
+            ++i;
+            continue;
+        }
+        const size_t begin = i;
+        while (i < size && isActive(i)) ++i;
+        runs.push_back({begin, i - begin, entry});
+        entry += i - begin;
+    }
+    return runs;
+}
+
+template <typename F>
+void SparseTensorField3D::forEachActive(F func) const {
+    const auto& runs = *runs_;
+
+#pragma omp parallel for schedule(dynamic)
+    for (long long r = 0; r < static_cast<long long>(runs.size()); ++r) {
+        const auto& run = runs[r];
+        for (size_t i = 0; i < run.length; ++i) {
+            func(run.begin + i, run.entry + i);
+        }
+    }
+}
+
+}  // namespace inviwo
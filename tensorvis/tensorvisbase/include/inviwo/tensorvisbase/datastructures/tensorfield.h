@@ -38,6 +38,7 @@
 #include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
 #include <inviwo/tensorvisbase/util/tensorutil.h>
 #include <inviwo/tensorvisbase/util/misc.h>
+#include <inviwo/tensorvisbase/util/statistics.h>
 #include <Eigen/Dense>
 #include <inviwo/core/datastructures/spatialdata.h>
 #include <inviwo/tensorvisbase/datastructures/attributes.h>
@@ -46,9 +47,33 @@
 #include <type_traits>
 #include <optional>
 #include <memory>
+#include <array>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 #include <inviwo/core/util/constexprhash.h>
 
 namespace inviwo {
+/**
+ * Storage layout of the tensors of a TensorField. PackedSymmetric only keeps the N(N+1)/2 unique
+ * components of symmetric tensors and reconstructs the full tensor on access.
+ */
+enum class TensorStorage { Full, PackedSymmetric };
+
+/**
+ * Eager fields compute the default meta data (eigen values and eigen vectors) and the eigen value
+ * data maps on construction. Lazy fields compute any meta data on first access through
+ * getMetaData() or getMetaDataContainer() instead, see TensorField::getMetaData().
+ */
+enum class MetaDataPolicy { Eager, Lazy };
+
+/**
+ * Averaging used for the levels of the level of detail pyramid of a tensor field, see
+ * TensorField3D::buildPyramid(). LogEuclidean averages symmetric positive definite tensors in the
+ * log domain, see tensorutil::logEuclideanMean(), and falls back to Linear for other tensors.
+ */
+enum class PyramidFilter { Linear, LogEuclidean };
+
 /**
  * \class TensorField
  * \brief Base data structure for tensorfields.
@@ -61,15 +86,36 @@ public:
     using matN = glm::mat<N, N, precision, glm::defaultp>;
     using matNb = glm::mat<N + 1, N + 1, precision, glm::defaultp>;
     using vecN = glm::vec<N, precision, glm::defaultp>;
+    /**
+     * Unique components of a symmetric tensor, i.e. the upper triangle stored row by row
+     * (xx, xy, xz, yy, yz, zz for N = 3).
+     */
+    using packedN = std::array<precision, N*(N + 1) / 2>;
 
     static constexpr unsigned int dimensionality = N;
 
     TensorField() = delete;
 
     TensorField(const sizeN_t& dimensions, const std::vector<matN>& tensors,
-                std::shared_ptr<DataFrame> metaData = nullptr);
+                std::shared_ptr<DataFrame> metaData = nullptr,
+                MetaDataPolicy policy = MetaDataPolicy::Eager);
+    /**
+     * The following constructors take ownership of the tensors, no copy is made. Tensors passed as
+     * shared pointer are shared with the caller until either side modifies them, see
+     * editableTensors().
+     */
+    TensorField(const sizeN_t& dimensions, std::vector<matN>&& tensors,
+                std::shared_ptr<DataFrame> metaData = nullptr,
+                MetaDataPolicy policy = MetaDataPolicy::Eager);
     TensorField(const sizeN_t& dimensions, std::shared_ptr<std::vector<matN>> tensors,
-                std::shared_ptr<DataFrame> metaData = nullptr);
+                std::shared_ptr<DataFrame> metaData = nullptr,
+                MetaDataPolicy policy = MetaDataPolicy::Eager);
+    /**
+     * Creates a tensor field with TensorStorage::PackedSymmetric.
+     */
+    TensorField(const sizeN_t& dimensions, std::shared_ptr<std::vector<packedN>> tensors,
+                std::shared_ptr<DataFrame> metaData = nullptr,
+                MetaDataPolicy policy = MetaDataPolicy::Eager);
 
     /**
      * NOTE: This method creates a shallow copy, i.e. the tensors and the meta data are
@@ -98,13 +144,17 @@ public:
 
     std::string getDataInfo() const;
 
-    template <bool useMask = false, typename ReturnType = std::conditional_t<
-                                        useMask, std::pair<bool, const matN&>, matN&>>
-    const ReturnType at(sizeN_t position) const;
+    /**
+     * Returns the tensor at the given position. For TensorStorage::PackedSymmetric only this
+     * tensor is unpacked.
+     */
+    template <bool useMask = false,
+              typename ReturnType = std::conditional_t<useMask, std::pair<bool, matN>, matN>>
+    ReturnType at(sizeN_t position) const;
 
-    template <bool useMask = false, typename ReturnType = std::conditional_t<
-                                        useMask, std::pair<bool, const matN&>, matN&>>
-    const ReturnType at(size_t index) const;
+    template <bool useMask = false,
+              typename ReturnType = std::conditional_t<useMask, std::pair<bool, matN>, matN>>
+    ReturnType at(size_t index) const;
 
     sizeN_t getDimensions() const final { return dimensions_; }
 
@@ -128,14 +178,77 @@ public:
 
     matNb getBasisAndOffset() const;
 
+    /**
+     * Returns the full tensors. NOTE: For TensorStorage::PackedSymmetric, every call unpacks all
+     * tensors into a new vector that is not kept by the field. Use packedTensors() or at() instead
+     * where possible.
+     */
     std::shared_ptr<const std::vector<matN>> tensors() const;
 
-    void setMask(const std::vector<glm::uint8>& mask) { binaryMask_ = mask; }
-    const std::vector<glm::uint8>& getMask() const { return binaryMask_; }
+    /**
+     * Returns the packed tensors for TensorStorage::PackedSymmetric, nullptr otherwise.
+     */
+    std::shared_ptr<const std::vector<packedN>> packedTensors() const { return packedTensors_; }
+
+    TensorStorage storage() const {
+        return packedTensors_ ? TensorStorage::PackedSymmetric : TensorStorage::Full;
+    }
+
+    static packedN pack(const matN& tensor);
+    static matN unpack(const packedN& tensor);
+    static std::shared_ptr<std::vector<packedN>> pack(const std::vector<matN>& tensors);
+    static std::shared_ptr<std::vector<matN>> unpack(const std::vector<packedN>& tensors);
+
+    void setMask(const std::vector<glm::uint8>& mask) {
+        binaryMask_ = std::make_shared<const std::vector<glm::uint8>>(mask);
+    }
+    /**
+     * Shares the mask with other fields, e.g. the timesteps of a sequence with the same topology.
+     */
+    void setMask(std::shared_ptr<const std::vector<glm::uint8>> mask) {
+        binaryMask_ = std::move(mask);
+    }
+    const std::vector<glm::uint8>& getMask() const {
+        static const std::vector<glm::uint8> empty;
+        return binaryMask_ ? *binaryMask_ : empty;
+    }
+    std::shared_ptr<const std::vector<glm::uint8>> sharedMask() const { return binaryMask_; }
 
     void setTensors(std::shared_ptr<std::vector<matN>> tensors);
+    void setPackedTensors(std::shared_ptr<std::vector<packedN>> tensors);
     void setMetaData(std::shared_ptr<DataFrame> metaData);
 
+    MetaDataPolicy metaDataPolicy() const { return metaDataPolicy_; }
+    /**
+     * Switching to MetaDataPolicy::Eager computes the default meta data and the data maps, reusing
+     * columns that have already been computed on demand.
+     */
+    void setMetaDataPolicy(MetaDataPolicy policy);
+
+    /**
+     * Copy-on-write access to the tensors. Tensor storage is shared between shallow copies, the
+     * first call to this method on a field whose storage is shared copies it. Packed symmetric
+     * storage is converted to full storage. Meta data columns computed from the tensors, i.e. the
+     * attributes of attributes.h, are dropped since they would be stale after editing. Fields
+     * with MetaDataPolicy::Lazy recompute them on demand, for MetaDataPolicy::Eager call
+     * updateMetaData() once done editing. NOTE: Not thread safe with respect to concurrent copies
+     * of the same field.
+     */
+    std::vector<matN>& editableTensors();
+
+    /**
+     * Recomputes the default meta data and the data maps of a field with MetaDataPolicy::Eager
+     * after editing its tensors, see editableTensors(). Does nothing for MetaDataPolicy::Lazy.
+     */
+    void updateMetaData();
+
+    /**
+     * Copy-on-write access to the meta data. If the DataFrame is shared with other fields, it is
+     * replaced by a new DataFrame referring to the same columns, so that adding or dropping
+     * columns does not affect the other fields.
+     */
+    std::shared_ptr<DataFrame> editableMetaData();
+
     /*
     If the tensor field has a mask, this method return the number of 1s in it -
     telling you how many of the positions in the tensor field are defined.
@@ -145,6 +258,7 @@ public:
     /**
      * Data map for the eigen values of the tensor field.
      * 0 := major, 1 := middle, 2 := minor
+     * NOTE: Not computed for fields with MetaDataPolicy::Lazy, see setMetaDataPolicy().
      */
     std::array<DataMapper, N> dataMapEigenValues_;
     /**
@@ -153,14 +267,26 @@ public:
      */
     std::array<DataMapper, N> dataMapEigenVectors_;
 
-    bool hasMask() const { return binaryMask_.size() == size_; }
+    bool hasMask() const { return binaryMask_ && binaryMask_->size() == size_; }
 
     const util::IndexMapper<N>& indexMapper() const { return indexMapper_; }
 
     /**
-     * Perform lookup as to whether the specified meta data is available for the tensor field.
+     * Number of levels of the level of detail pyramid including the field itself as level 0, i.e.
+     * 1 if no pyramid has been built.
+     */
+    size_t getNumberOfLevels() const { return pyramid_ ? pyramid_->levels.size() + 1 : 1; }
+    /**
+     * Returns the coarsest level with at least the given dimensions along every axis, 0 if no
+     * pyramid has been built.
+     */
+    size_t getLevelFor(const sizeN_t& dimensions) const;
+
+    /**
+     * Perform lookup as to whether the specified meta data is available for the tensor field,
+     * either in the meta data DataFrame or computed on demand.
      * HINT: If it is not, you might want to add a meta data processor to your network to calculate
-     * the desired meta data.
+     * the desired meta data or use MetaDataPolicy::Lazy.
      */
     template <typename T>
     bool hasMetaData() const;
@@ -169,7 +295,9 @@ public:
 
     /**
      * Tensor field meta data is stored in a DataFrame. If available, this method returns the column
-     * for the meta data specified by T (see attributes.h). Nullopt otherwise.
+     * for the meta data specified by T (see attributes.h). For MetaDataPolicy::Lazy, missing meta
+     * data is computed on first access and cached, requesting one of the eigen system attributes
+     * computes all of them in the same pass. Nullopt otherwise.
      */
     template <typename T>
     std::optional<std::shared_ptr<const Column>> getMetaData() const;
@@ -182,9 +310,30 @@ public:
     template <typename T>
     const std::vector<typename T::value_type>& getMetaDataContainer() const;
 
+    /**
+     * Computes the attributes whose identifier hashes are contained in ids from the tensors, see
+     * attributes::calculate(). The columns are neither added to the meta data nor cached. Packed
+     * tensors are unpacked one at a time.
+     */
+    std::vector<std::shared_ptr<Column>> calculateAttributes(const std::vector<size_t>& ids) const;
+
     std::shared_ptr<const DataFrame> metaData() const { return metaData_; }
+    /**
+     * NOTE: The returned DataFrame might be shared with other fields, use editableMetaData() to
+     * add or remove columns.
+     */
     std::shared_ptr<DataFrame> metaData() { return metaData_; }
 
+    /**
+     * Statistics of the columns of metaData() followed by the columns computed on demand, see
+     * tensorutil::computeStatistics(). For MetaDataPolicy::Lazy, the eigen system is computed
+     * first, other columns computed on demand are only included once they were requested.
+     * Computed on first access and cached, the cache is shared between shallow copies and
+     * discarded when the tensors or the meta data columns change.
+     */
+    std::shared_ptr<const std::vector<tensorutil::ColumnStatistics>> statistics(
+        size_t bins = 256) const;
+
     value_type getMajorEigenValue(const size_t index) const {
         return value_type(this->getMetaDataContainer<attributes::MajorEigenValue>()[index]);
     }
@@ -210,25 +359,92 @@ protected:
     sizeN_t dimensions_;
     util::IndexMapper<N> indexMapper_;
     std::shared_ptr<std::vector<matN>> tensors_;
+    std::shared_ptr<std::vector<packedN>> packedTensors_;
     size_t size_;
     std::shared_ptr<DataFrame> metaData_;
 
-    std::vector<glm::uint8> binaryMask_;
+    std::shared_ptr<const std::vector<glm::uint8>> binaryMask_;
+
+    /**
+     * Columns computed on demand, shared between shallow copies as long as they refer to the same
+     * tensors.
+     */
+    struct LazyMetaData {
+        std::shared_mutex mutex;
+        std::unordered_map<std::string, std::shared_ptr<const Column>> columns;
+    };
+    MetaDataPolicy metaDataPolicy_;
+    std::shared_ptr<LazyMetaData> lazyMetaData_;
+
+    template <typename T>
+    std::optional<std::shared_ptr<const Column>> lazyMetaData() const;
+
+    /**
+     * Representations derived from the tensors, e.g. volumes for rendering, created on first
+     * access by the derived field. Shared between shallow copies as long as they refer to the same
+     * tensors.
+     */
+    struct Representations {
+        std::mutex mutex;
+        std::unordered_map<std::string, std::shared_ptr<const void>> items;
+    };
+    std::shared_ptr<Representations> representations_;
+
+    /**
+     * Coarser levels of the field, shared between shallow copies as long as they refer to the same
+     * tensors. The levels are of the type of the derived field.
+     */
+    struct Pyramid {
+        PyramidFilter filter;
+        std::vector<std::shared_ptr<const TensorField>> levels;
+    };
+    std::shared_ptr<const Pyramid> pyramid_;
+
+    /**
+     * Builds the pyramid with levels of type Field, see TensorField3D::buildPyramid().
+     */
+    template <typename Field>
+    void createPyramid(PyramidFilter filter);
 
     virtual void initializeDefaultMetaData() = 0;
     virtual void computeDataMaps() = 0;
+    // Drops the columns of the meta data that are computed from the tensors
+    void dropDerivedMetaData();
 };
 
 template <unsigned int N, typename precision>
 inline TensorField<N, precision>::TensorField(const sizeN_t& dimensions,
                                               const std::vector<matN>& tensors,
-                                              std::shared_ptr<DataFrame> metaData)
+                                              std::shared_ptr<DataFrame> metaData,
+                                              MetaDataPolicy policy)
     : StructuredGridEntity<N>()
     , dimensions_(dimensions)
     , indexMapper_(util::IndexMapper<N>(dimensions))
     , tensors_(std::make_shared<std::vector<matN>>(tensors))
     , size_(glm::compMul(dimensions))
-    , metaData_(metaData) {
+    , metaData_(metaData)
+    , metaDataPolicy_(policy)
+    , lazyMetaData_(std::make_shared<LazyMetaData>())
+    , representations_(std::make_shared<Representations>()) {
+    if (!metaData_) {
+        metaData_ = std::make_shared<DataFrame>();
+    }
+}
+
+template <unsigned int N, typename precision>
+inline TensorField<N, precision>::TensorField(const sizeN_t& dimensions,
+                                              std::vector<matN>&& tensors,
+                                              std::shared_ptr<DataFrame> metaData,
+                                              MetaDataPolicy policy)
+    : StructuredGridEntity<N>()
+    , dimensions_(dimensions)
+    , indexMapper_(util::IndexMapper<N>(dimensions))
+    , tensors_(std::make_shared<std::vector<matN>>(std::move(tensors)))
+    , size_(glm::compMul(dimensions))
+    , metaData_(metaData)
+    , metaDataPolicy_(policy)
+    , lazyMetaData_(std::make_shared<LazyMetaData>())
+    , representations_(std::make_shared<Representations>()) {
     if (!metaData_) {
         metaData_ = std::make_shared<DataFrame>();
     }
@@ -237,13 +453,36 @@ inline TensorField<N, precision>::TensorField(const sizeN_t& dimensions,
 template <unsigned int N, typename precision>
 inline TensorField<N, precision>::TensorField(const sizeN_t& dimensions,
                                               std::shared_ptr<std::vector<matN>> tensors,
-                                              std::shared_ptr<DataFrame> metaData)
+                                              std::shared_ptr<DataFrame> metaData,
+                                              MetaDataPolicy policy)
+    : StructuredGridEntity<N>()
+    , dimensions_(dimensions)
+    , indexMapper_(util::IndexMapper<N>(dimensions))
+    , tensors_(std::move(tensors))
+    , size_(glm::compMul(dimensions))
+    , metaData_(metaData)
+    , metaDataPolicy_(policy)
+    , lazyMetaData_(std::make_shared<LazyMetaData>())
+    , representations_(std::make_shared<Representations>()) {
+    if (!metaData_) {
+        metaData_ = std::make_shared<DataFrame>();
+    }
+}
+
+template <unsigned int N, typename precision>
+inline TensorField<N, precision>::TensorField(const sizeN_t& dimensions,
+                                              std::shared_ptr<std::vector<packedN>> tensors,
+                                              std::shared_ptr<DataFrame> metaData,
+                                              MetaDataPolicy policy)
     : StructuredGridEntity<N>()
     , dimensions_(dimensions)
     , indexMapper_(util::IndexMapper<N>(dimensions))
-    , tensors_(std::make_shared<std::vector<matN>>(*tensors))
+    , packedTensors_(tensors)
     , size_(glm::compMul(dimensions))
-    , metaData_(metaData) {
+    , metaData_(metaData)
+    , metaDataPolicy_(policy)
+    , lazyMetaData_(std::make_shared<LazyMetaData>())
+    , representations_(std::make_shared<Representations>()) {
     if (!metaData_) {
         metaData_ = std::make_shared<DataFrame>();
     }
@@ -257,9 +496,14 @@ inline TensorField<N, precision>::TensorField(const TensorField<N, precision>& t
     , dimensions_(tf.dimensions_)
     , indexMapper_(util::IndexMapper<N>(dimensions_))
     , tensors_(tf.tensors_)
+    , packedTensors_(tf.packedTensors_)
     , size_(tf.size_)
     , metaData_(tf.metaData_)
-    , binaryMask_(tf.binaryMask_) {
+    , binaryMask_(tf.binaryMask_)
+    , metaDataPolicy_(tf.metaDataPolicy_)
+    , lazyMetaData_(tf.lazyMetaData_)
+    , representations_(tf.representations_)
+    , pyramid_(tf.pyramid_) {
     this->setOffset(tf.getOffset());
     this->setBasis(tf.getBasis());
 }
@@ -270,9 +514,17 @@ inline std::string TensorField<N, precision>::getDataInfo() const {
     ss << "<table border='0' cellspacing='0' cellpadding='0' "
           "style='border-color:white;white-space:pre;'>/n"
        << tensorutil::getHTMLTableRowString("Type", std::to_string(N) + "D tensor field")
-       << tensorutil::getHTMLTableRowString("Number of tensors", tensors_->size())
-       << tensorutil::getHTMLTableRowString("Dimensions", dimensions_)
-       << tensorutil::getHTMLTableRowString("Max major field eigenvalue",
+       << tensorutil::getHTMLTableRowString("Number of tensors", size_)
+       << tensorutil::getHTMLTableRowString(
+              "Storage", storage() == TensorStorage::Full ? "Full" : "Packed symmetric")
+       << tensorutil::getHTMLTableRowString("Dimensions", dimensions_);
+    if (metaDataPolicy_ == MetaDataPolicy::Lazy &&
+        !hasMetaData<attributes::MajorEigenValue>()) {
+        ss << tensorutil::getHTMLTableRowString("Meta data", "Computed on demand")
+           << tensorutil::getHTMLTableRowString("Extends", getExtents()) << "</table>";
+        return ss.str();
+    }
+    ss << tensorutil::getHTMLTableRowString("Max major field eigenvalue",
                                             dataMapEigenValues_[0].valueRange.y)
        << tensorutil::getHTMLTableRowString("Min major field eigenvalue",
                                             dataMapEigenValues_[0].valueRange.x);
@@ -283,9 +535,9 @@ inline std::string TensorField<N, precision>::getDataInfo() const {
                                                 dataMapEigenValues_[1].valueRange.x);
     }
     ss << tensorutil::getHTMLTableRowString("Max minor field eigenvalue",
-                                            dataMapEigenValues_[2].valueRange.y)
+                                            dataMapEigenValues_[N - 1].valueRange.y)
        << tensorutil::getHTMLTableRowString("Min minor field eigenvalue",
-                                            dataMapEigenValues_[2].valueRange.x)
+                                            dataMapEigenValues_[N - 1].valueRange.x)
        << tensorutil::getHTMLTableRowString("Extends", getExtents())
 
        << "</table>";
@@ -294,18 +546,19 @@ inline std::string TensorField<N, precision>::getDataInfo() const {
 
 template <unsigned int N, typename precision>
 template <bool useMask, typename ReturnType>
-inline const ReturnType TensorField<N, precision>::at(sizeN_t position) const {
+inline ReturnType TensorField<N, precision>::at(sizeN_t position) const {
     return this->at<useMask>(indexMapper_(position));
 }
 
 template <unsigned int N, typename precision>
 template <bool useMask, typename ReturnType>
-inline const ReturnType TensorField<N, precision>::at(size_t index) const {
+inline ReturnType TensorField<N, precision>::at(size_t index) const {
+    const auto tensor = packedTensors_ ? unpack((*packedTensors_)[index]) : (*tensors_)[index];
+
     if constexpr (useMask) {
-        return std::make_pair<const bool, const matN&>(binaryMask_[index],
-                                                       tensors_->operator[](index));
+        return ReturnType((*binaryMask_)[index] != 0, tensor);
     } else {
-        return tensors_->operator[](index);
+        return tensor;
     }
 }
 
@@ -367,13 +620,85 @@ inline typename TensorField<N, precision>::matNb TensorField<N, precision>::getB
 template <unsigned int N, typename precision>
 inline std::shared_ptr<const std::vector<typename TensorField<N, precision>::matN>>
 TensorField<N, precision>::tensors() const {
+    if (packedTensors_) return unpack(*packedTensors_);
     return tensors_;
 }
 
+template <unsigned int N, typename precision>
+inline std::vector<std::shared_ptr<Column>> TensorField<N, precision>::calculateAttributes(
+    const std::vector<size_t>& ids) const {
+    // Only the attributes listed for the dimensionality of the field can be computed
+    using Types = std::conditional_t<N == 2, attributes::types2D, attributes::types3D>;
+    if (packedTensors_) {
+        const auto& packed = *packedTensors_;
+        return attributes::calculate<Types>(
+            packed.size(), [&packed](size_t i) { return unpack(packed[i]); }, ids);
+    }
+    return attributes::calculate<Types>(*tensors_, ids);
+}
+
+template <unsigned int N, typename precision>
+inline typename TensorField<N, precision>::packedN TensorField<N, precision>::pack(
+    const matN& tensor) {
+    packedN packed;
+    size_t i = 0;
+    for (unsigned int row{0}; row < N; ++row) {
+        for (unsigned int col{row}; col < N; ++col) {
+            packed[i++] = tensor[col][row];
+        }
+    }
+    return packed;
+}
+
+template <unsigned int N, typename precision>
+inline typename TensorField<N, precision>::matN TensorField<N, precision>::unpack(
+    const packedN& tensor) {
+    matN unpacked;
+    size_t i = 0;
+    for (unsigned int row{0}; row < N; ++row) {
+        for (unsigned int col{row}; col < N; ++col) {
+            unpacked[col][row] = unpacked[row][col] = tensor[i++];
+        }
+    }
+    return unpacked;
+}
+
+template <unsigned int N, typename precision>
+inline std::shared_ptr<std::vector<typename TensorField<N, precision>::packedN>>
+TensorField<N, precision>::pack(const std::vector<matN>& tensors) {
+    auto packed = std::make_shared<std::vector<packedN>>(tensors.size());
+    std::transform(tensors.begin(), tensors.end(), packed->begin(),
+                   [](const matN& tensor) { return pack(tensor); });
+    return packed;
+}
+
+template <unsigned int N, typename precision>
+inline std::shared_ptr<std::vector<typename TensorField<N, precision>::matN>>
+TensorField<N, precision>::unpack(const std::vector<packedN>& tensors) {
+    auto unpacked = std::make_shared<std::vector<matN>>(tensors.size());
+    std::transform(tensors.begin(), tensors.end(), unpacked->begin(),
+                   [](const packedN& tensor) { return unpack(tensor); });
+    return unpacked;
+}
+
 template <unsigned int N, typename precision>
 inline void TensorField<N, precision>::setTensors(
     std::shared_ptr<std::vector<typename TensorField<N, precision>::matN>> tensors) {
     tensors_ = tensors;
+    packedTensors_.reset();
+    lazyMetaData_ = std::make_shared<LazyMetaData>();
+    representations_ = std::make_shared<Representations>();
+    pyramid_.reset();
+}
+
+template <unsigned int N, typename precision>
+inline void TensorField<N, precision>::setPackedTensors(
+    std::shared_ptr<std::vector<typename TensorField<N, precision>::packedN>> tensors) {
+    packedTensors_ = tensors;
+    tensors_.reset();
+    lazyMetaData_ = std::make_shared<LazyMetaData>();
+    representations_ = std::make_shared<Representations>();
+    pyramid_.reset();
 }
 
 template <unsigned int N, typename precision>
@@ -381,9 +706,187 @@ inline void TensorField<N, precision>::setMetaData(std::shared_ptr<DataFrame> me
     metaData_ = metaData;
 }
 
+template <unsigned int N, typename precision>
+inline std::vector<typename TensorField<N, precision>::matN>&
+TensorField<N, precision>::editableTensors() {
+    if (packedTensors_) {
+        tensors_ = unpack(*packedTensors_);
+        packedTensors_.reset();
+    } else if (tensors_.use_count() > 1) {
+        tensors_ = std::make_shared<std::vector<matN>>(*tensors_);
+    }
+    lazyMetaData_ = std::make_shared<LazyMetaData>();
+    representations_ = std::make_shared<Representations>();
+    pyramid_.reset();
+    dropDerivedMetaData();
+    return *tensors_;
+}
+
+template <unsigned int N, typename precision>
+inline void TensorField<N, precision>::updateMetaData() {
+    if (metaDataPolicy_ == MetaDataPolicy::Eager) {
+        initializeDefaultMetaData();
+        computeDataMaps();
+    }
+}
+
+template <unsigned int N, typename precision>
+size_t TensorField<N, precision>::getLevelFor(const sizeN_t& dimensions) const {
+    if (!pyramid_) return 0;
+
+    for (size_t level = pyramid_->levels.size(); level > 0; --level) {
+        const auto levelDimensions = pyramid_->levels[level - 1]->getDimensions();
+        if (glm::all(glm::greaterThanEqual(levelDimensions, dimensions))) return level;
+    }
+    return 0;
+}
+
+template <unsigned int N, typename precision>
+template <typename Field>
+void TensorField<N, precision>::createPyramid(PyramidFilter filter) {
+    constexpr size_t numChildren = size_t{1} << N;
+
+    auto pyramid = std::make_shared<Pyramid>();
+    pyramid->filter = filter;
+
+    const TensorField* source = this;
+    while (glm::compMax(source->getDimensions()) > 1) {
+        const auto sourceDimensions = source->getDimensions();
+        const auto dimensions = (sourceDimensions + sizeN_t(1)) / sizeN_t(2);
+        const auto& sourceMapper = source->indexMapper();
+        const util::IndexMapper<N> indexMapper(dimensions);
+        const bool hasMask = source->hasMask();
+        const auto& sourceMask = source->getMask();
+
+        std::vector<matN> tensors(glm::compMul(dimensions));
+        std::vector<glm::uint8> mask(hasMask ? tensors.size() : 0);
+
+#pragma omp parallel for
+        for (long long i = 0; i < static_cast<long long>(tensors.size()); ++i) {
+            const auto position = indexMapper(static_cast<size_t>(i));
+
+            // The up to 2^N tensors of the source covered by this one, undefined ones are skipped
+            std::array<matN, numChildren> children;
+            size_t count = 0;
+            for (size_t child = 0; child < numChildren; ++child) {
+                auto childPosition = position * sizeN_t(2);
+                for (unsigned int d = 0; d < N; ++d) childPosition[d] += (child >> d) & 1;
+                if (glm::any(glm::greaterThanEqual(childPosition, sourceDimensions))) continue;
+
+                const auto index = sourceMapper(childPosition);
+                if (hasMask && sourceMask[index] == 0) continue;
+                children[count++] = source->at(index);
+            }
+
+            if (hasMask) mask[i] = count != 0 ? 1 : 0;
+            if (count == 0) continue;
+
+            if (filter == PyramidFilter::LogEuclidean) {
+                if (auto mean = tensorutil::logEuclideanMean(children.data(), count)) {
+                    tensors[i] = *mean;
+                    continue;
+                }
+            }
+            auto sum = matN(0);
+            for (size_t child = 0; child < count; ++child) sum += children[child];
+            tensors[i] = sum / static_cast<precision>(count);
+        }
+
+        // Levels compute their meta data on demand, only the levels in use need it
+        auto level = std::make_shared<Field>(dimensions, std::move(tensors), nullptr,
+                                             MetaDataPolicy::Lazy);
+        level->setBasis(this->getBasis());
+        level->setOffset(this->getOffset());
+        level->setMask(mask);
+
+        source = level.get();
+        pyramid->levels.push_back(std::move(level));
+    }
+
+    pyramid_ = pyramid;
+}
+
+template <unsigned int N, typename precision>
+inline void TensorField<N, precision>::setMetaDataPolicy(MetaDataPolicy policy) {
+    metaDataPolicy_ = policy;
+    if (policy == MetaDataPolicy::Eager) {
+        initializeDefaultMetaData();
+        computeDataMaps();
+    }
+}
+
+template <unsigned int N, typename precision>
+inline std::shared_ptr<const std::vector<tensorutil::ColumnStatistics>>
+TensorField<N, precision>::statistics(size_t bins) const {
+    struct CachedStatistics {
+        std::vector<std::weak_ptr<const Column>> columns;  // not keeping replaced columns alive
+        std::shared_ptr<const std::vector<tensorutil::ColumnStatistics>> statistics;
+    };
+
+    // Same columns as an eager field by default
+    if (metaDataPolicy_ == MetaDataPolicy::Lazy) getMetaData<attributes::MajorEigenValue>();
+
+    std::vector<std::shared_ptr<const Column>> columns;
+    for (auto column : *metaData_) {
+        if (column->getHeader() == "index") continue;
+        columns.push_back(column);
+    }
+    {
+        std::vector<std::shared_ptr<const Column>> lazyColumns;
+        std::shared_lock<std::shared_mutex> lock(lazyMetaData_->mutex);
+        for (const auto& item : lazyMetaData_->columns) {
+            if (!metaData_->getColumn(item.first)) lazyColumns.push_back(item.second);
+        }
+        std::sort(lazyColumns.begin(), lazyColumns.end(), [](const auto& a, const auto& b) {
+            return a->getHeader() < b->getHeader();
+        });
+        columns.insert(columns.end(), lazyColumns.begin(), lazyColumns.end());
+    }
+
+    // Columns might have been replaced or added to the meta data in place
+    auto isCurrent = [&columns](const CachedStatistics& cached) {
+        return std::equal(
+            columns.begin(), columns.end(), cached.columns.begin(), cached.columns.end(),
+            [](const auto& column, const auto& weak) { return column == weak.lock(); });
+    };
+
+    const auto key = "Statistics/" + std::to_string(bins);
+    {
+        std::lock_guard<std::mutex> lock(representations_->mutex);
+        if (auto it = representations_->items.find(key); it != representations_->items.end()) {
+            const auto cached = std::static_pointer_cast<const CachedStatistics>(it->second);
+            if (isCurrent(*cached)) return cached->statistics;
+        }
+    }
+
+    auto cached = std::make_shared<CachedStatistics>(CachedStatistics{
+        {columns.begin(), columns.end()},
+        std::make_shared<const std::vector<tensorutil::ColumnStatistics>>(
+            tensorutil::computeStatistics(columns, size_, bins))});
+
+    std::lock_guard<std::mutex> lock(representations_->mutex);
+    representations_->items[key] = cached;
+    return cached->statistics;
+}
+
+template <unsigned int N, typename precision>
+inline std::shared_ptr<DataFrame> TensorField<N, precision>::editableMetaData() {
+    if (metaData_.use_count() > 1) {
+        auto metaData = std::make_shared<DataFrame>();
+        for (auto column : *metaData_) {
+            if (column->getHeader() == "index") continue;
+            metaData->addColumn(column);
+        }
+        metaData->updateIndexBuffer();
+        metaData_ = metaData;
+    }
+    return metaData_;
+}
+
 template <unsigned int N, typename precision>
 inline int TensorField<N, precision>::getNumDefinedEntries() const {
-    return static_cast<int>(std::count(std::begin(binaryMask_), std::end(binaryMask_), 1));
+    const auto& mask = getMask();
+    return static_cast<int>(std::count(std::begin(mask), std::end(mask), 1));
 }
 
 namespace {
@@ -401,6 +904,22 @@ struct HasMetaData {
 };
 }  // namespace
 
+template <unsigned int N, typename precision>
+inline void TensorField<N, precision>::dropDerivedMetaData() {
+    using Types = std::conditional_t<N == 2, attributes::types2D, attributes::types3D>;
+
+    std::vector<std::string> derived;
+    for (auto column : *metaData_) {
+        const auto& name = column->getHeader();
+        if (util::for_each_type<Types>{}(HasMetaData{}, name).wasFound_) derived.push_back(name);
+    }
+    if (derived.empty()) return;
+
+    // Other fields sharing the DataFrame keep their columns
+    auto metaData = editableMetaData();
+    for (const auto& name : derived) metaData->dropColumn(name);
+}
+
 template <unsigned int N, typename precision>
 inline bool TensorField<N, precision>::hasMetaData(const std::string& name) const {
     if constexpr (N == 3) {
@@ -419,7 +938,12 @@ inline bool TensorField<N, precision>::hasMetaData() const {
             return pair.first == name;
         };
 
-        return std::find_if(headers.begin(), headers.end(), pred) != headers.end();
+        if (std::find_if(headers.begin(), headers.end(), pred) != headers.end()) {
+            return true;
+        }
+
+        std::shared_lock<std::shared_mutex> lock(lazyMetaData_->mutex);
+        return lazyMetaData_->columns.count(name) != 0;
     }
 }
 
@@ -437,8 +961,55 @@ inline std::optional<std::shared_ptr<const Column>> TensorField<N, precision>::g
             return metaData_->getColumn(name);
         }
 
-        return std::nullopt;
+        return lazyMetaData<T>();
+    }
+}
+
+template <unsigned int N, typename precision>
+template <typename T>
+inline std::optional<std::shared_ptr<const Column>> TensorField<N, precision>::lazyMetaData()
+    const {
+    const auto name = std::string(T::identifier);
+    {
+        std::shared_lock<std::shared_mutex> lock(lazyMetaData_->mutex);
+        if (auto it = lazyMetaData_->columns.find(name); it != lazyMetaData_->columns.end()) {
+            return it->second;
+        }
+    }
+    if (metaDataPolicy_ != MetaDataPolicy::Lazy) return std::nullopt;
+
+    std::unique_lock<std::shared_mutex> lock(lazyMetaData_->mutex);
+    auto& columns = lazyMetaData_->columns;
+    // Another thread might have computed the column while we were waiting for the lock
+    if (auto it = columns.find(name); it != columns.end()) {
+        return it->second;
+    }
+
+    std::vector<size_t> ids{util::constexpr_hash(T::identifier)};
+    if constexpr (T::usesEigenSystem) {
+        // The eigen system is the expensive part, compute all columns derived from it at once
+        std::array<std::string_view, 6> eigenSystem{
+            attributes::MajorEigenValue::identifier,
+            attributes::IntermediateEigenValue::identifier,
+            attributes::MinorEigenValue::identifier,
+            attributes::MajorEigenVector<N>::identifier,
+            attributes::IntermediateEigenVector<N>::identifier,
+            attributes::MinorEigenVector<N>::identifier};
+        for (const auto& identifier : eigenSystem) {
+            if (columns.count(std::string(identifier)) == 0) {
+                ids.push_back(util::constexpr_hash(identifier));
+            }
+        }
+    }
+
+    for (auto& column : calculateAttributes(ids)) {
+        columns.emplace(column->getHeader(), column);
+    }
+
+    if (auto it = columns.find(name); it != columns.end()) {
+        return it->second;
     }
+    return std::nullopt;
 }
 
 template <unsigned int N, typename precision>
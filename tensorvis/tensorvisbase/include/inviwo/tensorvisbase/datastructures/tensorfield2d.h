@@ -53,9 +53,17 @@ public:
     TensorField2D() = delete;
 
     TensorField2D(const sizeN_t& dimensions, const std::vector<matN>& tensors,
-                  std::shared_ptr<DataFrame> metaData = nullptr);
+                  std::shared_ptr<DataFrame> metaData = nullptr,
+                  MetaDataPolicy policy = MetaDataPolicy::Eager);
+    TensorField2D(const sizeN_t& dimensions, std::vector<matN>&& tensors,
+                  std::shared_ptr<DataFrame> metaData = nullptr,
+                  MetaDataPolicy policy = MetaDataPolicy::Eager);
     TensorField2D(const sizeN_t& dimensions, std::shared_ptr<std::vector<matN>> tensors,
-                  std::shared_ptr<DataFrame> metaData = nullptr);
+                  std::shared_ptr<DataFrame> metaData = nullptr,
+                  MetaDataPolicy policy = MetaDataPolicy::Eager);
+    TensorField2D(const sizeN_t& dimensions, std::shared_ptr<std::vector<packedN>> tensors,
+                  std::shared_ptr<DataFrame> metaData = nullptr,
+                  MetaDataPolicy policy = MetaDataPolicy::Eager);
 
     // Destructors
     virtual ~TensorField2D() = default;
@@ -71,20 +79,42 @@ public:
 
     virtual TensorField2D* deepCopy() const final;
 
+    /**
+     * Builds the level of detail pyramid of the field in parallel. Every level halves the
+     * dimensions of the previous one, rounding up, down to a single tensor. The levels compute
+     * their meta data on demand. The pyramid is shared between shallow copies and discarded when
+     * the tensors change.
+     */
+    void buildPyramid(PyramidFilter filter = PyramidFilter::LogEuclidean);
+
+    /**
+     * Returns the given level of the pyramid, 1 <= level < getNumberOfLevels(). Level 0 is the
+     * field itself.
+     */
+    std::shared_ptr<const TensorField2D> getLevel(size_t level) const;
+
     std::shared_ptr<Image> getImageRepresentation() const;
 
-    const dvec2& getNormalizedImagePosition(size_t index) const;
-    const std::vector<dvec2>& normalizedImagePositions() const;
+    /**
+     * Position of the tensor in normalized image coordinates, [0,1] along both axes. Computed from
+     * the index, the positions are not stored.
+     */
+    dvec2 getNormalizedImagePosition(size_t index) const;
+    /**
+     * Writes the normalized image positions of the tensors [first, first + count) to positions.
+     */
+    void normalizedImagePositions(size_t first, size_t count, dvec2* positions) const;
+    /**
+     * Returns the normalized image positions of all tensors. NOTE: Allocates a new vector on
+     * every call, prefer getNormalizedImagePosition() in per-tensor loops.
+     */
+    std::vector<dvec2> normalizedImagePositions() const;
 
 protected:
     virtual void initializeDefaultMetaData() final;
     virtual void computeDataMaps() final;
 
 private:
-    void computeNormalizedScreenCoordinates();
-
-    std::vector<dvec2> normalizedImagePositions_;
-
     template <typename T, typename R>
     void addIfNotPresent(std::shared_ptr<DataFrame>, const R& data) const;
 };
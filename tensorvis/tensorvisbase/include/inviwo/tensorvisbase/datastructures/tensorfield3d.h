@@ -45,9 +45,17 @@ public:
     TensorField3D() = delete;
 
     TensorField3D(const sizeN_t& dimensions, const std::vector<matN>& tensors,
-                  std::shared_ptr<DataFrame> metaData = nullptr);
+                  std::shared_ptr<DataFrame> metaData = nullptr,
+                  MetaDataPolicy policy = MetaDataPolicy::Eager);
+    TensorField3D(const sizeN_t& dimensions, std::vector<matN>&& tensors,
+                  std::shared_ptr<DataFrame> metaData = nullptr,
+                  MetaDataPolicy policy = MetaDataPolicy::Eager);
     TensorField3D(const sizeN_t& dimensions, std::shared_ptr<std::vector<matN>> tensors,
-                  std::shared_ptr<DataFrame> metaData = nullptr);
+                  std::shared_ptr<DataFrame> metaData = nullptr,
+                  MetaDataPolicy policy = MetaDataPolicy::Eager);
+    TensorField3D(const sizeN_t& dimensions, std::shared_ptr<std::vector<packedN>> tensors,
+                  std::shared_ptr<DataFrame> metaData = nullptr,
+                  MetaDataPolicy policy = MetaDataPolicy::Eager);
 
     virtual ~TensorField3D() = default;
 
@@ -62,6 +70,20 @@ public:
 
     virtual TensorField3D* deepCopy() const final;
 
+    /**
+     * Builds the level of detail pyramid of the field in parallel. Every level halves the
+     * dimensions of the previous one, rounding up, down to a single tensor. The levels compute
+     * their meta data on demand. The pyramid is shared between shallow copies and discarded when
+     * the tensors change.
+     */
+    void buildPyramid(PyramidFilter filter = PyramidFilter::LogEuclidean);
+
+    /**
+     * Returns the given level of the pyramid, 1 <= level < getNumberOfLevels(). Level 0 is the
+     * field itself.
+     */
+    std::shared_ptr<const TensorField3D> getLevel(size_t level) const;
+
     value_type getIntermediateEigenValue(const size_t index) const {
         return value_type(this->getMetaDataContainer<attributes::IntermediateEigenValue>()[index]);
     }
@@ -74,9 +96,40 @@ public:
         return this->getMetaDataContainer<attributes::IntermediateEigenValue>();
     }
 
-    std::array<std::shared_ptr<Volume>, 3> getVolumeRepresentation() const;
+    /**
+     * Layout of the volume representation of the field
+     * Columns: three vec3 volumes holding the columns of the tensors
+     * Symmetric: two vec3 volumes holding the diagonal (xx, yy, zz) and the off-diagonal entries
+     * (xy, xz, yz) of symmetric tensors
+     */
+    enum class VolumeLayout { Columns, Symmetric };
+
+    /**
+     * Returns volumes holding the tensors in the given layout. The volumes are created in parallel
+     * on first access and cached. The cache is shared between shallow copies and discarded when the
+     * tensors change, so the volumes and their GPU representations can be reused across frames.
+     */
+    std::vector<std::shared_ptr<const Volume>> getVolumeRepresentation(VolumeLayout layout) const;
+    /**
+     * Returns the three column volumes, see getVolumeRepresentation(VolumeLayout::Columns).
+     */
+    std::array<std::shared_ptr<const Volume>, 3> getVolumeRepresentation() const;
+    /**
+     * Position of the tensor scaled by the spacing of the field. Axes with a single voxel get
+     * sliceCoord. Computed from the index, the positions are not stored.
+     */
     vec3 getNormalizedVolumePosition(size_t index, double sliceCoord) const;
-    std::optional<std::vector<vec3>> getNormalizedScreenCoordinates(float sliceCoord);
+    /**
+     * Writes the positions of the tensors [first, first + count) to positions, see
+     * getNormalizedVolumePosition().
+     */
+    void getNormalizedVolumePositions(size_t first, size_t count, double sliceCoord,
+                                      vec3* positions) const;
+    /**
+     * Returns the positions of all tensors, see getNormalizedVolumePosition(). NOTE: Allocates a
+     * new vector on every call.
+     */
+    std::optional<std::vector<vec3>> getNormalizedScreenCoordinates(float sliceCoord) const;
 
 protected:
     virtual void initializeDefaultMetaData() final;
@@ -0,0 +1,115 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+
+#include <functional>
+#include <memory>
+
+namespace inviwo {
+
+/**
+ * \class TensorField3DSequence
+ * \brief Time-varying 3D tensor field whose timesteps are loaded on demand.
+ *
+ * Timesteps are created by a Loader and kept in a cache bounded by a memory budget, the least
+ * recently used timesteps are evicted first. Requesting a timestep prefetches the following
+ * getPrefetchCount() timesteps on the thread pool, wrapping around at the end of the sequence,
+ * so that playback finds the next timesteps in memory. Timesteps with the same dimensions and
+ * mask as the first loaded timestep share its mask.
+ *
+ * The cache is shared between copies of the sequence. All methods are thread safe.
+ */
+class IVW_MODULE_TENSORVISBASE_API TensorField3DSequence {
+public:
+    /**
+     * Creates the given timestep. cancelled returns true once the result is no longer needed, the
+     * loader may then return nullptr early. Exceptions are propagated to get().
+     */
+    using Loader = std::function<std::shared_ptr<TensorField3D>(
+        size_t timestep, const std::function<bool()>& cancelled)>;
+
+    static constexpr size_t defaultMemoryBudget = size_t{2} << 30;
+    static constexpr size_t defaultPrefetchCount = 2;
+
+    TensorField3DSequence(size_t numberOfTimesteps, Loader loader,
+                          size_t memoryBudget = defaultMemoryBudget,
+                          size_t prefetchCount = defaultPrefetchCount);
+    TensorField3DSequence(const TensorField3DSequence&) = default;
+    TensorField3DSequence& operator=(const TensorField3DSequence&) = default;
+    ~TensorField3DSequence() = default;
+
+    size_t size() const;
+
+    /**
+     * Returns the timestep, loading it on the calling thread if it is neither cached nor being
+     * prefetched, and waiting for it otherwise. Prefetches the following timesteps.
+     */
+    std::shared_ptr<const TensorField3D> get(size_t timestep) const;
+    /**
+     * Returns the timestep if it is cached, nullptr otherwise. Does not block, but starts loading
+     * the timestep and the following ones in the background.
+     */
+    std::shared_ptr<const TensorField3D> tryGet(size_t timestep) const;
+
+    /**
+     * Loads the timestep in the background if it is not cached or loading.
+     */
+    void prefetch(size_t timestep) const;
+
+    size_t getMemoryBudget() const;
+    /**
+     * Upper limit for the estimated memory of the cached timesteps in bytes. The most recently
+     * requested timestep is always kept.
+     */
+    void setMemoryBudget(size_t bytes);
+
+    size_t getPrefetchCount() const;
+    void setPrefetchCount(size_t count);
+
+    /**
+     * Estimated memory of the cached timesteps in bytes.
+     */
+    size_t getMemoryUsage() const;
+
+    /**
+     * Estimated memory of a field in bytes, tensors, mask and meta data columns.
+     */
+    static size_t estimateMemory(const TensorField3D& tensorField);
+
+private:
+    struct State;
+    std::shared_ptr<State> state_;
+};
+
+}  // namespace inviwo
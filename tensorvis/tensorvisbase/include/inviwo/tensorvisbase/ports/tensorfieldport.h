@@ -35,6 +35,9 @@
 #include <inviwo/core/datastructures/datatraits.h>
 #include <inviwo/tensorvisbase/datastructures/tensorfield2d.h>
 #include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfield3dsequence.h>
+#include <inviwo/tensorvisbase/datastructures/sparsetensorfield3d.h>
+#include <inviwo/tensorvisbase/datastructures/brickedtensorfield3d.h>
 
 namespace inviwo {
 
@@ -86,4 +89,77 @@ struct DataTraits<TensorField3D> {
     }
 };
 
+/**
+ * \ingroup ports
+ */
+using SparseTensorField3DInport = DataInport<SparseTensorField3D>;
+
+/**
+ * \ingroup ports
+ */
+using SparseTensorField3DOutport = DataOutport<SparseTensorField3D>;
+
+template <>
+struct DataTraits<SparseTensorField3D> {
+    static std::string classIdentifier() { return "org.inviwo.SparseTensorField3D"; }
+    static std::string dataName() { return "SparseTensorField3D"; }
+    static uvec3 colorCode() { return uvec3(46, 205, 232); }
+    static Document info(const SparseTensorField3D& data) {
+        std::ostringstream oss;
+        oss << data.getDataInfo();
+        Document doc;
+        doc.append("p", oss.str());
+        return doc;
+    }
+};
+
+/**
+ * \ingroup ports
+ */
+using BrickedTensorField3DInport = DataInport<BrickedTensorField3D>;
+
+/**
+ * \ingroup ports
+ */
+using BrickedTensorField3DOutport = DataOutport<BrickedTensorField3D>;
+
+template <>
+struct DataTraits<BrickedTensorField3D> {
+    static std::string classIdentifier() { return "org.inviwo.BrickedTensorField3D"; }
+    static std::string dataName() { return "BrickedTensorField3D"; }
+    static uvec3 colorCode() { return uvec3(46, 155, 232); }
+    static Document info(const BrickedTensorField3D& data) {
+        std::ostringstream oss;
+        oss << data.getDataInfo();
+        Document doc;
+        doc.append("p", oss.str());
+        return doc;
+    }
+};
+
+/**
+ * \ingroup ports
+ */
+using TensorField3DSequenceInport = DataInport<TensorField3DSequence>;
+
+/**
+ * \ingroup ports
+ */
+using TensorField3DSequenceOutport = DataOutport<TensorField3DSequence>;
+
+template <>
+struct DataTraits<TensorField3DSequence> {
+    static std::string classIdentifier() { return "org.inviwo.TensorField3DSequence"; }
+    static std::string dataName() { return "TensorField3DSequence"; }
+    static uvec3 colorCode() { return uvec3(46, 130, 232); }
+    static Document info(const TensorField3DSequence& data) {
+        std::ostringstream oss;
+        oss << "Timesteps: " << data.size() << "<br>Cached: " << data.getMemoryUsage() / (1 << 20)
+            << " / " << data.getMemoryBudget() / (1 << 20) << " MB";
+        Document doc;
+        doc.append("p", oss.str());
+        return doc;
+    }
+};
+
 }  // namespace inviwo
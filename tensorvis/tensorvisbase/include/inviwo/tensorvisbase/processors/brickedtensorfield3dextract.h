@@ -0,0 +1,78 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/tensorvisbase/ports/tensorfieldport.h>
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.BrickedTensorField3DExtract, Bricked Tensor Field 3D Extract}
+ * ![](org.inviwo.BrickedTensorField3DExtract.png?classIdentifier=org.inviwo.BrickedTensorField3DExtract)
+ * Extracts one brick of a bricked tensor field into an in-memory tensor field, see
+ * BrickedTensorField3D::extract(). Stepping through the bricks feeds the existing tensor field
+ * processors brick by brick, only the selected brick has to fit into memory.
+ *
+ * ### Inports
+ *   * __inport__ Bricked tensor field.
+ *
+ * ### Outports
+ *   * __outport__ Tensor field of the selected brick, placed at the position of the brick.
+ *
+ * ### Properties
+ *   * __Brick__ Index of the brick to extract.
+ *   * __Padding__ Number of voxels of the neighbouring bricks to include along each side, so
+ *     that interpolation across brick boundaries is continuous.
+ *   * __Compute meta data on demand__ Use MetaDataPolicy::Lazy for the extracted field.
+ */
+class IVW_MODULE_TENSORVISBASE_API BrickedTensorField3DExtract : public Processor {
+public:
+    BrickedTensorField3DExtract();
+    virtual ~BrickedTensorField3DExtract() = default;
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    BrickedTensorField3DInport inport_;
+    TensorField3DOutport outport_;
+
+    OrdinalProperty<size3_t> brick_;
+    IntSizeTProperty padding_;
+    BoolProperty lazyMetaData_;
+};
+
+}  // namespace inviwo
@@ -0,0 +1,67 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/tensorvisbase/ports/tensorfieldport.h>
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.SparseTensorField3DToDataFrame, Sparse Tensor Field 3D To Data Frame}
+ * ![](org.inviwo.SparseTensorField3DToDataFrame.png?classIdentifier=org.inviwo.SparseTensorField3DToDataFrame)
+ * Forwards the meta data of the input sparse tensor field for plotting or the like. The data frame
+ * holds one row per active voxel with its eigen values, eigen vectors and linear voxel index.
+ *
+ * ### Inports
+ *   * __inport__ Sparse tensor field inport.
+ *
+ * ### Outports
+ *   * __dataFrameOutport__ Outputs the data frame.
+ *
+ */
+class IVW_MODULE_TENSORVISBASE_API SparseTensorField3DToDataFrame : public Processor {
+public:
+    SparseTensorField3DToDataFrame();
+    virtual ~SparseTensorField3DToDataFrame() = default;
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    SparseTensorField3DInport inport_;
+    DataFrameOutport dataFrameOutport_;
+};
+
+}  // namespace inviwo
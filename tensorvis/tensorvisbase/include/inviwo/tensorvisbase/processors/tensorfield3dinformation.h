@@ -32,23 +32,29 @@
 #include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/processors/processor.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
 #include <inviwo/tensorvisbase/ports/tensorfieldport.h>
 
 namespace inviwo {
 
 /** \docpage{org.inviwo.TensorField3DInformation, Tensor Field 3D Information}
  * ![](org.inviwo.TensorField3DInformation.png?classIdentifier=org.inviwo.TensorField3DInformation)
- * Explanation of how to use the processor.
+ * Shows the tensor and eigen system at an index and the statistics of the meta data of the field.
  *
  * ### Inports
- *   * __<Inport1>__ <description>.
+ *   * __inport__ Tensor field.
  *
  * ### Outports
- *   * __<Outport1>__ <description>.
+ *   * __statistics__ Range, moments and quantiles of every meta data column, see
+ *     tensorutil::statisticsToDataFrame().
+ *   * __histograms__ Histograms of every meta data column, see
+ *     tensorutil::histogramsToDataFrame().
  *
  * ### Properties
- *   * __<Prop1>__ <description>.
- *   * __<Prop2>__ <description>
+ *   * __Index__ Voxel whose tensor is shown.
+ *   * __Histogram bins__ Number of bins of the histograms, also determines the accuracy of the
+ *     quantiles.
  */
 
 /**
@@ -69,8 +75,11 @@ public:
 
 private:
     TensorField3DInport inport_;
+    DataFrameOutport statisticsOutport_;
+    DataFrameOutport histogramsOutport_;
 
     IntVec3Property index_;
+    IntSizeTProperty bins_;
 
     FloatMat3Property tensor_;
     FloatMat3Property eigenVectors_;
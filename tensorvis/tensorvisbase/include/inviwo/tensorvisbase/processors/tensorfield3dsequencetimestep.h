@@ -0,0 +1,79 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/activityindicator.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/tensorvisbase/ports/tensorfieldport.h>
+
+#include <atomic>
+#include <memory>
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.TensorField3DSequenceTimestep, Tensor Field 3D Sequence Timestep}
+ * ![](org.inviwo.TensorField3DSequenceTimestep.png?classIdentifier=org.inviwo.TensorField3DSequenceTimestep)
+ * Selects one timestep of a tensor field sequence. Timesteps that are not prefetched yet are
+ * loaded in the background, the previous timestep stays on the outport meanwhile.
+ *
+ * ### Inports
+ *   * __inport__ Tensor field sequence.
+ *
+ * ### Outports
+ *   * __outport__ The selected timestep.
+ *
+ * ### Properties
+ *   * __Timestep__ Index of the timestep.
+ */
+class IVW_MODULE_TENSORVISBASE_API TensorField3DSequenceTimestep : public Processor,
+                                                                   public ActivityIndicatorOwner {
+public:
+    TensorField3DSequenceTimestep();
+    virtual ~TensorField3DSequenceTimestep();
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    TensorField3DSequenceInport inport_;
+    TensorField3DOutport outport_;
+
+    IntSizeTProperty timestep_;
+
+    std::shared_ptr<const TensorField3D> tensorField_;
+    std::shared_ptr<std::atomic<bool>> cancelLoad_;
+};
+
+}  // namespace inviwo
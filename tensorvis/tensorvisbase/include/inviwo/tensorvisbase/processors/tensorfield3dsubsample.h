@@ -35,6 +35,7 @@
 #include <inviwo/tensorvisbase/ports/tensorfieldport.h>
 #include <inviwo/tensorvisbase/util/tensorfieldutil.h>
 #include <inviwo/core/processors/progressbarowner.h>
+#include <inviwo/core/properties/boolproperty.h>
 
 namespace inviwo {
 
@@ -76,8 +77,15 @@ private:
 
     FloatProperty resolutionMultiplier_;
     TemplateOptionProperty<tensorutil::InterpolationMethod> interpolationMethod_;
+    BoolProperty usePyramid_;
+    TemplateOptionProperty<PyramidFilter> pyramidFilter_;
 
-    std::shared_ptr<TensorField3D> tf_;
+    std::shared_ptr<const TensorField3D> tf_;
+
+    // Shallow copy of the input holding the pyramid, rebuilt when the input or filter changes
+    std::shared_ptr<TensorField3D> pyramid_;
+    std::shared_ptr<const TensorField3D> pyramidInput_;
+    PyramidFilter pyramidFilterUsed_;
 
     void subsample();
 
@@ -32,11 +32,19 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/ports/imageport.h>
 #include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/activityindicator.h>
 #include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
 #include <inviwo/core/ports/dataoutport.h>
+#include <inviwo/core/properties/boolproperty.h>
 #include <inviwo/core/properties/compositeproperty.h>
+#include <inviwo/core/properties/optionproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
 #include <inviwo/tensorvisbase/ports/tensorfieldport.h>
 #include <inviwo/tensorvisbase/properties/tensorglyphproperty.h>
+#include <inviwo/tensorvisbase/algorithm/glyphplacement.h>
+
+#include <atomic>
+#include <memory>
 
 namespace inviwo {
 
@@ -51,8 +59,24 @@ namespace inviwo {
  *   * __<Outport1>__ <description>.
  *
  * ### Properties
- *   * __<Prop1>__ <description>.
- *   * __<Prop2>__ <description>
+ *   * __Output__ Either one mesh per glyph or all glyphs merged into a single mesh, which is
+ *     generated in parallel and drawn in one call.
+ *   * __Glyph placement__ Where glyphs are placed: every stride voxels, jittered within cells of
+ *     stride voxels, Poisson-disk distributed with a minimum distance in voxels, or importance
+ *     sampled with probabilities proportional to a scalar meta data column or attribute, which
+ *     is computed if the field does not have it. The random placements are reproducible for a
+ *     given seed. With the level of detail pyramid, regular and jittered placements with a
+ *     stride read the tensors from the coarsest pyramid level that still has a tensor per glyph,
+ *     so that a glyph shows the average of the voxels it stands for instead of a single one.
+ *     The pyramid is built once per input and filter, see TensorField3D::buildPyramid().
+ *   * __Level of detail__ Glyphs smaller than the full detail size in world space are generated
+ *     with half the resolution for every halving of their size, and glyphs below a fraction of
+ *     the maximum norm or anisotropy of the field are skipped. Glyph sizes can be scaled by the
+ *     norm of the tensor. The number of triangles generated is shown next to the number of
+ *     triangles that the glyphs would have at full detail.
+ *
+ * Glyphs are generated in the background. The previous glyphs stay on the outport until the new
+ * ones are done, and changing a property cancels a generation that is still running.
  */
 
 /**
@@ -60,10 +84,13 @@ namespace inviwo {
  * \brief VERY_BRIEFLY_DESCRIBE_THE_CLASS
  * DESCRIBE_THE_CLASS_FROM_A_DEVELOPER_PERSPECTIVE
  */
-class IVW_MODULE_TENSORVISBASE_API TensorGlyphProcessor : public Processor {
+class IVW_MODULE_TENSORVISBASE_API TensorGlyphProcessor : public Processor,
+                                                           public ActivityIndicatorOwner {
 public:
     TensorGlyphProcessor();
-    virtual ~TensorGlyphProcessor() = default;
+    virtual ~TensorGlyphProcessor();
+
+    enum class Output { MeshPerGlyph, Merged };
 
     virtual void process() override;
 
@@ -74,7 +101,43 @@ private:
     TensorField3DInport inport_;
     DataOutport<std::vector<std::shared_ptr<Mesh>>> outport_;
 
+    TemplateOptionProperty<Output> output_;
+
+    CompositeProperty placement_;
+    TemplateOptionProperty<tensorutil::GlyphPlacement> placementMode_;
+    IntSize3Property stride_;
+    FloatProperty radius_;
+    IntSizeTProperty count_;
+    OptionPropertyString importanceColumn_;
+    IntProperty seed_;
+    BoolProperty usePyramid_;
+    TemplateOptionProperty<PyramidFilter> pyramidFilter_;
+
+    CompositeProperty lod_;
+    IntSizeTProperty levels_;
+    FloatProperty detailSize_;
+    BoolProperty scaleByNorm_;
+    FloatProperty minNorm_;
+    FloatProperty minAnisotropy_;
+    IntSizeTProperty culled_;
+    IntSizeTProperty triangles_;
+    IntSizeTProperty fullDetailTriangles_;
+
     TensorGlyphProperty glyphParameters_;
+
+    void updatePlacementVisibility();
+    tensorutil::GlyphPlacementSettings placementSettings() const;
+    tensorutil::GlyphLodSettings lodSettings() const;
+    bool settingsModified() const;
+    void generate();
+
+    std::shared_ptr<std::vector<std::shared_ptr<Mesh>>> meshes_;
+    std::shared_ptr<std::atomic<bool>> cancelGeneration_;
+
+    // Only accessed on the main thread, the generation builds the pyramid if it is missing
+    std::shared_ptr<const TensorField3D> pyramid_;
+    std::shared_ptr<const TensorField3D> pyramidInput_;
+    PyramidFilter pyramidFilterUsed_;
 };
 
 }  // namespace inviwo
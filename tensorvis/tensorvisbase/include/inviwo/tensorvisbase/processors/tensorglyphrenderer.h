@@ -99,6 +99,8 @@ private:
     ImageOutport outport_;
 
     std::vector<std::unique_ptr<MeshDrawer>> meshDrawers_;
+    // Number of the first glyph of each mesh, merged meshes contain several glyphs
+    std::vector<size_t> firstGlyphs_;
 
     CameraProperty camera_;
     CameraTrackball trackball_;
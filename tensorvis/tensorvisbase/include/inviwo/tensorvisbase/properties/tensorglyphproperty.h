@@ -32,10 +32,14 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
 #include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+#include <inviwo/tensorvisbase/algorithm/glyphbatch.h>
+#include <inviwo/tensorvisbase/datastructures/glyphtemplate.h>
 #include <inviwo/core/properties/compositeproperty.h>
 #include <inviwo/core/properties/optionproperty.h>
 #include <inviwo/core/properties/ordinalproperty.h>
 
+#include <optional>
+
 namespace inviwo {
 
 /**
@@ -73,14 +77,26 @@ public:
     float gamma() const;
 
     const std::shared_ptr<BasicMesh> generateGlyph(std::shared_ptr<const TensorField3D> tensorField,
-                                                   size_t index, const vec3 pos);
+                                                   size_t index, const vec3 pos) const;
+    const std::shared_ptr<BasicMesh> generateGlyph(std::shared_ptr<const TensorField3D> tensorField,
+                                                   size_t index, const vec3 pos,
+                                                   const vec4& color) const;
     const std::shared_ptr<BasicMesh> generateGlyph(std::shared_ptr<const TensorField3D> tensorField,
-                                                   size_t index, const vec3 pos, const vec4& color);
+                                                   size_t index, const vec3 pos,
+                                                   const float size) const;
+    /**
+     * Generates the glyph at the given level of detail, see glyphExtent(size_t).
+     */
     const std::shared_ptr<BasicMesh> generateGlyph(std::shared_ptr<const TensorField3D> tensorField,
-                                                   size_t index, const vec3 pos, const float size);
+                                                   size_t index, const vec3 pos, const vec4& color,
+                                                   const float size, size_t level = 0) const;
+    /**
+     * Generates the glyph from the given template, see glyphTemplate().
+     */
     const std::shared_ptr<BasicMesh> generateGlyph(std::shared_ptr<const TensorField3D> tensorField,
                                                    size_t index, const vec3 pos, const vec4& color,
-                                                   const float size);
+                                                   const float size,
+                                                   const GlyphTemplate& sphere) const;
 
     const std::shared_ptr<BasicMesh> generateGlyph(const mat3& tensor, const vec3& pos,
                                                    const float size,
@@ -94,6 +110,44 @@ public:
                                                      const float size,
                                                      const vec4& color = vec4(1.)) const;
 
+    /**
+     * Vertex and index count of every glyph that generateGlyph(tensorField, index, pos) creates
+     * with the current settings. All glyphs of a type and resolution share the same topology.
+     * Every level of detail halves the resolution, down to a minimum of four segments.
+     */
+    tensorutil::GlyphExtent glyphExtent(size_t level = 0) const;
+    tensorutil::GlyphExtent glyphExtent(const GlyphTemplate& sphere) const;
+
+    /**
+     * The template that glyphs of a tensor field are generated from at the given level of detail.
+     * Templates are only cached while referenced, see GlyphTemplate::get(), hence glyph
+     * generators fetch the template once and pass it to writeGlyph() or generateGlyph() for every
+     * glyph.
+     */
+    std::shared_ptr<const GlyphTemplate> glyphTemplate(size_t level = 0) const;
+
+    /**
+     * Writes the glyph of generateGlyph(tensorField, index, pos) into a slot of a glyph batch, see
+     * tensorutil::batchGlyphs. The slot needs to have the extent glyphExtent(). Safe to call
+     * concurrently.
+     */
+    void writeGlyph(std::shared_ptr<const TensorField3D> tensorField, size_t index,
+                    const vec3& pos, tensorutil::GlyphSlot& slot) const;
+
+    /**
+     * Writes a glyph of the given size and level of detail into a slot with the extent
+     * glyphExtent(level).
+     */
+    void writeGlyph(std::shared_ptr<const TensorField3D> tensorField, size_t index,
+                    const vec3& pos, float size, size_t level, tensorutil::GlyphSlot& slot) const;
+    /**
+     * Writes a glyph of the given size from the given template into a slot with the extent
+     * glyphExtent(sphere).
+     */
+    void writeGlyph(std::shared_ptr<const TensorField3D> tensorField, size_t index,
+                    const vec3& pos, float size, const GlyphTemplate& sphere,
+                    tensorutil::GlyphSlot& slot) const;
+
 protected:
     // Properties go here
     TemplateOptionProperty<GlyphType> glyphType_;
@@ -120,30 +174,46 @@ private:
     }
 
     void evalColorReadOnly();
-    float signedExponentiation(float x, float a);
-    vec3 cartesianToSpherical(const vec3& pos) const;
-    std::pair<bool, vec3> intersectTriangle(const vec2& coord,
-                                            const std::array<vec2, 3>& tri_verts);
-
-    const std::shared_ptr<BasicMesh> generateSuperquadric(
-        std::shared_ptr<const TensorField3D> tensorField, size_t index, const vec3 pos,
-        const vec4& color, const float size);
-
-    const std::shared_ptr<BasicMesh> generateSuperquadric(const mat3& tensor, const vec3& pos,
-                                                          const float size,
-                                                          const vec4& color = vec4(1.)) const;
-
-    const std::shared_ptr<BasicMesh> generateSuperquadric(const std::array<float, 3>& eigenvalues,
-                                                          const vec3& pos, const float size,
-                                                          const vec4& color = vec4(1.)) const;
-
-    const std::shared_ptr<BasicMesh> generateReynolds(
-        std::shared_ptr<const TensorField3D> tensorField, size_t index, const vec3 pos,
-        const float size);
-
-    const std::shared_ptr<BasicMesh> generateQuadric(
-        std::shared_ptr<const TensorField3D> tensorField, size_t index, const vec3 pos,
-        const vec4& color, const float size);
+    static float signedExponentiation(float x, float a);
+    static std::pair<bool, vec3> intersectTriangle(const vec2& coord,
+                                                   const std::array<vec2, 3>& tri_verts);
+
+    /**
+     * The write functions generate a glyph of unit size centered at the origin into a slot with
+     * the extent of the glyph. They start from the cached template of the glyph shape and only
+     * deform its positions and normals. Glyphs with a basis of their own return it, it has to be
+     * applied on top of the translation and scaling of the glyph.
+     */
+    std::optional<mat3> writeGlyphGeometry(const std::shared_ptr<const TensorField3D>& tensorField,
+                                           size_t index, const vec4& color,
+                                           const GlyphTemplate& sphere,
+                                           tensorutil::GlyphSlot& slot) const;
+
+    mat3 writeSuperquadric(const std::shared_ptr<const TensorField3D>& tensorField, size_t index,
+                           const GlyphTemplate& sphere, const vec4& color,
+                           tensorutil::GlyphSlot& slot) const;
+
+    void writeSuperquadric(const std::array<float, 3>& eigenValues, const GlyphTemplate& sphere,
+                           const vec4& color, tensorutil::GlyphSlot& slot) const;
+
+    mat3 writeSuperquadricExtended(const std::shared_ptr<const TensorField3D>& tensorField,
+                                   size_t index, const GlyphTemplate& sphere,
+                                   tensorutil::GlyphSlot& slot) const;
+
+    void writeReynolds(const mat3& tensor, const GlyphTemplate& sphere,
+                       tensorutil::GlyphSlot& slot) const;
+
+    void writeHWY(const mat3& tensor, const GlyphTemplate& sphere, const vec4& color,
+                  tensorutil::GlyphSlot& slot) const;
+
+    void writeCombinedReynoldsHWY(const mat3& tensor, const GlyphTemplate& sphere,
+                                  const vec4& color, tensorutil::GlyphSlot& slot) const;
+
+    /**
+     * Quadrics, cubes and cylinders: the template transformed by the tensor.
+     */
+    void writeTransformed(const mat3& tensor, const GlyphTemplate& shape, const vec4& color,
+                          tensorutil::GlyphSlot& slot) const;
 
     const std::shared_ptr<BasicMesh> generateCube(const mat3& tensor, const vec3& pos,
                                                   const float size,
@@ -153,22 +223,6 @@ private:
                                                       const float size,
                                                       const vec4& color = vec4(1.)) const;
 
-    const std::shared_ptr<BasicMesh> generateHWY(std::shared_ptr<const TensorField3D> tensorField,
-                                                 size_t index, const vec3 pos, const vec4& color,
-                                                 const float size);
-
-    const std::shared_ptr<BasicMesh> generateCombinedReynoldsHWY(
-        std::shared_ptr<const TensorField3D> tensorField, size_t index, const vec3 pos,
-        const vec4& color, const float size);
-
-    const std::shared_ptr<BasicMesh> generateSuperquadricExtended(
-        std::shared_ptr<const TensorField3D> tensorField, size_t index, const vec3 pos,
-        const float size);
-
-    std::shared_ptr<BasicMesh> createSuperquadric(const std::array<float, 3>& eigenValues,
-                                                  const vec3& pos, const float size,
-                                                  const vec4& color) const;
-
     static inline constexpr std::array<std::array<vec2, 3>, 10> tri_uv{
         {{vec2(0.00, 0.00), vec2(0.50, 0.00), vec2(0.25, 0.25)},
          {vec2(0.00, 0.00), vec2(0.25, 0.25), vec2(0.00, 0.50)},
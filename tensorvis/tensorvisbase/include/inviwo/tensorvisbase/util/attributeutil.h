@@ -31,6 +31,7 @@
 
 #include <type_traits>
 #include <string>
+#include <algorithm>
 
 #include <inviwo/core/processors/processor.h>
 #include <inviwo/core/properties/boolproperty.h>
@@ -68,34 +69,64 @@ private:
     std::shared_ptr<const TensorFieldType> tensorField_;
 };
 
+/**
+ * Drops deselected meta data columns right away and collects the ones to be added, which are then
+ * calculated in a single fused pass over the tensors by calculatePending().
+ */
 template <unsigned N>
 struct AddRemoveMetaData {
     using TensorFieldType =
         std::conditional_t<N == 2, TensorField2D, std::conditional_t<N == 3, TensorField3D, void>>;
+
     AddRemoveMetaData() = delete;
     AddRemoveMetaData(std::shared_ptr<TensorFieldType> tensorField) : tensorField_(tensorField) {}
 
     template <typename T>
     void operator()(const size_t id, const bool add) {
-        auto metaData = tensorField_->metaData();
-
         if (id == util::constexpr_hash(T::identifier)) {
             if (tensorField_->template hasMetaData<T>()) {
-                if (!add) {
-                    metaData->dropColumn(std::string(T::identifier));
+                const auto name = std::string(T::identifier);
+                const auto& headers = tensorField_->metaData()->getHeaders();
+                const bool inDataFrame =
+                    std::any_of(headers.begin(), headers.end(),
+                                [&name](const auto& header) { return header.first == name; });
+                if (!add && inDataFrame) {
+                    tensorField_->editableMetaData()->dropColumn(name);
+                } else if (add && !inDataFrame) {
+                    // Computed on demand by a field with MetaDataPolicy::Lazy, reuse the column
+                    computed_.push_back(std::const_pointer_cast<Column>(
+                        *tensorField_->template getMetaData<T>()));
                 }
             } else {
                 if (add) {
-                    metaData->addColumn(std::make_shared<TemplateColumn<typename T::value_type>>(
-                        std::string(T::identifier),
-                        T::calculate(tensorField_->tensors(), metaData)));
+                    pending_.push_back(id);
                 }
             }
         }
     }
 
+    void calculatePending() {
+        if (pending_.empty() && computed_.empty()) return;
+
+        auto metaData = tensorField_->editableMetaData();
+        for (auto column : computed_) {
+            metaData->addColumn(column);
+        }
+        if (!pending_.empty()) {
+            for (auto column : tensorField_->calculateAttributes(pending_)) {
+                metaData->addColumn(column);
+            }
+        }
+        metaData->updateIndexBuffer();
+
+        pending_.clear();
+        computed_.clear();
+    }
+
 private:
     std::shared_ptr<TensorFieldType> tensorField_;
+    std::vector<size_t> pending_;
+    std::vector<std::shared_ptr<Column>> computed_;
 };
 
 template <unsigned N>
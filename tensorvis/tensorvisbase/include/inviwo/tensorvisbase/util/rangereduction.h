@@ -0,0 +1,215 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace inviwo {
+namespace tensorutil {
+
+/**
+ * Input of reduceRanges(). The column holds count * components values starting at data, all
+ * components are reduced together, e.g. components = 3 for a column of vec3.
+ */
+template <typename T>
+struct RangeColumn {
+    const T* data;
+    size_t components = 1;
+    /**
+     * Skip values with a magnitude below the epsilon of T, e.g. to find the range of the
+     * defined tensors of a masked field.
+     */
+    bool ignoreZeros = false;
+};
+
+/**
+ * Result of reduceRanges(). If no value was taken into account, count is zero and range is
+ * (max, lowest).
+ */
+struct ValueRange {
+    dvec2 range{std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest()};
+    size_t count = 0;
+    /**
+     * Number of values per bin over range, empty if no histogram was requested
+     */
+    std::vector<size_t> histogram;
+};
+
+namespace detail {
+constexpr size_t rangeLanes = 16;
+
+/**
+ * Reduces the values [begin, end) into the running min/max/count of the column. The values are
+ * processed in blocks of rangeLanes with independent accumulators and branch-free selects, so
+ * the inner loops vectorize.
+ */
+template <typename T>
+void reduceRange(const T* data, size_t begin, size_t end, bool ignoreZeros, T& min, T& max,
+                 size_t& count) {
+    T lmin[rangeLanes], lmax[rangeLanes];
+    size_t lcount[rangeLanes]{};
+    std::fill(std::begin(lmin), std::end(lmin), min);
+    std::fill(std::begin(lmax), std::end(lmax), max);
+
+    constexpr T lowest = std::numeric_limits<T>::lowest();
+    constexpr T highest = std::numeric_limits<T>::max();
+    constexpr T epsilon = std::numeric_limits<T>::epsilon();
+
+    size_t i = begin;
+    if (ignoreZeros) {
+        for (; i + rangeLanes <= end; i += rangeLanes) {
+            for (size_t l = 0; l < rangeLanes; ++l) {
+                const T v = data[i + l];
+                const bool valid = !(std::abs(v) < epsilon);
+                lmin[l] = std::min(lmin[l], valid ? v : highest);
+                lmax[l] = std::max(lmax[l], valid ? v : lowest);
+                lcount[l] += valid;
+            }
+        }
+    } else {
+        for (; i + rangeLanes <= end; i += rangeLanes) {
+            for (size_t l = 0; l < rangeLanes; ++l) {
+                const T v = data[i + l];
+                lmin[l] = std::min(lmin[l], v);
+                lmax[l] = std::max(lmax[l], v);
+            }
+        }
+        count += i - begin;
+    }
+    for (; i < end; ++i) {
+        const T v = data[i];
+        if (ignoreZeros && std::abs(v) < epsilon) continue;
+        lmin[0] = std::min(lmin[0], v);
+        lmax[0] = std::max(lmax[0], v);
+        ++lcount[0];
+    }
+
+    for (size_t l = 0; l < rangeLanes; ++l) {
+        min = std::min(min, lmin[l]);
+        max = std::max(max, lmax[l]);
+        count += lcount[l];
+    }
+}
+}  // namespace detail
+
+/**
+ * Computes the ranges of several columns of count entries in a single parallel pass. The entries
+ * are split into chunks, each chunk is reduced for all columns before moving on, and the partial
+ * results are merged afterwards.
+ *
+ * If bins > 0 a histogram with that many bins over the range of each column is computed in a
+ * second pass.
+ */
+template <typename T>
+std::vector<ValueRange> reduceRanges(const std::vector<RangeColumn<T>>& columns, size_t count,
+                                     size_t bins = 0) {
+    const auto numColumns = columns.size();
+    const auto numChunks = std::max<size_t>(
+        1, std::min(count / 1024,
+                    4 * static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency()))));
+    const auto chunkSize = (count + numChunks - 1) / numChunks;
+
+    struct Partial {
+        T min = std::numeric_limits<T>::max();
+        T max = std::numeric_limits<T>::lowest();
+        size_t count = 0;
+    };
+    std::vector<Partial> partials(numChunks * numColumns);
+
+#pragma omp parallel for
+    for (long long chunk = 0; chunk < static_cast<long long>(numChunks); ++chunk) {
+        const size_t begin = std::min(count, static_cast<size_t>(chunk) * chunkSize);
+        const size_t end = std::min(count, begin + chunkSize);
+        for (size_t c = 0; c < numColumns; ++c) {
+            const auto& column = columns[c];
+            auto& partial = partials[chunk * numColumns + c];
+            detail::reduceRange(column.data, begin * column.components, end * column.components,
+                                column.ignoreZeros, partial.min, partial.max, partial.count);
+        }
+    }
+
+    std::vector<ValueRange> ranges(numColumns);
+    for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+        for (size_t c = 0; c < numColumns; ++c) {
+            const auto& partial = partials[chunk * numColumns + c];
+            if (partial.count == 0) continue;
+            ranges[c].range.x = std::min(ranges[c].range.x, static_cast<double>(partial.min));
+            ranges[c].range.y = std::max(ranges[c].range.y, static_cast<double>(partial.max));
+            ranges[c].count += partial.count;
+        }
+    }
+
+    if (bins == 0) return ranges;
+
+    std::vector<size_t> partialHistograms(numChunks * numColumns * bins, 0);
+
+#pragma omp parallel for
+    for (long long chunk = 0; chunk < static_cast<long long>(numChunks); ++chunk) {
+        const size_t begin = std::min(count, static_cast<size_t>(chunk) * chunkSize);
+        const size_t end = std::min(count, begin + chunkSize);
+        for (size_t c = 0; c < numColumns; ++c) {
+            const auto& column = columns[c];
+            const auto& range = ranges[c].range;
+            if (ranges[c].count == 0) continue;
+
+            auto histogram = partialHistograms.begin() + (chunk * numColumns + c) * bins;
+            const double scale =
+                range.y > range.x ? static_cast<double>(bins) / (range.y - range.x) : 0.0;
+            for (size_t i = begin * column.components; i < end * column.components; ++i) {
+                const T v = column.data[i];
+                if (column.ignoreZeros && std::abs(v) < std::numeric_limits<T>::epsilon()) {
+                    continue;
+                }
+                const auto bin = static_cast<size_t>((static_cast<double>(v) - range.x) * scale);
+                ++histogram[std::min(bin, bins - 1)];
+            }
+        }
+    }
+
+    for (size_t c = 0; c < numColumns; ++c) {
+        ranges[c].histogram.assign(bins, 0);
+        for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+            auto histogram = partialHistograms.begin() + (chunk * numColumns + c) * bins;
+            for (size_t b = 0; b < bins; ++b) ranges[c].histogram[b] += histogram[b];
+        }
+    }
+
+    return ranges;
+}
+
+}  // namespace tensorutil
+}  // namespace inviwo
@@ -0,0 +1,113 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/dataframe/datastructures/column.h>
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace inviwo {
+namespace tensorutil {
+
+/**
+ * Statistics of one component of a DataFrame column, see computeStatistics(). Non-finite values
+ * are not taken into account.
+ */
+struct IVW_MODULE_TENSORVISBASE_API ColumnStatistics {
+    /**
+     * Header of the column, with the component appended for vector columns, e.g. "Major Eigen
+     * Vector.x"
+     */
+    std::string name;
+    size_t count = 0;
+    dvec2 range{std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest()};
+    double mean = 0.0;
+    double variance = 0.0;
+    double skewness = 0.0;
+    /**
+     * Excess kurtosis, 0 for a normal distribution
+     */
+    double kurtosis = 0.0;
+    /**
+     * Number of values per bin, the bins evenly divide range
+     */
+    std::vector<size_t> histogram;
+
+    /**
+     * Approximate quantile for probability p in [0,1], interpolated linearly within the bin of the
+     * histogram it falls into. The error is at most the width of one bin. NaN if count is zero.
+     */
+    double quantile(double p) const;
+};
+
+/**
+ * Computes range, moments and a histogram of every component of every column of the DataFrame,
+ * except the index column, in parallel. Every chunk of rows is processed for all columns before
+ * moving on. A first pass finds the ranges, a second pass accumulates the moments, shifted by the
+ * center of the range for accuracy, together with the histograms.
+ */
+IVW_MODULE_TENSORVISBASE_API std::vector<ColumnStatistics> computeStatistics(
+    const DataFrame& dataFrame, size_t bins = 256);
+
+/**
+ * Same as above for the given columns, columns with other than the given number of rows are
+ * skipped.
+ */
+IVW_MODULE_TENSORVISBASE_API std::vector<ColumnStatistics> computeStatistics(
+    const std::vector<std::shared_ptr<const Column>>& columns, size_t rows, size_t bins = 256);
+
+/**
+ * Default probabilities of the quantiles in statisticsToDataFrame()
+ */
+IVW_MODULE_TENSORVISBASE_API const std::vector<double>& defaultQuantiles();
+
+/**
+ * One row per statistics with the columns Column, Count, Min, Max, Mean, Standard Deviation,
+ * Skewness, Kurtosis and one column per quantile, named after the percentage, e.g. "P50".
+ */
+IVW_MODULE_TENSORVISBASE_API std::shared_ptr<DataFrame> statisticsToDataFrame(
+    const std::vector<ColumnStatistics>& statistics,
+    const std::vector<double>& quantiles = defaultQuantiles());
+
+/**
+ * The histograms in long format, one row per bin with the columns Column, Bin Start, Bin End and
+ * Count.
+ */
+IVW_MODULE_TENSORVISBASE_API std::shared_ptr<DataFrame> histogramsToDataFrame(
+    const std::vector<ColumnStatistics>& statistics);
+
+}  // namespace tensorutil
+}  // namespace inviwo
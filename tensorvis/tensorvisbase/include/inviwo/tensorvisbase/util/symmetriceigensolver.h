@@ -0,0 +1,305 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/util/glm.h>
+
+#include <array>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace inviwo {
+namespace tensorutil {
+namespace detail {
+/**
+ * Relative eigenvalue gap below which the analytic eigenvectors are considered unreliable and the
+ * Jacobi fallback is used instead.
+ */
+template <typename T>
+constexpr T eigenGapTolerance() {
+    return std::is_same_v<T, float> ? T(1e-3) : T(1e-7);
+}
+
+/**
+ * Sorts the eigen pairs in descending order of the eigenvalues, i.e. l0 >= l1 >= l2.
+ */
+template <typename T>
+void sortEigenPairs(T (&values)[3], T (&vectors)[3][3]) {
+    const auto swapPairs = [&](int a, int b) {
+        std::swap(values[a], values[b]);
+        for (int i = 0; i < 3; ++i) std::swap(vectors[a][i], vectors[b][i]);
+    };
+    if (values[0] < values[1]) swapPairs(0, 1);
+    if (values[1] < values[2]) swapPairs(1, 2);
+    if (values[0] < values[1]) swapPairs(0, 1);
+}
+
+/**
+ * Closed-form eigenvalues of the symmetric matrix given by its six unique components (Smith's
+ * trigonometric solution of the characteristic polynomial). The values are sorted descending.
+ */
+template <typename T>
+void symmetricEigenValues(T a00, T a11, T a22, T a01, T a02, T a12, T (&values)[3]) {
+    const T p1 = a01 * a01 + a02 * a02 + a12 * a12;
+    const T q = (a00 + a11 + a22) / T(3);
+
+    if (p1 == T(0)) {
+        values[0] = std::max({a00, a11, a22});
+        values[2] = std::min({a00, a11, a22});
+        values[1] = a00 + a11 + a22 - values[0] - values[2];
+        return;
+    }
+
+    const T b00 = a00 - q;
+    const T b11 = a11 - q;
+    const T b22 = a22 - q;
+    const T p2 = b00 * b00 + b11 * b11 + b22 * b22 + T(2) * p1;
+    const T p = std::sqrt(p2 / T(6));
+
+    // det(B) / 2 with B = (A - qI) / p
+    const T det = b00 * (b11 * b22 - a12 * a12) - a01 * (a01 * b22 - a12 * a02) +
+                  a02 * (a01 * a12 - b11 * a02);
+    const T r = std::clamp(det / (T(2) * p * p * p), T(-1), T(1));
+
+    const T phi = std::acos(r) / T(3);
+    constexpr T twoThirdsPi = T(2.0943951023931954923);
+
+    values[0] = q + T(2) * p * std::cos(phi);
+    values[2] = q + T(2) * p * std::cos(phi + twoThirdsPi);
+    values[1] = T(3) * q - values[0] - values[2];
+}
+
+/**
+ * Eigenvector for the eigenvalue lambda, taken as the largest cross product of two rows of
+ * (A - lambda I). Returns false if all cross products degenerate, i.e. lambda is not simple.
+ */
+template <typename T>
+bool symmetricEigenVector(T a00, T a11, T a22, T a01, T a02, T a12, T lambda, T scale,
+                          T (&vector)[3]) {
+    const T r0[3] = {a00 - lambda, a01, a02};
+    const T r1[3] = {a01, a11 - lambda, a12};
+    const T r2[3] = {a02, a12, a22 - lambda};
+
+    const auto cross = [](const T(&a)[3], const T(&b)[3], T(&c)[3]) {
+        c[0] = a[1] * b[2] - a[2] * b[1];
+        c[1] = a[2] * b[0] - a[0] * b[2];
+        c[2] = a[0] * b[1] - a[1] * b[0];
+    };
+    const auto length2 = [](const T(&a)[3]) { return a[0] * a[0] + a[1] * a[1] + a[2] * a[2]; };
+
+    T c[3][3];
+    cross(r0, r1, c[0]);
+    cross(r0, r2, c[1]);
+    cross(r1, r2, c[2]);
+
+    const T l[3] = {length2(c[0]), length2(c[1]), length2(c[2])};
+    const int best = l[0] >= l[1] ? (l[0] >= l[2] ? 0 : 2) : (l[1] >= l[2] ? 1 : 2);
+
+    const T s2 = scale * scale;
+    if (!(l[best] > std::numeric_limits<T>::epsilon() * s2 * s2)) {
+        return false;
+    }
+
+    const T invLength = T(1) / std::sqrt(l[best]);
+    for (int i = 0; i < 3; ++i) vector[i] = c[best][i] * invLength;
+    return true;
+}
+
+/**
+ * Cyclic Jacobi eigenvalue iteration for a symmetric 3x3 matrix. Robust for repeated eigenvalues
+ * and used as fallback for the closed-form path. vectors[i] is the eigenvector to values[i].
+ */
+template <typename T>
+void jacobiEigenSystem(T a00, T a11, T a22, T a01, T a02, T a12, T (&values)[3],
+                       T (&vectors)[3][3]) {
+    T a[3][3] = {{a00, a01, a02}, {a01, a11, a12}, {a02, a12, a22}};
+    T v[3][3] = {{T(1), T(0), T(0)}, {T(0), T(1), T(0)}, {T(0), T(0), T(1)}};
+
+    for (int sweep = 0; sweep < 32; ++sweep) {
+        const T offDiagonal = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+        const T diagonal = a[0][0] * a[0][0] + a[1][1] * a[1][1] + a[2][2] * a[2][2];
+        if (offDiagonal <= std::numeric_limits<T>::epsilon() *
+                               std::numeric_limits<T>::epsilon() * diagonal) {
+            break;
+        }
+
+        for (int p = 0; p < 2; ++p) {
+            for (int q = p + 1; q < 3; ++q) {
+                if (a[p][q] == T(0)) continue;
+
+                const T theta = (a[q][q] - a[p][p]) / (T(2) * a[p][q]);
+                const T t = std::copysign(T(1), theta) /
+                            (std::abs(theta) + std::sqrt(theta * theta + T(1)));
+                const T c = T(1) / std::sqrt(t * t + T(1));
+                const T s = t * c;
+
+                for (int k = 0; k < 3; ++k) {
+                    const T akp = a[k][p];
+                    const T akq = a[k][q];
+                    a[k][p] = c * akp - s * akq;
+                    a[k][q] = s * akp + c * akq;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    const T apk = a[p][k];
+                    const T aqk = a[q][k];
+                    a[p][k] = c * apk - s * aqk;
+                    a[q][k] = s * apk + c * aqk;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    const T vkp = v[k][p];
+                    const T vkq = v[k][q];
+                    v[k][p] = c * vkp - s * vkq;
+                    v[k][q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        values[i] = a[i][i];
+        for (int k = 0; k < 3; ++k) vectors[i][k] = v[k][i];
+    }
+    sortEigenPairs(values, vectors);
+}
+
+/**
+ * Full eigen decomposition of the symmetric matrix given by its six unique components. The
+ * eigenvalues are computed in closed form, the eigenvectors of the two outer eigenvalues via
+ * cross products and the middle one as their cross product. Nearly repeated eigenvalues fall back
+ * to Jacobi iterations. Results are sorted descending, the zero matrix yields zero vectors.
+ */
+template <typename T>
+void symmetricEigenSystem(T a00, T a11, T a22, T a01, T a02, T a12, T (&values)[3],
+                          T (&vectors)[3][3]) {
+    const T scale = std::max({std::abs(a00), std::abs(a11), std::abs(a22), std::abs(a01),
+                              std::abs(a02), std::abs(a12)});
+
+    if (scale == T(0)) {
+        for (int i = 0; i < 3; ++i) {
+            values[i] = T(0);
+            for (int k = 0; k < 3; ++k) vectors[i][k] = T(0);
+        }
+        return;
+    }
+
+    // Normalize to avoid over- and underflow in the cubic terms
+    const T inv = T(1) / scale;
+    a00 *= inv;
+    a11 *= inv;
+    a22 *= inv;
+    a01 *= inv;
+    a02 *= inv;
+    a12 *= inv;
+
+    symmetricEigenValues(a00, a11, a22, a01, a02, a12, values);
+
+    const T gap = std::min(values[0] - values[1], values[1] - values[2]);
+    const T range = std::max(std::abs(values[0]), std::abs(values[2]));
+
+    if (gap > eigenGapTolerance<T>() * range &&
+        symmetricEigenVector(a00, a11, a22, a01, a02, a12, values[0], T(1), vectors[0]) &&
+        symmetricEigenVector(a00, a11, a22, a01, a02, a12, values[2], T(1), vectors[2])) {
+        vectors[1][0] = vectors[2][1] * vectors[0][2] - vectors[2][2] * vectors[0][1];
+        vectors[1][1] = vectors[2][2] * vectors[0][0] - vectors[2][0] * vectors[0][2];
+        vectors[1][2] = vectors[2][0] * vectors[0][1] - vectors[2][1] * vectors[0][0];
+    } else {
+        jacobiEigenSystem(a00, a11, a22, a01, a02, a12, values, vectors);
+    }
+
+    for (int i = 0; i < 3; ++i) values[i] *= scale;
+}
+}  // namespace detail
+
+/**
+ * Returns true if the tensor is symmetric up to a tolerance relative to its largest component.
+ */
+template <typename T>
+bool isSymmetric(const glm::mat<3, 3, T>& tensor,
+                 T relativeTolerance = std::numeric_limits<T>::epsilon() * T(16)) {
+    T scale{0};
+    for (glm::length_t i = 0; i < 3; ++i) {
+        for (glm::length_t j = 0; j < 3; ++j) {
+            scale = std::max(scale, std::abs(tensor[i][j]));
+        }
+    }
+    const T tolerance = relativeTolerance * scale;
+    return std::abs(tensor[0][1] - tensor[1][0]) <= tolerance &&
+           std::abs(tensor[0][2] - tensor[2][0]) <= tolerance &&
+           std::abs(tensor[1][2] - tensor[2][1]) <= tolerance;
+}
+
+/**
+ * Eigen decomposition of a symmetric 3x3 tensor using the closed-form solver with Jacobi
+ * fallback. Eigen pairs are sorted in descending order of the eigenvalues, as returned by
+ * calculateEigenValuesAndEigenVectors. Only the upper triangle of the tensor is read. The
+ * calculation is carried out in double precision regardless of T.
+ */
+template <typename T>
+std::array<std::pair<T, glm::vec<3, T>>, 3> symmetricEigenSystem(const glm::mat<3, 3, T>& tensor) {
+    double values[3];
+    double vectors[3][3];
+    // glm is column major, tensor[col][row]
+    detail::symmetricEigenSystem<double>(tensor[0][0], tensor[1][1], tensor[2][2], tensor[1][0],
+                                         tensor[2][0], tensor[2][1], values, vectors);
+
+    std::array<std::pair<T, glm::vec<3, T>>, 3> result;
+    for (int i = 0; i < 3; ++i) {
+        result[i] = {T(values[i]), glm::vec<3, T>(vectors[i][0], vectors[i][1], vectors[i][2])};
+    }
+    return result;
+}
+
+/**
+ * Batched eigen decomposition of 3x3 tensors into the six eigen columns used as default meta data
+ * (see attributes.h). Tensors are processed in blocks of structure-of-arrays lanes so that the
+ * closed-form eigenvalue part vectorizes, blocks are distributed over OpenMP threads if available.
+ * Non-symmetric tensors are handed to the general Eigen solver, keeping the previous behavior.
+ * All output pointers must hold at least count elements.
+ */
+IVW_MODULE_TENSORVISBASE_API void symmetricEigenSystems(
+    const mat3* tensors, size_t count, float* majorEigenValues, float* intermediateEigenValues,
+    float* minorEigenValues, vec3* majorEigenVectors, vec3* intermediateEigenVectors,
+    vec3* minorEigenVectors);
+
+/**
+ * Overload for packed symmetric tensors (xx, xy, xz, yy, yz, zz), see TensorStorage.
+ */
+IVW_MODULE_TENSORVISBASE_API void symmetricEigenSystems(
+    const std::array<float, 6>* tensors, size_t count, float* majorEigenValues,
+    float* intermediateEigenValues, float* minorEigenValues, vec3* majorEigenVectors,
+    vec3* intermediateEigenVectors, vec3* minorEigenVectors);
+
+}  // namespace tensorutil
+}  // namespace inviwo
@@ -54,22 +54,50 @@ IVW_MODULE_TENSORVISBASE_API void bindTensorFieldAsColorTexture(std::shared_ptr<
                                                                 Shader &shader,
                                                                 TextureUnitContainer &textureUnits);
 
+/**
+ * Binds the column volumes of the tensor field, see TensorField3D::getVolumeRepresentation(), as
+ * tensorFieldCol1-3. The volumes are cached by the field and returned in volumes.
+ */
 IVW_MODULE_TENSORVISBASE_API void bindTensorFieldAsVolume(
-    std::array<std::shared_ptr<Volume>, 3> volumes,
+    std::array<std::shared_ptr<const Volume>, 3> &volumes,
     std::shared_ptr<const TensorField3D> &tensorField, Shader &shader,
     TextureUnitContainer &textureUnits);
 
+/**
+ * Resamples the tensor field to the new dimensions, keeping its basis and offset. The output is
+ * computed in parallel, tile by tile. Interpolation weights are precomputed per axis.
+ *
+ * @param progress called with the fraction of tiles done, from the calling thread
+ * @param cancelled polled between batches of tiles, resampling stops and returns nullptr once it
+ * returns true
+ */
 std::shared_ptr<TensorField2D> IVW_MODULE_TENSORVISBASE_API
 subsample2D(std::shared_ptr<const TensorField2D> tensorField, size2_t newDimensions,
             const InterpolationMethod method = InterpolationMethod::Barycentric);
 
+std::shared_ptr<TensorField2D> IVW_MODULE_TENSORVISBASE_API subsample2D(
+    std::shared_ptr<const TensorField2D> tensorField, size2_t newDimensions,
+    const InterpolationMethod method, std::function<void(float)> progress,
+    std::function<bool()> cancelled = nullptr);
+
 IVW_MODULE_TENSORVISBASE_API std::shared_ptr<TensorField3D> subsample3D(
     std::shared_ptr<const TensorField3D> tensorField, size3_t newDimensions,
     const InterpolationMethod method = InterpolationMethod::Linear);
 
 IVW_MODULE_TENSORVISBASE_API std::shared_ptr<TensorField3D> subsample3D(
     std::shared_ptr<const TensorField3D> tensorField, size3_t newDimensions,
-    const InterpolationMethod method, std::function<void(float)> fun);
+    const InterpolationMethod method, std::function<void(float)> progress,
+    std::function<bool()> cancelled = nullptr);
+
+/**
+ * Returns the coarsest level of the pyramid of the tensor field with at least the given dimensions,
+ * or the field itself if it has no pyramid. See TensorField3D::buildPyramid().
+ */
+IVW_MODULE_TENSORVISBASE_API std::shared_ptr<const TensorField2D> selectLevel(
+    std::shared_ptr<const TensorField2D> tensorField, const size2_t &dimensions);
+
+IVW_MODULE_TENSORVISBASE_API std::shared_ptr<const TensorField3D> selectLevel(
+    std::shared_ptr<const TensorField3D> tensorField, const size3_t &dimensions);
 
 IVW_MODULE_TENSORVISBASE_API std::shared_ptr<PosTexColorMesh>
 generateBoundingBoxAdjacencyForTensorField(std::shared_ptr<const TensorField3D> tensorField,
@@ -37,7 +37,9 @@
 #include <modules/eigenutils/eigenutils.h>
 #include <modules/opengl/shader/shaderutils.h>
 #include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/tensorvisbase/util/symmetriceigensolver.h>
 #include <limits>
+#include <optional>
 
 namespace inviwo {
 namespace util {
@@ -65,6 +67,12 @@ T eigenvalue(const glm::mat<M, M, T> &tensor) {
             return T(0);
         }
 
+        if constexpr (M == 3) {
+            if (tensorutil::isSymmetric(tensor)) {
+                return tensorutil::symmetricEigenSystem(tensor)[N].first;
+            }
+        }
+
         Eigen::EigenSolver<Eigen::Matrix<T, M, M>> solver(util::glm2eigen(tensor));
 
         auto sortable = std::array<T, M>{};
@@ -92,6 +100,12 @@ glm::vec<M, T> eigenvector(const glm::mat<M, M, T> &tensor) {
             return vec_type(0);
         }
 
+        if constexpr (M == 3) {
+            if (tensorutil::isSymmetric(tensor)) {
+                return tensorutil::symmetricEigenSystem(tensor)[N].second;
+            }
+        }
+
         Eigen::EigenSolver<Eigen::Matrix<T, M, M>> solver(util::glm2eigen(tensor));
 
         std::vector<std::pair<T, vec_type>> sortable;
@@ -283,6 +297,41 @@ std::array<double, 3> IVW_MODULE_TENSORVISBASE_API calculateEigenValues(const dm
 
 dmat3 IVW_MODULE_TENSORVISBASE_API calculateEigenSystem(const dmat3 &tensor);
 
+/**
+ * Log-Euclidean mean exp(1/n sum log(T_i)) of the given tensors. Unlike the arithmetic mean, it
+ * preserves the geometric mean of the determinants, i.e. averaging does not swell the tensors.
+ * Returns nullopt if one of the tensors is not symmetric positive definite.
+ * See Arsigny et al., Log-Euclidean metrics for fast and simple calculus on diffusion tensors.
+ */
+template <typename T, glm::length_t M>
+std::optional<glm::mat<M, M, T>> logEuclideanMean(const glm::mat<M, M, T> *tensors,
+                                                  size_t count) {
+    using EigenMatrix = Eigen::Matrix<T, M, M>;
+
+    if (count == 0) return std::nullopt;
+
+    EigenMatrix sum = EigenMatrix::Zero();
+    for (size_t i = 0; i < count; ++i) {
+        const EigenMatrix tensor = util::glm2eigen(tensors[i]);
+        if (!tensor.isApprox(tensor.transpose(), std::numeric_limits<T>::epsilon() * T(16))) {
+            return std::nullopt;
+        }
+
+        Eigen::SelfAdjointEigenSolver<EigenMatrix> solver(tensor);
+        if (solver.info() != Eigen::Success || solver.eigenvalues().minCoeff() <= T(0)) {
+            return std::nullopt;
+        }
+        sum += solver.eigenvectors() * solver.eigenvalues().array().log().matrix().asDiagonal() *
+               solver.eigenvectors().transpose();
+    }
+
+    Eigen::SelfAdjointEigenSolver<EigenMatrix> solver(sum / static_cast<T>(count));
+    const EigenMatrix mean = solver.eigenvectors() *
+                             solver.eigenvalues().array().exp().matrix().asDiagonal() *
+                             solver.eigenvectors().transpose();
+    return util::eigen2glm<T, M, M>(mean);
+}
+
 static const std::string lamda_str{u8"λ"};
 
 static const std::string lamda1_str{u8"λ₁"};
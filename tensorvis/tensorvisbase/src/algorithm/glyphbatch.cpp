@@ -0,0 +1,194 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisbase/algorithm/glyphbatch.h>
+#include <inviwo/core/metadata/metadata.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+namespace inviwo {
+
+namespace tensorutil {
+
+const std::string GlyphBatch::glyphCountKey{"GlyphCount"};
+
+size_t GlyphBatch::glyphOfVertex(size_t vertex) const {
+    const auto it = std::upper_bound(vertexOffsets.begin(), vertexOffsets.end(), vertex);
+    return static_cast<size_t>(std::distance(vertexOffsets.begin(), it)) - 1;
+}
+
+std::shared_ptr<BasicMesh> GlyphBatch::extract(size_t glyph) const {
+    const auto firstVertex = vertexOffsets[glyph];
+    const auto numVertices = vertexOffsets[glyph + 1] - firstVertex;
+    const auto firstIndex = indexOffsets[glyph];
+    const auto numIndices = indexOffsets[glyph + 1] - firstIndex;
+
+    auto copyRange = [&](const auto* buffer, auto* dstBuffer) {
+        const auto& src = buffer->getRAMRepresentation()->getDataContainer();
+        auto& dst = dstBuffer->getEditableRAMRepresentation()->getDataContainer();
+        dst.assign(src.begin() + firstVertex, src.begin() + firstVertex + numVertices);
+    };
+
+    auto glyphMesh = std::make_shared<BasicMesh>();
+    copyRange(mesh->getVertices(), glyphMesh->getEditableVertices());
+    copyRange(mesh->getNormals(), glyphMesh->getEditableNormals());
+    copyRange(mesh->getColors(), glyphMesh->getEditableColors());
+    glyphMesh->getEditableTexCoords()->getEditableRAMRepresentation()->getDataContainer().resize(
+        numVertices, vec3(0.0f));
+
+    const auto& src = mesh->getIndices(0)->getRAMRepresentation()->getDataContainer();
+    auto& dst = glyphMesh->addIndexBuffer(DrawType::Triangles, ConnectivityType::None)
+                    ->getDataContainer();
+    dst.resize(numIndices);
+    std::transform(src.begin() + firstIndex, src.begin() + firstIndex + numIndices, dst.begin(),
+                   [base = static_cast<std::uint32_t>(firstVertex)](auto i) { return i - base; });
+
+    return glyphMesh;
+}
+
+GlyphBatch batchGlyphs(const std::vector<GlyphExtent>& extents,
+                       const std::function<void(size_t glyph, GlyphSlot& slot)>& write,
+                       const std::function<bool()>& cancelled) {
+    // Glyph numbers above 2^24 are rounded in the texture coordinates and picking breaks
+    if (extents.size() > GlyphBatch::maxGlyphs) {
+        throw Exception("Too many glyphs for a single mesh: " + std::to_string(extents.size()) +
+                            " (at most " + std::to_string(GlyphBatch::maxGlyphs) + ")",
+                        IVW_CONTEXT_CUSTOM("tensorutil::batchGlyphs"));
+    }
+
+    GlyphBatch batch;
+    batch.vertexOffsets.resize(extents.size() + 1, 0);
+    batch.indexOffsets.resize(extents.size() + 1, 0);
+    for (size_t i = 0; i < extents.size(); ++i) {
+        batch.vertexOffsets[i + 1] = batch.vertexOffsets[i] + extents[i].vertices;
+        batch.indexOffsets[i + 1] = batch.indexOffsets[i] + extents[i].indices;
+    }
+
+    const auto numVertices = batch.vertexOffsets.back();
+    if (numVertices > std::numeric_limits<std::uint32_t>::max()) {
+        throw Exception("Too many glyph vertices for a single mesh: " + std::to_string(numVertices),
+                        IVW_CONTEXT_CUSTOM("tensorutil::batchGlyphs"));
+    }
+
+    batch.mesh = std::make_shared<BasicMesh>();
+    auto& positions =
+        batch.mesh->getEditableVertices()->getEditableRAMRepresentation()->getDataContainer();
+    auto& normals =
+        batch.mesh->getEditableNormals()->getEditableRAMRepresentation()->getDataContainer();
+    auto& colors =
+        batch.mesh->getEditableColors()->getEditableRAMRepresentation()->getDataContainer();
+    auto& texCoords =
+        batch.mesh->getEditableTexCoords()->getEditableRAMRepresentation()->getDataContainer();
+    auto& indices = batch.mesh->addIndexBuffer(DrawType::Triangles, ConnectivityType::None)
+                        ->getDataContainer();
+
+    positions.resize(numVertices);
+    normals.resize(numVertices);
+    colors.resize(numVertices);
+    texCoords.resize(numVertices);
+    indices.resize(batch.indexOffsets.back());
+
+    const auto numGlyphs = static_cast<long long>(extents.size());
+    std::atomic<bool> stopped{false};
+
+#pragma omp parallel for
+    for (long long i = 0; i < numGlyphs; ++i) {
+        if (stopped) continue;
+        if (cancelled && cancelled()) {
+            stopped = true;
+            continue;
+        }
+
+        const auto glyph = static_cast<size_t>(i);
+        const auto firstVertex = batch.vertexOffsets[glyph];
+        const auto firstIndex = batch.indexOffsets[glyph];
+
+        GlyphSlot slot{positions.data() + firstVertex, normals.data() + firstVertex,
+                       colors.data() + firstVertex, indices.data() + firstIndex, extents[glyph]};
+        write(glyph, slot);
+
+        const auto base = static_cast<std::uint32_t>(firstVertex);
+        std::for_each(slot.indices, slot.indices + slot.extent.indices,
+                      [base](std::uint32_t& index) { index += base; });
+        std::fill_n(texCoords.data() + firstVertex, slot.extent.vertices,
+                    vec3(static_cast<float>(glyph), 0.0f, 0.0f));
+    }
+
+    if (stopped) return {};
+
+    batch.mesh->setMetaData<IntMetaData>(GlyphBatch::glyphCountKey,
+                                         static_cast<int>(extents.size()));
+
+    return batch;
+}
+
+GlyphExtent glyphExtent(const BasicMesh& glyph) {
+    GlyphExtent extent{glyph.getVertices()->getSize(), 0};
+    for (const auto& indexBuffer : glyph.getIndexBuffers()) {
+        extent.indices += indexBuffer.second->getSize();
+    }
+    return extent;
+}
+
+void writeGlyph(const BasicMesh& glyph, GlyphSlot& slot) {
+    const auto& positions = glyph.getVertices()->getRAMRepresentation()->getDataContainer();
+    const auto& normals = glyph.getNormals()->getRAMRepresentation()->getDataContainer();
+    const auto& colors = glyph.getColors()->getRAMRepresentation()->getDataContainer();
+
+    std::copy(positions.begin(), positions.end(), slot.positions);
+    std::copy(normals.begin(), normals.end(), slot.normals);
+    std::copy(colors.begin(), colors.end(), slot.colors);
+
+    auto dst = slot.indices;
+    for (const auto& indexBuffer : glyph.getIndexBuffers()) {
+        const auto& indices = indexBuffer.second->getRAMRepresentation()->getDataContainer();
+        dst = std::copy(indices.begin(), indices.end(), dst);
+    }
+
+    transformGlyph(glyph.getWorldMatrix() * glyph.getModelMatrix(), slot);
+}
+
+void transformGlyph(const mat4& dataToWorld, GlyphSlot& slot) {
+    const mat3 normalMatrix = glm::transpose(glm::inverse(mat3(dataToWorld)));
+
+    std::transform(slot.positions, slot.positions + slot.extent.vertices, slot.positions,
+                   [&](const vec3& p) {
+                       const auto world = dataToWorld * vec4(p, 1.0f);
+                       return vec3(world) / world.w;
+                   });
+    std::transform(slot.normals, slot.normals + slot.extent.vertices, slot.normals,
+                   [&](const vec3& n) { return glm::normalize(normalMatrix * n); });
+}
+
+}  // namespace tensorutil
+
+}  // namespace inviwo
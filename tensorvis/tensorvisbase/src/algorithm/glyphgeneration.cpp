@@ -0,0 +1,103 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisbase/algorithm/glyphgeneration.h>
+#include <inviwo/tensorvisbase/algorithm/glyphbatch.h>
+#include <inviwo/tensorvisbase/properties/tensorglyphproperty.h>
+
+namespace inviwo {
+
+namespace tensorutil {
+
+std::optional<GeneratedGlyphs> generateGlyphs(std::shared_ptr<const TensorField3D> tensorField,
+                                              const TensorGlyphProperty& glyphParameters,
+                                              bool merged, const GlyphPlacementSettings& placement,
+                                              const GlyphLodSettings& lod,
+                                              const std::function<bool()>& cancelled) {
+    const std::function<bool()> isCancelled = [&cancelled]() { return cancelled && cancelled(); };
+
+    const auto glyphs = placeGlyphs(*tensorField, placement);
+    if (isCancelled()) return std::nullopt;
+    const auto levels = selectGlyphLevels(*tensorField, glyphs, glyphParameters.size(), lod);
+
+    GeneratedGlyphs result;
+    result.culled = levels.culled;
+    result.fullDetailTriangles = glyphs.size() * glyphParameters.glyphExtent().indices / 3;
+
+    for (size_t level = 0; level < levels.levels.size(); ++level) {
+        const auto& levelGlyphs = levels.levels[level];
+        const auto& sizes = levels.sizes[level];
+        if (levelGlyphs.empty()) continue;
+        if (isCancelled()) return std::nullopt;
+
+        // Held for the whole level, the template cache only keeps referenced templates
+        const auto glyphTemplate = glyphParameters.glyphTemplate(level);
+        const auto extent = glyphParameters.glyphExtent(*glyphTemplate);
+        result.triangles += levelGlyphs.size() * extent.indices / 3;
+
+        if (merged) {
+            // Glyphs of the same level share the same topology, so they are batched together
+            const std::vector<GlyphExtent> extents(levelGlyphs.size(), extent);
+            auto batch = batchGlyphs(
+                extents,
+                [&](size_t i, GlyphSlot& slot) {
+                    const auto glyph = levelGlyphs[i];
+                    glyphParameters.writeGlyph(tensorField, glyphs.indices[glyph],
+                                               glyphs.positions[glyph], sizes[i], *glyphTemplate,
+                                               slot);
+                },
+                isCancelled);
+            if (!batch.mesh) return std::nullopt;
+            result.meshes->push_back(batch.mesh);
+        } else {
+            auto& meshes = *result.meshes;
+            const auto first = meshes.size();
+            meshes.resize(first + levelGlyphs.size());
+            const auto color = glyphParameters.color();
+            const auto numGlyphs = static_cast<long long>(levelGlyphs.size());
+
+#pragma omp parallel for
+            for (long long i = 0; i < numGlyphs; ++i) {
+                if (isCancelled()) continue;
+                const auto glyph = levelGlyphs[static_cast<size_t>(i)];
+                meshes[first + static_cast<size_t>(i)] =
+                    glyphParameters.generateGlyph(tensorField, glyphs.indices[glyph],
+                                                  glyphs.positions[glyph], color,
+                                                  sizes[static_cast<size_t>(i)], *glyphTemplate);
+            }
+            if (isCancelled()) return std::nullopt;
+        }
+    }
+
+    return result;
+}
+
+}  // namespace tensorutil
+
+}  // namespace inviwo
@@ -0,0 +1,379 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisbase/algorithm/glyphplacement.h>
+#include <inviwo/tensorvisbase/datastructures/sparsetensorfield3d.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/util/constexprhash.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/indexmapper.h>
+#include <inviwo/dataframe/datastructures/column.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+
+namespace inviwo {
+
+namespace tensorutil {
+
+namespace {
+
+std::uint64_t splitMix64(std::uint64_t x) {
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+/**
+ * Uniform random number in [0, 1). It only depends on its arguments, so that random placements do
+ * not depend on the order in which cells or voxels are visited.
+ */
+double random(std::uint64_t seed, std::uint64_t key, std::uint64_t stream = 0) {
+    const auto bits = splitMix64(seed ^ splitMix64(key * 4 + stream));
+    return static_cast<double>(bits >> 11) / static_cast<double>(std::uint64_t{1} << 53);
+}
+
+class Placer {
+public:
+    explicit Placer(const TensorField3D& tensorField)
+        : tensorField_{tensorField}
+        , dimensions_{tensorField.getDimensions()}
+        , indexMapper_{dimensions_}
+        , spacing_{tensorField.getSpacing()}
+        , offset_{tensorField.getOffset()}
+        , mask_{tensorField.hasMask() ? &tensorField.getMask() : nullptr} {}
+
+    // Defined by the mask and a non-zero tensor
+    bool isCandidate(size_t index) const {
+        return (!mask_ || (*mask_)[index] != 0) && tensorField_.at(index) != mat3(0.0f);
+    }
+
+    // Adds a glyph at a position in index space
+    void add(size_t index, const vec3& position) {
+        result.indices.push_back(index);
+        result.positions.push_back(spacing_ * position + offset_);
+    }
+
+    void regular(size3_t stride) {
+        if (mask_) {
+            // For masked fields only the runs of defined voxels are visited
+            for (const auto& run : SparseTensorField3D::findRuns(*mask_)) {
+                for (size_t index = run.begin; index < run.begin + run.length; ++index) {
+                    const auto voxel = indexMapper_(index);
+                    if (voxel % stride == size3_t{0} && tensorField_.at(index) != mat3(0.0f)) {
+                        add(index, vec3(voxel));
+                    }
+                }
+            }
+            return;
+        }
+
+        for (size_t z = 0; z < dimensions_.z; z += stride.z) {
+            for (size_t y = 0; y < dimensions_.y; y += stride.y) {
+                for (size_t x = 0; x < dimensions_.x; x += stride.x) {
+                    const auto index = indexMapper_(size3_t{x, y, z});
+                    if (isCandidate(index)) add(index, vec3(size3_t{x, y, z}));
+                }
+            }
+        }
+    }
+
+    void jittered(size3_t stride, std::uint64_t seed) {
+        const auto cells = (dimensions_ + stride - size3_t{1}) / stride;
+        const util::IndexMapper3D cellMapper(cells);
+        const vec3 upper{dimensions_ - size3_t{1}};
+
+        for (size_t z = 0; z < cells.z; ++z) {
+            for (size_t y = 0; y < cells.y; ++y) {
+                for (size_t x = 0; x < cells.x; ++x) {
+                    const size3_t cell{x, y, z};
+                    const auto origin = cell * stride;
+                    const auto extent = glm::min(stride, dimensions_ - origin);
+                    const auto key = cellMapper(cell);
+
+                    // Voxel i covers [i - 0.5, i + 0.5) in index space
+                    vec3 position;
+                    for (glm::length_t i = 0; i < 3; ++i) {
+                        const auto u = random(seed, key, static_cast<std::uint64_t>(i));
+                        position[i] = static_cast<float>(static_cast<double>(origin[i]) - 0.5 +
+                                                         u * static_cast<double>(extent[i]));
+                    }
+
+                    const auto index = indexMapper_(
+                        size3_t{glm::clamp(glm::round(position), vec3{0.0f}, upper)});
+                    if (isCandidate(index)) add(index, position);
+                }
+            }
+        }
+    }
+
+    void poissonDisk(float radius, std::uint64_t seed) {
+        // Dart throwing over the defined voxels in a random order
+        std::vector<std::pair<std::uint64_t, size_t>> order;
+        for (size_t index = 0; index < tensorField_.getSize(); ++index) {
+            if (isCandidate(index)) order.emplace_back(splitMix64(seed ^ splitMix64(index)), index);
+        }
+        std::sort(order.begin(), order.end());
+
+        // Spatial hash with cells of the size of the radius, neighbors are within 3x3x3 cells
+        const auto r = std::max(radius, std::numeric_limits<float>::epsilon());
+        const auto r2 = r * r;
+        auto cellKey = [](const glm::i64vec3& cell) {
+            constexpr std::uint64_t mask = (std::uint64_t{1} << 21) - 1;
+            return (static_cast<std::uint64_t>(cell.x) & mask) |
+                   ((static_cast<std::uint64_t>(cell.y) & mask) << 21) |
+                   ((static_cast<std::uint64_t>(cell.z) & mask) << 42);
+        };
+        std::unordered_map<std::uint64_t, std::vector<vec3>> grid;
+
+        auto isFree = [&](const vec3& position, const glm::i64vec3& cell) {
+            for (std::int64_t dz = -1; dz <= 1; ++dz) {
+                for (std::int64_t dy = -1; dy <= 1; ++dy) {
+                    for (std::int64_t dx = -1; dx <= 1; ++dx) {
+                        const auto it = grid.find(cellKey(cell + glm::i64vec3{dx, dy, dz}));
+                        if (it == grid.end()) continue;
+                        for (const auto& other : it->second) {
+                            const auto d = position - other;
+                            if (glm::dot(d, d) < r2) return false;
+                        }
+                    }
+                }
+            }
+            return true;
+        };
+
+        std::vector<size_t> accepted;
+        for (const auto& item : order) {
+            const vec3 position{indexMapper_(item.second)};
+            const glm::i64vec3 cell{glm::floor(position / r)};
+            if (isFree(position, cell)) {
+                grid[cellKey(cell)].push_back(position);
+                accepted.push_back(item.second);
+            }
+        }
+
+        std::sort(accepted.begin(), accepted.end());
+        for (const auto index : accepted) add(index, vec3{indexMapper_(index)});
+    }
+
+    void importance(const Column& column, size_t count, std::uint64_t seed) {
+        const auto ram = column.getBuffer()->getRepresentation<BufferRAM>();
+
+        // Weighted sampling without replacement (Efraimidis and Spirakis): the voxels with the
+        // largest keys log(u) / w are drawn
+        std::vector<std::pair<double, size_t>> keys;
+        for (size_t index = 0; index < tensorField_.getSize(); ++index) {
+            if (!isCandidate(index)) continue;
+            const auto weight = ram->getAsDouble(index);
+            if (!(weight > 0.0) || !std::isfinite(weight)) continue;
+            keys.emplace_back(std::log(1.0 - random(seed, index)) / weight, index);
+        }
+
+        count = std::min(count, keys.size());
+        std::nth_element(keys.begin(), keys.begin() + count, keys.end(), std::greater<>());
+
+        std::vector<size_t> selected(count);
+        std::transform(keys.begin(), keys.begin() + count, selected.begin(),
+                       [](const auto& item) { return item.second; });
+        std::sort(selected.begin(), selected.end());
+        for (const auto index : selected) add(index, vec3{indexMapper_(index)});
+    }
+
+    GlyphPositions result;
+
+private:
+    const TensorField3D& tensorField_;
+    size3_t dimensions_;
+    util::IndexMapper3D indexMapper_;
+    vec3 spacing_;
+    vec3 offset_;
+    const std::vector<glm::uint8>* mask_;
+};
+
+/**
+ * The meta data column of the attribute, computed on the fly if the field neither has nor computes
+ * it on demand.
+ */
+template <typename Attribute>
+std::shared_ptr<const Column> attributeColumn(const TensorField3D& tensorField) {
+    if (auto metaData = tensorField.getMetaData<Attribute>()) return *metaData;
+    return tensorField.calculateAttributes({util::constexpr_hash(Attribute::identifier)}).front();
+}
+
+struct ScalarAttributeColumn {
+    template <typename T>
+    void operator()(const TensorField3D& tensorField, const std::string& name) {
+        if constexpr (std::is_base_of_v<attributes::ScalarBase, T>) {
+            if (!column && name == T::identifier) column = attributeColumn<T>(tensorField);
+        }
+    }
+
+    std::shared_ptr<const Column> column;
+};
+
+struct ScalarAttributeNames {
+    template <typename T>
+    void operator()(const DataFrame& metaData) {
+        if constexpr (std::is_base_of_v<attributes::ScalarBase, T>) {
+            const auto name = std::string(T::identifier);
+            if (!metaData.getColumn(name)) names.push_back(name);
+        }
+    }
+
+    std::vector<std::string> names;
+};
+
+/**
+ * Values of a scalar meta data attribute relative to its maximum over the whole field.
+ */
+template <typename Attribute>
+std::function<float(size_t)> relativeAttribute(const TensorField3D& tensorField) {
+    const auto column = attributeColumn<Attribute>(tensorField);
+    const auto& values =
+        std::dynamic_pointer_cast<const Buffer<typename Attribute::value_type>>(column->getBuffer())
+            ->getRAMRepresentation()
+            ->getDataContainer();
+    const auto maxValue = values.empty() ? 0.0f : *std::max_element(values.begin(), values.end());
+    return [column, &values, maxValue](size_t index) {
+        return maxValue > 0.0f ? values[index] / maxValue : 0.0f;
+    };
+}
+
+}  // namespace
+
+GlyphPositions placeGlyphs(const TensorField3D& tensorField,
+                           const GlyphPlacementSettings& settings) {
+    const auto stride = glm::max(settings.stride, size3_t{1});
+
+    Placer placer{tensorField};
+    switch (settings.placement) {
+        case GlyphPlacement::Regular:
+            placer.regular(stride);
+            break;
+        case GlyphPlacement::Jittered:
+            placer.jittered(stride, settings.seed);
+            break;
+        case GlyphPlacement::PoissonDisk:
+            placer.poissonDisk(settings.radius, settings.seed);
+            break;
+        case GlyphPlacement::Importance: {
+            const auto column = settings.importance
+                                    ? settings.importance
+                                    : scalarAttribute(tensorField, settings.importanceAttribute);
+            if (!column || column->getSize() != tensorField.getSize() ||
+                column->getBuffer()->getDataFormat()->getComponents() != 1) {
+                throw Exception(
+                    "Importance sampling of glyphs needs a scalar column with one value per voxel",
+                    IVW_CONTEXT_CUSTOM("tensorutil::placeGlyphs"));
+            }
+            placer.importance(*column, settings.count, settings.seed);
+            break;
+        }
+    }
+    return std::move(placer.result);
+}
+
+std::vector<std::string> scalarAttributes(const TensorField3D& tensorField) {
+    std::vector<std::string> names;
+    const auto metaData = tensorField.metaData();
+    for (const auto& column : *metaData) {
+        if (column->getHeader() == "index" ||
+            column->getBuffer()->getDataFormat()->getComponents() != 1) {
+            continue;
+        }
+        names.push_back(column->getHeader());
+    }
+    const auto attributes =
+        util::for_each_type<attributes::types3D>{}(ScalarAttributeNames{}, *metaData).names;
+    names.insert(names.end(), attributes.begin(), attributes.end());
+    return names;
+}
+
+std::shared_ptr<const Column> scalarAttribute(const TensorField3D& tensorField,
+                                              const std::string& name) {
+    if (auto column = tensorField.metaData()->getColumn(name)) {
+        if (column->getBuffer()->getDataFormat()->getComponents() != 1) return nullptr;
+        return column;
+    }
+    return util::for_each_type<attributes::types3D>{}(ScalarAttributeColumn{}, tensorField, name)
+        .column;
+}
+
+GlyphLevels selectGlyphLevels(const TensorField3D& tensorField, const GlyphPositions& glyphs,
+                              float size, const GlyphLodSettings& settings) {
+    const auto numLevels = std::max(settings.levels, size_t{1});
+
+    // Lazy meta data is only computed when needed, the anisotropy needs the eigen system
+    std::function<float(size_t)> norm;
+    if (settings.scaleByNorm || settings.minNorm > 0.0f) {
+        norm = relativeAttribute<attributes::FrobeniusNorm>(tensorField);
+    }
+    std::function<float(size_t)> anisotropy;
+    if (settings.minAnisotropy > 0.0f) {
+        anisotropy = relativeAttribute<attributes::Anisotropy>(tensorField);
+    }
+
+    GlyphLevels result;
+    result.levels.resize(numLevels);
+    result.sizes.resize(numLevels);
+
+    for (size_t glyph = 0; glyph < glyphs.size(); ++glyph) {
+        const auto index = glyphs.indices[glyph];
+        const auto relativeNorm = norm ? norm(index) : 1.0f;
+        if ((settings.minNorm > 0.0f && relativeNorm < settings.minNorm) ||
+            (anisotropy && anisotropy(index) < settings.minAnisotropy)) {
+            ++result.culled;
+            continue;
+        }
+
+        const auto glyphSize = settings.scaleByNorm ? size * relativeNorm : size;
+        if (!(glyphSize > 0.0f)) {
+            ++result.culled;
+            continue;
+        }
+
+        size_t level = 0;
+        if (glyphSize < settings.detailSize) {
+            const auto halvings = std::floor(std::log2(settings.detailSize / glyphSize));
+            level = static_cast<size_t>(std::min(halvings, static_cast<float>(numLevels - 1)));
+        }
+        result.levels[level].push_back(glyph);
+        result.sizes[level].push_back(glyphSize);
+    }
+
+    return result;
+}
+
+}  // namespace tensorutil
+
+}  // namespace inviwo
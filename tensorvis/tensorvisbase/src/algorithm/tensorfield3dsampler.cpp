@@ -0,0 +1,220 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisbase/algorithm/tensorfield3dsampler.h>
+#include <inviwo/tensorvisbase/util/tensorutil.h>
+
+#include <algorithm>
+
+#include <glm/gtx/component_wise.hpp>
+
+namespace inviwo {
+
+namespace {
+constexpr size_t lanes = 8;
+// Below this many positions the thread start-up costs more than the sampling
+constexpr size_t parallelThreshold = 1024;
+
+dmat3 toMat3(const mat3& tensor) { return dmat3(tensor); }
+dmat3 toMat3(const TensorField3D::packedN& tensor) {
+    return dmat3(TensorField3D::unpack(tensor));
+}
+
+const float* components(const mat3& tensor) { return glm::value_ptr(tensor); }
+const float* components(const TensorField3D::packedN& tensor) { return tensor.data(); }
+
+/**
+ * Weighted sums of the corner tensors of count lanes, component by component. Works on full and
+ * packed tensors alike, the latter are unpacked once per sample.
+ */
+template <typename Tensor>
+void accumulate(const std::vector<Tensor>& data, const size_t* base,
+                const std::array<size_t, 8>& corners, const double (&weights)[8][lanes],
+                size_t count, dmat3* tensors) {
+    constexpr size_t numComponents = sizeof(Tensor) / sizeof(float);
+    static_assert(numComponents == 9 || numComponents == 6);
+
+    for (size_t l = 0; l < count; ++l) {
+        double sum[numComponents]{};
+        for (size_t c = 0; c < 8; ++c) {
+            const float* tensor = components(data[base[l] + corners[c]]);
+            const double weight = weights[c][l];
+            for (size_t k = 0; k < numComponents; ++k) sum[k] += weight * tensor[k];
+        }
+        if constexpr (numComponents == 9) {
+            tensors[l] = glm::make_mat3(sum);
+        } else {
+            // Same layout as TensorField::pack(), the upper triangle row by row
+            tensors[l] = dmat3(sum[0], sum[1], sum[2], sum[1], sum[3], sum[4], sum[2], sum[4],
+                               sum[5]);
+        }
+    }
+}
+
+}  // namespace
+
+TensorField3DSampler::TensorField3DSampler(std::shared_ptr<const TensorField3D> tensorField,
+                                           EigenVector eigenVector,
+                                           tensorutil::InterpolationMethod method,
+                                           CoordinateSpace space)
+    : SpatialSampler<3, 3, double>(*tensorField, space)
+    , tensorField_(tensorField)
+    , tensors_(tensorField->packedTensors() ? nullptr : tensorField->tensors())
+    , packedTensors_(tensorField->packedTensors())
+    , eigenVector_(eigenVector)
+    , method_(method)
+    , toDataSpace_(getCoordinateTransformer().getMatrix(space, CoordinateSpace::Data))
+    , bounds_(tensorField->getBounds<double>()) {
+
+    const auto dims = tensorField->getDimensions();
+    strides_ = size3_t(1, dims.x, dims.x * dims.y);
+
+    size3_t steps{0};
+    for (int i = 0; i < 3; ++i) {
+        maxLower_[i] = dims[i] > 1 ? dims[i] - 2 : 0;
+        steps[i] = dims[i] > 1 ? strides_[i] : 0;
+    }
+    for (size_t c = 0; c < 8; ++c) {
+        corners_[c] = (c & 1 ? steps.x : 0) + (c & 2 ? steps.y : 0) + (c & 4 ? steps.z : 0);
+    }
+}
+
+dmat3 TensorField3DSampler::sampleTensor(const dvec3& position) const {
+    return sampleTensorDataSpace(dvec3(toDataSpace_ * dvec4(position, 1.0)));
+}
+
+void TensorField3DSampler::sampleTensors(const std::vector<dvec3>& positions,
+                                         std::vector<dmat3>& tensors) const {
+    tensors.resize(positions.size());
+    sampleTensors(positions.data(), positions.size(), tensors.data());
+}
+
+std::vector<dmat3> TensorField3DSampler::sampleTensors(const std::vector<dvec3>& positions) const {
+    std::vector<dmat3> tensors;
+    sampleTensors(positions, tensors);
+    return tensors;
+}
+
+void TensorField3DSampler::sampleTensors(const dvec3* positions, size_t count,
+                                         dmat3* tensors) const {
+    const auto numBlocks = static_cast<long long>((count + lanes - 1) / lanes);
+    const bool transform = toDataSpace_ != dmat4(1.0);
+
+#pragma omp parallel for if (count > parallelThreshold)
+    for (long long block = 0; block < numBlocks; ++block) {
+        const size_t begin = static_cast<size_t>(block) * lanes;
+        const size_t n = std::min(lanes, count - begin);
+
+        if (transform) {
+            dvec3 local[lanes];
+            for (size_t l = 0; l < n; ++l) {
+                local[l] = dvec3(toDataSpace_ * dvec4(positions[begin + l], 1.0));
+            }
+            sampleBlockDataSpace(local, n, tensors + begin);
+        } else {
+            sampleBlockDataSpace(positions + begin, n, tensors + begin);
+        }
+    }
+}
+
+dvec3 TensorField3DSampler::sampleDataSpace(const dvec3& pos) const {
+    const auto eigenSystem =
+        tensorutil::calculateEigenValuesAndEigenVectors(sampleTensorDataSpace(pos));
+
+    switch (eigenVector_) {
+        case EigenVector::Major:
+            return eigenSystem[0].second;
+        case EigenVector::Intermediate:
+            return eigenSystem[1].second;
+        case EigenVector::Minor:
+        default:
+            return eigenSystem[2].second;
+    }
+}
+
+bool TensorField3DSampler::withinBoundsDataSpace(const dvec3& pos) const {
+    return glm::all(glm::greaterThanEqual(pos, dvec3(0.0))) &&
+           glm::all(glm::lessThanEqual(pos, dvec3(1.0)));
+}
+
+dmat3 TensorField3DSampler::sampleTensorDataSpace(const dvec3& pos) const {
+    dmat3 tensor;
+    sampleBlockDataSpace(&pos, 1, &tensor);
+    return tensor;
+}
+
+void TensorField3DSampler::sampleBlockDataSpace(const dvec3* positions, size_t count,
+                                                dmat3* tensors) const {
+    if (method_ == tensorutil::InterpolationMethod::Nearest) {
+        for (size_t l = 0; l < count; ++l) {
+            const auto index = glm::compAdd(
+                size3_t(glm::round(glm::clamp(positions[l], dvec3(0.0), dvec3(1.0)) * bounds_)) *
+                strides_);
+            tensors[l] = packedTensors_ ? toMat3((*packedTensors_)[index])
+                                        : toMat3((*tensors_)[index]);
+        }
+        return;
+    }
+
+    // Lower cell corners and local coordinates, structure-of-arrays. Padding lanes are zero.
+    size_t base[lanes]{};
+    double fx[lanes]{}, fy[lanes]{}, fz[lanes]{};
+    for (size_t l = 0; l < count; ++l) {
+        const auto p = glm::clamp(positions[l], dvec3(0.0), dvec3(1.0)) * bounds_;
+        const auto lower = glm::min(size3_t(p), maxLower_);
+        base[l] = glm::compAdd(lower * strides_);
+        fx[l] = p.x - static_cast<double>(lower.x);
+        fy[l] = p.y - static_cast<double>(lower.y);
+        fz[l] = p.z - static_cast<double>(lower.z);
+    }
+
+    // Trilinear weights, branch-free over the lanes
+    double weights[8][lanes];
+    for (size_t l = 0; l < lanes; ++l) {
+        const double x1 = fx[l], y1 = fy[l], z1 = fz[l];
+        const double x0 = 1.0 - x1, y0 = 1.0 - y1, z0 = 1.0 - z1;
+        weights[0][l] = x0 * y0 * z0;
+        weights[1][l] = x1 * y0 * z0;
+        weights[2][l] = x0 * y1 * z0;
+        weights[3][l] = x1 * y1 * z0;
+        weights[4][l] = x0 * y0 * z1;
+        weights[5][l] = x1 * y0 * z1;
+        weights[6][l] = x0 * y1 * z1;
+        weights[7][l] = x1 * y1 * z1;
+    }
+
+    // Gather the corner tensors and accumulate all components at once
+    if (packedTensors_) {
+        accumulate(*packedTensors_, base, corners_, weights, count, tensors);
+    } else {
+        accumulate(*tensors_, base, corners_, weights, count, tensors);
+    }
+}
+
+}  // namespace inviwo
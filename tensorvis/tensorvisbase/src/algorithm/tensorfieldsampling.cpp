@@ -117,53 +117,37 @@ dmat2 sample(std::shared_ptr<const TensorField2D> tensorField, const dvec2& posi
 std::pair<glm::uint8, dmat3> sample(std::shared_ptr<const TensorField3D> tensorField,
                                     const dvec3& position,
                                     const tensorutil::InterpolationMethod method) {
-    // Position is in texture space [0,1], translate to index space
-    const auto bounds = tensorField->getBounds<double>();
-    const auto indexPosition = position * bounds;
-
-    dmat3 val{0.0};
-
-    if (method == tensorutil::InterpolationMethod::Linear) {
-        const auto xm = glm::floor(indexPosition.x);
-        const auto ym = glm::floor(indexPosition.y);
-        const auto zm = glm::floor(indexPosition.z);
-
-        const auto xp = glm::ceil(indexPosition.x);
-        const auto yp = glm::ceil(indexPosition.y);
-        const auto zp = glm::ceil(indexPosition.z);
-
-        const auto xFrac = glm::fract(position.x * bounds.x);
-        const auto yFrac = glm::fract(position.y * bounds.y);
-        const auto zFrac = glm::fract(position.z * bounds.z);
-
-        // Upper layer
-        const auto& tensor010 = tensorField->at(size3_t(xm, yp, zm));
-        const auto& tensor011 = tensorField->at(size3_t(xm, yp, zp));
-        const auto tensorUpperLeft = glm::mix(tensor010, tensor011, zFrac);
-
-        const auto& tensor111 = tensorField->at(size3_t(xp, yp, zp));
-        const auto& tensor110 = tensorField->at(size3_t(xp, yp, zm));
-        const auto tensorUpperRight = glm::mix(tensor110, tensor111, zFrac);
-
-        const auto tensorUpper = glm::mix(tensorUpperLeft, tensorUpperRight, xFrac);
-
-        // Lower layer
-        const auto& tensor000 = tensorField->at(size3_t(xm, ym, zm));
-        const auto& tensor001 = tensorField->at(size3_t(xm, ym, zp));
-        const auto tensorLowerLeft = glm::mix(tensor000, tensor001, zFrac);
-
-        const auto& tensor100 = tensorField->at(size3_t(xp, ym, zm));
-        const auto& tensor101 = tensorField->at(size3_t(xp, ym, zp));
-        const auto tensorLowerRight = glm::mix(tensor100, tensor101, zFrac);
+    switch (method) {
+        case tensorutil::InterpolationMethod::Linear:
+            return detail::sample3D<tensorutil::InterpolationMethod::Linear>(*tensorField,
+                                                                            position);
+        case tensorutil::InterpolationMethod::Nearest:
+            return detail::sample3D<tensorutil::InterpolationMethod::Nearest>(*tensorField,
+                                                                             position);
+        default:
+            return detail::sample3D<tensorutil::InterpolationMethod::Barycentric>(*tensorField,
+                                                                                 position);
+    }
+}
 
-        const auto tensorLower = glm::mix(tensorLowerLeft, tensorLowerRight, xFrac);
+std::pair<glm::uint8, dmat3> sample(std::shared_ptr<const BrickedTensorField3D> tensorField,
+                                    const dvec3& position,
+                                    const tensorutil::InterpolationMethod method) {
+    auto accessor = tensorField->accessor();
+    return sample(accessor, position, method);
+}
 
-        val = glm::mix(tensorLower, tensorUpper, yFrac);
-    } else {
-        if (method == tensorutil::InterpolationMethod::Nearest) {
-            val = tensorField->at(size3_t(glm::round(indexPosition)));
-        }
+std::pair<glm::uint8, dmat3> sample(BrickedTensorField3D::Accessor& accessor,
+                                    const dvec3& position,
+                                    const tensorutil::InterpolationMethod method) {
+    switch (method) {
+        case tensorutil::InterpolationMethod::Linear:
+            return detail::sample3D<tensorutil::InterpolationMethod::Linear>(accessor, position);
+        case tensorutil::InterpolationMethod::Nearest:
+            return detail::sample3D<tensorutil::InterpolationMethod::Nearest>(accessor, position);
+        default:
+            return detail::sample3D<tensorutil::InterpolationMethod::Barycentric>(accessor,
+                                                                                 position);
     }
-    return std::pair<glm::uint8, dmat3>(glm::uint8{1}, dmat3());
 }
 }  // namespace inviwo
@@ -28,138 +28,110 @@
  *********************************************************************************/
 
 #include <inviwo/tensorvisbase/algorithm/tensorfieldslicing.h>
-#include <inviwo/core/util/indexmapper.h>
-#include <inviwo/tensorvisbase/util/tensorutil.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
 
 namespace inviwo {
-namespace detail {
-std::shared_ptr<TensorField2D> getSlice2D(std::shared_ptr<const TensorField3D> inTensorField,
-                                          const CartesianCoordinateAxis axis,
-                                          const size_t sliceNumber) {
-    auto fieldDimensions = inTensorField->getDimensions();
-    size2_t dimensions{0};
 
-    switch (axis) {
-        case CartesianCoordinateAxis::X:
-            dimensions = size2_t(fieldDimensions.y, fieldDimensions.z);
-            break;
-        case CartesianCoordinateAxis::Y:
-            dimensions = size2_t(fieldDimensions.x, fieldDimensions.z);
-            break;
-        case CartesianCoordinateAxis::Z:
-            dimensions = size2_t(fieldDimensions.x, fieldDimensions.y);
-            break;
+TensorField3DSliceView::TensorField3DSliceView(std::shared_ptr<const TensorField3D> tensorField,
+                                               const CartesianCoordinateAxis axis,
+                                               const size_t sliceNumber)
+    : tensorField_(tensorField), axis_(axis), sliceNumber_(sliceNumber) {
+    if (tensorField->storage() == TensorStorage::PackedSymmetric) {
+        packedTensors_ = tensorField->packedTensors();
+    } else {
+        tensors_ = tensorField->tensors();
     }
 
-    util::IndexMapper2D indexMapper(dimensions);
-
-    std::vector<TensorField2D::matN> sliceData;
-    sliceData.resize(dimensions.x * dimensions.y);
+    const auto fieldDimensions = tensorField->getDimensions();
+    const auto fieldStrides =
+        size3_t(1, fieldDimensions.x, fieldDimensions.x * fieldDimensions.y);
 
     switch (axis) {
         case CartesianCoordinateAxis::X:
-            for (size_t z = 0; z < dimensions.y; z++) {
-                for (size_t y = 0; y < dimensions.x; y++) {
-                    auto x = sliceNumber;
-                    sliceData[indexMapper(size2_t(y, z))] =
-                        tensorutil::getProjectedTensor(inTensorField->at(size3_t(x, y, z)), axis);
-                }
-            }
+            projection_ = size2_t(1, 2);
             break;
         case CartesianCoordinateAxis::Y:
-            for (size_t z = 0; z < dimensions.y; z++) {
-                for (size_t x = 0; x < dimensions.x; x++) {
-                    auto y = sliceNumber;
-                    sliceData[indexMapper(size2_t(x, z))] =
-                        tensorutil::getProjectedTensor(inTensorField->at(size3_t(x, y, z)), axis);
-                }
-            }
+            projection_ = size2_t(0, 2);
             break;
         case CartesianCoordinateAxis::Z:
-            for (size_t y = 0; y < dimensions.y; y++) {
-                for (size_t x = 0; x < dimensions.x; x++) {
-                    auto z = sliceNumber;
-                    sliceData[indexMapper(size2_t(x, y))] =
-                        tensorutil::getProjectedTensor(inTensorField->at(size3_t(x, y, z)), axis);
-                }
-            }
-            break;
         default:
-            IVW_ASSERT(false, "getSlice2D");
+            projection_ = size2_t(0, 1);
+            break;
     }
+    const auto normal = 3 - projection_.x - projection_.y;
 
-    auto tensorField = std::make_shared<TensorField2D>(dimensions, sliceData);
-    // tensorField->setOffset(inTensorField->getOffset());
+    if (sliceNumber >= fieldDimensions[normal]) {
+        throw Exception("Slice number " + std::to_string(sliceNumber) + " out of bounds",
+                        IVW_CONTEXT_CUSTOM("TensorField3DSliceView"));
+    }
 
-    return tensorField;
+    dimensions_ = size2_t(fieldDimensions[projection_.x], fieldDimensions[projection_.y]);
+    strides_ = size2_t(fieldStrides[projection_.x], fieldStrides[projection_.y]);
+    offset_ = sliceNumber * fieldStrides[normal];
 }
 
-std::shared_ptr<TensorField3D> getSlice3D(std::shared_ptr<const TensorField3D> inTensorField,
-                                          const CartesianCoordinateAxis axis,
-                                          const size_t sliceNumber) {
-    auto fieldDimensions = inTensorField->getDimensions();
-    size3_t dimensions{0};
-    float frac{0.0f};
-
-    auto stepSize = inTensorField->getSpacing<float>();
+std::shared_ptr<TensorField2D> TensorField3DSliceView::materialize2D() const {
+    std::vector<TensorField2D::matN> sliceData(getSize());
+    const auto rows = static_cast<long long>(dimensions_.y);
 
-    switch (axis) {
-        case CartesianCoordinateAxis::X:
-            dimensions = size3_t(1, fieldDimensions.y, fieldDimensions.z);
-            frac = static_cast<float>(sliceNumber) * stepSize.x;
-            break;
-        case CartesianCoordinateAxis::Y:
-            dimensions = size3_t(fieldDimensions.x, 1, fieldDimensions.z);
-            frac = static_cast<float>(sliceNumber) * stepSize.y;
-            break;
-        case CartesianCoordinateAxis::Z:
-            dimensions = size3_t(fieldDimensions.x, fieldDimensions.y, 1);
-            frac = static_cast<float>(sliceNumber) * stepSize.z;
-            break;
+#pragma omp parallel for
+    for (long long y = 0; y < rows; ++y) {
+        auto dst = sliceData.begin() + y * dimensions_.x;
+        for (size_t x = 0; x < dimensions_.x; ++x) {
+            dst[x] = projectedAt(size2_t(x, y));
+        }
     }
 
-    util::IndexMapper3D indexMapper(dimensions);
-
-    std::vector<mat3> sliceData{};
-    sliceData.resize(dimensions.x * dimensions.y * dimensions.z);
-    vec3 offset{0};
+    return std::make_shared<TensorField2D>(dimensions_, std::move(sliceData));
+}
 
-    switch (axis) {
-        case CartesianCoordinateAxis::X:
-            for (size_t z = 0; z < dimensions.z; z++) {
-                for (size_t y = 0; y < dimensions.y; y++) {
-                    auto x = sliceNumber;
-                    sliceData[indexMapper(size3_t(0, y, z))] = inTensorField->at(size3_t(x, y, z));
-                    offset.x = frac;
-                }
-            }
-            break;
-        case CartesianCoordinateAxis::Y:
-            for (size_t z = 0; z < dimensions.z; z++) {
-                for (size_t x = 0; x < dimensions.x; x++) {
-                    auto y = sliceNumber;
-                    sliceData[indexMapper(size3_t(x, 0, z))] = inTensorField->at(size3_t(x, y, z));
-                    offset.y = frac;
-                }
-            }
-            break;
-        case CartesianCoordinateAxis::Z:
-            for (size_t y = 0; y < dimensions.y; y++) {
-                for (size_t x = 0; x < dimensions.x; x++) {
-                    auto z = sliceNumber;
-                    sliceData[indexMapper(size3_t(x, y, 0))] = inTensorField->at(size3_t(x, y, z));
-                    offset.z = frac;
-                }
+std::shared_ptr<TensorField3D> TensorField3DSliceView::materialize3D() const {
+    size3_t dimensions{1};
+    dimensions[projection_.x] = dimensions_.x;
+    dimensions[projection_.y] = dimensions_.y;
+
+    std::vector<mat3> sliceData(getSize());
+    const auto rows = static_cast<long long>(dimensions_.y);
+
+#pragma omp parallel for
+    for (long long y = 0; y < rows; ++y) {
+        auto dst = sliceData.begin() + y * dimensions_.x;
+        const auto first = index(size2_t(0, y));
+        if (tensors_ && strides_.x == 1) {
+            // Rows of y and z slices are contiguous in the field
+            std::copy_n(tensors_->begin() + first, dimensions_.x, dst);
+        } else {
+            for (size_t x = 0; x < dimensions_.x; ++x) {
+                dst[x] = at(size2_t(x, y));
             }
-            break;
+        }
     }
 
-    auto tensorField = std::make_shared<TensorField3D>(dimensions, sliceData);
+    auto tensorField = std::make_shared<TensorField3D>(dimensions, std::move(sliceData));
+
+    const auto normal = 3 - projection_.x - projection_.y;
+    vec3 offset{0};
+    offset[normal] = static_cast<float>(sliceNumber_) * tensorField_->getSpacing<float>()[normal];
 
-    tensorField->setExtents(inTensorField->getExtents());
+    tensorField->setExtents(tensorField_->getExtents());
     tensorField->setOffset(offset);
 
     return tensorField;
 }
+
+namespace detail {
+std::shared_ptr<TensorField2D> getSlice2D(std::shared_ptr<const TensorField3D> inTensorField,
+                                          const CartesianCoordinateAxis axis,
+                                          const size_t sliceNumber) {
+    return TensorField3DSliceView(inTensorField, axis, sliceNumber).materialize2D();
+}
+
+std::shared_ptr<TensorField3D> getSlice3D(std::shared_ptr<const TensorField3D> inTensorField,
+                                          const CartesianCoordinateAxis axis,
+                                          const size_t sliceNumber) {
+    return TensorField3DSliceView(inTensorField, axis, sliceNumber).materialize3D();
+}
 }  // namespace detail
 }  // namespace inviwo
@@ -0,0 +1,188 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisbase/algorithm/tensorfieldsubset.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/stringconversion.h>
+#include <inviwo/dataframe/datastructures/column.h>
+
+#include <algorithm>
+#include <string_view>
+
+namespace inviwo {
+
+namespace {
+
+// Sub-box of a field, 2D fields are handled as fields of depth 1
+struct Box {
+    size3_t fieldDimensions;
+    size3_t origin;
+    size3_t dimensions;
+};
+
+template <unsigned int N>
+Box makeBox(const glm::vec<N, size_t>& fieldDimensions, const glm::vec<N, size_t>& origin,
+            const glm::vec<N, size_t>& dimensions, std::string_view context) {
+    Box box{size3_t{1}, size3_t{0}, size3_t{1}};
+    for (unsigned int i = 0; i < N; ++i) {
+        if (dimensions[i] == 0 || origin[i] + dimensions[i] > fieldDimensions[i]) {
+            throw Exception("Subset " + toString(origin) + " + " + toString(dimensions) +
+                                " does not fit into a field of dimensions " +
+                                toString(fieldDimensions),
+                            IVW_CONTEXT_CUSTOM(std::string(context)));
+        }
+        box.fieldDimensions[i] = fieldDimensions[i];
+        box.origin[i] = origin[i];
+        box.dimensions[i] = dimensions[i];
+    }
+    return box;
+}
+
+/**
+ * Copies the elements of the box from src, which holds one element per voxel of the field. Rows
+ * along x are contiguous in both, they are copied as a whole and distributed over threads.
+ */
+template <typename T>
+std::vector<T> copyBox(const T* src, const Box& box) {
+    const auto rowLength = box.dimensions.x;
+    const auto rows = static_cast<long long>(box.dimensions.y * box.dimensions.z);
+    const auto sliceSize = box.fieldDimensions.x * box.fieldDimensions.y;
+
+    std::vector<T> dst(rowLength * box.dimensions.y * box.dimensions.z);
+
+#pragma omp parallel for if (rows > 64)
+    for (long long row = 0; row < rows; ++row) {
+        const auto y = box.origin.y + static_cast<size_t>(row) % box.dimensions.y;
+        const auto z = box.origin.z + static_cast<size_t>(row) / box.dimensions.y;
+        const auto first = box.origin.x + y * box.fieldDimensions.x + z * sliceSize;
+        std::copy_n(src + first, rowLength, dst.begin() + row * rowLength);
+    }
+
+    return dst;
+}
+
+/**
+ * Copies every column holding one value per tensor of the field, other columns are dropped.
+ */
+std::shared_ptr<DataFrame> copyColumns(const DataFrame& metaData, size_t fieldSize,
+                                       const Box& box) {
+    auto result = std::make_shared<DataFrame>();
+    for (auto column : metaData) {
+        if (column->getHeader() == "index") continue;
+        const auto buffer = column->getBuffer();
+        if (buffer->getSize() != fieldSize) continue;
+
+        buffer->getRepresentation<BufferRAM>()->dispatch<void>([&](auto ram) {
+            using T = util::PrecisionValueType<decltype(ram)>;
+            result->addColumn(std::make_shared<TemplateColumn<T>>(
+                column->getHeader(), copyBox(ram->getDataContainer().data(), box)));
+        });
+    }
+    result->updateIndexBuffer();
+    return result;
+}
+
+template <typename Field>
+std::shared_ptr<Field> copySubset(const Field& tensorField, const Box& box) {
+    using sizeN_t = typename Field::sizeN_t;
+    using vecN = glm::vec<sizeN_t::length(), float>;
+    constexpr auto N = sizeN_t::length();
+
+    sizeN_t dimensions{0};
+    vecN origin{0.0f};
+    for (glm::length_t i = 0; i < N; ++i) {
+        dimensions[i] = box.dimensions[i];
+        origin[i] = static_cast<float>(box.origin[i]);
+    }
+
+    auto metaData = copyColumns(*tensorField.metaData(), tensorField.getSize(), box);
+    const auto policy = tensorField.metaDataPolicy();
+
+    std::shared_ptr<Field> result;
+    if (const auto packed = tensorField.packedTensors()) {
+        result = std::make_shared<Field>(
+            dimensions,
+            std::make_shared<std::vector<typename Field::packedN>>(copyBox(packed->data(), box)),
+            metaData, policy);
+    } else {
+        result = std::make_shared<Field>(dimensions, copyBox(tensorField.tensors()->data(), box),
+                                         metaData, policy);
+    }
+
+    if (tensorField.hasMask()) result->setMask(copyBox(tensorField.getMask().data(), box));
+
+    const auto spacing = tensorField.template getSpacing<float>();
+    result->setExtents(spacing * vecN(dimensions - sizeN_t{1}));
+    result->setOffset(tensorField.getOffset() + origin * spacing);
+
+    return result;
+}
+
+}  // namespace
+
+TensorField3DSubsetView::TensorField3DSubsetView(std::shared_ptr<const TensorField3D> tensorField,
+                                                 const size3_t& origin, const size3_t& dimensions)
+    : tensorField_(tensorField)
+    , mask_(tensorField->hasMask() ? tensorField->sharedMask() : nullptr)
+    , origin_(origin)
+    , dimensions_(dimensions) {
+    const auto fieldDimensions = tensorField->getDimensions();
+    makeBox<3>(fieldDimensions, origin, dimensions, "TensorField3DSubsetView");
+
+    if (tensorField->storage() == TensorStorage::PackedSymmetric) {
+        packedTensors_ = tensorField->packedTensors();
+    } else {
+        tensors_ = tensorField->tensors();
+    }
+
+    strides_ = size3_t(1, fieldDimensions.x, fieldDimensions.x * fieldDimensions.y);
+    offset_ = origin.x + origin.y * strides_.y + origin.z * strides_.z;
+}
+
+std::shared_ptr<TensorField3D> TensorField3DSubsetView::materialize() const {
+    return copySubset(*tensorField_, Box{tensorField_->getDimensions(), origin_, dimensions_});
+}
+
+namespace tensorutil {
+
+std::shared_ptr<TensorField2D> subset(std::shared_ptr<const TensorField2D> tensorField,
+                                      const size2_t& origin, const size2_t& dimensions) {
+    return copySubset(*tensorField, makeBox<2>(tensorField->getDimensions(), origin, dimensions,
+                                               "tensorutil::subset"));
+}
+
+std::shared_ptr<TensorField3D> subset(std::shared_ptr<const TensorField3D> tensorField,
+                                      const size3_t& origin, const size3_t& dimensions) {
+    return TensorField3DSubsetView(tensorField, origin, dimensions).materialize();
+}
+
+}  // namespace tensorutil
+
+}  // namespace inviwo
@@ -0,0 +1,390 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisbase/datastructures/brickedtensorfield3d.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/tensorvisbase/util/memorymappedfile.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <type_traits>
+#include <unordered_map>
+
+namespace inviwo {
+
+namespace {
+constexpr char magic[8] = {'T', 'F', 'B', 'R', 'I', 'C', 'K', 'S'};
+constexpr std::uint64_t version = 1;
+constexpr size_t alignment = 64;
+
+using matN = BrickedTensorField3D::matN;
+using packedN = TensorField3D::packedN;
+
+/**
+ * Layout of a brick file:
+ *   - FileHeader
+ *   - Bricks starting at dataOffset, numBricks.x * numBricks.y * numBricks.z bricks of
+ *     brickSize^3 tensors each in x-fastest order. Bricks at the upper boundary are padded to the
+ *     full brick size so that every brick is at a fixed offset. Tensors are stored as matN, or as
+ *     packedN for TensorStorage::PackedSymmetric.
+ */
+struct FileHeader {
+    char magic[8];
+    std::uint64_t version;
+    std::uint64_t dimensions[3];
+    std::uint64_t brickSize;
+    std::uint32_t storage;
+    std::uint32_t reserved;
+    float basis[9];
+    float offset[3];
+    std::uint64_t dataOffset;
+};
+static_assert(std::is_trivially_copyable_v<FileHeader>);
+
+size_t align(size_t offset) { return (offset + alignment - 1) / alignment * alignment; }
+
+size_t bytesPerTensor(TensorStorage storage) {
+    return storage == TensorStorage::PackedSymmetric ? sizeof(packedN) : sizeof(matN);
+}
+
+size3_t numberOfBricks(const size3_t& dimensions, size_t brickSize) {
+    return (dimensions + size3_t(brickSize - 1)) / size3_t(brickSize);
+}
+}  // namespace
+
+struct BrickedTensorField3D::Storage {
+    explicit Storage(const std::string& path) : file(path) {}
+
+    MemoryMappedFile file;
+    FileHeader header;
+    size_t bytesPerBrick;
+
+    std::mutex mutex;
+    size_t cacheSize;
+    // Most recently used brick first
+    std::list<size_t> lru;
+    std::unordered_map<size_t, std::pair<std::shared_ptr<const std::vector<matN>>,
+                                         std::list<size_t>::iterator>>
+        bricks;
+
+    void evict() {
+        while (bricks.size() > cacheSize && !lru.empty()) {
+            bricks.erase(lru.back());
+            lru.pop_back();
+        }
+    }
+};
+
+BrickedTensorField3D::BrickedTensorField3D(const std::string& path, size_t cacheSize)
+    : StructuredGridEntity<3>()
+    , storage_(std::make_shared<Storage>(path))
+    , indexMapper_(size3_t(0))
+    , brickMapper_(size3_t(0)) {
+    auto& header = storage_->header;
+    header = *storage_->file.at<FileHeader>(0);
+
+    if (!std::equal(std::begin(magic), std::end(magic), std::begin(header.magic))) {
+        throw FileException("No valid brick file: " + path, IVW_CONTEXT);
+    }
+    if (header.version != version) {
+        throw FileException("Unsupported brick file version " + std::to_string(header.version) +
+                                " in " + path,
+                            IVW_CONTEXT);
+    }
+    if (header.brickSize == 0 ||
+        (header.storage != static_cast<std::uint32_t>(TensorStorage::Full) &&
+         header.storage != static_cast<std::uint32_t>(TensorStorage::PackedSymmetric))) {
+        throw FileException("Invalid brick file header in " + path, IVW_CONTEXT);
+    }
+
+    dimensions_ = size3_t(header.dimensions[0], header.dimensions[1], header.dimensions[2]);
+    brickSize_ = static_cast<size_t>(header.brickSize);
+    numBricks_ = numberOfBricks(dimensions_, brickSize_);
+    indexMapper_ = util::IndexMapper3D(dimensions_);
+    brickMapper_ = util::IndexMapper3D(numBricks_);
+
+    storage_->cacheSize = std::max(cacheSize, size_t{1});
+    storage_->bytesPerBrick = brickSize_ * brickSize_ * brickSize_ * bytesPerTensor(storage());
+
+    // Validate the file size once, so that decoding the bricks does not have to
+    storage_->file.at<std::byte>(static_cast<size_t>(header.dataOffset),
+                                 glm::compMul(numBricks_) * storage_->bytesPerBrick);
+
+    mat3 basis;
+    std::memcpy(glm::value_ptr(basis), header.basis, sizeof(header.basis));
+    setBasis(basis);
+    setOffset(vec3(header.offset[0], header.offset[1], header.offset[2]));
+}
+
+BrickedTensorField3D* BrickedTensorField3D::clone() const {
+    return new BrickedTensorField3D(*this);
+}
+
+std::string BrickedTensorField3D::getDataInfo() const {
+    std::stringstream ss;
+    ss << "<table border='0' cellspacing='0' cellpadding='0' "
+          "style='border-color:white;white-space:pre;'>/n"
+       << tensorutil::getHTMLTableRowString("Type", "Bricked 3D tensor field")
+       << tensorutil::getHTMLTableRowString("Brick size", brickSize_)
+       << tensorutil::getHTMLTableRowString("Bricks", numBricks_)
+       << tensorutil::getHTMLTableRowString("Cached bricks", getCacheSize())
+       << tensorutil::getHTMLTableRowString(
+              "Storage", storage() == TensorStorage::Full ? "Full" : "Packed symmetric")
+       << tensorutil::getHTMLTableRowString("Dimensions", dimensions_)
+       << tensorutil::getHTMLTableRowString("Extends", getExtents()) << "</table>";
+    return ss.str();
+}
+
+size3_t BrickedTensorField3D::getDimensions() const { return dimensions_; }
+
+size_t BrickedTensorField3D::getSize() const { return glm::compMul(dimensions_); }
+
+TensorStorage BrickedTensorField3D::storage() const {
+    return static_cast<TensorStorage>(storage_->header.storage);
+}
+
+size_t BrickedTensorField3D::getBrickSize() const { return brickSize_; }
+
+size3_t BrickedTensorField3D::getNumberOfBricks() const { return numBricks_; }
+
+size_t BrickedTensorField3D::getCacheSize() const {
+    std::scoped_lock lock(storage_->mutex);
+    return storage_->cacheSize;
+}
+
+void BrickedTensorField3D::setCacheSize(size_t cacheSize) {
+    std::scoped_lock lock(storage_->mutex);
+    storage_->cacheSize = std::max(cacheSize, size_t{1});
+    storage_->evict();
+}
+
+BrickedTensorField3D::matN BrickedTensorField3D::at(const size3_t& position) const {
+    return accessor().at(position);
+}
+
+BrickedTensorField3D::matN BrickedTensorField3D::at(size_t index) const {
+    return at(indexMapper_(index));
+}
+
+BrickedTensorField3D::Brick BrickedTensorField3D::getBrick(const size3_t& brickIndex) const {
+    const auto origin = brickIndex * size3_t(brickSize_);
+    return Brick{brickIndex, origin, glm::min(size3_t(brickSize_), dimensions_ - origin),
+                 brickSize_, brickTensors(brickMapper_(brickIndex))};
+}
+
+void BrickedTensorField3D::forEachBrick(const std::function<void(const Brick&)>& func) const {
+    const auto numBricks = glm::compMul(numBricks_);
+#pragma omp parallel for
+    for (long long i = 0; i < static_cast<long long>(numBricks); ++i) {
+        func(getBrick(brickMapper_(static_cast<size_t>(i))));
+    }
+}
+
+std::shared_ptr<TensorField3D> BrickedTensorField3D::extract(const size3_t& min,
+                                                             const size3_t& max,
+                                                             MetaDataPolicy policy) const {
+    if (glm::any(glm::greaterThan(min, max)) ||
+        glm::any(glm::greaterThanEqual(max, dimensions_))) {
+        throw Exception("Region out of bounds", IVW_CONTEXT);
+    }
+
+    const auto dimensions = max - min + size3_t(1);
+    util::IndexMapper3D indexMapper(dimensions);
+    std::vector<matN> tensors(glm::compMul(dimensions));
+
+    // Visit the overlapping bricks one by one, so that each is decoded only once
+    const auto minBrick = min / size3_t(brickSize_);
+    const auto maxBrick = max / size3_t(brickSize_);
+    for (size_t bz = minBrick.z; bz <= maxBrick.z; ++bz) {
+        for (size_t by = minBrick.y; by <= maxBrick.y; ++by) {
+            for (size_t bx = minBrick.x; bx <= maxBrick.x; ++bx) {
+                const auto brick = getBrick(size3_t(bx, by, bz));
+                const auto lower = glm::max(min, brick.origin);
+                const auto upper = glm::min(max, brick.origin + brick.dimensions - size3_t(1));
+#pragma omp parallel for
+                for (long long z = lower.z; z <= static_cast<long long>(upper.z); ++z) {
+                    for (size_t y = lower.y; y <= upper.y; ++y) {
+                        for (size_t x = lower.x; x <= upper.x; ++x) {
+                            const size3_t position(x, y, z);
+                            tensors[indexMapper(position - min)] =
+                                brick.at(position - brick.origin);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    auto tensorField =
+        std::make_shared<TensorField3D>(dimensions, std::move(tensors), nullptr, policy);
+
+    const auto spacing = getSpacing();
+    tensorField->setBasis(getBasis());
+    tensorField->setExtents(spacing * vec3(glm::max(dimensions - size3_t(1), size3_t(1))));
+    tensorField->setOffset(getOffset() + vec3(min) * spacing);
+
+    return tensorField;
+}
+
+std::shared_ptr<const std::vector<BrickedTensorField3D::matN>> BrickedTensorField3D::brickTensors(
+    size_t brickIndex) const {
+    auto& cache = *storage_;
+    {
+        std::scoped_lock lock(cache.mutex);
+        auto it = cache.bricks.find(brickIndex);
+        if (it != cache.bricks.end()) {
+            cache.lru.splice(cache.lru.begin(), cache.lru, it->second.second);
+            return it->second.first;
+        }
+    }
+
+    // Decode outside of the lock, concurrent misses on different bricks do not block each other
+    const auto numTensors = brickSize_ * brickSize_ * brickSize_;
+    const auto source =
+        cache.file.data() + cache.header.dataOffset + brickIndex * cache.bytesPerBrick;
+    auto tensors = std::make_shared<std::vector<matN>>(numTensors);
+    if (storage() == TensorStorage::PackedSymmetric) {
+        for (size_t i = 0; i < numTensors; ++i) {
+            packedN packed;
+            std::memcpy(packed.data(), source + i * sizeof(packedN), sizeof(packedN));
+            (*tensors)[i] = TensorField3D::unpack(packed);
+        }
+    } else {
+        std::memcpy(tensors->data(), source, numTensors * sizeof(matN));
+    }
+
+    std::scoped_lock lock(cache.mutex);
+    auto it = cache.bricks.find(brickIndex);
+    if (it != cache.bricks.end()) {
+        // Another thread decoded the same brick in the meantime
+        cache.lru.splice(cache.lru.begin(), cache.lru, it->second.second);
+        return it->second.first;
+    }
+    cache.lru.push_front(brickIndex);
+    cache.bricks.emplace(brickIndex, std::make_pair(tensors, cache.lru.begin()));
+    cache.evict();
+    return tensors;
+}
+
+void BrickedTensorField3D::write(const std::string& path, const size3_t& dimensions,
+                                 const mat3& basis, const vec3& offset, TensorStorage storage,
+                                 const BrickSource& source, size_t brickSize) {
+    if (brickSize == 0) {
+        throw Exception("Brick size must be larger than zero",
+                        IVW_CONTEXT_CUSTOM("BrickedTensorField3D"));
+    }
+
+    std::ofstream outFile(path, std::ios::out | std::ios::binary);
+    if (!outFile) {
+        throw FileException("Could not open " + path + " for writing",
+                            IVW_CONTEXT_CUSTOM("BrickedTensorField3D"));
+    }
+
+    FileHeader header{};
+    std::copy(std::begin(magic), std::end(magic), std::begin(header.magic));
+    header.version = version;
+    for (glm::length_t i = 0; i < 3; ++i) {
+        header.dimensions[i] = dimensions[i];
+        header.offset[i] = offset[i];
+    }
+    header.brickSize = brickSize;
+    header.storage = static_cast<std::uint32_t>(storage);
+    std::memcpy(header.basis, glm::value_ptr(basis), sizeof(header.basis));
+    header.dataOffset = align(sizeof(FileHeader));
+
+    outFile.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+    const std::vector<char> padding(header.dataOffset - sizeof(FileHeader), 0);
+    outFile.write(padding.data(), padding.size());
+
+    const auto numBricks = numberOfBricks(dimensions, brickSize);
+    const auto numTensors = brickSize * brickSize * brickSize;
+    std::vector<matN> block(numTensors);
+    std::vector<matN> brick(numTensors);
+    std::vector<packedN> packed(storage == TensorStorage::PackedSymmetric ? numTensors : 0);
+
+    for (size_t bz = 0; bz < numBricks.z; ++bz) {
+        for (size_t by = 0; by < numBricks.y; ++by) {
+            for (size_t bx = 0; bx < numBricks.x; ++bx) {
+                const auto origin = size3_t(bx, by, bz) * size3_t(brickSize);
+                const auto blockDimensions = glm::min(size3_t(brickSize), dimensions - origin);
+                source(origin, blockDimensions, block.data());
+
+                // Scatter the densely packed block into the padded brick
+                std::fill(brick.begin(), brick.end(), matN(0.0f));
+                for (size_t z = 0; z < blockDimensions.z; ++z) {
+                    for (size_t y = 0; y < blockDimensions.y; ++y) {
+                        std::copy_n(block.begin() + blockDimensions.x * (y + blockDimensions.y * z),
+                                    blockDimensions.x,
+                                    brick.begin() + brickSize * (y + brickSize * z));
+                    }
+                }
+
+                if (storage == TensorStorage::PackedSymmetric) {
+                    std::transform(brick.begin(), brick.end(), packed.begin(),
+                                   [](const matN& tensor) { return TensorField3D::pack(tensor); });
+                    outFile.write(reinterpret_cast<const char*>(packed.data()),
+                                  packed.size() * sizeof(packedN));
+                } else {
+                    outFile.write(reinterpret_cast<const char*>(brick.data()),
+                                  brick.size() * sizeof(matN));
+                }
+            }
+        }
+    }
+
+    if (!outFile) {
+        throw FileException("Could not write " + path, IVW_CONTEXT_CUSTOM("BrickedTensorField3D"));
+    }
+}
+
+void BrickedTensorField3D::write(const std::string& path, const TensorField3D& tensorField,
+                                 size_t brickSize) {
+    const auto& indexMapper = tensorField.indexMapper();
+    const auto source = [&](const size3_t& origin, const size3_t& dimensions, matN* out) {
+#pragma omp parallel for
+        for (long long z = 0; z < static_cast<long long>(dimensions.z); ++z) {
+            for (size_t y = 0; y < dimensions.y; ++y) {
+                for (size_t x = 0; x < dimensions.x; ++x) {
+                    out[x + dimensions.x * (y + dimensions.y * z)] =
+                        tensorField.at(indexMapper(origin + size3_t(x, y, z)));
+                }
+            }
+        }
+    };
+
+    write(path, tensorField.getDimensions(), tensorField.getBasis(), tensorField.getOffset(),
+          tensorField.storage(), source, brickSize);
+}
+
+}  // namespace inviwo
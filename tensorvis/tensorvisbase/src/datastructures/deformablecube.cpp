@@ -30,61 +30,9 @@
 #include <inviwo/tensorvisbase/datastructures/deformablecube.h>
 
 namespace inviwo {
-DeformableCube::DeformableCube(const vec4& color) {
-    createCube(color);
-
-    calculateNormals();
-}
-
-void DeformableCube::createCube(const vec4& color) {
-    mesh_ = std::make_shared<BasicMesh>();
-
-    auto indexBuffer = mesh_->addIndexBuffer(DrawType::Triangles, ConnectivityType::None);
-    indexBuffer->getDataContainer().reserve(36);
-
-    const auto p000 = vec3(-0.5f, -0.5f, -0.5f);
-    const auto p001 = vec3(-0.5f, -0.5f, +0.5f);
-    const auto p010 = vec3(-0.5f, +0.5f, -0.5f);
-    const auto p011 = vec3(-0.5f, +0.5f, +0.5f);
-    const auto p100 = vec3(+0.5f, -0.5f, -0.5f);
-    const auto p101 = vec3(+0.5f, -0.5f, +0.5f);
-    const auto p110 = vec3(+0.5f, +0.5f, -0.5f);
-    const auto p111 = vec3(+0.5f, +0.5f, +0.5f);
-
-    const auto xNorm = vec3(1, 0, 0);
-    const auto yNorm = vec3(0, 1, 0);
-    const auto zNorm = vec3(0, 0, 1);
-
-    const auto pos00 = vec3(0, 0, 0);
-    const auto pos10 = vec3(1, 0, 0);
-    const auto pos11 = vec3(1, 1, 0);
-    // pos normal tex color
-
-    glm::uint32_t offset = 0;
-
-    auto addFace = [&](const vec3& v1, const vec3& v2, const vec3& v3, const vec3& v4,
-                       const vec3& normal) {
-        mesh_->addVertices({
-            {v1, normal, pos00, color},
-            {v2, normal, pos10, color},
-            {v3, normal, pos11, color},
-            {v4, normal, pos00, color},
-        });
-        indexBuffer->add({offset + 0, offset + 1, offset + 2, offset + 0, offset + 2, offset + 3});
-
-        faces_.emplace_back(offset + 0, offset + 1, offset + 2);
-        faces_.emplace_back(offset + 0, offset + 2, offset + 3);
-
-        offset += 4;
-    };
-
-    addFace(p000, p100, p110, p010, zNorm);
-    addFace(p100, p101, p111, p110, xNorm);
-    addFace(p010, p110, p111, p011, yNorm);
-    addFace(p001, p000, p010, p011, -xNorm);
-    addFace(p011, p111, p101, p001, -zNorm);
-    addFace(p001, p101, p100, p000, -yNorm);
-}
+DeformableCube::DeformableCube(const vec4& color)
+    : template_{GlyphTemplate::get(GlyphTemplate::Shape::Cube)}
+    , mesh_{template_->createMesh(color)} {}
 
 void DeformableCube::deform(const std::function<void(vec3& vertex)>& lambda,
                             const bool& normalize) {
@@ -153,34 +101,6 @@ void DeformableCube::calculateNormals() {
         mesh_->getEditableVertices()->getEditableRAMRepresentation()->getDataContainer();
     auto& normals = mesh_->getEditableNormals()->getEditableRAMRepresentation()->getDataContainer();
 
-    for (auto& normal : normals) {
-        normal = vec3(0.f);
-    }
-
-    for (const auto& face : faces_) {
-        auto v1 = vertices[face.x];
-        auto v2 = vertices[face.y];
-        auto v3 = vertices[face.z];
-
-        auto edge1 = v2 - v1;
-        auto edge2 = v3 - v1;
-
-        auto faceNormal = glm::cross(edge1, edge2);
-
-        normals[face.x] += faceNormal;
-        normals[face.y] += faceNormal;
-        normals[face.z] += faceNormal;
-    }
-
-    size_t i = 0;
-    for (auto& normal : normals) {
-        normal = glm::normalize(normal);
-        auto cosAlpha = glm::dot(normal, glm::normalize(vertices[i]));
-
-        if (cosAlpha < 0.f) {
-            normal = -normal;
-        }
-        i++;
-    }
+    template_->computeNormals(vertices.data(), normals.data());
 }
 }  // namespace inviwo
\ No newline at end of file
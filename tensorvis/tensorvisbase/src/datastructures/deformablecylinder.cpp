@@ -30,91 +30,9 @@
 #include <inviwo/tensorvisbase/datastructures/deformablecylinder.h>
 
 namespace inviwo {
-DeformableCylinder::DeformableCylinder(const size_t& numTheta, const vec4& color) {
-    createCylinder(numTheta, color);
-
-    calculateNormals();
-}
-
-void DeformableCylinder::createCylinder(const size_t& numTheta, const vec4& color) {
-    mesh_ = std::make_shared<BasicMesh>();
-
-    auto rotation_matrix = mat3(glm::rotate(mat4(1), static_cast<float>(M_PI / 2.), vec3(1, 0, 0)));
-
-    auto indexBuffer = mesh_->addIndexBuffer(DrawType::Triangles, ConnectivityType::None);
-
-    // 2 for the centers plus the first one on the ring with 2 normals respectively
-    glm::uint32_t num_indices = 0;
-
-    const auto frac = static_cast<float>((2. * M_PI) / static_cast<float>(numTheta));
-
-    const auto top_center = vec3(0.5f) - vec3(0.5f);
-    const auto bot_center = vec3(0.5f, -0.5f, 0.5f) - vec3(0.5f);
-    const auto top_start = vec3(0.5f, 0.5f, 1.0f) - vec3(0.5f);
-    const auto bot_start = vec3(0.5f, -0.5f, 1.0f) - vec3(0.5f);
-    const auto rot_vector = vec3(0.0f, 0.0f, 0.5f);
-
-    mesh_->addVertices({{rotation_matrix * top_center,
-                         glm::normalize(rotation_matrix * vec3(0, 1, 0)), vec3(), color},
-                        {rotation_matrix * bot_center,
-                         glm::normalize(rotation_matrix * vec3(0, -1, 0)), vec3(), color},
-                        {rotation_matrix * top_start,
-                         glm::normalize(rotation_matrix * vec3(0, 1, 0)), vec3(), color},
-                        {rotation_matrix * bot_start,
-                         glm::normalize(rotation_matrix * vec3(0, -1, 0)), vec3(), color},
-                        {rotation_matrix * top_start,
-                         glm::normalize(rotation_matrix * vec3(0, 0, 1)), vec3(), color},
-                        {rotation_matrix * bot_start,
-                         glm::normalize(rotation_matrix * vec3(0, 0, 1)), vec3(), color}});
-
-    num_indices += 6;
-
-    for (glm::uint32_t i = 1; i < numTheta; i++) {
-        const auto cur_vec = glm::rotateY(rot_vector, i * frac);
-
-        mesh_->addVertices({
-            {rotation_matrix * (top_center + cur_vec),
-             glm::normalize(rotation_matrix * vec3(0, 1, 0)), vec3(), color},  // 0  top y dir
-            {rotation_matrix * (bot_center + cur_vec),
-             glm::normalize(rotation_matrix * vec3(0, -1, 0)), vec3(), color},  // 1  bot y dir
-            {rotation_matrix * (top_center + cur_vec), glm::normalize(rotation_matrix * cur_vec),
-             vec3(), color},  // 2  top out dir
-            {rotation_matrix * (bot_center + cur_vec), glm::normalize(rotation_matrix * cur_vec),
-             vec3(), color}  // 3  bot out dir
-        });
-
-        num_indices += 4;
-
-        indexBuffer->add({0, num_indices - 4, num_indices - 4 - 4});
-        faces_.emplace_back(0, num_indices - 4, num_indices - 4 - 4);
-
-        indexBuffer->add({1, num_indices - 4 - 3, num_indices - 3});
-        faces_.emplace_back(1, num_indices - 4 - 3, num_indices - 3);
-
-        auto v1 = num_indices - 2;
-        auto v2 = num_indices - 2 - 4;
-        auto v3 = num_indices - 1;
-        auto v4 = num_indices - 1 - 4;
-
-        indexBuffer->add({v3, v2, v1});
-        faces_.emplace_back(v3, v2, v1);
-
-        indexBuffer->add({v3, v4, v2});
-        faces_.emplace_back(v3, v4, v2);
-    }
-
-    indexBuffer->add({0, 2, num_indices - 4});
-    faces_.emplace_back(0, 2, num_indices - 4);
-
-    indexBuffer->add({1, num_indices - 3, 3});
-    faces_.emplace_back(1, num_indices - 3, 3);
-
-    indexBuffer->add({5, num_indices - 2, 4});
-    faces_.emplace_back(5, num_indices - 2, 4);
-
-    indexBuffer->add({5, num_indices - 1, num_indices - 2});
-    faces_.emplace_back(5, num_indices - 1, num_indices - 2);
-}
+DeformableCylinder::DeformableCylinder(const size_t& numTheta, const vec4& color)
+    : template_{GlyphTemplate::get(GlyphTemplate::Shape::Cylinder, numTheta)}
+    , mesh_{template_->createMesh(color)} {}
 
 void DeformableCylinder::deform(const std::function<void(vec3& vertex)>& lambda,
                                 const bool& normalize) {
@@ -183,25 +101,6 @@ void DeformableCylinder::calculateNormals() {
         mesh_->getEditableVertices()->getEditableRAMRepresentation()->getDataContainer();
     auto& normals = mesh_->getEditableNormals()->getEditableRAMRepresentation()->getDataContainer();
 
-    for (auto& normal : normals) {
-        normal = vec3(0.f);
-    }
-
-    for (const auto& face : faces_) {
-        auto v1 = vertices[face.x];
-        auto v2 = vertices[face.y];
-        auto v3 = vertices[face.z];
-
-        auto edge1 = v2 - v1;
-        auto edge2 = v3 - v1;
-
-        auto faceNormal = glm::cross(edge1, edge2);
-
-        normals[face.x] += faceNormal;
-        normals[face.y] += faceNormal;
-        normals[face.z] += faceNormal;
-    }
-
-    for (auto& normal : normals) normal = -glm::normalize(normal);
+    template_->computeNormals(vertices.data(), normals.data());
 }
 }  // namespace inviwo
\ No newline at end of file
@@ -0,0 +1,317 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisbase/datastructures/glyphtemplate.h>
+
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace inviwo {
+
+std::shared_ptr<const GlyphTemplate> GlyphTemplate::get(Shape shape, size_t numTheta,
+                                                        size_t numPhi) {
+    if (shape == Shape::Cube) numTheta = 0;
+    if (shape != Shape::Sphere) numPhi = 0;
+    const auto key = std::make_tuple(shape, numTheta, numPhi);
+
+    static std::mutex mutex;
+    static std::map<std::tuple<Shape, size_t, size_t>, std::weak_ptr<const GlyphTemplate>> cache;
+
+    std::scoped_lock lock{mutex};
+    auto& entry = cache[key];
+    auto glyphTemplate = entry.lock();
+    if (!glyphTemplate) {
+        glyphTemplate = std::make_shared<const GlyphTemplate>(shape, numTheta, numPhi);
+        entry = glyphTemplate;
+    }
+    return glyphTemplate;
+}
+
+GlyphTemplate::GlyphTemplate(Shape shape, size_t numTheta, size_t numPhi) : shape_{shape} {
+    switch (shape) {
+        case Shape::Sphere:
+            createSphere(numTheta, numPhi);
+            break;
+        case Shape::Cube:
+            createCube();
+            break;
+        case Shape::Cylinder:
+            createCylinder(numTheta);
+            break;
+    }
+
+    normals_.resize(positions_.size());
+    computeNormals(positions_.data(), normals_.data());
+}
+
+void GlyphTemplate::computeNormals(const vec3* positions, vec3* normals) const {
+    const auto numVertices = positions_.size();
+    std::fill_n(normals, numVertices, vec3(0.0f));
+
+    for (size_t i = 0; i + 2 < indices_.size(); i += 3) {
+        const auto a = indices_[i];
+        const auto b = indices_[i + 1];
+        const auto c = indices_[i + 2];
+
+        const auto faceNormal =
+            glm::cross(positions[b] - positions[a], positions[c] - positions[a]);
+
+        normals[a] += faceNormal;
+        normals[b] += faceNormal;
+        normals[c] += faceNormal;
+    }
+
+    if (shape_ == Shape::Cylinder) {
+        std::transform(normals, normals + numVertices, normals,
+                       [](const vec3& normal) { return -glm::normalize(normal); });
+        return;
+    }
+
+    // Orient the normals away from the center
+    for (size_t i = 0; i < numVertices; ++i) {
+        normals[i] = glm::normalize(normals[i]);
+        if (glm::dot(normals[i], glm::normalize(positions[i])) < 0.0f) {
+            normals[i] = -normals[i];
+        }
+    }
+}
+
+std::shared_ptr<BasicMesh> GlyphTemplate::createMesh(const vec4& color) const {
+    auto mesh = std::make_shared<BasicMesh>();
+    mesh->getEditableVertices()->getEditableRAMRepresentation()->getDataContainer() = positions_;
+    mesh->getEditableNormals()->getEditableRAMRepresentation()->getDataContainer() = normals_;
+    mesh->getEditableTexCoords()->getEditableRAMRepresentation()->getDataContainer() = texCoords_;
+    mesh->getEditableColors()->getEditableRAMRepresentation()->getDataContainer().assign(
+        positions_.size(), color);
+    mesh->addIndexBuffer(DrawType::Triangles, ConnectivityType::None)->getDataContainer() =
+        indices_;
+    return mesh;
+}
+
+void GlyphTemplate::createSphere(size_t numTheta, size_t numPhi) {
+    auto nFaces = (numPhi - 3) * (numTheta - 1) * 2 + (numPhi - 3) * 2 + 2 * ((numTheta - 1) + 1);
+    indices_.reserve(nFaces * 3);
+
+    auto totalVertices = (numPhi - 1) * numTheta + 2;  // 2 extreme points
+    positions_.reserve(totalVertices);
+    texCoords_.reserve(totalVertices);
+
+    std::vector<uint32_t> addedIndices;
+    addedIndices.reserve(totalVertices);
+
+    auto calcVert = [](vec3& vertex, const float& cosphi, const float& sinphi,
+                       const float& costheta, const float& sintheta) -> auto {
+        auto sgnsinphi = int(glm::sign(sinphi));
+        auto sgncosphi = int(glm::sign(cosphi));
+        auto sgnsintheta = int(glm::sign(sintheta));
+        auto sgncostheta = int(glm::sign(costheta));
+
+        vertex.x = (sgncostheta * std::abs(costheta)) * (sgnsinphi * std::abs(sinphi));
+        vertex.y = (sgnsintheta * std::abs(sintheta)) * (sgnsinphi * std::abs(sinphi));
+        vertex.z = sgncosphi * std::abs(cosphi);
+    };
+    auto addVertex = [&](const vec3& vertex) -> auto {
+        positions_.emplace_back(vertex);
+        texCoords_.emplace_back(0.0f);
+        return static_cast<uint32_t>(positions_.size() - 1);
+    };
+    auto addTriangle = [&](uint32_t a, uint32_t b, uint32_t c) {
+        indices_.insert(indices_.end(), {a, b, c});
+    };
+
+    // Generate main geometry body
+    for (size_t j = 1; j < numPhi - 1; j++) {
+        for (size_t i = 0; i < numTheta; i++) {
+            auto theta = static_cast<float>(i) * 2.f * static_cast<float>(M_PI) /
+                         (static_cast<float>(numTheta));
+            auto phi = static_cast<float>(j) * static_cast<float>(M_PI) /
+                       (static_cast<float>(numPhi) - 1.f);
+
+            vec3 vertex;
+            calcVert(vertex, std::cos(phi), std::sin(phi), std::cos(theta), std::sin(theta));
+
+            addedIndices.emplace_back(addVertex(vertex));
+        }
+    }
+
+    vec3 vertex;
+    calcVert(vertex, 1.f, 0.f, 1.f, 0.f);
+    addedIndices.emplace_back(addVertex(vertex));
+
+    // Generate second extreme point
+    auto theta = (static_cast<float>(numTheta) - 1.f) * 2.f * static_cast<float>(M_PI) /
+                 (static_cast<float>(numTheta) - 1.f);
+    auto phi = (static_cast<float>(numPhi) - 1.f) * static_cast<float>(M_PI) /
+               (static_cast<float>(numPhi) - 1);
+    calcVert(vertex, std::cos(phi), std::sin(phi), std::cos(theta), std::sin(theta));
+    addedIndices.emplace_back(addVertex(vertex));
+
+    // Tesselate main geometry
+    // First, we create the triangles for the "sides"
+    for (size_t j = 0; j < numPhi - 3; j++) {
+        for (size_t i = 0; i < numTheta - 1; i++) {
+            auto firstItemInFirstRow = numTheta * j;
+            auto firstItemInSecondRow = numTheta * (j + 1);
+
+            addTriangle(addedIndices.at(firstItemInSecondRow + i),
+                        addedIndices.at(firstItemInFirstRow + 1 + i),
+                        addedIndices.at(firstItemInFirstRow + i));
+            addTriangle(addedIndices.at(firstItemInFirstRow + 1 + i),
+                        addedIndices.at(firstItemInSecondRow + i),
+                        addedIndices.at(firstItemInSecondRow + 1 + i));
+        }
+    }
+
+    for (size_t j = 0; j < numPhi - 3; j++) {
+        auto firstItemInFirstRow = j * numTheta;
+        auto firstItemInSecondRow = (j + 1) * numTheta;
+        auto lastItemInFirstRow = (j * numTheta) + (numTheta - 1);
+        auto lastItemInSecondRow = ((j + 1) * numTheta) + (numTheta - 1);
+
+        addTriangle(addedIndices.at(lastItemInSecondRow), addedIndices.at(firstItemInFirstRow),
+                    addedIndices.at(lastItemInFirstRow));
+        addTriangle(addedIndices.at(firstItemInFirstRow), addedIndices.at(lastItemInSecondRow),
+                    addedIndices.at(firstItemInSecondRow));
+    }
+
+    // Tesselate first extreme point
+    // Now, we need to create the triangles connected to the extreme points
+    auto extremePoint1 = addedIndices.at(addedIndices.size() - 2);
+    for (size_t i = 0; i < numTheta - 1; i++) {
+        addTriangle(extremePoint1, addedIndices.at(i), addedIndices.at(i + 1));
+    }
+    addTriangle(extremePoint1, addedIndices.at(numTheta - 1), addedIndices.at(0));
+
+    // Tesselate second extreme point
+    auto extremePoint2 = addedIndices.at(addedIndices.size() - 1);
+    for (size_t i = 0; i < numTheta - 1; i++) {
+        addTriangle(extremePoint2, addedIndices.at((i + 1) + numTheta * (numPhi - 3)),
+                    addedIndices.at(i + numTheta * (numPhi - 3)));
+    }
+    addTriangle(extremePoint2, addedIndices.at(numTheta * (numPhi - 2) - numTheta),
+                addedIndices.at(numTheta * (numPhi - 2) - 1));
+
+    // Spherical coordinates of the vertices, as used by the superquadric glyphs
+    sphericalTable_.reserve(positions_.size());
+    for (const auto& v : positions_) {
+        const auto phiCoord = glm::acos(v.z / glm::length(v));
+        const auto thetaCoord = std::atan2(v.y, v.x);
+        sphericalTable_.emplace_back(glm::sin(phiCoord), glm::cos(phiCoord),
+                                     glm::sin(thetaCoord), glm::cos(thetaCoord));
+    }
+}
+
+void GlyphTemplate::createCube() {
+    const auto p000 = vec3(-0.5f, -0.5f, -0.5f);
+    const auto p001 = vec3(-0.5f, -0.5f, +0.5f);
+    const auto p010 = vec3(-0.5f, +0.5f, -0.5f);
+    const auto p011 = vec3(-0.5f, +0.5f, +0.5f);
+    const auto p100 = vec3(+0.5f, -0.5f, -0.5f);
+    const auto p101 = vec3(+0.5f, -0.5f, +0.5f);
+    const auto p110 = vec3(+0.5f, +0.5f, -0.5f);
+    const auto p111 = vec3(+0.5f, +0.5f, +0.5f);
+
+    const auto pos00 = vec3(0, 0, 0);
+    const auto pos10 = vec3(1, 0, 0);
+    const auto pos11 = vec3(1, 1, 0);
+
+    auto addFace = [&](const vec3& v1, const vec3& v2, const vec3& v3, const vec3& v4) {
+        const auto offset = static_cast<std::uint32_t>(positions_.size());
+        positions_.insert(positions_.end(), {v1, v2, v3, v4});
+        texCoords_.insert(texCoords_.end(), {pos00, pos10, pos11, pos00});
+        indices_.insert(indices_.end(),
+                        {offset + 0, offset + 1, offset + 2, offset + 0, offset + 2, offset + 3});
+    };
+
+    addFace(p000, p100, p110, p010);
+    addFace(p100, p101, p111, p110);
+    addFace(p010, p110, p111, p011);
+    addFace(p001, p000, p010, p011);
+    addFace(p011, p111, p101, p001);
+    addFace(p001, p101, p100, p000);
+}
+
+void GlyphTemplate::createCylinder(size_t numTheta) {
+    auto rotation_matrix = mat3(glm::rotate(mat4(1), static_cast<float>(M_PI / 2.), vec3(1, 0, 0)));
+
+    const auto frac = static_cast<float>((2. * M_PI) / static_cast<float>(numTheta));
+
+    const auto top_center = vec3(0.5f) - vec3(0.5f);
+    const auto bot_center = vec3(0.5f, -0.5f, 0.5f) - vec3(0.5f);
+    const auto top_start = vec3(0.5f, 0.5f, 1.0f) - vec3(0.5f);
+    const auto bot_start = vec3(0.5f, -0.5f, 1.0f) - vec3(0.5f);
+    const auto rot_vector = vec3(0.0f, 0.0f, 0.5f);
+
+    auto addVertex = [&](const vec3& vertex) {
+        positions_.push_back(rotation_matrix * vertex);
+        texCoords_.emplace_back(0.0f);
+    };
+    auto addTriangle = [&](glm::uint32_t a, glm::uint32_t b, glm::uint32_t c) {
+        indices_.insert(indices_.end(), {a, b, c});
+    };
+
+    // 2 for the centers plus the first one on the ring with 2 normals respectively
+    addVertex(top_center);
+    addVertex(bot_center);
+    addVertex(top_start);
+    addVertex(bot_start);
+    addVertex(top_start);
+    addVertex(bot_start);
+
+    glm::uint32_t num_indices = 6;
+
+    for (glm::uint32_t i = 1; i < numTheta; i++) {
+        const auto cur_vec = glm::rotateY(rot_vector, i * frac);
+
+        addVertex(top_center + cur_vec);  // 0  top y dir
+        addVertex(bot_center + cur_vec);  // 1  bot y dir
+        addVertex(top_center + cur_vec);  // 2  top out dir
+        addVertex(bot_center + cur_vec);  // 3  bot out dir
+
+        num_indices += 4;
+
+        auto v1 = num_indices - 2;
+        auto v2 = num_indices - 2 - 4;
+        auto v3 = num_indices - 1;
+        auto v4 = num_indices - 1 - 4;
+
+        addTriangle(0, num_indices - 4, num_indices - 4 - 4);
+        addTriangle(1, num_indices - 4 - 3, num_indices - 3);
+        addTriangle(v3, v2, v1);
+        addTriangle(v3, v4, v2);
+    }
+
+    addTriangle(0, 2, num_indices - 4);
+    addTriangle(1, num_indices - 3, 3);
+    addTriangle(5, num_indices - 2, 4);
+    addTriangle(5, num_indices - 1, num_indices - 2);
+}
+
+}  // namespace inviwo
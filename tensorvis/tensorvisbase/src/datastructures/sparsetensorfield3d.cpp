@@ -0,0 +1,273 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisbase/datastructures/sparsetensorfield3d.h>
+#include <inviwo/tensorvisbase/util/symmetriceigensolver.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <sstream>
+
+namespace inviwo {
+
+namespace {
+using Run = SparseTensorField3D::Run;
+
+/**
+ * Copies the active voxels of dense into the compact array, run by run in parallel
+ */
+template <typename T>
+std::shared_ptr<std::vector<T>> gather(const std::vector<Run>& runs, size_t numActive,
+                                       const std::vector<T>& dense) {
+    auto compact = std::make_shared<std::vector<T>>(numActive);
+
+#pragma omp parallel for schedule(dynamic)
+    for (long long r = 0; r < static_cast<long long>(runs.size()); ++r) {
+        const auto& run = runs[r];
+        std::copy_n(dense.begin() + run.begin, run.length, compact->begin() + run.entry);
+    }
+    return compact;
+}
+
+/**
+ * Inverse of gather, voxels outside of the runs are set to value
+ */
+template <typename T>
+std::shared_ptr<std::vector<T>> scatter(const std::vector<Run>& runs, size_t size,
+                                        const std::vector<T>& compact, const T& value) {
+    auto dense = std::make_shared<std::vector<T>>(size, value);
+
+#pragma omp parallel for schedule(dynamic)
+    for (long long r = 0; r < static_cast<long long>(runs.size()); ++r) {
+        const auto& run = runs[r];
+        std::copy_n(compact.begin() + run.entry, run.length, dense->begin() + run.begin);
+    }
+    return dense;
+}
+}  // namespace
+
+SparseTensorField3D::SparseTensorField3D(const TensorField3D& tensorField, MetaDataPolicy policy)
+    : StructuredGridEntity<3>()
+    , dimensions_(tensorField.getDimensions())
+    , indexMapper_(dimensions_)
+    , numActive_(0)
+    , metaData_(std::make_shared<LazyMetaData>()) {
+    this->setBasis(tensorField.getBasis());
+    this->setOffset(tensorField.getOffset());
+
+    const auto size = tensorField.getSize();
+    const auto packed = tensorField.packedTensors();
+    const auto tensors = packed ? nullptr : tensorField.tensors();
+
+    std::vector<Run> runs;
+    if (tensorField.hasMask()) {
+        runs = findRuns(tensorField.getMask());
+    } else if (packed) {
+        runs = findRunsIf(size, [&](size_t i) { return (*packed)[i] != packedN{}; });
+    } else {
+        runs = findRunsIf(size, [&](size_t i) { return (*tensors)[i] != matN(0.0f); });
+    }
+    numActive_ = runs.empty() ? 0 : runs.back().entry + runs.back().length;
+
+    if (packed) {
+        packedTensors_ = gather(runs, numActive_, *packed);
+    } else {
+        tensors_ = gather(runs, numActive_, *tensors);
+    }
+    runs_ = std::make_shared<const std::vector<Run>>(std::move(runs));
+
+    if (policy == MetaDataPolicy::Eager) metaData();
+}
+
+SparseTensorField3D::SparseTensorField3D(const size3_t& dimensions, std::vector<Run> runs,
+                                         std::shared_ptr<const std::vector<matN>> tensors,
+                                         MetaDataPolicy policy)
+    : StructuredGridEntity<3>()
+    , dimensions_(dimensions)
+    , indexMapper_(dimensions_)
+    , numActive_(0)
+    , tensors_(std::move(tensors))
+    , metaData_(std::make_shared<LazyMetaData>()) {
+    setRuns(std::move(runs), tensors_ ? tensors_->size() : 0);
+    if (policy == MetaDataPolicy::Eager) metaData();
+}
+
+SparseTensorField3D::SparseTensorField3D(const size3_t& dimensions, std::vector<Run> runs,
+                                         std::shared_ptr<const std::vector<packedN>> tensors,
+                                         MetaDataPolicy policy)
+    : StructuredGridEntity<3>()
+    , dimensions_(dimensions)
+    , indexMapper_(dimensions_)
+    , numActive_(0)
+    , packedTensors_(std::move(tensors))
+    , metaData_(std::make_shared<LazyMetaData>()) {
+    setRuns(std::move(runs), packedTensors_ ? packedTensors_->size() : 0);
+    if (policy == MetaDataPolicy::Eager) metaData();
+}
+
+void SparseTensorField3D::setRuns(std::vector<Run> runs, size_t numTensors) {
+    if (!tensors_ && !packedTensors_) {
+        throw Exception("Sparse tensor field without tensors",
+                        IVW_CONTEXT_CUSTOM("SparseTensorField3D"));
+    }
+
+    size_t end = 0;
+    size_t entry = 0;
+    for (const auto& run : runs) {
+        if (run.length == 0 || run.begin < end || run.entry != entry ||
+            run.begin + run.length > getSize()) {
+            throw Exception("Invalid run [" + std::to_string(run.begin) + ", " +
+                                std::to_string(run.begin + run.length) + ") for a grid of " +
+                                std::to_string(getSize()) + " voxels",
+                            IVW_CONTEXT_CUSTOM("SparseTensorField3D"));
+        }
+        end = run.begin + run.length;
+        entry += run.length;
+    }
+    if (entry != numTensors) {
+        throw Exception(std::to_string(numTensors) + " tensors for " + std::to_string(entry) +
+                            " active voxels",
+                        IVW_CONTEXT_CUSTOM("SparseTensorField3D"));
+    }
+
+    numActive_ = entry;
+    runs_ = std::make_shared<const std::vector<Run>>(std::move(runs));
+}
+
+SparseTensorField3D* SparseTensorField3D::clone() const { return new SparseTensorField3D(*this); }
+
+std::string SparseTensorField3D::getDataInfo() const {
+    std::stringstream ss;
+    ss << "<table border='0' cellspacing='0' cellpadding='0' "
+          "style='border-color:white;white-space:pre;'>/n"
+       << tensorutil::getHTMLTableRowString("Type", "Sparse 3D tensor field")
+       << tensorutil::getHTMLTableRowString("Active tensors", numActive_)
+       << tensorutil::getHTMLTableRowString("Runs", runs_->size())
+       << tensorutil::getHTMLTableRowString(
+              "Storage", storage() == TensorStorage::Full ? "Full" : "Packed symmetric")
+       << tensorutil::getHTMLTableRowString("Dimensions", dimensions_)
+       << tensorutil::getHTMLTableRowString("Extends", getExtents()) << "</table>";
+    return ss.str();
+}
+
+std::optional<size_t> SparseTensorField3D::entry(size_t index) const {
+    const auto& runs = *runs_;
+    // First run starting after index, the candidate is the one before
+    auto it = std::upper_bound(runs.begin(), runs.end(), index,
+                               [](size_t i, const Run& run) { return i < run.begin; });
+    if (it == runs.begin()) return std::nullopt;
+    --it;
+    if (index >= it->begin + it->length) return std::nullopt;
+    return it->entry + (index - it->begin);
+}
+
+SparseTensorField3D::matN SparseTensorField3D::at(size_t index) const {
+    if (const auto e = entry(index)) return entryAt(*e);
+    return matN(0.0f);
+}
+
+std::shared_ptr<const DataFrame> SparseTensorField3D::metaData() const {
+    std::call_once(metaData_->once, [&]() { metaData_->dataFrame = computeMetaData(); });
+    return metaData_->dataFrame;
+}
+
+std::shared_ptr<const DataFrame> SparseTensorField3D::computeMetaData() const {
+    std::vector<float> majorEigenValues(numActive_);
+    std::vector<float> intermediateEigenValues(numActive_);
+    std::vector<float> minorEigenValues(numActive_);
+
+    std::vector<vec3> majorEigenVectors(numActive_);
+    std::vector<vec3> intermediateEigenVectors(numActive_);
+    std::vector<vec3> minorEigenVectors(numActive_);
+
+    if (packedTensors_) {
+        tensorutil::symmetricEigenSystems(
+            packedTensors_->data(), numActive_, majorEigenValues.data(),
+            intermediateEigenValues.data(), minorEigenValues.data(), majorEigenVectors.data(),
+            intermediateEigenVectors.data(), minorEigenVectors.data());
+    } else {
+        tensorutil::symmetricEigenSystems(
+            tensors_->data(), numActive_, majorEigenValues.data(), intermediateEigenValues.data(),
+            minorEigenValues.data(), majorEigenVectors.data(), intermediateEigenVectors.data(),
+            minorEigenVectors.data());
+    }
+
+    std::vector<glm::u64> voxels(numActive_);
+    forEachActive([&](size_t index, size_t entry) { voxels[entry] = index; });
+
+    auto dataFrame = std::make_shared<DataFrame>();
+    dataFrame->addColumn(
+        std::make_shared<TemplateColumn<glm::u64>>("Voxel", std::move(voxels)));
+
+    const auto add = [&](auto attribute, auto&& data) {
+        using A = decltype(attribute);
+        dataFrame->addColumn(std::make_shared<TemplateColumn<typename A::value_type>>(
+            std::string(A::identifier), std::move(data)));
+    };
+    add(attributes::MajorEigenValue{}, majorEigenValues);
+    add(attributes::IntermediateEigenValue{}, intermediateEigenValues);
+    add(attributes::MinorEigenValue{}, minorEigenValues);
+    add(attributes::MajorEigenVector3D{}, majorEigenVectors);
+    add(attributes::IntermediateEigenVector3D{}, intermediateEigenVectors);
+    add(attributes::MinorEigenVector3D{}, minorEigenVectors);
+
+    dataFrame->updateIndexBuffer();
+
+    return dataFrame;
+}
+
+std::shared_ptr<TensorField3D> SparseTensorField3D::toDense(MetaDataPolicy policy) const {
+    const auto& runs = *runs_;
+
+    std::shared_ptr<TensorField3D> tensorField;
+    if (packedTensors_) {
+        tensorField = std::make_shared<TensorField3D>(
+            dimensions_, scatter(runs, getSize(), *packedTensors_, packedN{}), nullptr, policy);
+    } else {
+        tensorField = std::make_shared<TensorField3D>(
+            dimensions_, scatter(runs, getSize(), *tensors_, matN(0.0f)), nullptr, policy);
+    }
+
+    std::vector<glm::uint8> mask(getSize(), 0);
+    for (const auto& run : runs) {
+        std::fill_n(mask.begin() + run.begin, run.length, glm::uint8{1});
+    }
+    tensorField->setMask(mask);
+    tensorField->setBasis(this->getBasis());
+    tensorField->setOffset(this->getOffset());
+
+    return tensorField;
+}
+
+std::vector<SparseTensorField3D::Run> SparseTensorField3D::findRuns(
+    const std::vector<glm::uint8>& mask) {
+    return findRunsIf(mask.size(), [&](size_t i) { return mask[i] != 0; });
+}
+
+}  // namespace inviwo
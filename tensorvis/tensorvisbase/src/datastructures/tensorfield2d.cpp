@@ -29,41 +29,72 @@
 
 #include <inviwo/tensorvisbase/datastructures/tensorfield2d.h>
 #include <inviwo/core/datastructures/image/imageram.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/tensorvisbase/util/rangereduction.h>
 
 namespace inviwo {
 TensorField2D::TensorField2D(const sizeN_t& dimensions, const std::vector<matN>& tensors,
-                             std::shared_ptr<DataFrame> metaData)
-    : TensorField<2, float>(dimensions, tensors, metaData) {
+                             std::shared_ptr<DataFrame> metaData, MetaDataPolicy policy)
+    : TensorField<2, float>(dimensions, tensors, metaData, policy) {
+    initializeDefaultMetaData();
+    computeDataMaps();
+}
+
+TensorField2D::TensorField2D(const sizeN_t& dimensions, std::vector<matN>&& tensors,
+                             std::shared_ptr<DataFrame> metaData, MetaDataPolicy policy)
+    : TensorField<2, float>(dimensions, std::move(tensors), metaData, policy) {
     initializeDefaultMetaData();
     computeDataMaps();
-    computeNormalizedScreenCoordinates();
 }
 
 TensorField2D::TensorField2D(const sizeN_t& dimensions, std::shared_ptr<std::vector<matN>> tensors,
-                             std::shared_ptr<DataFrame> metaData)
-    : TensorField<2, float>(dimensions, tensors, metaData) {
+                             std::shared_ptr<DataFrame> metaData, MetaDataPolicy policy)
+    : TensorField<2, float>(dimensions, std::move(tensors), metaData, policy) {
     initializeDefaultMetaData();
     computeDataMaps();
-    computeNormalizedScreenCoordinates();
 }
 
-TensorField2D::TensorField2D(const TensorField2D& tf)
-    : TensorField<2, float>(tf), normalizedImagePositions_(tf.normalizedImagePositions_) {
+TensorField2D::TensorField2D(const sizeN_t& dimensions,
+                             std::shared_ptr<std::vector<packedN>> tensors,
+                             std::shared_ptr<DataFrame> metaData, MetaDataPolicy policy)
+    : TensorField<2, float>(dimensions, tensors, metaData, policy) {
     initializeDefaultMetaData();
     computeDataMaps();
 }
 
+TensorField2D::TensorField2D(const TensorField2D& tf)
+    : TensorField<2, float>(tf) {
+    // The data maps are copied from tf, they only need to be recomputed if the eigen system had to
+    // be added to the meta data
+    const auto numColumns = metaData_->getNumberOfColumns();
+    initializeDefaultMetaData();
+    if (metaData_->getNumberOfColumns() != numColumns) computeDataMaps();
+}
+
 TensorField2D* TensorField2D::clone() const { return new TensorField2D(*this); }
 
 TensorField2D* TensorField2D::deepCopy() const {
     auto tf = new TensorField2D(*this);
 
-    tf->setTensors(std::make_shared<std::vector<matN>>(*tensors_));
+    if (packedTensors_) {
+        tf->setPackedTensors(std::make_shared<std::vector<packedN>>(*packedTensors_));
+    } else {
+        tf->setTensors(std::make_shared<std::vector<matN>>(*tensors_));
+    }
     tf->setMetaData(std::make_shared<DataFrame>(*metaData_));
 
     return tf;
 }
 
+void TensorField2D::buildPyramid(PyramidFilter filter) { createPyramid<TensorField2D>(filter); }
+
+std::shared_ptr<const TensorField2D> TensorField2D::getLevel(size_t level) const {
+    if (level == 0 || level >= getNumberOfLevels()) {
+        throw Exception("Invalid pyramid level " + std::to_string(level), IVW_CONTEXT);
+    }
+    return std::static_pointer_cast<const TensorField2D>(pyramid_->levels[level - 1]);
+}
+
 std::shared_ptr<Image> TensorField2D::getImageRepresentation() const {
     using layer_type = glm::vec<4, value_type>;
     auto dataFormat = new DataFormat<layer_type>();
@@ -80,15 +111,45 @@ std::shared_ptr<Image> TensorField2D::getImageRepresentation() const {
     return std::make_shared<Image>(layer);
 }
 
-const dvec2& TensorField2D::getNormalizedImagePosition(const size_t index) const {
-    return normalizedImagePositions_[index];
+dvec2 TensorField2D::getNormalizedImagePosition(const size_t index) const {
+    const auto pos = indexMapper_(index);
+    return dvec2(dimensions_.x < 2 ? 0.0 : pos.x / static_cast<double>(dimensions_.x - 1),
+                 dimensions_.y < 2 ? 0.0 : pos.y / static_cast<double>(dimensions_.y - 1));
+}
+
+void TensorField2D::normalizedImagePositions(const size_t first, const size_t count,
+                                             dvec2* positions) const {
+    const dvec2 step(dimensions_.x < 2 ? 0.0 : 1.0 / static_cast<double>(dimensions_.x - 1),
+                     dimensions_.y < 2 ? 0.0 : 1.0 / static_cast<double>(dimensions_.y - 1));
+
+    // Step through the rows instead of mapping every index
+    auto pos = indexMapper_(first);
+    for (size_t i = 0; i < count; ++i) {
+        positions[i] = dvec2(pos) * step;
+        if (++pos.x == dimensions_.x) {
+            pos.x = 0;
+            ++pos.y;
+        }
+    }
 }
 
-const std::vector<dvec2>& TensorField2D::normalizedImagePositions() const {
-    return normalizedImagePositions_;
+std::vector<dvec2> TensorField2D::normalizedImagePositions() const {
+    std::vector<dvec2> positions(size_);
+    const auto rows = static_cast<long long>(dimensions_.y);
+
+#pragma omp parallel for
+    for (long long y = 0; y < rows; ++y) {
+        const auto first = static_cast<size_t>(y) * dimensions_.x;
+        normalizedImagePositions(first, dimensions_.x, positions.data() + first);
+    }
+
+    return positions;
 }
 
 void TensorField2D::initializeDefaultMetaData() {
+    // Lazy fields compute the eigen system on first access
+    if (metaDataPolicy_ == MetaDataPolicy::Lazy) return;
+
     // clang-format off
     if (this->hasMetaData<attributes::MajorEigenValue>() &&
         this->hasMetaData<attributes::MinorEigenValue>() &&
@@ -98,7 +159,7 @@ void TensorField2D::initializeDefaultMetaData() {
     }
     // clang-format on
 
-    auto newMetaData = std::make_shared<DataFrame>(*metaData_);
+    auto newMetaData = editableMetaData();
 
     auto func = [](const matN& tensor) -> std::array<std::pair<value_type, vecN>, 2> {
         if (tensor == matN(0)) {
@@ -131,11 +192,9 @@ void TensorField2D::initializeDefaultMetaData() {
     majorEigenVectors.resize(size_);
     minorEigenVectors.resize(size_);
 
-    const auto& t_ref = *tensors_;
-
 #pragma omp parallel for
-    for (int i = 0; i < static_cast<int>(tensors_->size()); i++) {
-        auto tensor = t_ref[i];
+    for (int i = 0; i < static_cast<int>(size_); i++) {
+        const auto tensor = at(static_cast<size_t>(i));
         auto eigenValuesAndEigenVectors = func(tensor);
 
         majorEigenVectors[i] = eigenValuesAndEigenVectors[0].second;
@@ -156,58 +215,20 @@ void TensorField2D::initializeDefaultMetaData() {
 }
 
 void TensorField2D::computeDataMaps() {
-    const auto& majorEigenValues = this->majorEigenValues();
-    const auto& minorEigenValues = this->minorEigenValues();
-
-    dataMapEigenValues_[0].dataRange.x = dataMapEigenValues_[0].valueRange.x =
-        *std::min_element(majorEigenValues.begin(), majorEigenValues.end());
-    dataMapEigenValues_[0].dataRange.y = dataMapEigenValues_[0].valueRange.y =
-        *std::max_element(majorEigenValues.begin(), majorEigenValues.end());
-    dataMapEigenValues_[1].dataRange.x = dataMapEigenValues_[1].valueRange.x =
-        *std::min_element(minorEigenValues.begin(), minorEigenValues.end());
-    dataMapEigenValues_[1].dataRange.y = dataMapEigenValues_[1].valueRange.y =
-        *std::max_element(minorEigenValues.begin(), minorEigenValues.end());
-
-    auto min_f = [](const vecN& vec) -> value_type { return std::min(vec.x, vec.y); };
-    auto max_f = [](const vecN& vec) -> value_type { return std::max(vec.x, vec.y); };
-
-    auto min = std::numeric_limits<value_type>::max();
-    auto max = std::numeric_limits<value_type>::lowest();
-
-    for (const auto& v : this->majorEigenVectors()) {
-        min = std::min(min_f(v), min);
-        max = std::max(max_f(v), max);
-    }
-
-    dataMapEigenVectors_[0].dataRange.x = dataMapEigenVectors_[0].valueRange.x = min;
-    dataMapEigenVectors_[0].dataRange.y = dataMapEigenVectors_[0].valueRange.y = max;
-
-    min = std::numeric_limits<value_type>::max();
-    max = std::numeric_limits<value_type>::lowest();
-    for (const auto& v : this->minorEigenVectors()) {
-        min = std::min(min_f(v), min);
-        max = std::max(max_f(v), max);
-    }
-    dataMapEigenVectors_[1].dataRange.x = dataMapEigenVectors_[1].valueRange.x = min;
-    dataMapEigenVectors_[1].dataRange.y = dataMapEigenVectors_[1].valueRange.y = max;
-}
-
-void TensorField2D::computeNormalizedScreenCoordinates() {
-    normalizedImagePositions_.resize(size_);
-
-    auto xFrac = 1.0 / static_cast<double>(dimensions_.x - 1);
-    auto yFrac = 1.0 / static_cast<double>(dimensions_.y - 1);
-
-    if (dimensions_.x == 0 || dimensions_.y == 0) {
-        LogError("Tensor field 2D has at least one zero-sized dimension!");
-        return;
-    }
-
-    for (size_t y = 0; y < dimensions_.y; y++) {
-        for (size_t x = 0; x < dimensions_.x; x++) {
-            normalizedImagePositions_[indexMapper_(size2_t(x, y))] =
-                dvec2(dimensions_.x < 2 ? 0. : x * xFrac, dimensions_.y < 2 ? 0. : y * yFrac);
-        }
+    if (metaDataPolicy_ == MetaDataPolicy::Lazy) return;
+
+    // All eigen values and eigen vector components in one pass over the meta data
+    const auto ranges = tensorutil::reduceRanges<value_type>(
+        {{this->majorEigenValues().data()},
+         {this->minorEigenValues().data()},
+         {reinterpret_cast<const value_type*>(this->majorEigenVectors().data()), 2},
+         {reinterpret_cast<const value_type*>(this->minorEigenVectors().data()), 2}},
+        size_);
+
+    for (size_t i = 0; i < 2; ++i) {
+        dataMapEigenValues_[i].dataRange = dataMapEigenValues_[i].valueRange = ranges[i].range;
+        dataMapEigenVectors_[i].dataRange = dataMapEigenVectors_[i].valueRange =
+            ranges[2 + i].range;
     }
 }
 }  // namespace inviwo
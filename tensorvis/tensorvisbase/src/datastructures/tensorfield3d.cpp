@@ -3,40 +3,76 @@
 #include <inviwo/core/util/stdextensions.h>
 #include <modules/eigenutils/eigenutils.h>
 #include <inviwo/tensorvisbase/util/misc.h>
+#include <inviwo/tensorvisbase/util/symmetriceigensolver.h>
+#include <inviwo/tensorvisbase/util/rangereduction.h>
 #include <inviwo/core/util/exception.h>
 
 namespace inviwo {
 TensorField3D::TensorField3D(const sizeN_t &dimensions, const std::vector<matN> &tensors,
-                             std::shared_ptr<DataFrame> metaData)
-    : TensorField<3, float>(dimensions, tensors, metaData) {
+                             std::shared_ptr<DataFrame> metaData, MetaDataPolicy policy)
+    : TensorField<3, float>(dimensions, tensors, metaData, policy) {
+    initializeDefaultMetaData();
+    computeDataMaps();
+}
+
+TensorField3D::TensorField3D(const sizeN_t &dimensions, std::vector<matN> &&tensors,
+                             std::shared_ptr<DataFrame> metaData, MetaDataPolicy policy)
+    : TensorField<3, float>(dimensions, std::move(tensors), metaData, policy) {
     initializeDefaultMetaData();
     computeDataMaps();
 }
 
 TensorField3D::TensorField3D(const sizeN_t &dimensions, std::shared_ptr<std::vector<matN>> tensors,
-                             std::shared_ptr<DataFrame> metaData)
-    : TensorField<3, float>(dimensions, tensors, metaData) {
+                             std::shared_ptr<DataFrame> metaData, MetaDataPolicy policy)
+    : TensorField<3, float>(dimensions, std::move(tensors), metaData, policy) {
     initializeDefaultMetaData();
     computeDataMaps();
 }
 
-TensorField3D::TensorField3D(const TensorField3D &tf) : TensorField<3, float>(tf) {
+TensorField3D::TensorField3D(const sizeN_t &dimensions,
+                             std::shared_ptr<std::vector<packedN>> tensors,
+                             std::shared_ptr<DataFrame> metaData, MetaDataPolicy policy)
+    : TensorField<3, float>(dimensions, tensors, metaData, policy) {
     initializeDefaultMetaData();
     computeDataMaps();
 }
 
+TensorField3D::TensorField3D(const TensorField3D &tf) : TensorField<3, float>(tf) {
+    // The data maps are copied from tf, they only need to be recomputed if the eigen system had to
+    // be added to the meta data
+    const auto numColumns = metaData_->getNumberOfColumns();
+    initializeDefaultMetaData();
+    if (metaData_->getNumberOfColumns() != numColumns) computeDataMaps();
+}
+
 TensorField3D *TensorField3D::clone() const { return new TensorField3D(*this); }
 
 TensorField3D *TensorField3D::deepCopy() const {
     auto tf = new TensorField3D(*this);
 
-    tf->setTensors(std::make_shared<std::vector<matN>>(*tensors_));
+    if (packedTensors_) {
+        tf->setPackedTensors(std::make_shared<std::vector<packedN>>(*packedTensors_));
+    } else {
+        tf->setTensors(std::make_shared<std::vector<matN>>(*tensors_));
+    }
     tf->setMetaData(std::make_shared<DataFrame>(*metaData_));
 
     return tf;
 }
 
+void TensorField3D::buildPyramid(PyramidFilter filter) { createPyramid<TensorField3D>(filter); }
+
+std::shared_ptr<const TensorField3D> TensorField3D::getLevel(size_t level) const {
+    if (level == 0 || level >= getNumberOfLevels()) {
+        throw Exception("Invalid pyramid level " + std::to_string(level), IVW_CONTEXT);
+    }
+    return std::static_pointer_cast<const TensorField3D>(pyramid_->levels[level - 1]);
+}
+
 void TensorField3D::initializeDefaultMetaData() {
+    // Lazy fields compute the eigen system on first access
+    if (metaDataPolicy_ == MetaDataPolicy::Lazy) return;
+
     // clang-format off
     if (this->hasMetaData<attributes::MajorEigenValue>() &&
         this->hasMetaData<attributes::IntermediateEigenValue>() &&
@@ -48,61 +84,26 @@ void TensorField3D::initializeDefaultMetaData() {
     }
     // clang-format on
 
-    auto newMetaData = std::make_shared<DataFrame>(*metaData_);
-
-    auto func = [](const mat3 &tensor) -> std::array<std::pair<float, vec3>, 3> {
-        if (tensor == mat3(0.0f)) {
-            return {{std::make_pair(0.0f, vec3{0.0f}), std::make_pair(0.0f, vec3{0.0f}),
-                     std::make_pair(0.0f, vec3{0.0f})}};
-            return std::array<std::pair<float, vec3>, 3>{std::make_pair(0.0f, vec3(0.0f)),
-                                                         std::make_pair(0.0f, vec3(0.0f)),
-                                                         std::make_pair(0.0f, vec3(0.0f))};
-        }
-
-        Eigen::EigenSolver<Eigen::Matrix3f> solver(util::glm2eigen(tensor));
-        const auto eigenValues = util::eigen2glm<float, 3, 1>(solver.eigenvalues().real());
-        const auto eigenVectors = util::eigen2glm<float, 3, 3>(solver.eigenvectors().real());
-
-        const auto range =
-            util::as_range(glm::value_ptr(eigenValues), glm::value_ptr(eigenValues) + 3);
-
-        const auto ordering = util::ordering(range, std::greater<float>());
-
-        return {{std::make_pair(eigenValues[ordering[0]], eigenVectors[ordering[0]]),
-                 std::make_pair(eigenValues[ordering[1]], eigenVectors[ordering[1]]),
-                 std::make_pair(eigenValues[ordering[2]], eigenVectors[ordering[2]])}};
-    };
-
-    std::vector<float> majorEigenValues;
-    std::vector<float> intermediateEigenValues;
-    std::vector<float> minorEigenValues;
-
-    std::vector<vec3> majorEigenVectors;
-    std::vector<vec3> intermediateEigenVectors;
-    std::vector<vec3> minorEigenVectors;
-
-    majorEigenValues.resize(size_);
-    intermediateEigenValues.resize(size_);
-    minorEigenValues.resize(size_);
-
-    majorEigenVectors.resize(size_);
-    intermediateEigenVectors.resize(size_);
-    minorEigenVectors.resize(size_);
-
-    const auto &t_ref = *tensors_;
-
-#pragma omp parallel for
-    for (int i = 0; i < static_cast<int>(tensors_->size()); i++) {
-        auto tensor = t_ref[i];
-        auto eigenValuesAndEigenVectors = func(tensor);
-
-        majorEigenVectors[i] = eigenValuesAndEigenVectors[0].second;
-        intermediateEigenVectors[i] = eigenValuesAndEigenVectors[1].second;
-        minorEigenVectors[i] = eigenValuesAndEigenVectors[2].second;
-
-        majorEigenValues[i] = eigenValuesAndEigenVectors[0].first;
-        intermediateEigenValues[i] = eigenValuesAndEigenVectors[1].first;
-        minorEigenValues[i] = eigenValuesAndEigenVectors[2].first;
+    auto newMetaData = editableMetaData();
+
+    std::vector<float> majorEigenValues(size_);
+    std::vector<float> intermediateEigenValues(size_);
+    std::vector<float> minorEigenValues(size_);
+
+    std::vector<vec3> majorEigenVectors(size_);
+    std::vector<vec3> intermediateEigenVectors(size_);
+    std::vector<vec3> minorEigenVectors(size_);
+
+    if (packedTensors_) {
+        tensorutil::symmetricEigenSystems(
+            packedTensors_->data(), packedTensors_->size(), majorEigenValues.data(),
+            intermediateEigenValues.data(), minorEigenValues.data(), majorEigenVectors.data(),
+            intermediateEigenVectors.data(), minorEigenVectors.data());
+    } else {
+        tensorutil::symmetricEigenSystems(
+            tensors_->data(), tensors_->size(), majorEigenValues.data(),
+            intermediateEigenValues.data(), minorEigenValues.data(), majorEigenVectors.data(),
+            intermediateEigenVectors.data(), minorEigenVectors.data());
     }
 
     addIfNotPresent<attributes::MajorEigenValue>(newMetaData, majorEigenValues);
@@ -125,114 +126,147 @@ vec3 TensorField3D::getNormalizedVolumePosition(const size_t index, const double
                 dimensions_.z < 2 ? sliceCoord : pos.z * stepSize.z);
 }
 
-std::optional<std::vector<vec3>> TensorField3D::getNormalizedScreenCoordinates(float sliceCoord) {
-    std::vector<vec3> normalizedVolumePositions;
-    normalizedVolumePositions.resize(size_);
+void TensorField3D::getNormalizedVolumePositions(const size_t first, const size_t count,
+                                                 const double sliceCoord, vec3* positions) const {
+    const auto stepSize = getSpacing();
+    const auto slice = static_cast<float>(sliceCoord);
+    const auto coord = [&](glm::length_t i, size_t p) {
+        return dimensions_[i] < 2 ? slice : static_cast<float>(p) * stepSize[i];
+    };
+
+    // Step through the rows instead of mapping every index
+    auto pos = indexMapper_(first);
+    for (size_t i = 0; i < count; ++i) {
+        positions[i] = vec3(coord(0, pos.x), coord(1, pos.y), coord(2, pos.z));
+        if (++pos.x == dimensions_.x) {
+            pos.x = 0;
+            if (++pos.y == dimensions_.y) {
+                pos.y = 0;
+                ++pos.z;
+            }
+        }
+    }
+}
 
+std::optional<std::vector<vec3>> TensorField3D::getNormalizedScreenCoordinates(
+    float sliceCoord) const {
     if (dimensions_.x == 0 || dimensions_.y == 0 || dimensions_.z == 0) {
         LogError("Tensor field 3D has at least one zero-sized dimension!");
         return std::nullopt;
     }
 
-    for (size_t z = 0; z < dimensions_.z; z++) {
-        for (size_t y = 0; y < dimensions_.y; y++) {
-            for (size_t x = 0; x < dimensions_.x; x++) {
-                const auto index = indexMapper_(size3_t(x, y, z));
-                normalizedVolumePositions[index] = getNormalizedVolumePosition(index, sliceCoord);
-            }
-        }
+    std::vector<vec3> normalizedVolumePositions(size_);
+    const auto rows = static_cast<long long>(dimensions_.y * dimensions_.z);
+
+#pragma omp parallel for
+    for (long long row = 0; row < rows; ++row) {
+        const auto first = static_cast<size_t>(row) * dimensions_.x;
+        getNormalizedVolumePositions(first, dimensions_.x, sliceCoord,
+                                     normalizedVolumePositions.data() + first);
     }
 
     return normalizedVolumePositions;
 }
 
 void TensorField3D::computeDataMaps() {
-    const auto &majorEigenValues = this->majorEigenValues();
-    const auto &middleEigenValues = this->intermediateEigenValues();
-    const auto &minorEigenValues = this->minorEigenValues();
-
-    dataMapEigenValues_[0].dataRange.x = dataMapEigenValues_[0].valueRange.x =
-        *std::min_element(majorEigenValues.begin(), majorEigenValues.end());
-    dataMapEigenValues_[0].dataRange.y = dataMapEigenValues_[0].valueRange.y =
-        *std::max_element(majorEigenValues.begin(), majorEigenValues.end());
-    dataMapEigenValues_[1].dataRange.x = dataMapEigenValues_[1].valueRange.x =
-        *std::min_element(middleEigenValues.begin(), middleEigenValues.end());
-    dataMapEigenValues_[1].dataRange.y = dataMapEigenValues_[1].valueRange.y =
-        *std::max_element(middleEigenValues.begin(), middleEigenValues.end());
-    dataMapEigenValues_[2].dataRange.x = dataMapEigenValues_[2].valueRange.x =
-        *std::min_element(minorEigenValues.begin(), minorEigenValues.end());
-    dataMapEigenValues_[2].dataRange.y = dataMapEigenValues_[2].valueRange.y =
-        *std::max_element(minorEigenValues.begin(), minorEigenValues.end());
-
-    auto min_f = [](const dvec3 &vec) -> double { return std::min(std::min(vec.x, vec.y), vec.z); };
-    auto max_f = [](const dvec3 &vec) -> double { return std::max(std::max(vec.x, vec.y), vec.z); };
-
-    auto min = std::numeric_limits<double>::max();
-    auto max = std::numeric_limits<double>::lowest();
-    for (const auto &v : this->majorEigenVectors()) {
-        min = std::min(min_f(v), min);
-        max = std::max(max_f(v), max);
-    }
-    dataMapEigenVectors_[0].dataRange.x = dataMapEigenVectors_[0].valueRange.x = min;
-    dataMapEigenVectors_[0].dataRange.y = dataMapEigenVectors_[0].valueRange.y = max;
-
-    min = std::numeric_limits<double>::max();
-    max = std::numeric_limits<double>::lowest();
-    for (const auto &v : this->intermediateEigenVectors()) {
-        min = std::min(min_f(v), min);
-        max = std::max(max_f(v), max);
-    }
-    dataMapEigenVectors_[1].dataRange.x = dataMapEigenVectors_[1].valueRange.x = min;
-    dataMapEigenVectors_[1].dataRange.y = dataMapEigenVectors_[1].valueRange.y = max;
-
-    min = std::numeric_limits<double>::max();
-    max = std::numeric_limits<double>::lowest();
-    for (const auto &v : this->minorEigenVectors()) {
-        min = std::min(min_f(v), min);
-        max = std::max(max_f(v), max);
+    if (metaDataPolicy_ == MetaDataPolicy::Lazy) return;
+
+    // All eigen values and eigen vector components in one pass over the meta data
+    const auto ranges = tensorutil::reduceRanges<float>(
+        {{this->majorEigenValues().data()},
+         {this->intermediateEigenValues().data()},
+         {this->minorEigenValues().data()},
+         {reinterpret_cast<const float*>(this->majorEigenVectors().data()), 3},
+         {reinterpret_cast<const float*>(this->intermediateEigenVectors().data()), 3},
+         {reinterpret_cast<const float*>(this->minorEigenVectors().data()), 3}},
+        size_);
+
+    for (size_t i = 0; i < 3; ++i) {
+        dataMapEigenValues_[i].dataRange = dataMapEigenValues_[i].valueRange = ranges[i].range;
+        dataMapEigenVectors_[i].dataRange = dataMapEigenVectors_[i].valueRange =
+            ranges[3 + i].range;
     }
-    dataMapEigenVectors_[2].dataRange.x = dataMapEigenVectors_[2].valueRange.x = min;
-    dataMapEigenVectors_[2].dataRange.y = dataMapEigenVectors_[2].valueRange.y = max;
 }
 
 /**
- *   Returns three volumes representing the tensor field.
- *
  * At each position, a tensor is given by
-
+ *
  *   xx   xy   xz
  *   yx   yy   yz
  *   zx   zy   zz
  *
- * The volumes return by this method decompose the tensor into its three columns.
- * I.e., the first volume contains the values xx, yz, and zx.
+ * The column layout decomposes the tensor into its three columns, i.e. the first volume contains
+ * the values xx, yx, and zx. The symmetric layout stores (xx, yy, zz) and (xy, xz, yz).
  */
-std::array<std::shared_ptr<Volume>, 3> TensorField3D::getVolumeRepresentation() const {
-    auto volumeCol1 = std::make_shared<Volume>(dimensions_, DataVec3Float32::get());
-    auto volumeCol2 = std::make_shared<Volume>(dimensions_, DataVec3Float32::get());
-    auto volumeCol3 = std::make_shared<Volume>(dimensions_, DataVec3Float32::get());
-
-    auto col1RAM = volumeCol1->getEditableRepresentation<VolumeRAM>();
-    auto col2RAM = volumeCol2->getEditableRepresentation<VolumeRAM>();
-    auto col3RAM = volumeCol3->getEditableRepresentation<VolumeRAM>();
-
-    util::IndexMapper3D indexMapper(dimensions_);
-
-    for (size_t z = 0; z < dimensions_.z; z++) {
-        for (size_t x = 0; x < dimensions_.x; x++) {
-            for (size_t y = 0; y < dimensions_.y; y++) {
-                const auto &tensor = at(size3_t(x, y, z));
-
-                col1RAM->setFromDVec3(size3_t(x, y, z), tensor[0]);
+std::vector<std::shared_ptr<const Volume>> TensorField3D::getVolumeRepresentation(
+    VolumeLayout layout) const {
+    const std::string key =
+        layout == VolumeLayout::Columns ? "volumes.columns" : "volumes.symmetric";
+
+    std::lock_guard<std::mutex> lock(representations_->mutex);
+    if (auto it = representations_->items.find(key); it != representations_->items.end()) {
+        return *std::static_pointer_cast<const std::vector<std::shared_ptr<const Volume>>>(
+            it->second);
+    }
 
-                col2RAM->setFromDVec3(size3_t(x, y, y), tensor[1]);
+    const size_t numVolumes = layout == VolumeLayout::Columns ? 3 : 2;
+    std::vector<std::shared_ptr<Volume>> volumes(numVolumes);
+    std::array<vec3*, 3> data{};
+    for (size_t i = 0; i < numVolumes; ++i) {
+        volumes[i] = std::make_shared<Volume>(dimensions_, DataVec3Float32::get());
+        data[i] = static_cast<vec3*>(volumes[i]->getEditableRepresentation<VolumeRAM>()->getData());
+    }
 
-                col3RAM->setFromDVec3(size3_t(x, y, y), tensor[2]);
+    // The volumes use the same linear index as the tensors, write all of them in a single pass
+    const auto size = static_cast<long long>(size_);
+    if (packedTensors_) {
+        // Packed entries are xx, xy, xz, yy, yz, zz
+        const auto& packed = *packedTensors_;
+        if (layout == VolumeLayout::Columns) {
+#pragma omp parallel for
+            for (long long i = 0; i < size; ++i) {
+                const auto& p = packed[i];
+                data[0][i] = vec3(p[0], p[1], p[2]);
+                data[1][i] = vec3(p[1], p[3], p[4]);
+                data[2][i] = vec3(p[2], p[4], p[5]);
+            }
+        } else {
+#pragma omp parallel for
+            for (long long i = 0; i < size; ++i) {
+                const auto& p = packed[i];
+                data[0][i] = vec3(p[0], p[3], p[5]);
+                data[1][i] = vec3(p[1], p[2], p[4]);
+            }
+        }
+    } else {
+        const auto& tensors = *tensors_;
+        if (layout == VolumeLayout::Columns) {
+#pragma omp parallel for
+            for (long long i = 0; i < size; ++i) {
+                const auto& t = tensors[i];
+                data[0][i] = t[0];
+                data[1][i] = t[1];
+                data[2][i] = t[2];
+            }
+        } else {
+#pragma omp parallel for
+            for (long long i = 0; i < size; ++i) {
+                const auto& t = tensors[i];
+                data[0][i] = vec3(t[0][0], t[1][1], t[2][2]);
+                data[1][i] = vec3(t[1][0], t[2][0], t[2][1]);
             }
         }
     }
 
-    return {volumeCol1, volumeCol2, volumeCol3};
+    auto cached = std::make_shared<std::vector<std::shared_ptr<const Volume>>>(volumes.begin(),
+                                                                               volumes.end());
+    representations_->items[key] = cached;
+    return *cached;
+}
+
+std::array<std::shared_ptr<const Volume>, 3> TensorField3D::getVolumeRepresentation() const {
+    const auto volumes = getVolumeRepresentation(VolumeLayout::Columns);
+    return {volumes[0], volumes[1], volumes[2]};
 }
 
 }  // namespace inviwo
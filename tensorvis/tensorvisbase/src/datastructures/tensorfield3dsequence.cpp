@@ -0,0 +1,302 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisbase/datastructures/tensorfield3dsequence.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace inviwo {
+
+struct TensorField3DSequence::State {
+    State(size_t numberOfTimesteps, Loader loader, size_t memoryBudget, size_t prefetchCount)
+        : size{numberOfTimesteps}
+        , loader{std::move(loader)}
+        , memoryBudget{memoryBudget}
+        , prefetchCount{prefetchCount} {}
+
+    struct Entry {
+        std::shared_ptr<const TensorField3D> field;
+        std::exception_ptr error;
+        size_t bytes = 0;
+        bool loading = true;
+    };
+
+    const size_t size;
+    const Loader loader;
+
+    std::mutex mutex;
+    std::condition_variable loaded;
+    size_t memoryBudget;
+    size_t prefetchCount;
+    std::unordered_map<size_t, Entry> entries;
+    std::list<size_t> recentlyUsed;  // loaded timesteps, most recently used first
+    size_t memoryUsage = 0;
+    size_t current = 0;
+
+    // Timesteps with the dimensions and mask of the first loaded one share its mask. Only the
+    // mask is kept, the timestep itself may be evicted.
+    std::shared_ptr<const std::vector<glm::uint8>> referenceMask;
+    size3_t referenceDimensions{0};
+
+    void touch(size_t timestep) {
+        auto it = std::find(recentlyUsed.begin(), recentlyUsed.end(), timestep);
+        if (it != recentlyUsed.end()) recentlyUsed.splice(recentlyUsed.begin(), recentlyUsed, it);
+    }
+
+    void evict() {
+        auto it = recentlyUsed.end();
+        while (memoryUsage > memoryBudget && it != recentlyUsed.begin()) {
+            --it;
+            if (*it == current) continue;
+            auto entry = entries.find(*it);
+            memoryUsage -= entry->second.bytes;
+            entries.erase(entry);
+            it = recentlyUsed.erase(it);
+        }
+    }
+
+    static void shareMask(const std::shared_ptr<const std::vector<glm::uint8>>& mask,
+                          const size3_t& dimensions, TensorField3D& field) {
+        if (!mask || !field.hasMask() || field.getDimensions() != dimensions) return;
+        if (field.sharedMask() != mask && field.getMask() == *mask) field.setMask(mask);
+    }
+
+    /**
+     * Runs the loader for a timestep marked as loading and stores the result. Returns false if
+     * the state is gone, i.e. all sequences referring to it were destroyed.
+     */
+    static bool load(const std::weak_ptr<State>& weakState, size_t timestep) {
+        Loader loader;
+        if (auto state = weakState.lock()) {
+            loader = state->loader;
+        } else {
+            return false;
+        }
+
+        const std::function<bool()> cancelled = [weakState]() { return weakState.expired(); };
+
+        std::shared_ptr<TensorField3D> field;
+        std::exception_ptr error;
+        try {
+            field = loader(timestep, cancelled);
+            if (!field && !cancelled()) {
+                throw Exception("Loader returned no tensor field for timestep " +
+                                    std::to_string(timestep),
+                                IVW_CONTEXT_CUSTOM("TensorField3DSequence"));
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        auto state = weakState.lock();
+        if (!state) return false;
+
+        size_t bytes = 0;
+        if (field) {
+            std::shared_ptr<const std::vector<glm::uint8>> mask;
+            size3_t dimensions;
+            {
+                std::scoped_lock lock{state->mutex};
+                if (!state->referenceMask && field->hasMask()) {
+                    state->referenceMask = field->sharedMask();
+                    state->referenceDimensions = field->getDimensions();
+                }
+                mask = state->referenceMask;
+                dimensions = state->referenceDimensions;
+            }
+            shareMask(mask, dimensions, *field);
+            bytes = estimateMemory(*field);
+        }
+
+        {
+            std::scoped_lock lock{state->mutex};
+            auto& entry = state->entries[timestep];
+            entry.loading = false;
+            if (field) {
+                entry.field = field;
+                entry.bytes = bytes;
+                state->memoryUsage += bytes;
+                state->recentlyUsed.push_front(timestep);
+                state->evict();
+            } else {
+                // Keep the error for the waiting get(), a later request loads the timestep again
+                entry.error = error;
+            }
+        }
+        state->loaded.notify_all();
+        return true;
+    }
+
+    /**
+     * Starts loading the timesteps following the given one on the pool. Expects the mutex to be
+     * locked.
+     */
+    void prefetchFollowing(const std::shared_ptr<State>& self, size_t timestep) {
+        const auto count = std::min(prefetchCount, size - 1);
+        for (size_t i = 1; i <= count; ++i) {
+            startLoad(self, (timestep + i) % size);
+        }
+    }
+
+    /**
+     * Marks the timestep as loading and dispatches the loader, unless it is already cached or
+     * loading. Expects the mutex to be locked.
+     */
+    void startLoad(const std::shared_ptr<State>& self, size_t timestep) {
+        auto it = entries.find(timestep);
+        if (it != entries.end() && (it->second.loading || it->second.field)) return;
+        entries[timestep] = Entry{};
+        dispatchPool([weakState = std::weak_ptr<State>(self), timestep]() {
+            State::load(weakState, timestep);
+        });
+    }
+};
+
+TensorField3DSequence::TensorField3DSequence(size_t numberOfTimesteps, Loader loader,
+                                             size_t memoryBudget, size_t prefetchCount)
+    : state_{std::make_shared<State>(numberOfTimesteps, std::move(loader), memoryBudget,
+                                     prefetchCount)} {}
+
+size_t TensorField3DSequence::size() const { return state_->size; }
+
+std::shared_ptr<const TensorField3D> TensorField3DSequence::get(size_t timestep) const {
+    if (timestep >= state_->size) {
+        throw Exception("Timestep " + std::to_string(timestep) + " out of range [0, " +
+                            std::to_string(state_->size) + ")",
+                        IVW_CONTEXT);
+    }
+
+    bool loadHere = false;
+    {
+        std::scoped_lock lock{state_->mutex};
+        state_->current = timestep;
+        auto it = state_->entries.find(timestep);
+        if (it == state_->entries.end() || (!it->second.loading && !it->second.field)) {
+            state_->entries[timestep] = State::Entry{};
+            loadHere = true;
+        }
+        state_->prefetchFollowing(state_, timestep);
+    }
+
+    if (loadHere) State::load(state_, timestep);
+
+    std::unique_lock lock{state_->mutex};
+    state_->loaded.wait(lock, [&]() {
+        auto it = state_->entries.find(timestep);
+        return it == state_->entries.end() || !it->second.loading;
+    });
+
+    auto it = state_->entries.find(timestep);
+    if (it == state_->entries.end()) {
+        throw Exception("Timestep " + std::to_string(timestep) + " was evicted while loading",
+                        IVW_CONTEXT);
+    }
+    if (auto error = it->second.error) {
+        state_->entries.erase(it);
+        std::rethrow_exception(error);
+    }
+    state_->touch(timestep);
+    return it->second.field;
+}
+
+std::shared_ptr<const TensorField3D> TensorField3DSequence::tryGet(size_t timestep) const {
+    if (timestep >= state_->size) return nullptr;
+
+    std::scoped_lock lock{state_->mutex};
+    state_->current = timestep;
+    state_->prefetchFollowing(state_, timestep);
+
+    auto it = state_->entries.find(timestep);
+    if (it != state_->entries.end() && it->second.field) {
+        state_->touch(timestep);
+        return it->second.field;
+    }
+    if (it != state_->entries.end() && it->second.error) state_->entries.erase(it);
+    state_->startLoad(state_, timestep);
+    return nullptr;
+}
+
+void TensorField3DSequence::prefetch(size_t timestep) const {
+    if (timestep >= state_->size) return;
+    std::scoped_lock lock{state_->mutex};
+    state_->startLoad(state_, timestep);
+}
+
+size_t TensorField3DSequence::getMemoryBudget() const {
+    std::scoped_lock lock{state_->mutex};
+    return state_->memoryBudget;
+}
+
+void TensorField3DSequence::setMemoryBudget(size_t bytes) {
+    std::scoped_lock lock{state_->mutex};
+    state_->memoryBudget = bytes;
+    state_->evict();
+}
+
+size_t TensorField3DSequence::getPrefetchCount() const {
+    std::scoped_lock lock{state_->mutex};
+    return state_->prefetchCount;
+}
+
+void TensorField3DSequence::setPrefetchCount(size_t count) {
+    std::scoped_lock lock{state_->mutex};
+    state_->prefetchCount = count;
+}
+
+size_t TensorField3DSequence::getMemoryUsage() const {
+    std::scoped_lock lock{state_->mutex};
+    return state_->memoryUsage;
+}
+
+size_t TensorField3DSequence::estimateMemory(const TensorField3D& tensorField) {
+    size_t bytes = 0;
+    if (tensorField.storage() == TensorStorage::PackedSymmetric) {
+        bytes += tensorField.getSize() * sizeof(TensorField3D::packedN);
+    } else {
+        bytes += tensorField.getSize() * sizeof(TensorField3D::matN);
+    }
+    bytes += tensorField.getMask().size() * sizeof(glm::uint8);
+
+    const auto metaData = tensorField.metaData();
+    for (size_t i = 0; i < metaData->getNumberOfColumns(); ++i) {
+        const auto buffer = metaData->getColumn(i)->getBuffer();
+        bytes += buffer->getSize() * buffer->getDataFormat()->getSize();
+    }
+    return bytes;
+}
+
+}  // namespace inviwo
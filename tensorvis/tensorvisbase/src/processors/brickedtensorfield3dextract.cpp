@@ -0,0 +1,80 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisbase/processors/brickedtensorfield3dextract.h>
+#include <inviwo/tensorvisbase/tensorvisbasemodule.h>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo BrickedTensorField3DExtract::processorInfo_{
+    "org.inviwo.BrickedTensorField3DExtract",  // Class identifier
+    "Bricked Tensor Field 3D Extract",         // Display name
+    "Tensor visualization",                    // Category
+    CodeState::Experimental,                   // Code state
+    tag::OpenTensorVis | Tag::CPU,             // Tags
+};
+const ProcessorInfo BrickedTensorField3DExtract::getProcessorInfo() const {
+    return processorInfo_;
+}
+
+BrickedTensorField3DExtract::BrickedTensorField3DExtract()
+    : Processor()
+    , inport_("inport")
+    , outport_("outport")
+    , brick_("brick", "Brick", size3_t(0), size3_t(0), size3_t(0))
+    , padding_("padding", "Padding", 1, 0, 16)
+    , lazyMetaData_("lazyMetaData", "Compute meta data on demand", true) {
+    addPort(inport_);
+    addPort(outport_);
+
+    addProperties(brick_, padding_, lazyMetaData_);
+
+    inport_.onChange([this]() {
+        if (!inport_.hasData()) return;
+        brick_.setMaxValue(inport_.getData()->getNumberOfBricks() - size3_t(1));
+    });
+}
+
+void BrickedTensorField3DExtract::process() {
+    const auto tensorField = inport_.getData();
+    const auto brickSize = size3_t(tensorField->getBrickSize());
+    const auto padding = size3_t(padding_.get());
+
+    const auto origin =
+        glm::min(brick_.get(), tensorField->getNumberOfBricks() - size3_t(1)) * brickSize;
+    const auto min = origin - glm::min(origin, padding);
+    const auto max = glm::min(origin + brickSize - size3_t(1) + padding,
+                              tensorField->getDimensions() - size3_t(1));
+
+    outport_.setData(tensorField->extract(
+        min, max, lazyMetaData_.get() ? MetaDataPolicy::Lazy : MetaDataPolicy::Eager));
+}
+
+}  // namespace inviwo
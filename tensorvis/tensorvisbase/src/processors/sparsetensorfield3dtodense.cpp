@@ -0,0 +1,63 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisbase/processors/sparsetensorfield3dtodense.h>
+#include <inviwo/tensorvisbase/tensorvisbasemodule.h>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo SparseTensorField3DToDense::processorInfo_{
+    "org.inviwo.SparseTensorField3DToDense",  // Class identifier
+    "Sparse Tensor Field 3D To Dense",        // Display name
+    "Tensor visualization",                   // Category
+    CodeState::Experimental,                  // Code state
+    tag::OpenTensorVis | Tag::CPU,            // Tags
+};
+const ProcessorInfo SparseTensorField3DToDense::getProcessorInfo() const {
+    return processorInfo_;
+}
+
+SparseTensorField3DToDense::SparseTensorField3DToDense()
+    : Processor()
+    , inport_("inport")
+    , outport_("outport")
+    , lazyMetaData_("lazyMetaData", "Compute meta data on demand", true) {
+    addPort(inport_);
+    addPort(outport_);
+
+    addProperty(lazyMetaData_);
+}
+
+void SparseTensorField3DToDense::process() {
+    outport_.setData(inport_.getData()->toDense(lazyMetaData_.get() ? MetaDataPolicy::Lazy
+                                                                    : MetaDataPolicy::Eager));
+}
+
+}  // namespace inviwo
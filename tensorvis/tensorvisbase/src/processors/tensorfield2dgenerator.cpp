@@ -306,7 +306,7 @@ void TensorField2DGenerator::generate2DField() {
     data.resize(rawData.size());
     std::copy(std::begin(rawData), std::end(rawData), std::begin(data));
 
-    outport2D_.setData(std::make_shared<TensorField2D>(dimensions, data));
+    outport2D_.setData(std::make_shared<TensorField2D>(dimensions, std::move(data)));
 }
 
 }  // namespace inviwo
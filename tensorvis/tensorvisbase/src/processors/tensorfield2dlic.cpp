@@ -30,6 +30,7 @@
 #include <inviwo/tensorvisbase/processors/tensorfield2dlic.h>
 #include <algorithm>
 #include <inviwo/tensorvisbase/tensorvisbasemodule.h>
+#include <inviwo/tensorvisbase/util/rangereduction.h>
 
 namespace inviwo {
 
@@ -90,29 +91,18 @@ void TensorField2DLIC::updateEigenValues() {
     auto subsampled = tensorutil::subsample2D(inport_.getData(),
                                               inport_.getData()->getDimensions() * size2_t(2, 2));
 
-    std::vector<TensorField2D::value_type> eigenValues;
-    if (majorMinor_.get()) {
-        eigenValues = std::vector<TensorField2D::value_type>(subsampled->minorEigenValues());
-    } else {
-        eigenValues = std::vector<TensorField2D::value_type>(subsampled->majorEigenValues());
-    }
+    const auto& eigenValues =
+        majorMinor_.get() ? subsampled->minorEigenValues() : subsampled->majorEigenValues();
 
-    minVal_ = static_cast<float>(*std::min_element(eigenValues.begin(), eigenValues.end()));
-    maxVal_ = static_cast<float>(*std::max_element(eigenValues.begin(), eigenValues.end()));
-
-    if (minVal_ == 0.0) {
-        // Delete zero entries to find actual minimum
-        eigenValues.erase(
-            std::remove_if(eigenValues.begin(), eigenValues.end(),
-                           [](auto x) {
-                               return std::abs(x) <
-                                      std::numeric_limits<TensorField2D::value_type>::epsilon();
-                           }),
-            eigenValues.end());
-
-        minVal_ = static_cast<float>(*std::min_element(eigenValues.begin(), eigenValues.end()));
-        maxVal_ = static_cast<float>(*std::max_element(eigenValues.begin(), eigenValues.end()));
-    }
+    // If the minimum is zero, the actual minimum is the one of the non-zero entries. Both ranges
+    // are computed in the same pass.
+    const auto ranges = tensorutil::reduceRanges<TensorField2D::value_type>(
+        {{eigenValues.data()}, {eigenValues.data(), 1, true}}, eigenValues.size());
+
+    const auto& range =
+        ranges[0].range.x == 0.0 && ranges[1].count > 0 ? ranges[1].range : ranges[0].range;
+    minVal_ = static_cast<float>(range.x);
+    maxVal_ = static_cast<float>(range.y);
 
     eigenValueRange_ = glm::abs(minVal_ - maxVal_);
 }
@@ -114,13 +114,17 @@ void TensorField2DMetaData::addRemoveMetaData(std::shared_ptr<TensorField2D> ten
     auto comp = getPropertiesByType<CompositeProperty>().front();
     auto props = comp->getProperties();
 
+    util::AddRemoveMetaData<2> addRemove{tensorField};
+
     for (auto prop : props) {
         const auto id = util::constexpr_hash(std::string_view(prop->getDisplayName()));
         const auto add = static_cast<BoolProperty*>(prop)->get();
 
-        util::for_each_type<attributes::types2D>{}(util::AddRemoveMetaData<2>{tensorField}, id,
-                                                   add);
+        // for_each_type takes the functor by value, keep the collected state of the returned copy
+        addRemove = util::for_each_type<attributes::types2D>{}(addRemove, id, add);
     }
+
+    addRemove.calculatePending();
 }
 
 void TensorField2DMetaData::process() {
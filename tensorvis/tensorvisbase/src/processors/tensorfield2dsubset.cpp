@@ -28,6 +28,7 @@
  *********************************************************************************/
 
 #include <inviwo/tensorvisbase/processors/tensorfield2dsubset.h>
+#include <inviwo/tensorvisbase/algorithm/tensorfieldsubset.h>
 #include <inviwo/tensorvisbase/tensorvisbasemodule.h>
 
 namespace inviwo {
@@ -84,19 +85,8 @@ TensorField2DSubset::TensorField2DSubset()
 }
 
 void TensorField2DSubset::process() {
-    auto tensorField = inport_.getData();
-
-    auto dimensions = size2_t(offset_.get() + size2_t{1});
-
-    std::vector<TensorField2D::matN> rawData;
-
-    for (size_t y = origin_.get().y; y <= origin_.get().y + offset_.get().y; ++y) {
-        for (size_t x = origin_.get().x; x <= origin_.get().x + offset_.get().x; ++x) {
-            rawData.push_back(tensorField->at(size2_t(x, y)));
-        }
-    }
-
-    outport_.setData(std::make_shared<TensorField2D>(dimensions, rawData));
+    outport_.setData(tensorutil::subset(inport_.getData(), origin_.get(),
+                                        offset_.get() + size2_t{1}));
 }
 
 }  // namespace inviwo
@@ -48,7 +48,10 @@ const ProcessorInfo TensorField3DInformation::getProcessorInfo() const { return
 TensorField3DInformation::TensorField3DInformation()
     : Processor()
     , inport_("inport")
+    , statisticsOutport_("statistics")
+    , histogramsOutport_("histograms")
     , index_("index", "Index", ivec3(0), ivec3(0), ivec3(std::numeric_limits<int>::max()), ivec3(1))
+    , bins_("bins", "Histogram bins", 256, 1, 4096)
     , tensor_("tensor", "Tensor", mat3(0.f), mat3(std::numeric_limits<float>::lowest()),
               mat3(std::numeric_limits<float>::max()), mat3(std::numeric_limits<float>::epsilon()))
     , eigenVectors_("eigenVectors", "Eigenvectors", mat3(0.f),
@@ -60,10 +63,12 @@ TensorField3DInformation::TensorField3DInformation()
     , basisAndOffset_("basisAndOffset", "Basis and offset", mat4{1.f}, mat4{-1000.f}, mat4{1000.f},
                       mat4{0.00001f}) {
     addPort(inport_);
+    addPort(statisticsOutport_);
+    addPort(histogramsOutport_);
 
     inport_.onChange([this]() { invalidate(InvalidationLevel::InvalidResources); });
 
-    addProperties(index_, tensor_, eigenVectors_, eigenValues_, basisAndOffset_);
+    addProperties(index_, bins_, tensor_, eigenVectors_, eigenValues_, basisAndOffset_);
 
     tensor_.setReadOnly(true);
     eigenVectors_.setReadOnly(true);
@@ -103,6 +108,13 @@ void TensorField3DInformation::process() {
     eigenValues_.set(eigenValues);
 
     basisAndOffset_.set(tensorField->getBasisAndOffset());
+
+    // Cached on the field, only computed once per field and number of bins
+    if (statisticsOutport_.isConnected() || histogramsOutport_.isConnected()) {
+        const auto statistics = tensorField->statistics(bins_.get());
+        statisticsOutport_.setData(tensorutil::statisticsToDataFrame(*statistics));
+        histogramsOutport_.setData(tensorutil::histogramsToDataFrame(*statistics));
+    }
 }
 
 }  // namespace inviwo
@@ -112,13 +112,17 @@ void TensorField3DMetaData::addRemoveMetaData(std::shared_ptr<TensorField3D> ten
     auto comp = getPropertiesByType<CompositeProperty>().front();
     auto props = comp->getProperties();
 
+    util::AddRemoveMetaData<3> addRemove{tensorField};
+
     for (auto prop : props) {
         const auto id = util::constexpr_hash(std::string_view(prop->getDisplayName()));
         const auto add = static_cast<BoolProperty*>(prop)->get();
 
-        util::for_each_type<attributes::types3D>{}(util::AddRemoveMetaData<3>{tensorField}, id,
-                                                   add);
+        // for_each_type takes the functor by value, keep the collected state of the returned copy
+        addRemove = util::for_each_type<attributes::types3D>{}(addRemove, id, add);
     }
+
+    addRemove.calculatePending();
 }
 
 void TensorField3DMetaData::process() {
@@ -0,0 +1,110 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisbase/processors/tensorfield3dsequencetimestep.h>
+#include <inviwo/tensorvisbase/tensorvisbasemodule.h>
+#include <inviwo/core/util/exception.h>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo TensorField3DSequenceTimestep::processorInfo_{
+    "org.inviwo.TensorField3DSequenceTimestep",  // Class identifier
+    "Tensor Field 3D Sequence Timestep",         // Display name
+    "Tensor Visualization",                      // Category
+    CodeState::Experimental,                     // Code state
+    tag::OpenTensorVis | Tag::CPU,               // Tags
+};
+
+const ProcessorInfo TensorField3DSequenceTimestep::getProcessorInfo() const {
+    return processorInfo_;
+}
+
+TensorField3DSequenceTimestep::TensorField3DSequenceTimestep()
+    : Processor()
+    , inport_("inport")
+    , outport_("outport")
+    , timestep_("timestep", "Timestep", 0, 0, 0, 1) {
+    addPort(inport_);
+    addPort(outport_);
+    addProperty(timestep_);
+
+    inport_.onChange([this]() {
+        const auto size = inport_.hasData() ? inport_.getData()->size() : size_t{0};
+        timestep_.setMaxValue(size > 0 ? size - 1 : 0);
+    });
+}
+
+TensorField3DSequenceTimestep::~TensorField3DSequenceTimestep() {
+    if (cancelLoad_) *cancelLoad_ = true;
+}
+
+void TensorField3DSequenceTimestep::process() {
+    auto sequence = inport_.getData();
+    if (sequence->size() == 0) {
+        outport_.clear();
+        return;
+    }
+    const auto timestep = std::min(timestep_.get(), sequence->size() - 1);
+
+    if (auto tensorField = sequence->tryGet(timestep)) {
+        if (cancelLoad_) *cancelLoad_ = true;
+        cancelLoad_.reset();
+        getActivityIndicator().setActive(false);
+        tensorField_ = tensorField;
+        outport_.setData(tensorField_);
+        return;
+    }
+
+    // Not prefetched yet, keep the previous timestep on the outport until it is loaded
+    if (tensorField_) outport_.setData(tensorField_);
+
+    if (cancelLoad_) *cancelLoad_ = true;
+    cancelLoad_ = std::make_shared<std::atomic<bool>>(false);
+    getActivityIndicator().setActive(true);
+
+    dispatchPool([this, cancel = cancelLoad_, sequence, timestep]() {
+        try {
+            sequence->get(timestep);
+        } catch (const Exception& e) {
+            dispatchFront([this, cancel, message = e.getMessage()]() {
+                if (*cancel) return;
+                LogError(message);
+                getActivityIndicator().setActive(false);
+            });
+            return;
+        }
+        dispatchFront([this, cancel]() {
+            if (*cancel) return;
+            invalidate(InvalidationLevel::InvalidOutput);
+        });
+    });
+}
+
+}  // namespace inviwo
@@ -71,6 +71,10 @@ TensorField3DSlice::TensorField3DSlice()
 
     offsetOutport_.setData(std::make_shared<size_t>(0));
 
+    // The slices are only materialized for connected ports, see process()
+    outport2D_.onConnect([this]() { invalidate(InvalidationLevel::InvalidOutput); });
+    outport3D_.onConnect([this]() { invalidate(InvalidationLevel::InvalidOutput); });
+
     addProperty(sliceAlongAxis_);
     addProperty(sliceNr_);
 
@@ -163,10 +167,20 @@ void TensorField3DSlice::process() {
     auto offset = offsetDimensions.x * offsetDimensions.y * (sliceNr_.get());
     offsetOutport_.setData(std::make_shared<size_t>(offset));
 
-    auto slice2D = slice<2>(inport_.getData(), sliceAlongAxis_.get(), sliceNr_.get());
-
-    outport2D_.setData(slice2D);
-    outport3D_.setData(slice<3>(inport_.getData(), sliceAlongAxis_.get(), sliceNr_.get()));
+    // Only materialize the slices that are actually consumed, scrubbing through the slices of a
+    // large field would otherwise copy every slice twice. Unconnected ports are cleared instead
+    // of keeping a stale slice.
+    const TensorField3DSliceView view(tensorField, sliceAlongAxis_.get(), sliceNr_.get());
+    if (outport2D_.isConnected()) {
+        outport2D_.setData(view.materialize2D());
+    } else {
+        outport2D_.clear();
+    }
+    if (outport3D_.isConnected()) {
+        outport3D_.setData(view.materialize3D());
+    } else {
+        outport3D_.clear();
+    }
     sliceOutport_.setData(tensorutil::generateSliceLevelGeometryForTensorField(
         inport_.getData(), sliceColor_.get(), sliceAlongAxis_.get(), sliceNr_.get()));
     planeOutport_.setData(tensorutil::generateSlicePlaneGeometryForTensorField(
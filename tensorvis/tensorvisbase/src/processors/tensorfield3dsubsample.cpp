@@ -54,17 +54,26 @@ TensorField3DSubsample::TensorField3DSubsample()
           {{"linear", "Linear", tensorutil::InterpolationMethod::Linear},
            {"nearest", "Nearest neighbour", tensorutil::InterpolationMethod::Nearest}},
           0, InvalidationLevel::Valid)
-    , tf_(nullptr) {
+    , usePyramid_("usePyramid", "Use level of detail pyramid", false, InvalidationLevel::Valid)
+    , pyramidFilter_("pyramidFilter", "Pyramid filter",
+                     {{"logEuclidean", "Log-Euclidean", PyramidFilter::LogEuclidean},
+                      {"linear", "Linear", PyramidFilter::Linear}},
+                     0, InvalidationLevel::Valid)
+    , tf_(nullptr)
+    , pyramidFilterUsed_(PyramidFilter::LogEuclidean) {
     addPort(inport_);
     addPort(outport_);
 
     addProperty(resolutionMultiplier_);
 
     addProperty(interpolationMethod_);
+    addProperties(usePyramid_, pyramidFilter_);
 
     inport_.onChange([this]() { subsample(); });
     resolutionMultiplier_.onChange([this]() { subsample(); });
     interpolationMethod_.onChange([this]() { subsample(); });
+    usePyramid_.onChange([this]() { subsample(); });
+    pyramidFilter_.onChange([this]() { subsample(); });
 }
 
 void TensorField3DSubsample::initializeResources() {}
@@ -80,24 +89,67 @@ void TensorField3DSubsample::subsample() {
                 auto on_progress = [&bar](float progress) { bar.updateProgress(progress); };
                 isRunning_ = true;
 
-                const auto resolutionMultiplier = resolutionMultiplier_.get();
-                const auto interpolationMethod = interpolationMethod_.get();
+                float resolutionMultiplier;
+                tensorutil::InterpolationMethod interpolationMethod;
+                bool usePyramid;
+                PyramidFilter pyramidFilter;
+                std::shared_ptr<const TensorField3D> source;
+
+                // Stops a pass as soon as it is outdated, the loop then restarts with the
+                // current parameters
+                const auto parametersChanged = [&]() {
+                    return resolutionMultiplier != resolutionMultiplier_.get() ||
+                           interpolationMethod != interpolationMethod_.get() ||
+                           usePyramid != usePyramid_.get() ||
+                           pyramidFilter != pyramidFilter_.get() || source != inport_.getData();
+                };
 
                 do {
+                    resolutionMultiplier = resolutionMultiplier_.get();
+                    interpolationMethod = interpolationMethod_.get();
+                    usePyramid = usePyramid_.get();
+                    pyramidFilter = pyramidFilter_.get();
+
+                    source = inport_.getData();
+                    if (!source) break;
+
                     bar.show();
                     bar.updateProgress(0.f);
 
-                    tf_ = tensorutil::subsample3D(
-                        inport_.getData(),
-                        size3_t(glm::round(vec3(inport_.getData()->getDimensions()) *
-                                           resolutionMultiplier)),
-                        interpolationMethod, on_progress);
+                    auto input = source;
+                    const auto dimensions =
+                        size3_t(glm::round(vec3(input->getDimensions()) * resolutionMultiplier));
+
+                    if (usePyramid) {
+                        // The pyramid is built once per input, changing the resolution only
+                        // selects another level
+                        if (pyramid_ == nullptr || pyramidInput_ != input ||
+                            pyramidFilterUsed_ != pyramidFilter) {
+                            pyramid_ = std::shared_ptr<TensorField3D>(input->clone());
+                            pyramid_->buildPyramid(pyramidFilter);
+                            pyramidInput_ = input;
+                            pyramidFilterUsed_ = pyramidFilter;
+                        }
+                        input = tensorutil::selectLevel(pyramid_, dimensions);
+                    } else {
+                        pyramid_.reset();
+                        pyramidInput_.reset();
+                    }
+
+                    if (input->getDimensions() == dimensions) {
+                        tf_ = input;
+                    } else {
+                        if (auto result = tensorutil::subsample3D(
+                                input, dimensions, interpolationMethod, on_progress,
+                                parametersChanged)) {
+                            tf_ = result;
+                        }
+                    }
 
                     on_progress(1.f);
 
                     bar.hide();
-                } while (resolutionMultiplier != resolutionMultiplier_.get() ||
-                         interpolationMethod != interpolationMethod_.get());
+                } while (parametersChanged());
 
                 dispatchFront([this]() { invalidate(InvalidationLevel::InvalidOutput); });
 
@@ -28,6 +28,7 @@
  *********************************************************************************/
 
 #include <inviwo/tensorvisbase/processors/tensorfield3dsubset.h>
+#include <inviwo/tensorvisbase/algorithm/tensorfieldsubset.h>
 #include <inviwo/tensorvisbase/tensorvisbasemodule.h>
 
 namespace inviwo {
@@ -87,33 +88,8 @@ TensorField3DSubset::TensorField3DSubset()
 }
 
 void TensorField3DSubset::process() {
-    auto tensorField = inport_.getData();
-
-    auto dimensions = size3_t(offset_.get() + size3_t(1));
-
-    auto spacing = tensorField->getSpacing<float>();
-
-    std::vector<mat3> rawData;
-
-    for (size_t z = origin_.get().z; z <= origin_.get().z + offset_.get().z; ++z) {
-        for (size_t y = origin_.get().y; y <= origin_.get().y + offset_.get().y; ++y) {
-            for (size_t x = origin_.get().x; x <= origin_.get().x + offset_.get().x; ++x) {
-                rawData.push_back(tensorField->at(size3_t(x, y, z)));
-            }
-        }
-    }
-
-    auto outField = std::make_shared<TensorField3D>(dimensions, rawData);
-
-    const auto extents = spacing * vec3(dimensions - size3_t(1));
-
-    outField->setExtents(extents);
-
-    const auto offset = tensorField->getOffset() + (vec3(origin_.get()) * spacing);
-
-    outField->setOffset(offset);
-
-    outport_.setData(outField);
+    outport_.setData(tensorutil::subset(inport_.getData(), origin_.get(),
+                                        offset_.get() + size3_t(1)));
 }
 
 }  // namespace inviwo
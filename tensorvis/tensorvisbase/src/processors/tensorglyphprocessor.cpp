@@ -28,11 +28,32 @@
  *********************************************************************************/
 
 #include <inviwo/tensorvisbase/processors/tensorglyphprocessor.h>
+#include <inviwo/tensorvisbase/algorithm/glyphgeneration.h>
+#include <inviwo/tensorvisbase/util/tensorfieldutil.h>
 #include <inviwo/tensorvisbase/util/tensorutil.h>
 #include <inviwo/tensorvisbase/tensorvisbasemodule.h>
+#include <inviwo/core/util/exception.h>
+
+#include <optional>
+#include <tuple>
 
 namespace inviwo {
 
+namespace {
+/**
+ * Coarsest level of the pyramid with a tensor for every glyph of a placement with the given
+ * stride, and the stride to use on that level
+ */
+std::pair<std::shared_ptr<const TensorField3D>, size3_t> levelForStride(
+    std::shared_ptr<const TensorField3D> pyramid, const size3_t& stride) {
+    const auto dimensions = pyramid->getDimensions();
+    const auto glyphs = (dimensions + stride - size3_t(1)) / stride;
+    auto level = tensorutil::selectLevel(pyramid, glyphs);
+    const auto levelStride = glm::max(size3_t(1), stride * level->getDimensions() / dimensions);
+    return {level, levelStride};
+}
+}  // namespace
+
 // The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
 const ProcessorInfo TensorGlyphProcessor::processorInfo_{
     "org.inviwo.TensorGlyphProcessor",  // Class identifier
@@ -48,48 +69,209 @@ TensorGlyphProcessor::TensorGlyphProcessor()
     : Processor()
     , inport_("inport")
     , outport_("outport")
+    , output_("output", "Output",
+              {{"meshPerGlyph", "Mesh per glyph", Output::MeshPerGlyph},
+               {"merged", "Merged mesh", Output::Merged}})
+    , placement_("placement", "Glyph placement")
+    , placementMode_("mode", "Placement",
+                     {{"regular", "Regular", tensorutil::GlyphPlacement::Regular},
+                      {"jittered", "Jittered", tensorutil::GlyphPlacement::Jittered},
+                      {"poissonDisk", "Poisson disk", tensorutil::GlyphPlacement::PoissonDisk},
+                      {"importance", "Importance", tensorutil::GlyphPlacement::Importance}})
+    , stride_("stride", "Stride", size3_t{1}, size3_t{1}, size3_t{64})
+    , radius_("radius", "Radius (voxels)", 2.0f, 0.5f, 64.0f, 0.1f)
+    , count_("count", "Number of glyphs", 1000, 1, 1000000)
+    , importanceColumn_("importanceColumn", "Importance")
+    , seed_("seed", "Seed", 0, 0, std::numeric_limits<int>::max())
+    , usePyramid_("usePyramid", "Use level of detail pyramid", false)
+    , pyramidFilter_("pyramidFilter", "Pyramid filter",
+                     {{"logEuclidean", "Log-Euclidean", PyramidFilter::LogEuclidean},
+                      {"linear", "Linear", PyramidFilter::Linear}},
+                     0)
+    , lod_("lod", "Level of detail")
+    , levels_("levels", "Levels", 1, 1, 8)
+    , detailSize_("detailSize", "Full detail size", 1.0f, 0.001f, 10.0f, 0.001f)
+    , scaleByNorm_("scaleByNorm", "Scale by norm", false)
+    , minNorm_("minNorm", "Minimum norm", 0.0f, 0.0f, 1.0f, 0.001f)
+    , minAnisotropy_("minAnisotropy", "Minimum anisotropy", 0.0f, 0.0f, 1.0f, 0.001f)
+    , culled_("culled", "Culled glyphs", 0, 0, std::numeric_limits<size_t>::max(), 1,
+              InvalidationLevel::Valid)
+    , triangles_("triangles", "Triangles", 0, 0, std::numeric_limits<size_t>::max(), 1,
+                 InvalidationLevel::Valid)
+    , fullDetailTriangles_("fullDetailTriangles", "Triangles at full detail", 0, 0,
+                           std::numeric_limits<size_t>::max(), 1, InvalidationLevel::Valid)
     , glyphParameters_("glyphParameters", "Glyph parameters")
-
-{
+    , pyramidFilterUsed_(PyramidFilter::LogEuclidean) {
     addPort(outport_);
     addPort(inport_);
 
+    addProperty(output_);
+    placement_.addProperties(placementMode_, stride_, radius_, count_, importanceColumn_, seed_,
+                             usePyramid_, pyramidFilter_);
+    addProperty(placement_);
+    lod_.addProperties(levels_, detailSize_, scaleByNorm_, minNorm_, minAnisotropy_, culled_,
+                       triangles_, fullDetailTriangles_);
+    addProperty(lod_);
     addProperty(glyphParameters_);
+
+    culled_.setReadOnly(true);
+    triangles_.setReadOnly(true);
+    fullDetailTriangles_.setReadOnly(true);
+
+    updatePlacementVisibility();
+    placementMode_.onChange([this]() { updatePlacementVisibility(); });
+
+    // Without input the processor is not evaluated, the glyphs are dropped right away
+    inport_.onDisconnect([this]() { generate(); });
+    inport_.onChange([this]() {
+        if (!inport_.hasData()) {
+            generate();
+            return;
+        }
+
+        // Any scalar meta data column or attribute can drive the importance sampling, missing
+        // attributes are computed during the generation
+        std::vector<OptionPropertyStringOption> options;
+        for (const auto& name : tensorutil::scalarAttributes(*inport_.getData())) {
+            options.emplace_back(name, name, name);
+        }
+        importanceColumn_.replaceOptions(options);
+    });
 }
 
-void TensorGlyphProcessor::process() {
-    if (!inport_.hasData() || !inport_.getData().get()) return;
+TensorGlyphProcessor::~TensorGlyphProcessor() {
+    if (cancelGeneration_) *cancelGeneration_ = true;
+}
 
-    auto tensorField = inport_.getData();
+void TensorGlyphProcessor::updatePlacementVisibility() {
+    const auto mode = placementMode_.get();
+    const auto strided = mode == tensorutil::GlyphPlacement::Regular ||
+                         mode == tensorutil::GlyphPlacement::Jittered;
+    stride_.setVisible(strided);
+    radius_.setVisible(mode == tensorutil::GlyphPlacement::PoissonDisk);
+    count_.setVisible(mode == tensorutil::GlyphPlacement::Importance);
+    importanceColumn_.setVisible(mode == tensorutil::GlyphPlacement::Importance);
+    seed_.setVisible(mode != tensorutil::GlyphPlacement::Regular);
+    usePyramid_.setVisible(strided);
+    pyramidFilter_.setVisible(strided);
+}
 
-    auto dimensions = tensorField->getDimensions();
+tensorutil::GlyphPlacementSettings TensorGlyphProcessor::placementSettings() const {
+    tensorutil::GlyphPlacementSettings settings;
+    settings.placement = placementMode_.get();
+    settings.stride = stride_.get();
+    settings.radius = radius_.get();
+    settings.count = count_.get();
+    settings.seed = static_cast<std::uint64_t>(seed_.get());
 
-    util::IndexMapper3D indexMapper(dimensions);
+    if (settings.placement == tensorutil::GlyphPlacement::Importance &&
+        importanceColumn_.size() > 0) {
+        settings.importanceAttribute = importanceColumn_.get();
+    }
+    return settings;
+}
 
-    auto comp = glm::zero<mat3>();
+tensorutil::GlyphLodSettings TensorGlyphProcessor::lodSettings() const {
+    tensorutil::GlyphLodSettings settings;
+    settings.levels = levels_.get();
+    settings.detailSize = detailSize_.get();
+    settings.scaleByNorm = scaleByNorm_.get();
+    settings.minNorm = minNorm_.get();
+    settings.minAnisotropy = minAnisotropy_.get();
+    return settings;
+}
 
-    auto meshes = new std::vector<std::shared_ptr<Mesh>>();
+bool TensorGlyphProcessor::settingsModified() const {
+    // The statistics of the level of detail are set by the processor itself and left out
+    return output_.isModified() || placement_.isModified() || levels_.isModified() ||
+           detailSize_.isModified() || scaleByNorm_.isModified() || minNorm_.isModified() ||
+           minAnisotropy_.isModified() || glyphParameters_.isModified();
+}
 
-    const vec3 voxelDist{tensorField->getSpacing()};
-    const vec3 offset{tensorField->getOffset()};
+void TensorGlyphProcessor::process() {
+    if (inport_.isChanged() || settingsModified()) generate();
 
-    for (size_t z = 0; z < dimensions.z; z++) {
-        for (size_t y = 0; y < dimensions.y; y++) {
-            for (size_t x = 0; x < dimensions.x; x++) {
-                const auto& tensor = tensorField->at(size3_t(x, y, z));
-                if (tensor == comp) continue;
-                const auto index = indexMapper(size3_t(x, y, z));
+    // Keep the previous glyphs until the new ones are generated
+    if (meshes_) outport_.setData(meshes_);
+}
 
-                // const auto dpos = tensorField->getNormalizedVolumePosition(index);
-                // const auto pos = vec3(dpos);
+void TensorGlyphProcessor::generate() {
+    if (cancelGeneration_) *cancelGeneration_ = true;
+    cancelGeneration_ = std::make_shared<std::atomic<bool>>(false);
 
-                const vec3 pos{voxelDist * vec3{x, y, z} + offset};
+    auto tensorField = inport_.getData();
+    if (!tensorField) {
+        // Nothing to show, do not keep the glyphs of the previous field
+        meshes_.reset();
+        pyramid_.reset();
+        pyramidInput_.reset();
+        outport_.clear();
+        getActivityIndicator().setActive(false);
+        return;
+    }
+
+    // The generation works on a snapshot of the settings, the properties may change meanwhile
+    std::shared_ptr<const TensorGlyphProperty> glyphParameters{glyphParameters_.clone()};
+    const auto merged = output_.get() == Output::Merged;
+    const auto placement = placementSettings();
+    const auto lod = lodSettings();
+
+    // Only the placements with a stride can use the pyramid
+    const auto usePyramid = usePyramid_.get() &&
+                            (placement.placement == tensorutil::GlyphPlacement::Regular ||
+                             placement.placement == tensorutil::GlyphPlacement::Jittered) &&
+                            glm::compMax(placement.stride) > 1;
+    const auto pyramidFilter = pyramidFilter_.get();
+    auto pyramid = usePyramid && pyramidInput_ == tensorField && pyramidFilterUsed_ == pyramidFilter
+                       ? pyramid_
+                       : nullptr;
 
-                meshes->emplace_back(glyphParameters_.generateGlyph(tensorField, index, pos));
+    getActivityIndicator().setActive(true);
+
+    dispatchPool([this, cancel = cancelGeneration_, tensorField, glyphParameters, merged,
+                  placement, lod, usePyramid, pyramidFilter, pyramid]() mutable {
+        std::optional<tensorutil::GeneratedGlyphs> glyphs;
+        bool builtPyramid = false;
+        try {
+            auto source = tensorField;
+            auto levelPlacement = placement;
+            if (usePyramid) {
+                if (!pyramid) {
+                    auto field = std::shared_ptr<TensorField3D>(tensorField->clone());
+                    field->buildPyramid(pyramidFilter);
+                    pyramid = field;
+                    builtPyramid = true;
+                }
+                std::tie(source, levelPlacement.stride) = levelForStride(pyramid, placement.stride);
             }
+            glyphs = tensorutil::generateGlyphs(source, *glyphParameters, merged, levelPlacement,
+                                                lod, [&cancel]() { return cancel->load(); });
+        } catch (const Exception& e) {
+            dispatchFront([this, cancel, glyphParameters, message = e.getMessage()]() {
+                if (*cancel) return;
+                LogError(message);
+                getActivityIndicator().setActive(false);
+            });
+            return;
         }
-    }
 
-    outport_.setData(meshes);
+        // Release the snapshot on the main thread
+        dispatchFront([this, cancel, glyphParameters, glyphs = std::move(glyphs), tensorField,
+                       pyramid = builtPyramid ? pyramid : nullptr, pyramidFilter]() {
+            if (*cancel) return;
+            if (pyramid) {
+                pyramid_ = pyramid;
+                pyramidInput_ = tensorField;
+                pyramidFilterUsed_ = pyramidFilter;
+            }
+            if (!glyphs) return;
+            meshes_ = glyphs->meshes;
+            culled_.set(glyphs->culled);
+            triangles_.set(glyphs->triangles);
+            fullDetailTriangles_.set(glyphs->fullDetailTriangles);
+            getActivityIndicator().setActive(false);
+            invalidate(InvalidationLevel::InvalidOutput);
+        });
+    });
 }
 }  // namespace inviwo
@@ -34,6 +34,8 @@
 #include <inviwo/core/rendering/meshdrawerfactory.h>
 #include <inviwo/core/interaction/events/pickingevent.h>
 #include <inviwo/tensorvisbase/tensorvisbasemodule.h>
+#include <inviwo/tensorvisbase/algorithm/glyphbatch.h>
+#include <inviwo/core/metadata/metadata.h>
 
 namespace inviwo {
 
@@ -94,13 +96,18 @@ TensorGlyphRenderer::TensorGlyphRenderer()
 
     meshInport_.onChange([&]() {
         meshDrawers_.clear();
+        firstGlyphs_.clear();
 
+        size_t numGlyphs = 0;
         for (const auto& mesh : *meshInport_.getData()) {
             meshDrawers_.emplace_back(
                 InviwoApplication::getPtr()->getMeshDrawerFactory()->create(mesh.get()));
+            firstGlyphs_.push_back(numGlyphs);
+            numGlyphs += static_cast<size_t>(
+                mesh->getMetaData<IntMetaData>(tensorutil::GlyphBatch::glyphCountKey, 1));
         }
 
-        picking_.resize(meshInport_.getData()->size());
+        picking_.resize(numGlyphs);
     });
 
     indexOutport_.setData(std::make_shared<size_t>(0));
@@ -175,13 +182,16 @@ void TensorGlyphRenderer::process() {
 
     utilgl::setShaderUniforms(shader_, camera_, "camera");
     utilgl::setShaderUniforms(shader_, lighting_, "light");
-    shader_.setUniform("pickingColor", picking_.getColor());
 
-    signed long long i = 0;
+    size_t i = 0;
     for (auto& drawer : meshDrawers_) {
-        shader_.setUniform("pickingColor", picking_.getColor(i));
+        const auto firstGlyph = firstGlyphs_[i];
+        shader_.setUniform("pickingOffset",
+                           static_cast<glm::uint>(picking_.getPickingId(firstGlyph)));
+        shader_.setUniform("mergedGlyphs", drawer->getMesh()->hasMetaData<IntMetaData>(
+                                               tensorutil::GlyphBatch::glyphCountKey));
+        shader_.setUniform("selectedGlyph", selectedID_ - static_cast<int>(firstGlyph));
         utilgl::setShaderUniforms(shader_, *(drawer->getMesh()), "geometry");
-        shader_.setUniform("highlight", i == selectedID_);
         {
             utilgl::CullFaceState culling1(cullFace_.get());
             drawer->draw();
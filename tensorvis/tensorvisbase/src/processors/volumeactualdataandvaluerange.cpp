@@ -1,6 +1,7 @@
 #include <inviwo/tensorvisbase/processors/volumeactualdataandvaluerange.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/tensorvisbase/tensorvisbasemodule.h>
+#include <inviwo/tensorvisbase/util/rangereduction.h>
 
 namespace inviwo {
 
@@ -35,16 +36,10 @@ void VolumeActualDataAndValueRange::process() {
 
     auto outVolume = inVolume->clone();
 
-    auto min = std::numeric_limits<float>::max();
-    auto max = std::numeric_limits<float>::lowest();
+    const auto ranges = tensorutil::reduceRanges<glm::f32>({{inVolumeData}}, numElements);
 
-    for (size_t i = 0; i < numElements; i++) {
-        min = std::min(min, inVolumeData[i]);
-        max = std::max(max, inVolumeData[i]);
-    }
-
-    outVolume->dataMap_.dataRange = vec2(min, max);
-    outVolume->dataMap_.valueRange = vec2(min, max);
+    outVolume->dataMap_.dataRange = ranges[0].range;
+    outVolume->dataMap_.valueRange = ranges[0].range;
 
     outport_.setData(std::make_shared<Volume>(*outVolume));
 }
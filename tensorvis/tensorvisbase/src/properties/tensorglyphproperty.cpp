@@ -28,12 +28,87 @@
  *********************************************************************************/
 
 #include <inviwo/tensorvisbase/properties/tensorglyphproperty.h>
-#include <inviwo/tensorvisbase/datastructures/deformablesphere.h>
-#include <inviwo/tensorvisbase/datastructures/deformablecube.h>
-#include <inviwo/tensorvisbase/datastructures/deformablecylinder.h>
 #include <inviwo/tensorvisbase/util/tensorfieldutil.h>
 
 namespace inviwo {
+
+namespace {
+
+/**
+ * Copies the template into the slot and moves every vertex with deform(vertexIndex, vertex,
+ * color). If normalize is set the glyph is scaled to fit into the unit sphere. The normals are
+ * computed from the deformed positions.
+ */
+template <typename Deform>
+void deformTemplate(const GlyphTemplate& glyph, const vec4& color, bool normalize,
+                    tensorutil::GlyphSlot& slot, Deform deform) {
+    const auto numVertices = glyph.getNumVertices();
+    std::copy(glyph.getPositions().begin(), glyph.getPositions().end(), slot.positions);
+    std::fill_n(slot.colors, numVertices, color);
+
+    for (size_t i = 0; i < numVertices; ++i) {
+        deform(i, slot.positions[i], slot.colors[i]);
+    }
+
+    if (normalize) {
+        auto maxDist = std::numeric_limits<float>::lowest();
+        for (size_t i = 0; i < numVertices; ++i) {
+            maxDist = glm::max(glm::length(slot.positions[i]), maxDist);
+        }
+        for (size_t i = 0; i < numVertices; ++i) {
+            slot.positions[i] /= maxDist;
+        }
+    }
+
+    glyph.computeNormals(slot.positions, slot.normals);
+    std::copy(glyph.getIndices().begin(), glyph.getIndices().end(), slot.indices);
+}
+
+/**
+ * Creates the mesh of a single glyph. write fills the buffers of the mesh and returns the basis
+ * of the glyph, if any.
+ */
+template <typename Write>
+std::shared_ptr<BasicMesh> createGlyphMesh(const tensorutil::GlyphExtent& extent, const vec3& pos,
+                                           const float size, Write write) {
+    auto mesh = std::make_shared<BasicMesh>();
+    auto& positions =
+        mesh->getEditableVertices()->getEditableRAMRepresentation()->getDataContainer();
+    auto& normals = mesh->getEditableNormals()->getEditableRAMRepresentation()->getDataContainer();
+    auto& colors = mesh->getEditableColors()->getEditableRAMRepresentation()->getDataContainer();
+    auto& indices =
+        mesh->addIndexBuffer(DrawType::Triangles, ConnectivityType::None)->getDataContainer();
+
+    positions.resize(extent.vertices);
+    normals.resize(extent.vertices);
+    colors.resize(extent.vertices);
+    indices.resize(extent.indices);
+    mesh->getEditableTexCoords()->getEditableRAMRepresentation()->getDataContainer().resize(
+        extent.vertices, vec3(0.0f));
+
+    tensorutil::GlyphSlot slot{positions.data(), normals.data(), colors.data(), indices.data(),
+                               extent};
+    if (const std::optional<mat3> basis = write(slot)) {
+        mesh->setBasis(*basis);
+    }
+
+    mesh->setWorldMatrix(glm::translate(pos) * glm::scale(vec3(size)));
+
+    return mesh;
+}
+
+tensorutil::GlyphExtent extentOf(const GlyphTemplate& glyph) {
+    return {glyph.getNumVertices(), glyph.getNumIndices()};
+}
+
+size_t lodResolution(size_t resolution, size_t level) {
+    const size_t minResolution = 4;
+    if (level == 0 || resolution <= minResolution) return resolution;
+    return std::max(resolution >> std::min(level, size_t{16}), minResolution);
+}
+
+}  // namespace
+
 const std::string TensorGlyphProperty::classIdentifier{"org.inviwo.TensorGlyphProperty"};
 std::string TensorGlyphProperty::getClassIdentifier() const { return classIdentifier; }
 
@@ -146,13 +221,6 @@ float TensorGlyphProperty::signedExponentiation(float x, float a) {
     return sgn * std::pow(std::abs(x), a);
 }
 
-vec3 TensorGlyphProperty::cartesianToSpherical(const vec3& pos) const {
-    auto r = glm::length(pos);
-    auto phi = glm::acos(pos.z / r);
-    auto theta = std::atan2(pos.y, pos.x);
-    return vec3(r, phi, theta);
-}
-
 // From Ericsson Real-time collision detection
 std::pair<bool, vec3> TensorGlyphProperty::intersectTriangle(const vec2& coord,
                                                              const std::array<vec2, 3>& tri_verts) {
@@ -181,11 +249,15 @@ std::pair<bool, vec3> TensorGlyphProperty::intersectTriangle(const vec2& coord,
     return {true, vec3(1. - v - w, v, w)};
 }
 
-const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateSuperquadric(
-    std::shared_ptr<const TensorField3D> tensorField, size_t index, const vec3 pos,
-    const vec4& color, const float size) {
-    DeformableSphere sphere(resolutionTheta_.get(), resolutionPhi_.get(), color);
+std::shared_ptr<const GlyphTemplate> TensorGlyphProperty::glyphTemplate(size_t level) const {
+    return GlyphTemplate::get(GlyphTemplate::Shape::Sphere,
+                              lodResolution(resolutionTheta_.get(), level),
+                              lodResolution(resolutionPhi_.get(), level));
+}
 
+mat3 TensorGlyphProperty::writeSuperquadric(
+    const std::shared_ptr<const TensorField3D>& tensorField, size_t index,
+    const GlyphTemplate& sphere, const vec4& color, tensorutil::GlyphSlot& slot) const {
     auto eigenValuesAndEigenVectors =
         tensorutil::getSortedEigenValuesAndEigenVectorsForTensor(tensorField, index);
 
@@ -225,35 +297,14 @@ const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateSuperquadric(
         basis[2] = -basis[2];
     }
 
-    auto mesh = createSuperquadric(eigenValues, pos, size, color);
-    mesh->setBasis(basis);
+    writeSuperquadric(eigenValues, sphere, color, slot);
 
-    return mesh;
-}
-
-const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateSuperquadric(const mat3&, const vec3&,
-                                                                           const float,
-                                                                           const vec4&) const {
-    return std::shared_ptr<BasicMesh>();
-}
-
-const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateSuperquadric(
-    const std::array<float, 3>& eigenValues, const vec3& pos, const float size,
-    const vec4& color) const {
-
-    auto basis = glm::diagonal3x3(dvec3(eigenValues[0], eigenValues[1], eigenValues[2]));
-
-    auto mesh = createSuperquadric(eigenValues, pos, size, color);
-    mesh->setBasis(basis);
-
-    return mesh;
+    return basis;
 }
 
-std::shared_ptr<BasicMesh> TensorGlyphProperty::createSuperquadric(
-    const std::array<float, 3>& eigenValues, const vec3& pos, const float size,
-    const vec4& color) const {
-    DeformableSphere sphere(resolutionTheta_.get(), resolutionPhi_.get(), color);
-
+void TensorGlyphProperty::writeSuperquadric(const std::array<float, 3>& eigenValues,
+                                            const GlyphTemplate& sphere, const vec4& color,
+                                            tensorutil::GlyphSlot& slot) const {
     auto denominator = eigenValues[0] + eigenValues[1] + eigenValues[2];
     auto linearAnisotropy = (eigenValues[0] - eigenValues[1]) / denominator;
     auto planarAnisotropy = (2.0f * (eigenValues[1] - eigenValues[2])) / denominator;
@@ -269,41 +320,30 @@ std::shared_ptr<BasicMesh> TensorGlyphProperty::createSuperquadric(
         beta = glm::pow(1.0f - planarAnisotropy, gamma_.get());
     }
 
-    sphere.deform(
-        [&](vec3& v) {
-            /// Geometry calculation
-            auto sphericalCoords = cartesianToSpherical(v);
-
-            const auto sinphi = glm::sin(sphericalCoords.y);
-            const auto cosphi = glm::cos(sphericalCoords.y);
-            const auto sintheta = glm::sin(sphericalCoords.z);
-            const auto costheta = glm::cos(sphericalCoords.z);
-
-            v = {glm::sign(cosphi) * std::pow(std::abs(cosphi), beta),
-                 (-glm::sign(sintheta) * std::pow(std::abs(sintheta), alpha)) *
-                     (glm::sign(sinphi) * std::pow(std::abs(sinphi), beta)),
-                 (glm::sign(costheta) * std::pow(std::abs(costheta), alpha)) *
-                     (glm::sign(sinphi) * std::pow(std::abs(sinphi), beta))};
-
-            if (linearAnisotropy < planarAnisotropy) {
-                std::swap(v.x, v.z);
-                v.y *= -1.0f;
-            }
-        },
-        false);
-    sphere.transform(pos, vec3(size));
+    const auto& trig = sphere.getSphericalTable();
 
-    return sphere.getGeometry();
-}
+    deformTemplate(sphere, color, false, slot, [&](size_t i, vec3& v, vec4&) {
+        const auto sinphi = trig[i].x;
+        const auto cosphi = trig[i].y;
+        const auto sintheta = trig[i].z;
+        const auto costheta = trig[i].w;
 
-const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateReynolds(
-    std::shared_ptr<const TensorField3D> tensorField, size_t index, const vec3 pos,
-    const float size) {
-    DeformableSphere sphere(resolutionTheta_.get(), resolutionPhi_.get());
+        v = {glm::sign(cosphi) * std::pow(std::abs(cosphi), beta),
+             (-glm::sign(sintheta) * std::pow(std::abs(sintheta), alpha)) *
+                 (glm::sign(sinphi) * std::pow(std::abs(sinphi), beta)),
+             (glm::sign(costheta) * std::pow(std::abs(costheta), alpha)) *
+                 (glm::sign(sinphi) * std::pow(std::abs(sinphi), beta))};
 
-    const auto tensor = mat3(tensorField->at(index));
+        if (linearAnisotropy < planarAnisotropy) {
+            std::swap(v.x, v.z);
+            v.y *= -1.0f;
+        }
+    });
+}
 
-    sphere.deform([tensor](vec3& v, vec4& c) {
+void TensorGlyphProperty::writeReynolds(const mat3& tensor, const GlyphTemplate& sphere,
+                                        tensorutil::GlyphSlot& slot) const {
+    deformTemplate(sphere, vec4(1.0f), true, slot, [&tensor](size_t, vec3& v, vec4& c) {
         const auto displacement = tensor * v;
         const auto scale = glm::dot(displacement, v);
         v = v * scale;
@@ -314,73 +354,11 @@ const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateReynolds(
             c = vec4(0, 1, 0, 1);
         }
     });
-
-    sphere.transform(pos, vec3(size));
-
-    return sphere.getGeometry();
 }
 
-const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateQuadric(
-    std::shared_ptr<const TensorField3D> tensorField, size_t index, const vec3 pos,
-    const vec4& color, const float size) {
-    DeformableSphere sphere(resolutionTheta_.get(), resolutionPhi_.get(), color);
-
-    const auto tensor = mat3(tensorField->at(index));
-
-    sphere.deform([tensor](vec3& v) { v = tensor * v; });
-
-    sphere.transform(pos, vec3(size));
-
-    return sphere.getGeometry();
-}
-
-const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateQuadric(const mat3& tensor,
-                                                                      const vec3& pos,
-                                                                      const float size,
-                                                                      const vec4& color) const {
-    DeformableSphere sphere(resolutionTheta_.get(), resolutionPhi_.get(), color);
-
-    sphere.deform([tensor](vec3& v) { v = mat3(tensor) * v; });
-
-    sphere.transform(pos, vec3(size));
-
-    return sphere.getGeometry();
-}
-
-const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateCube(const mat3& tensor,
-                                                                   const vec3& pos,
-                                                                   const float size,
-                                                                   const vec4& color) const {
-    DeformableCube cube(color);
-
-    cube.deform([tensor](vec3& v) { v = mat3(tensor) * v; });
-
-    cube.transform(pos, vec3(size));
-
-    return cube.getGeometry();
-}
-
-const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateCylinder(const mat3& tensor,
-                                                                       const vec3& pos,
-                                                                       const float size,
-                                                                       const vec4& color) const {
-    DeformableCylinder cylinder(resolutionTheta_.get(), color);
-
-    cylinder.deform([tensor](vec3& v) { v = mat3(tensor) * v; });
-
-    cylinder.transform(pos, vec3(size));
-
-    return cylinder.getGeometry();
-}
-
-const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateHWY(
-    std::shared_ptr<const TensorField3D> tensorField, size_t index, const vec3 pos,
-    const vec4& color, const float size) {
-    DeformableSphere sphere(resolutionTheta_.get(), resolutionPhi_.get(), color);
-
-    const auto tensor = mat3(tensorField->at(index));
-
-    sphere.deform([tensor](vec3& v) {
+void TensorGlyphProperty::writeHWY(const mat3& tensor, const GlyphTemplate& sphere,
+                                   const vec4& color, tensorutil::GlyphSlot& slot) const {
+    deformTemplate(sphere, color, true, slot, [&tensor](size_t, vec3& v, vec4&) {
         const auto displacement = tensor * v;
         const auto normalPart = v * glm::dot(displacement, v);
         const auto orthoPart = displacement - normalPart;
@@ -388,27 +366,35 @@ const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateHWY(
         auto scale = glm::length(orthoPart);
         v = v * scale;
     });
-
-    sphere.transform(pos, vec3(size));
-
-    return sphere.getGeometry();
 }
 
-const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateCombinedReynoldsHWY(
-    std::shared_ptr<const TensorField3D> tensorField, size_t index, const vec3 pos,
-    const vec4& color, const float size) {
-    auto reynolds = generateReynolds(tensorField, index, pos, size);
-    auto hwy = generateHWY(tensorField, index, pos, color, size);
-    reynolds->append(hwy.get());
-
-    return reynolds;
+void TensorGlyphProperty::writeCombinedReynoldsHWY(const mat3& tensor,
+                                                   const GlyphTemplate& sphere,
+                                                   const vec4& color,
+                                                   tensorutil::GlyphSlot& slot) const {
+    const auto extent = extentOf(sphere);
+    tensorutil::GlyphSlot reynolds{slot.positions, slot.normals, slot.colors, slot.indices,
+                                   extent};
+    tensorutil::GlyphSlot hwy{slot.positions + extent.vertices, slot.normals + extent.vertices,
+                              slot.colors + extent.vertices, slot.indices + extent.indices,
+                              extent};
+
+    writeReynolds(tensor, sphere, reynolds);
+    writeHWY(tensor, sphere, color, hwy);
+
+    const auto offset = static_cast<std::uint32_t>(extent.vertices);
+    std::for_each(hwy.indices, hwy.indices + extent.indices,
+                  [offset](std::uint32_t& i) { i += offset; });
 }
 
-const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateSuperquadricExtended(
-    std::shared_ptr<const TensorField3D> tensorField, size_t index, const vec3 pos,
-    const float size) {
-    DeformableSphere sphere(resolutionTheta_.get(), resolutionPhi_.get());
+void TensorGlyphProperty::writeTransformed(const mat3& tensor, const GlyphTemplate& shape,
+                                           const vec4& color, tensorutil::GlyphSlot& slot) const {
+    deformTemplate(shape, color, true, slot, [&tensor](size_t, vec3& v, vec4&) { v = tensor * v; });
+}
 
+mat3 TensorGlyphProperty::writeSuperquadricExtended(
+    const std::shared_ptr<const TensorField3D>& tensorField, size_t index,
+    const GlyphTemplate& sphere, tensorutil::GlyphSlot& slot) const {
     auto eigenValuesAndEigenVectors =
         tensorutil::getSortedEigenValuesAndEigenVectorsForTensor(tensorField, index);
 
@@ -487,40 +473,38 @@ const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateSuperquadricExtend
         }
     }
 
-    sphere.deform([&](vec3& v, vec4& c) {
-        auto alpha = alpha_beta_betaprim.x;
-        auto beta = alpha_beta_betaprim.y;
-        auto beta_prim = alpha_beta_betaprim.z;
+    const auto alpha = alpha_beta_betaprim.x;
+    const auto beta = alpha_beta_betaprim.y;
+    const auto beta_prim = alpha_beta_betaprim.z;
+    const auto mat = glm::diagonal3x3(vec3(eigenValues[0], eigenValues[1], eigenValues[2]));
+    const auto& trig = sphere.getSphericalTable();
 
-        auto spherical_coords = cartesianToSpherical(v);
-        auto phi = spherical_coords.y;
-        auto theta = spherical_coords.z;
+    deformTemplate(sphere, vec4(1.0f), true, slot, [&](size_t i, vec3& v, vec4& c) {
+        const auto sinphi = trig[i].x;
+        const auto cosphi = trig[i].y;
+        const auto sintheta = trig[i].z;
+        const auto costheta = trig[i].w;
 
         if (beta_prim > 0.0f) {
-            auto y_beta = signedExponentiation(glm::sin(theta), alpha) *
-                          signedExponentiation(glm::sin(phi), beta);
-            auto z = signedExponentiation(glm::cos(phi), beta);
+            auto y_beta =
+                signedExponentiation(sintheta, alpha) * signedExponentiation(sinphi, beta);
+            auto z = signedExponentiation(cosphi, beta);
             auto s_beta_prim =
                 signedExponentiation(glm::acos(glm::pow(z, 1.0f / beta_prim)), beta_prim);
-            auto s_max = signedExponentiation(glm::sin(phi), beta);
+            auto s_max = signedExponentiation(sinphi, beta);
 
-            v.x = static_cast<float>(signedExponentiation(glm::cos(theta), alpha) *
-                                     signedExponentiation(glm::sin(phi), beta));
+            v.x = static_cast<float>(signedExponentiation(costheta, alpha) *
+                                     signedExponentiation(sinphi, beta));
             v.y = static_cast<float>(y_beta * s_beta_prim / s_max);
             v.z = static_cast<float>(z);
         } else {
-            v.x = static_cast<float>(signedExponentiation(glm::cos(theta), alpha) *
-                                     signedExponentiation(glm::sin(phi), beta));
-            v.y = static_cast<float>(signedExponentiation(glm::sin(theta), alpha) *
-                                     signedExponentiation(glm::sin(phi), beta));
-            v.z = static_cast<float>(signedExponentiation(glm::cos(phi), beta));
+            v.x = static_cast<float>(signedExponentiation(costheta, alpha) *
+                                     signedExponentiation(sinphi, beta));
+            v.y = static_cast<float>(signedExponentiation(sintheta, alpha) *
+                                     signedExponentiation(sinphi, beta));
+            v.z = static_cast<float>(signedExponentiation(cosphi, beta));
         }
 
-        std::array<float, 3> eigenValues{glm::abs(eigenValuesAndEigenVectors[0].first),
-                                         glm::abs(eigenValuesAndEigenVectors[1].first),
-                                         glm::abs(eigenValuesAndEigenVectors[2].first)};
-
-        auto mat = glm::diagonal3x3(vec3(eigenValues[0], eigenValues[1], eigenValues[2]));
         auto sign = glm::dot(vec3(v), mat * vec3(v));
         if (sign >= 0.0f) {
             c = vec4(0.0f, 0.0f, 1.0f, 1.0f);
@@ -529,100 +513,64 @@ const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateSuperquadricExtend
         }
     });
 
-    sphere.transform(pos, vec3(size));
-
-    auto mesh = sphere.getGeometry();
-
-    mesh->setBasis(basis);
-
-    return mesh;
+    return basis;
 }
 
-const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateGlyph(
-    std::shared_ptr<const TensorField3D> tensorField, size_t index, const vec3 pos) {
+std::optional<mat3> TensorGlyphProperty::writeGlyphGeometry(
+    const std::shared_ptr<const TensorField3D>& tensorField, size_t index, const vec4& color,
+    const GlyphTemplate& sphere, tensorutil::GlyphSlot& slot) const {
     switch (glyphType_.get()) {
         case GlyphType::Reynolds:
-            return generateReynolds(tensorField, index, pos, size_.get());
+            writeReynolds(mat3(tensorField->at(index)), sphere, slot);
+            break;
         case GlyphType::HYW:
-            return generateHWY(tensorField, index, pos, color_.get(), size_.get());
+            writeHWY(mat3(tensorField->at(index)), sphere, color, slot);
+            break;
         case GlyphType::CombinedReynoldsHYW:
-            return generateCombinedReynoldsHWY(tensorField, index, pos, color_.get(), size_.get());
+            writeCombinedReynoldsHWY(mat3(tensorField->at(index)), sphere, color, slot);
+            break;
         case GlyphType::Superquadric:
-            return generateSuperquadric(tensorField, index, pos, color_.get(), size_.get());
+            return writeSuperquadric(tensorField, index, sphere, color, slot);
         case GlyphType::SuperquadricExtended:
-            return generateSuperquadricExtended(tensorField, index, pos, size_.get());
+            return writeSuperquadricExtended(tensorField, index, sphere, slot);
         case GlyphType::Quadric:
-            return generateQuadric(tensorField, index, pos, color_.get(), size_.get());
+            writeTransformed(mat3(tensorField->at(index)), sphere, color, slot);
+            break;
         default:
             break;
     }
-    return std::make_shared<BasicMesh>();
+    return std::nullopt;
+}
+
+const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateGlyph(
+    std::shared_ptr<const TensorField3D> tensorField, size_t index, const vec3 pos) const {
+    return generateGlyph(tensorField, index, pos, color_.get(), size_.get());
 }
 
 const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateGlyph(
     std::shared_ptr<const TensorField3D> tensorField, size_t index, const vec3 pos,
-    const vec4& color) {
-    switch (glyphType_.get()) {
-        case GlyphType::Reynolds:
-            return generateReynolds(tensorField, index, pos, size_.get());
-        case GlyphType::HYW:
-            return generateHWY(tensorField, index, pos, color, size_.get());
-        case GlyphType::CombinedReynoldsHYW:
-            return generateCombinedReynoldsHWY(tensorField, index, pos, color, size_.get());
-        case GlyphType::Superquadric:
-            return generateSuperquadric(tensorField, index, pos, color, size_.get());
-        case GlyphType::SuperquadricExtended:
-            return generateSuperquadricExtended(tensorField, index, pos, size_.get());
-        case GlyphType::Quadric:
-            return generateQuadric(tensorField, index, pos, color, size_.get());
-        default:
-            break;
-    }
-    return std::make_shared<BasicMesh>();
+    const vec4& color) const {
+    return generateGlyph(tensorField, index, pos, color, size_.get());
 }
 
 const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateGlyph(
     std::shared_ptr<const TensorField3D> tensorField, size_t index, const vec3 pos,
-    const float size) {
-    switch (glyphType_.get()) {
-        case GlyphType::Reynolds:
-            return generateReynolds(tensorField, index, pos, size);
-        case GlyphType::HYW:
-            return generateHWY(tensorField, index, pos, color_.get(), size);
-        case GlyphType::CombinedReynoldsHYW:
-            return generateCombinedReynoldsHWY(tensorField, index, pos, color_.get(), size);
-        case GlyphType::Superquadric:
-            return generateSuperquadric(tensorField, index, pos, color_.get(), size);
-        case GlyphType::SuperquadricExtended:
-            return generateSuperquadricExtended(tensorField, index, pos, size);
-        case GlyphType::Quadric:
-            return generateQuadric(tensorField, index, pos, color_.get(), size);
-        default:
-            break;
-    }
-    return std::make_shared<BasicMesh>();
+    const float size) const {
+    return generateGlyph(tensorField, index, pos, color_.get(), size);
 }
 
 const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateGlyph(
     std::shared_ptr<const TensorField3D> tensorField, size_t index, const vec3 pos,
-    const vec4& color, const float size) {
-    switch (glyphType_.get()) {
-        case GlyphType::Reynolds:
-            return generateReynolds(tensorField, index, pos, size);
-        case GlyphType::HYW:
-            return generateHWY(tensorField, index, pos, color, size);
-        case GlyphType::CombinedReynoldsHYW:
-            return generateCombinedReynoldsHWY(tensorField, index, pos, color, size);
-        case GlyphType::Superquadric:
-            return generateSuperquadric(tensorField, index, pos, color, size);
-        case GlyphType::SuperquadricExtended:
-            return generateSuperquadricExtended(tensorField, index, pos, size);
-        case GlyphType::Quadric:
-            return generateQuadric(tensorField, index, pos, color, size);
-        default:
-            break;
-    }
-    return std::make_shared<BasicMesh>();
+    const vec4& color, const float size, size_t level) const {
+    return generateGlyph(tensorField, index, pos, color, size, *glyphTemplate(level));
+}
+
+const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateGlyph(
+    std::shared_ptr<const TensorField3D> tensorField, size_t index, const vec3 pos,
+    const vec4& color, const float size, const GlyphTemplate& sphere) const {
+    return createGlyphMesh(glyphExtent(sphere), pos, size, [&](tensorutil::GlyphSlot& slot) {
+        return writeGlyphGeometry(tensorField, index, color, sphere, slot);
+    });
 }
 
 const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateGlyph(const mat3& tensor,
@@ -644,9 +592,92 @@ const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateGlyph(const mat3&
 }
 
 const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateGlyph(
-    const std::array<float, 3>& eigenvalues, const vec3& pos, const float size,
+    const std::array<float, 3>& eigenValues, const vec3& pos, const float size,
     const vec4& color) const {
-    return generateSuperquadric(eigenvalues, pos, size, color);
+    const auto sphere = glyphTemplate();
+    return createGlyphMesh(extentOf(*sphere), pos, size, [&](tensorutil::GlyphSlot& slot) {
+        writeSuperquadric(eigenValues, *sphere, color, slot);
+        return std::optional<mat3>{
+            glm::diagonal3x3(vec3(eigenValues[0], eigenValues[1], eigenValues[2]))};
+    });
+}
+
+const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateQuadric(const mat3& tensor,
+                                                                      const vec3& pos,
+                                                                      const float size,
+                                                                      const vec4& color) const {
+    const auto sphere = glyphTemplate();
+    return createGlyphMesh(extentOf(*sphere), pos, size, [&](tensorutil::GlyphSlot& slot) {
+        writeTransformed(tensor, *sphere, color, slot);
+        return std::optional<mat3>{};
+    });
+}
+
+const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateCube(const mat3& tensor,
+                                                                   const vec3& pos,
+                                                                   const float size,
+                                                                   const vec4& color) const {
+    const auto cube = GlyphTemplate::get(GlyphTemplate::Shape::Cube);
+    return createGlyphMesh(extentOf(*cube), pos, size, [&](tensorutil::GlyphSlot& slot) {
+        writeTransformed(tensor, *cube, color, slot);
+        return std::optional<mat3>{};
+    });
+}
+
+const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateCylinder(const mat3& tensor,
+                                                                       const vec3& pos,
+                                                                       const float size,
+                                                                       const vec4& color) const {
+    const auto cylinder =
+        GlyphTemplate::get(GlyphTemplate::Shape::Cylinder, resolutionTheta_.get());
+    return createGlyphMesh(extentOf(*cylinder), pos, size, [&](tensorutil::GlyphSlot& slot) {
+        writeTransformed(tensor, *cylinder, color, slot);
+        return std::optional<mat3>{};
+    });
+}
+
+tensorutil::GlyphExtent TensorGlyphProperty::glyphExtent(size_t level) const {
+    return glyphExtent(*glyphTemplate(level));
+}
+
+tensorutil::GlyphExtent TensorGlyphProperty::glyphExtent(const GlyphTemplate& glyph) const {
+    const auto sphere = extentOf(glyph);
+
+    switch (glyphType_.get()) {
+        case GlyphType::Reynolds:
+        case GlyphType::HYW:
+        case GlyphType::Superquadric:
+        case GlyphType::SuperquadricExtended:
+        case GlyphType::Quadric:
+            return sphere;
+        case GlyphType::CombinedReynoldsHYW:
+            return {2 * sphere.vertices, 2 * sphere.indices};
+        default:
+            // Cubes and cylinders are not generated from tensor fields, see generateGlyph
+            return {};
+    }
+}
+
+void TensorGlyphProperty::writeGlyph(std::shared_ptr<const TensorField3D> tensorField,
+                                     size_t index, const vec3& pos,
+                                     tensorutil::GlyphSlot& slot) const {
+    writeGlyph(tensorField, index, pos, size_.get(), 0, slot);
+}
+
+void TensorGlyphProperty::writeGlyph(std::shared_ptr<const TensorField3D> tensorField,
+                                     size_t index, const vec3& pos, float size, size_t level,
+                                     tensorutil::GlyphSlot& slot) const {
+    writeGlyph(tensorField, index, pos, size, *glyphTemplate(level), slot);
+}
+
+void TensorGlyphProperty::writeGlyph(std::shared_ptr<const TensorField3D> tensorField,
+                                     size_t index, const vec3& pos, float size,
+                                     const GlyphTemplate& sphere,
+                                     tensorutil::GlyphSlot& slot) const {
+    const auto basis = writeGlyphGeometry(tensorField, index, color_.get(), sphere, slot);
+
+    tensorutil::transformGlyph(
+        glm::translate(pos) * glm::scale(vec3(size)) * mat4(basis.value_or(mat3(1.0f))), slot);
 }
 
 }  // namespace inviwo
@@ -36,7 +36,10 @@
 #include <inviwo/tensorvisbase/datavisualizer/anisotropyraycastingvisualizer.h>
 
 #include <inviwo/tensorvisbase/ports/tensorfieldport.h>
+#include <inviwo/tensorvisbase/processors/brickedtensorfield3dextract.h>
 #include <inviwo/tensorvisbase/processors/hyperstreamlines.h>
+#include <inviwo/tensorvisbase/processors/sparsetensorfield3dtodataframe.h>
+#include <inviwo/tensorvisbase/processors/sparsetensorfield3dtodense.h>
 #include <inviwo/tensorvisbase/processors/tensorfield2dmetadata.h>
 #include <inviwo/tensorvisbase/processors/tensorfield2dsubsample.h>
 #include <inviwo/tensorvisbase/processors/tensorfield2dsubset.h>
@@ -48,6 +51,7 @@
 #include <inviwo/tensorvisbase/processors/tensorfield3dmetadata.h>
 #include <inviwo/tensorvisbase/processors/tensorfield3dsubsample.h>
 #include <inviwo/tensorvisbase/processors/tensorfield3dsubset.h>
+#include <inviwo/tensorvisbase/processors/tensorfield3dsequencetimestep.h>
 #include <inviwo/tensorvisbase/processors/tensorfield3dtodataframe.h>
 #include <inviwo/tensorvisbase/processors/tensorfield2dgenerator.h>
 #include <inviwo/tensorvisbase/processors/tensorfield2dlic.h>
@@ -71,8 +75,17 @@ TensorVisBaseModule::TensorVisBaseModule(InviwoApplication* app)
     registerPort<TensorField2DOutport>();
     registerPort<TensorField3DInport>();
     registerPort<TensorField3DOutport>();
+    registerPort<TensorField3DSequenceInport>();
+    registerPort<TensorField3DSequenceOutport>();
+    registerPort<SparseTensorField3DInport>();
+    registerPort<SparseTensorField3DOutport>();
+    registerPort<BrickedTensorField3DInport>();
+    registerPort<BrickedTensorField3DOutport>();
 
+    registerProcessor<BrickedTensorField3DExtract>();
     registerProcessor<HyperStreamlines>();
+    registerProcessor<SparseTensorField3DToDataFrame>();
+    registerProcessor<SparseTensorField3DToDense>();
     registerProcessor<TensorField2DMetaData>();
     registerProcessor<TensorField2DSubsample>();
     registerProcessor<TensorField2DSubset>();
@@ -84,6 +97,7 @@ TensorVisBaseModule::TensorVisBaseModule(InviwoApplication* app)
     registerProcessor<TensorField3DMetaData>();
     registerProcessor<TensorField3DSubsample>();
     registerProcessor<TensorField3DSubset>();
+    registerProcessor<TensorField3DSequenceTimestep>();
     registerProcessor<TensorField3DToDataFrame>();
     registerProcessor<TensorField2DGenerator>();
     registerProcessor<TensorField2DLIC>();
@@ -0,0 +1,159 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisbase/util/memorymappedfile.h>
+
+#include <utility>
+
+#ifdef WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace inviwo {
+
+#ifdef WIN32
+MemoryMappedFile::MemoryMappedFile(const std::string& path) : path_(path) {
+    file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE) {
+        file_ = nullptr;
+        throw FileException("Could not open file " + path, IVW_CONTEXT);
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file_, &fileSize)) {
+        close();
+        throw FileException("Could not determine the size of " + path, IVW_CONTEXT);
+    }
+    size_ = static_cast<size_t>(fileSize.QuadPart);
+    if (size_ == 0) return;
+
+    mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping_) {
+        close();
+        throw FileException("Could not map file " + path, IVW_CONTEXT);
+    }
+    data_ = static_cast<const std::byte*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+    if (!data_) {
+        close();
+        throw FileException("Could not map file " + path, IVW_CONTEXT);
+    }
+}
+
+void MemoryMappedFile::close() {
+    if (data_) UnmapViewOfFile(data_);
+    if (mapping_) CloseHandle(mapping_);
+    if (file_) CloseHandle(file_);
+    data_ = nullptr;
+    mapping_ = nullptr;
+    file_ = nullptr;
+    size_ = 0;
+}
+
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& rhs) noexcept
+    : path_(std::move(rhs.path_))
+    , data_(std::exchange(rhs.data_, nullptr))
+    , size_(std::exchange(rhs.size_, 0))
+    , file_(std::exchange(rhs.file_, nullptr))
+    , mapping_(std::exchange(rhs.mapping_, nullptr)) {}
+
+MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& rhs) noexcept {
+    if (this != &rhs) {
+        close();
+        path_ = std::move(rhs.path_);
+        data_ = std::exchange(rhs.data_, nullptr);
+        size_ = std::exchange(rhs.size_, 0);
+        file_ = std::exchange(rhs.file_, nullptr);
+        mapping_ = std::exchange(rhs.mapping_, nullptr);
+    }
+    return *this;
+}
+#else
+MemoryMappedFile::MemoryMappedFile(const std::string& path) : path_(path) {
+    file_ = ::open(path.c_str(), O_RDONLY);
+    if (file_ == -1) {
+        throw FileException("Could not open file " + path, IVW_CONTEXT);
+    }
+
+    struct stat status;
+    if (::fstat(file_, &status) == -1) {
+        close();
+        throw FileException("Could not determine the size of " + path, IVW_CONTEXT);
+    }
+    size_ = static_cast<size_t>(status.st_size);
+    if (size_ == 0) return;
+
+    auto data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file_, 0);
+    if (data == MAP_FAILED) {
+        close();
+        throw FileException("Could not map file " + path, IVW_CONTEXT);
+    }
+    data_ = static_cast<const std::byte*>(data);
+}
+
+void MemoryMappedFile::close() {
+    if (data_) ::munmap(const_cast<std::byte*>(data_), size_);
+    if (file_ != -1) ::close(file_);
+    data_ = nullptr;
+    file_ = -1;
+    size_ = 0;
+}
+
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& rhs) noexcept
+    : path_(std::move(rhs.path_))
+    , data_(std::exchange(rhs.data_, nullptr))
+    , size_(std::exchange(rhs.size_, 0))
+    , file_(std::exchange(rhs.file_, -1)) {}
+
+MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& rhs) noexcept {
+    if (this != &rhs) {
+        close();
+        path_ = std::move(rhs.path_);
+        data_ = std::exchange(rhs.data_, nullptr);
+        size_ = std::exchange(rhs.size_, 0);
+        file_ = std::exchange(rhs.file_, -1);
+    }
+    return *this;
+}
+#endif
+
+MemoryMappedFile::~MemoryMappedFile() { close(); }
+
+}  // namespace inviwo
@@ -0,0 +1,350 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisbase/util/statistics.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/util/glm.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace inviwo {
+namespace tensorutil {
+
+namespace {
+
+struct Partial {
+    double min = std::numeric_limits<double>::max();
+    double max = std::numeric_limits<double>::lowest();
+    size_t count = 0;
+    // Power sums of the values shifted by the center of the range
+    double sums[4] = {0.0, 0.0, 0.0, 0.0};
+};
+
+/**
+ * Reads the components of one column. Both passes process the rows [begin, end) for every
+ * component, writing to consecutive partials.
+ */
+class ColumnReader {
+public:
+    virtual ~ColumnReader() = default;
+    virtual size_t components() const = 0;
+    virtual void range(size_t begin, size_t end, Partial* partials) const = 0;
+    virtual void moments(size_t begin, size_t end, const ColumnStatistics* statistics,
+                         Partial* partials, size_t* histograms) const = 0;
+};
+
+template <typename T>
+class TypedColumnReader : public ColumnReader {
+public:
+    using value_type = typename util::value_type<T>::type;
+    static constexpr size_t numComponents = util::extent<T>::value;
+
+    explicit TypedColumnReader(const T* data)
+        : data_{reinterpret_cast<const value_type*>(data)} {}
+
+    virtual size_t components() const override { return numComponents; }
+
+    virtual void range(size_t begin, size_t end, Partial* partials) const override {
+        for (size_t c = 0; c < numComponents; ++c) {
+            auto& partial = partials[c];
+            for (size_t i = begin; i < end; ++i) {
+                const auto v = static_cast<double>(data_[i * numComponents + c]);
+                if constexpr (std::is_floating_point_v<value_type>) {
+                    if (!std::isfinite(v)) continue;
+                }
+                partial.min = std::min(partial.min, v);
+                partial.max = std::max(partial.max, v);
+                ++partial.count;
+            }
+        }
+    }
+
+    virtual void moments(size_t begin, size_t end, const ColumnStatistics* statistics,
+                         Partial* partials, size_t* histograms) const override {
+        for (size_t c = 0; c < numComponents; ++c) {
+            const auto& stats = statistics[c];
+            if (stats.count == 0) continue;
+
+            auto& partial = partials[c];
+            const auto bins = stats.histogram.size();
+            auto histogram = histograms + c * bins;
+            const auto shift = 0.5 * (stats.range.x + stats.range.y);
+            const auto scale = stats.range.y > stats.range.x
+                                   ? static_cast<double>(bins) / (stats.range.y - stats.range.x)
+                                   : 0.0;
+
+            double s1 = 0.0, s2 = 0.0, s3 = 0.0, s4 = 0.0;
+            for (size_t i = begin; i < end; ++i) {
+                const auto v = static_cast<double>(data_[i * numComponents + c]);
+                if constexpr (std::is_floating_point_v<value_type>) {
+                    if (!std::isfinite(v)) continue;
+                }
+                const auto d = v - shift;
+                const auto d2 = d * d;
+                s1 += d;
+                s2 += d2;
+                s3 += d2 * d;
+                s4 += d2 * d2;
+                const auto bin = static_cast<size_t>((v - stats.range.x) * scale);
+                ++histogram[std::min(bin, bins - 1)];
+            }
+            partial.sums[0] += s1;
+            partial.sums[1] += s2;
+            partial.sums[2] += s3;
+            partial.sums[3] += s4;
+        }
+    }
+
+private:
+    const value_type* data_;
+};
+
+std::string componentName(const std::string& header, size_t component, size_t components) {
+    if (components == 1) return header;
+    if (components <= 4) return header + "." + "xyzw"[component];
+    return header + "[" + std::to_string(component) + "]";
+}
+
+}  // namespace
+
+double ColumnStatistics::quantile(double p) const {
+    if (count == 0 || histogram.empty()) return std::numeric_limits<double>::quiet_NaN();
+    if (range.y <= range.x) return range.x;
+
+    const auto target = std::clamp(p, 0.0, 1.0) * static_cast<double>(count);
+    const auto width = (range.y - range.x) / static_cast<double>(histogram.size());
+    double cumulative = 0.0;
+    for (size_t b = 0; b < histogram.size(); ++b) {
+        const auto binCount = static_cast<double>(histogram[b]);
+        if (binCount > 0.0 && cumulative + binCount >= target) {
+            const auto fraction = (target - cumulative) / binCount;
+            return range.x + (static_cast<double>(b) + fraction) * width;
+        }
+        cumulative += binCount;
+    }
+    return range.y;
+}
+
+std::vector<ColumnStatistics> computeStatistics(const DataFrame& dataFrame, size_t bins) {
+    std::vector<std::shared_ptr<const Column>> columns;
+    for (auto column : dataFrame) {
+        if (column->getHeader() == "index") continue;
+        columns.push_back(column);
+    }
+    return computeStatistics(columns, dataFrame.getNumberOfRows(), bins);
+}
+
+std::vector<ColumnStatistics> computeStatistics(
+    const std::vector<std::shared_ptr<const Column>>& columns, size_t rows, size_t bins) {
+    bins = std::max<size_t>(bins, 1);
+
+    std::vector<std::unique_ptr<ColumnReader>> readers;
+    std::vector<ColumnStatistics> statistics;
+    for (const auto& column : columns) {
+        const auto buffer = column->getBuffer();
+        if (buffer->getSize() != rows) continue;
+
+        const auto ram = buffer->getRepresentation<BufferRAM>();
+        auto reader = ram->dispatch<std::unique_ptr<ColumnReader>>(
+            [](auto typedRam) -> std::unique_ptr<ColumnReader> {
+                using T = util::PrecisionValueType<decltype(typedRam)>;
+                return std::make_unique<TypedColumnReader<T>>(
+                    typedRam->getDataContainer().data());
+            });
+        for (size_t c = 0; c < reader->components(); ++c) {
+            statistics.emplace_back();
+            statistics.back().name = componentName(column->getHeader(), c, reader->components());
+        }
+        readers.push_back(std::move(reader));
+    }
+
+    const auto numStatistics = statistics.size();
+    const auto numChunks = std::max<size_t>(
+        1, std::min(rows / 1024,
+                    4 * static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency()))));
+    const auto chunkSize = (rows + numChunks - 1) / numChunks;
+
+    std::vector<Partial> partials(numChunks * numStatistics);
+
+    const auto forEachChunk = [&](auto&& func) {
+#pragma omp parallel for
+        for (long long chunk = 0; chunk < static_cast<long long>(numChunks); ++chunk) {
+            const size_t begin = std::min(rows, static_cast<size_t>(chunk) * chunkSize);
+            const size_t end = std::min(rows, begin + chunkSize);
+            size_t first = 0;
+            for (const auto& reader : readers) {
+                func(static_cast<size_t>(chunk), *reader, begin, end, first);
+                first += reader->components();
+            }
+        }
+    };
+
+    // First pass, ranges
+    forEachChunk([&](size_t chunk, const ColumnReader& reader, size_t begin, size_t end,
+                     size_t first) {
+        reader.range(begin, end, &partials[chunk * numStatistics + first]);
+    });
+    for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+        for (size_t s = 0; s < numStatistics; ++s) {
+            const auto& partial = partials[chunk * numStatistics + s];
+            auto& stats = statistics[s];
+            stats.range.x = std::min(stats.range.x, partial.min);
+            stats.range.y = std::max(stats.range.y, partial.max);
+            stats.count += partial.count;
+        }
+    }
+    for (auto& stats : statistics) {
+        stats.histogram.assign(stats.count > 0 ? bins : 0, 0);
+    }
+
+    // Second pass, moments and histograms
+    std::vector<size_t> partialHistograms(numChunks * numStatistics * bins, 0);
+    forEachChunk([&](size_t chunk, const ColumnReader& reader, size_t begin, size_t end,
+                     size_t first) {
+        reader.moments(begin, end, &statistics[first], &partials[chunk * numStatistics + first],
+                       &partialHistograms[(chunk * numStatistics + first) * bins]);
+    });
+
+    for (size_t s = 0; s < numStatistics; ++s) {
+        auto& stats = statistics[s];
+        if (stats.count == 0) continue;
+
+        double sums[4] = {0.0, 0.0, 0.0, 0.0};
+        for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+            const auto& partial = partials[chunk * numStatistics + s];
+            for (size_t k = 0; k < 4; ++k) sums[k] += partial.sums[k];
+            const auto histogram = partialHistograms.begin() + (chunk * numStatistics + s) * bins;
+            for (size_t b = 0; b < bins; ++b) stats.histogram[b] += histogram[b];
+        }
+
+        // Central moments from the raw moments about the shift
+        const auto n = static_cast<double>(stats.count);
+        const auto m1 = sums[0] / n;
+        const auto r2 = sums[1] / n;
+        const auto r3 = sums[2] / n;
+        const auto r4 = sums[3] / n;
+        const auto mu2 = std::max(0.0, r2 - m1 * m1);
+        const auto mu3 = r3 - 3.0 * m1 * r2 + 2.0 * m1 * m1 * m1;
+        const auto mu4 = r4 - 4.0 * m1 * r3 + 6.0 * m1 * m1 * r2 - 3.0 * m1 * m1 * m1 * m1;
+
+        stats.mean = 0.5 * (stats.range.x + stats.range.y) + m1;
+        stats.variance = mu2;
+        if (mu2 > 0.0) {
+            stats.skewness = mu3 / std::pow(mu2, 1.5);
+            stats.kurtosis = mu4 / (mu2 * mu2) - 3.0;
+        }
+    }
+
+    return statistics;
+}
+
+const std::vector<double>& defaultQuantiles() {
+    static const std::vector<double> quantiles{0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99};
+    return quantiles;
+}
+
+std::shared_ptr<DataFrame> statisticsToDataFrame(const std::vector<ColumnStatistics>& statistics,
+                                                 const std::vector<double>& quantiles) {
+    const auto size = statistics.size();
+    std::vector<std::string> names(size);
+    std::vector<glm::u64> count(size);
+    std::vector<double> min(size), max(size), mean(size), deviation(size), skewness(size),
+        kurtosis(size);
+    std::vector<std::vector<double>> quantileValues(quantiles.size(), std::vector<double>(size));
+
+    for (size_t i = 0; i < size; ++i) {
+        const auto& stats = statistics[i];
+        names[i] = stats.name;
+        count[i] = stats.count;
+        min[i] = stats.range.x;
+        max[i] = stats.range.y;
+        mean[i] = stats.mean;
+        deviation[i] = std::sqrt(stats.variance);
+        skewness[i] = stats.skewness;
+        kurtosis[i] = stats.kurtosis;
+        for (size_t q = 0; q < quantiles.size(); ++q) {
+            quantileValues[q][i] = stats.quantile(quantiles[q]);
+        }
+    }
+
+    auto dataFrame = std::make_shared<DataFrame>();
+    dataFrame->addCategoricalColumn("Column", names);
+    dataFrame->addColumn(std::make_shared<TemplateColumn<glm::u64>>("Count", std::move(count)));
+    const auto add = [&](const std::string& header, std::vector<double>& data) {
+        dataFrame->addColumn(std::make_shared<TemplateColumn<double>>(header, std::move(data)));
+    };
+    add("Min", min);
+    add("Max", max);
+    add("Mean", mean);
+    add("Standard Deviation", deviation);
+    add("Skewness", skewness);
+    add("Kurtosis", kurtosis);
+    for (size_t q = 0; q < quantiles.size(); ++q) {
+        std::ostringstream header;
+        header << "P" << std::setprecision(3) << 100.0 * quantiles[q];
+        add(header.str(), quantileValues[q]);
+    }
+    dataFrame->updateIndexBuffer();
+
+    return dataFrame;
+}
+
+std::shared_ptr<DataFrame> histogramsToDataFrame(const std::vector<ColumnStatistics>& statistics) {
+    std::vector<std::string> names;
+    std::vector<double> binStart, binEnd;
+    std::vector<glm::u64> count;
+
+    for (const auto& stats : statistics) {
+        const auto bins = stats.histogram.size();
+        const auto width = bins > 0 ? (stats.range.y - stats.range.x) / bins : 0.0;
+        for (size_t b = 0; b < bins; ++b) {
+            names.push_back(stats.name);
+            binStart.push_back(stats.range.x + b * width);
+            binEnd.push_back(stats.range.x + (b + 1) * width);
+            count.push_back(stats.histogram[b]);
+        }
+    }
+
+    auto dataFrame = std::make_shared<DataFrame>();
+    dataFrame->addCategoricalColumn("Column", names);
+    dataFrame->addColumn(
+        std::make_shared<TemplateColumn<double>>("Bin Start", std::move(binStart)));
+    dataFrame->addColumn(std::make_shared<TemplateColumn<double>>("Bin End", std::move(binEnd)));
+    dataFrame->addColumn(std::make_shared<TemplateColumn<glm::u64>>("Count", std::move(count)));
+    dataFrame->updateIndexBuffer();
+
+    return dataFrame;
+}
+
+}  // namespace tensorutil
+}  // namespace inviwo
@@ -0,0 +1,215 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisbase/util/symmetriceigensolver.h>
+#include <inviwo/core/util/stdextensions.h>
+#include <modules/eigenutils/eigenutils.h>
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <Eigen/Dense>
+#include <warn/pop>
+
+namespace inviwo {
+namespace tensorutil {
+
+namespace {
+constexpr size_t lanes = 8;
+
+/*
+ * General (non-symmetric) decomposition, real parts of the eigen pairs sorted descending.
+ */
+void generalEigenSystem(const mat3& tensor, float (&values)[3], float (&vectors)[3][3]) {
+    Eigen::EigenSolver<Eigen::Matrix3f> solver(util::glm2eigen(tensor));
+    const auto eigenValues = util::eigen2glm<float, 3, 1>(solver.eigenvalues().real());
+    const auto eigenVectors = util::eigen2glm<float, 3, 3>(solver.eigenvectors().real());
+
+    const auto range = util::as_range(glm::value_ptr(eigenValues), glm::value_ptr(eigenValues) + 3);
+    const auto ordering = util::ordering(range, std::greater<float>());
+
+    for (int i = 0; i < 3; ++i) {
+        values[i] = eigenValues[ordering[i]];
+        for (int k = 0; k < 3; ++k) vectors[i][k] = eigenVectors[ordering[i]][k];
+    }
+}
+
+/*
+ * Loader is called as loader(index, a00, a11, a22, a01, a02, a12) and returns whether the tensor
+ * is symmetric. Solver is called for non-symmetric tensors and fills values and vectors.
+ */
+template <typename Loader, typename Solver>
+void solveBlocks(size_t count, Loader loader, Solver generalSolver, float* majorEigenValues,
+                 float* intermediateEigenValues, float* minorEigenValues, vec3* majorEigenVectors,
+                 vec3* intermediateEigenVectors, vec3* minorEigenVectors) {
+    const auto numBlocks = static_cast<int>((count + lanes - 1) / lanes);
+
+#pragma omp parallel for
+    for (int block = 0; block < numBlocks; ++block) {
+        const size_t begin = static_cast<size_t>(block) * lanes;
+        const size_t n = std::min(lanes, count - begin);
+
+        // Structure-of-arrays copy of the normalized upper triangles. Padding lanes are zero.
+        double a00[lanes]{}, a11[lanes]{}, a22[lanes]{}, a01[lanes]{}, a02[lanes]{}, a12[lanes]{};
+        double scale[lanes]{};
+        bool symmetric[lanes]{};
+
+        for (size_t l = 0; l < n; ++l) {
+            symmetric[l] = loader(begin + l, a00[l], a11[l], a22[l], a01[l], a02[l], a12[l]);
+        }
+
+        for (size_t l = 0; l < lanes; ++l) {
+            scale[l] = std::max({std::abs(a00[l]), std::abs(a11[l]), std::abs(a22[l]),
+                                 std::abs(a01[l]), std::abs(a02[l]), std::abs(a12[l])});
+            const double inv = scale[l] > 0.0 ? 1.0 / scale[l] : 0.0;
+            a00[l] *= inv;
+            a11[l] *= inv;
+            a22[l] *= inv;
+            a01[l] *= inv;
+            a02[l] *= inv;
+            a12[l] *= inv;
+        }
+
+        // Closed-form eigenvalues, branch-free over the lanes
+        double l0[lanes], l1[lanes], l2[lanes];
+        for (size_t l = 0; l < lanes; ++l) {
+            const double p1 = a01[l] * a01[l] + a02[l] * a02[l] + a12[l] * a12[l];
+            const double q = (a00[l] + a11[l] + a22[l]) / 3.0;
+            const double b00 = a00[l] - q;
+            const double b11 = a11[l] - q;
+            const double b22 = a22[l] - q;
+            const double p = std::sqrt((b00 * b00 + b11 * b11 + b22 * b22 + 2.0 * p1) / 6.0);
+            const double det = b00 * (b11 * b22 - a12[l] * a12[l]) -
+                               a01[l] * (a01[l] * b22 - a12[l] * a02[l]) +
+                               a02[l] * (a01[l] * a12[l] - b11 * a02[l]);
+            const double denominator = p > 0.0 ? 2.0 * p * p * p : 1.0;
+            const double r = std::min(std::max(det / denominator, -1.0), 1.0);
+            const double phi = std::acos(r) / 3.0;
+
+            l0[l] = q + 2.0 * p * std::cos(phi);
+            l2[l] = q + 2.0 * p * std::cos(phi + 2.0943951023931954923);
+            l1[l] = 3.0 * q - l0[l] - l2[l];
+        }
+
+        // Eigenvectors and fallbacks per lane
+        for (size_t l = 0; l < n; ++l) {
+            const size_t i = begin + l;
+            float values[3];
+            float vectors[3][3];
+
+            if (scale[l] == 0.0) {
+                for (int k = 0; k < 3; ++k) {
+                    values[k] = 0.0f;
+                    vectors[k][0] = vectors[k][1] = vectors[k][2] = 0.0f;
+                }
+            } else if (!symmetric[l]) {
+                generalSolver(i, values, vectors);
+            } else {
+                double v[3] = {l0[l], l1[l], l2[l]};
+                double e[3][3];
+
+                const double gap = std::min(v[0] - v[1], v[1] - v[2]);
+                const double range = std::max(std::abs(v[0]), std::abs(v[2]));
+
+                if (gap > detail::eigenGapTolerance<double>() * range &&
+                    detail::symmetricEigenVector(a00[l], a11[l], a22[l], a01[l], a02[l], a12[l],
+                                                 v[0], 1.0, e[0]) &&
+                    detail::symmetricEigenVector(a00[l], a11[l], a22[l], a01[l], a02[l], a12[l],
+                                                 v[2], 1.0, e[2])) {
+                    e[1][0] = e[2][1] * e[0][2] - e[2][2] * e[0][1];
+                    e[1][1] = e[2][2] * e[0][0] - e[2][0] * e[0][2];
+                    e[1][2] = e[2][0] * e[0][1] - e[2][1] * e[0][0];
+                } else {
+                    detail::jacobiEigenSystem(a00[l], a11[l], a22[l], a01[l], a02[l], a12[l], v,
+                                              e);
+                }
+
+                for (int k = 0; k < 3; ++k) {
+                    values[k] = static_cast<float>(v[k] * scale[l]);
+                    for (int c = 0; c < 3; ++c) vectors[k][c] = static_cast<float>(e[k][c]);
+                }
+            }
+
+            majorEigenValues[i] = values[0];
+            intermediateEigenValues[i] = values[1];
+            minorEigenValues[i] = values[2];
+            majorEigenVectors[i] = vec3(vectors[0][0], vectors[0][1], vectors[0][2]);
+            intermediateEigenVectors[i] = vec3(vectors[1][0], vectors[1][1], vectors[1][2]);
+            minorEigenVectors[i] = vec3(vectors[2][0], vectors[2][1], vectors[2][2]);
+        }
+    }
+}
+}  // namespace
+
+void symmetricEigenSystems(const mat3* tensors, size_t count, float* majorEigenValues,
+                           float* intermediateEigenValues, float* minorEigenValues,
+                           vec3* majorEigenVectors, vec3* intermediateEigenVectors,
+                           vec3* minorEigenVectors) {
+    solveBlocks(
+        count,
+        [tensors](size_t i, double& a00, double& a11, double& a22, double& a01, double& a02,
+                  double& a12) {
+            const auto& t = tensors[i];
+            a00 = t[0][0];
+            a11 = t[1][1];
+            a22 = t[2][2];
+            a01 = t[1][0];
+            a02 = t[2][0];
+            a12 = t[2][1];
+            return isSymmetric(t);
+        },
+        [tensors](size_t i, float(&values)[3], float(&vectors)[3][3]) {
+            generalEigenSystem(tensors[i], values, vectors);
+        },
+        majorEigenValues, intermediateEigenValues, minorEigenValues, majorEigenVectors,
+        intermediateEigenVectors, minorEigenVectors);
+}
+
+void symmetricEigenSystems(const std::array<float, 6>* tensors, size_t count,
+                           float* majorEigenValues, float* intermediateEigenValues,
+                           float* minorEigenValues, vec3* majorEigenVectors,
+                           vec3* intermediateEigenVectors, vec3* minorEigenVectors) {
+    solveBlocks(
+        count,
+        [tensors](size_t i, double& a00, double& a11, double& a22, double& a01, double& a02,
+                  double& a12) {
+            const auto& t = tensors[i];
+            a00 = t[0];
+            a01 = t[1];
+            a02 = t[2];
+            a11 = t[3];
+            a12 = t[4];
+            a22 = t[5];
+            return true;
+        },
+        [](size_t, float(&)[3], float(&)[3][3]) {}, majorEigenValues, intermediateEigenValues,
+        minorEigenValues, majorEigenVectors, intermediateEigenVectors, minorEigenVectors);
+}
+
+}  // namespace tensorutil
+}  // namespace inviwo
@@ -32,6 +32,10 @@
 #include <inviwo/tensorvisbase/util/tensorfieldutil.h>
 #include <inviwo/tensorvisbase/algorithm/tensorfieldsampling.h>
 
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
 namespace inviwo {
 namespace tensorutil {
 void bindTensorFieldAsColorTexture(std::shared_ptr<Image>& texture,
@@ -47,119 +51,200 @@ void bindTensorFieldAsColorTexture(std::shared_ptr<Image>& texture, TensorField2
     bindTensorFieldAsColorTexture(texture, inport.getData(), shader, textureUnits);
 }
 
-void bindTensorFieldAsVolume(std::array<std::shared_ptr<Volume>, 3> volumes,
+void bindTensorFieldAsVolume(std::array<std::shared_ptr<const Volume>, 3>& volumes,
                              std::shared_ptr<const TensorField3D>& tensorField, Shader& shader,
                              TextureUnitContainer& textureUnits) {
 
     volumes = tensorField->getVolumeRepresentation();
-    auto volumeCol1 = volumes[0];
-    auto volumeCol2 = volumes[1];
-    auto volumeCol3 = volumes[2];
 
-    utilgl::bindAndSetUniforms(shader, textureUnits, *volumeCol1, "tensorFieldCol1");
-    utilgl::bindAndSetUniforms(shader, textureUnits, *volumeCol2, "tensorFieldCol2");
-    utilgl::bindAndSetUniforms(shader, textureUnits, *volumeCol3, "tensorFieldCol3");
+    utilgl::bindAndSetUniforms(shader, textureUnits, *volumes[0], "tensorFieldCol1");
+    utilgl::bindAndSetUniforms(shader, textureUnits, *volumes[1], "tensorFieldCol2");
+    utilgl::bindAndSetUniforms(shader, textureUnits, *volumes[2], "tensorFieldCol3");
 }
 
-std::shared_ptr<TensorField2D> subsample2D(std::shared_ptr<const TensorField2D> tensorField,
-                                           size2_t newDimensions,
-                                           const InterpolationMethod method) {
-    std::vector<TensorField2D::matN> dataNew;
-    dataNew.resize(newDimensions.x * newDimensions.y);
-
-    util::IndexMapper2D indexMapperNew(newDimensions);
-
-    const auto bounds = tensorField->getBounds<double>();
-    const auto newBounds = glm::dvec2(newDimensions - size_t(1));
-
-    const auto xFrac = bounds.x / newBounds.x;
-    const auto yFrac = bounds.y / newBounds.y;
-
-    for (size_t x = 0; x < newDimensions.x; x++) {
-        for (size_t y = 0; y < newDimensions.y; y++) {
-            // Find position in old tensor field
-            auto pos = dvec2(xFrac * static_cast<double>(x), yFrac * static_cast<double>(y));
-            auto posNormalized = pos / bounds;
-
-            // Sample old tensor field at position
-            auto tensor = sample(tensorField, posNormalized, method);
-
-            // Assign tensor at x,y
-            dataNew[indexMapperNew(size2_t(x, y))] = tensor;
+namespace {
+/**
+ * Source indices and interpolation weights along one axis of the output, the tensor at
+ * lower[i] is weighted by 1 - weight[i] and the one at upper[i] by weight[i].
+ */
+struct AxisWeights {
+    std::vector<size_t> lower;
+    std::vector<size_t> upper;
+    std::vector<float> weight;
+};
+
+AxisWeights axisWeights(size_t dimension, size_t newDimension, const InterpolationMethod method) {
+    AxisWeights axis;
+    axis.lower.resize(newDimension);
+    axis.upper.resize(newDimension);
+    axis.weight.resize(newDimension, 0.0f);
+
+    const auto scale = newDimension > 1 ? static_cast<double>(dimension - 1) /
+                                              static_cast<double>(newDimension - 1)
+                                        : 0.0;
+    for (size_t i = 0; i < newDimension; ++i) {
+        const auto position = scale * static_cast<double>(i);
+        if (method == InterpolationMethod::Nearest) {
+            axis.lower[i] = std::min(static_cast<size_t>(std::round(position)), dimension - 1);
+            axis.upper[i] = axis.lower[i];
+        } else {
+            axis.lower[i] = std::min(static_cast<size_t>(position), dimension - 1);
+            axis.upper[i] = std::min(axis.lower[i] + 1, dimension - 1);
+            if (axis.upper[i] != axis.lower[i]) {
+                axis.weight[i] =
+                    static_cast<float>(position - static_cast<double>(axis.lower[i]));
+            }
         }
     }
-
-    return std::make_shared<TensorField2D>(newDimensions, dataNew);
+    return axis;
 }
 
-std::shared_ptr<TensorField3D> subsample3D(std::shared_ptr<const TensorField3D> tensorField,
-                                           size3_t newDimensions,
-                                           const InterpolationMethod method) {
-    std::vector<mat3> dataNew;
-    dataNew.resize(newDimensions.x * newDimensions.y * newDimensions.z);
-
-    util::IndexMapper3D indexMapperNew(newDimensions);
+template <typename Field>
+std::shared_ptr<Field> resample(const Field& tensorField,
+                                const typename Field::sizeN_t& newDimensions,
+                                const InterpolationMethod method,
+                                const std::function<void(float)>& progress,
+                                const std::function<bool()>& cancelled) {
+    using sizeN_t = typename Field::sizeN_t;
+    using matN = typename Field::matN;
+    constexpr auto N = Field::dimensionality;
+    // Tiles of 4096 output tensors, their sources stay in cache while a tile is resampled
+    constexpr size_t tileSize = N == 3 ? 16 : 64;
+
+    const auto dimensions = tensorField.getDimensions();
+    std::array<AxisWeights, N> axes;
+    for (unsigned int d = 0; d < N; ++d) {
+        axes[d] = axisWeights(dimensions[d], newDimensions[d], method);
+    }
 
-    auto xFrac = 1.0f / static_cast<float>(newDimensions.x - 1);
-    auto yFrac = 1.0f / static_cast<float>(newDimensions.y - 1);
-    auto zFrac = 1.0f / static_cast<float>(newDimensions.z - 1);
+    const auto& indexMapper = tensorField.indexMapper();
+    const util::IndexMapper<N> newIndexMapper(newDimensions);
+    const auto numTiles = (newDimensions + sizeN_t(tileSize - 1)) / sizeN_t(tileSize);
+    const util::IndexMapper<N> tileMapper(numTiles);
+    const auto tileCount = glm::compMul(numTiles);
+
+    const auto interpolate = [&](const sizeN_t& position) -> matN {
+        sizeN_t lower;
+        sizeN_t upper;
+        glm::vec<N, float> weight;
+        for (unsigned int d = 0; d < N; ++d) {
+            lower[d] = axes[d].lower[position[d]];
+            upper[d] = axes[d].upper[position[d]];
+            weight[d] = axes[d].weight[position[d]];
+        }
 
-    for (size_t x = 0; x < newDimensions.x; x++) {
-        for (size_t y = 0; y < newDimensions.y; y++) {
-            for (size_t z = 0; z < newDimensions.z; z++) {
-                // Find position in old tensor field
-                auto pos = dvec3(xFrac * static_cast<float>(x), yFrac * static_cast<float>(y),
-                                 zFrac * static_cast<float>(z));
+        if (method == InterpolationMethod::Nearest) {
+            return tensorField.at(indexMapper(lower));
+        }
 
-                // Sample old tensor field at position
-                auto tensor = sample(tensorField, pos, method);
+        if constexpr (N == 2) {
+            if (method == InterpolationMethod::Barycentric) {
+                // Split the cell along its diagonal from lower to upper
+                const auto& t00 = tensorField.at(indexMapper(lower));
+                const auto& t11 = tensorField.at(indexMapper(upper));
+                if (weight.y <= weight.x) {
+                    const auto& t10 = tensorField.at(indexMapper(sizeN_t(upper.x, lower.y)));
+                    return (1.0f - weight.x) * t00 + (weight.x - weight.y) * t10 + weight.y * t11;
+                } else {
+                    const auto& t01 = tensorField.at(indexMapper(sizeN_t(lower.x, upper.y)));
+                    return (1.0f - weight.y) * t00 + weight.x * t11 + (weight.y - weight.x) * t01;
+                }
+            }
+        }
 
-                // Assign tensor at x,y
-                dataNew[indexMapperNew(size3_t(x, y, z))] = tensor.second;
+        matN tensor(0.0f);
+        for (size_t corner = 0; corner < (size_t{1} << N); ++corner) {
+            sizeN_t source;
+            float cornerWeight = 1.0f;
+            for (unsigned int d = 0; d < N; ++d) {
+                const bool isUpper = (corner >> d) & 1;
+                source[d] = isUpper ? upper[d] : lower[d];
+                cornerWeight *= isUpper ? weight[d] : 1.0f - weight[d];
+            }
+            if (cornerWeight != 0.0f) tensor += cornerWeight * tensorField.at(indexMapper(source));
+        }
+        return tensor;
+    };
+
+    std::vector<matN> tensors(glm::compMul(newDimensions));
+
+    // Tiles are processed in parallel batches, progress is reported and cancellation checked
+    // between the batches from the calling thread
+    const auto batchSize =
+        4 * static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency()));
+    for (size_t batch = 0; batch < tileCount; batch += batchSize) {
+        if (cancelled && cancelled()) return nullptr;
+
+        const auto batchEnd = std::min(tileCount, batch + batchSize);
+#pragma omp parallel for schedule(dynamic)
+        for (long long tile = batch; tile < static_cast<long long>(batchEnd); ++tile) {
+            const auto first = tileMapper(static_cast<size_t>(tile)) * sizeN_t(tileSize);
+            const auto last = glm::min(first + sizeN_t(tileSize), newDimensions);
+
+            sizeN_t position;
+            if constexpr (N == 3) {
+                for (position.z = first.z; position.z < last.z; ++position.z) {
+                    for (position.y = first.y; position.y < last.y; ++position.y) {
+                        for (position.x = first.x; position.x < last.x; ++position.x) {
+                            tensors[newIndexMapper(position)] = interpolate(position);
+                        }
+                    }
+                }
+            } else {
+                for (position.y = first.y; position.y < last.y; ++position.y) {
+                    for (position.x = first.x; position.x < last.x; ++position.x) {
+                        tensors[newIndexMapper(position)] = interpolate(position);
+                    }
+                }
             }
         }
+
+        if (progress) progress(static_cast<float>(batchEnd) / static_cast<float>(tileCount));
     }
 
-    auto outField = std::make_shared<TensorField3D>(newDimensions, dataNew);
-    outField->setExtents(tensorField->getExtents());
+    auto outField = std::make_shared<Field>(newDimensions, std::move(tensors));
+    outField->setBasis(tensorField.getBasis());
+    outField->setOffset(tensorField.getOffset());
     return outField;
 }
+}  // namespace
 
-std::shared_ptr<TensorField3D> subsample3D(std::shared_ptr<const TensorField3D> tensorField,
-                                           size3_t newDimensions, const InterpolationMethod method,
-                                           std::function<void(float)> fun) {
-    std::vector<mat3> dataNew;
-    dataNew.resize(newDimensions.x * newDimensions.y * newDimensions.z);
-
-    util::IndexMapper3D indexMapperNew(newDimensions);
+std::shared_ptr<TensorField2D> subsample2D(std::shared_ptr<const TensorField2D> tensorField,
+                                           size2_t newDimensions,
+                                           const InterpolationMethod method) {
+    return resample(*tensorField, newDimensions, method, nullptr, nullptr);
+}
 
-    auto xFrac = 1.0f / static_cast<float>(newDimensions.x - 1);
-    auto yFrac = 1.0f / static_cast<float>(newDimensions.y - 1);
-    auto zFrac = 1.0f / static_cast<float>(newDimensions.z - 1);
+std::shared_ptr<TensorField2D> subsample2D(std::shared_ptr<const TensorField2D> tensorField,
+                                           size2_t newDimensions, const InterpolationMethod method,
+                                           std::function<void(float)> progress,
+                                           std::function<bool()> cancelled) {
+    return resample(*tensorField, newDimensions, method, progress, cancelled);
+}
 
-    const auto numElements =
-        static_cast<float>(newDimensions.x * newDimensions.y * newDimensions.z);
-    float i = 0.f;
+std::shared_ptr<TensorField3D> subsample3D(std::shared_ptr<const TensorField3D> tensorField,
+                                           size3_t newDimensions,
+                                           const InterpolationMethod method) {
+    return resample(*tensorField, newDimensions, method, nullptr, nullptr);
+}
 
-    for (size_t x = 0; x < newDimensions.x; x++) {
-        for (size_t y = 0; y < newDimensions.y; y++) {
-            for (size_t z = 0; z < newDimensions.z; z++) {
-                fun(std::min(0.99f, i++ / numElements));
-                // Find position in old tensor field
-                auto pos = vec3(xFrac * static_cast<float>(x), yFrac * static_cast<float>(y),
-                                zFrac * static_cast<float>(z));
+std::shared_ptr<TensorField3D> subsample3D(std::shared_ptr<const TensorField3D> tensorField,
+                                           size3_t newDimensions, const InterpolationMethod method,
+                                           std::function<void(float)> progress,
+                                           std::function<bool()> cancelled) {
+    return resample(*tensorField, newDimensions, method, progress, cancelled);
+}
 
-                // Sample old tensor field at position
-                auto tensor = sample(tensorField, pos, method);
+std::shared_ptr<const TensorField2D> selectLevel(std::shared_ptr<const TensorField2D> tensorField,
+                                                 const size2_t& dimensions) {
+    const auto level = tensorField->getLevelFor(dimensions);
+    return level == 0 ? tensorField : tensorField->getLevel(level);
+}
 
-                // Assign tensor at x,y
-                dataNew[indexMapperNew(size3_t(x, y, z))] = tensor.second;
-            }
-        }
-    }
-    auto outField = std::make_shared<TensorField3D>(newDimensions, dataNew);
-    outField->setExtents(tensorField->getExtents());
-    return outField;
+std::shared_ptr<const TensorField3D> selectLevel(std::shared_ptr<const TensorField3D> tensorField,
+                                                 const size3_t& dimensions) {
+    const auto level = tensorField->getLevelFor(dimensions);
+    return level == 0 ? tensorField : tensorField->getLevel(level);
 }
 
 std::shared_ptr<PosTexColorMesh> generateBoundingBoxAdjacencyForTensorField(
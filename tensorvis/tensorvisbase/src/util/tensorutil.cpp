@@ -74,6 +74,10 @@ std::array<std::pair<double, dvec3>, 3> calculateEigenValuesAndEigenVectors(cons
                                                        std::pair<double, dvec3>{0, dvec3(0)}};
     }
 
+    if (isSymmetric(tensor)) {
+        return symmetricEigenSystem(tensor);
+    }
+
     Eigen::EigenSolver<Eigen::Matrix<double, 3, 3>> solver(util::glm2eigen(tensor));
 
     auto lambda1 = solver.eigenvalues().col(0)[0].real();
@@ -108,6 +112,11 @@ std::array<double, 3> calculateEigenValues(const dmat3 &tensor) {
         return std::array<double, 3>{0, 0, 0};
     }
 
+    if (isSymmetric(tensor)) {
+        const auto eigenSystem = symmetricEigenSystem(tensor);
+        return {eigenSystem[0].first, eigenSystem[1].first, eigenSystem[2].first};
+    }
+
     Eigen::EigenSolver<Eigen::Matrix<double, 3, 3>> solver(util::glm2eigen(tensor));
 
     auto lambda1 = solver.eigenvalues().col(0)[0].real();
@@ -127,6 +136,11 @@ dmat3 IVW_MODULE_TENSORVISBASE_API calculateEigenSystem(const dmat3 &tensor) {
         return dmat3(0.0);
     }
 
+    if (isSymmetric(tensor)) {
+        const auto eigenSystem = symmetricEigenSystem(tensor);
+        return dmat3(eigenSystem[0].second, eigenSystem[1].second, eigenSystem[2].second);
+    }
+
     Eigen::EigenSolver<Eigen::Matrix<double, 3, 3>> solver(util::glm2eigen(tensor));
 
     auto lambda1 = solver.eigenvalues().col(0)[0].real();
@@ -0,0 +1,170 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <benchmark/benchmark.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/algorithm/tensorfield3dsampler.h>
+#include <inviwo/tensorvisbase/algorithm/tensorfieldsampling.h>
+#include <inviwo/tensorvisbase/algorithm/tensorfieldslicing.h>
+#include <inviwo/tensorvisbase/properties/tensorglyphproperty.h>
+#include <inviwo/tensorvisbase/util/symmetriceigensolver.h>
+#include <inviwo/tensorvisbase/util/tensorfieldutil.h>
+
+#include <random>
+
+/**
+ * Benchmarks of the hot paths of the module on synthetic fields of n^3 random symmetric tensors.
+ * n runs in powers of two from 16 to TENSORVIS_BENCHMARK_MAX_SIZE, which is set through the
+ * IVW_TENSORVIS_BENCHMARK_MAX_SIZE CMake variable. Use --benchmark_filter to select benchmarks.
+ */
+
+#ifndef TENSORVIS_BENCHMARK_MAX_SIZE
+#define TENSORVIS_BENCHMARK_MAX_SIZE 128
+#endif
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<std::vector<mat3>> randomTensors(size_t count) {
+    std::mt19937 gen(count);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    auto tensors = std::make_shared<std::vector<mat3>>(count);
+    for (auto& tensor : *tensors) {
+        for (glm::length_t col = 0; col < 3; ++col) {
+            for (glm::length_t row = col; row < 3; ++row) {
+                tensor[col][row] = tensor[row][col] = dist(gen);
+            }
+        }
+    }
+    return tensors;
+}
+
+std::shared_ptr<TensorField3D> randomField(size_t n,
+                                           MetaDataPolicy policy = MetaDataPolicy::Lazy) {
+    return std::make_shared<TensorField3D>(size3_t(n), randomTensors(n * n * n), nullptr, policy);
+}
+
+std::vector<dvec3> randomPositions(size_t count) {
+    std::mt19937 gen(count);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::vector<dvec3> positions(count);
+    for (auto& pos : positions) pos = dvec3(dist(gen), dist(gen), dist(gen));
+    return positions;
+}
+
+void fieldSizes(benchmark::internal::Benchmark* b) {
+    for (int n = 16; n <= TENSORVIS_BENCHMARK_MAX_SIZE; n *= 2) b->Arg(n);
+    b->Unit(benchmark::kMillisecond);
+}
+
+}  // namespace
+
+void eigenDecomposition(benchmark::State& state) {
+    const auto count = static_cast<size_t>(state.range(0) * state.range(0) * state.range(0));
+    const auto tensors = randomTensors(count);
+    std::vector<float> major(count), intermediate(count), minor(count);
+    std::vector<vec3> majorVectors(count), intermediateVectors(count), minorVectors(count);
+
+    for (auto _ : state) {
+        tensorutil::symmetricEigenSystems(tensors->data(), count, major.data(),
+                                          intermediate.data(), minor.data(), majorVectors.data(),
+                                          intermediateVectors.data(), minorVectors.data());
+        benchmark::DoNotOptimize(major.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(eigenDecomposition)->Apply(fieldSizes);
+
+void initializeDefaultMetaData(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    const auto tensors = randomTensors(n * n * n);
+
+    // The eager constructor shares the tensors and computes the default meta data and data maps
+    for (auto _ : state) {
+        TensorField3D tensorField(size3_t(n), tensors, nullptr, MetaDataPolicy::Eager);
+        benchmark::DoNotOptimize(tensorField.metaData());
+    }
+    state.SetItemsProcessed(state.iterations() * tensors->size());
+}
+BENCHMARK(initializeDefaultMetaData)->Apply(fieldSizes);
+
+void sampleLinear(benchmark::State& state) {
+    const auto tensorField = randomField(static_cast<size_t>(state.range(0)));
+    const auto positions = randomPositions(tensorField->getSize());
+
+    for (auto _ : state) {
+        for (const auto& pos : positions) {
+            benchmark::DoNotOptimize(
+                sample<tensorutil::InterpolationMethod::Linear>(tensorField, pos));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * positions.size());
+}
+BENCHMARK(sampleLinear)->Apply(fieldSizes);
+
+void sampleBatched(benchmark::State& state) {
+    const auto tensorField = randomField(static_cast<size_t>(state.range(0)));
+    const auto positions = randomPositions(tensorField->getSize());
+    const TensorField3DSampler sampler(tensorField);
+    std::vector<dmat3> tensors;
+
+    for (auto _ : state) {
+        sampler.sampleTensors(positions, tensors);
+        benchmark::DoNotOptimize(tensors.data());
+    }
+    state.SetItemsProcessed(state.iterations() * positions.size());
+}
+BENCHMARK(sampleBatched)->Apply(fieldSizes);
+
+void subsample3D(benchmark::State& state) {
+    const auto tensorField = randomField(static_cast<size_t>(state.range(0)));
+    const auto dimensions = tensorField->getDimensions() / size_t{2};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tensorutil::subsample3D(tensorField, dimensions));
+    }
+    state.SetItemsProcessed(state.iterations() * glm::compMul(dimensions));
+}
+BENCHMARK(subsample3D)->Apply(fieldSizes);
+
+void getSlice2D(benchmark::State& state) {
+    const auto tensorField = randomField(static_cast<size_t>(state.range(0)));
+    const auto sliceNumber = tensorField->getDimensions().x / 2;
+
+    for (auto _ : state) {
+        for (auto axis : {CartesianCoordinateAxis::X, CartesianCoordinateAxis::Y,
+                          CartesianCoordinateAxis::Z}) {
+            benchmark::DoNotOptimize(slice<2>(tensorField, axis, sliceNumber));
+        }
+    }
+}
+BENCHMARK(getSlice2D)->Apply(fieldSizes);
+
+void glyphGeneration(benchmark::State& state) {
+    const auto tensorField = randomField(static_cast<size_t>(state.range(0)));
+    const TensorGlyphProperty glyphs("glyphs", "Glyphs");
+
+    // Every 4th voxel along each axis, i.e. (n/4)^3 glyphs
+    const util::IndexMapper3D indexMapper(tensorField->getDimensions());
+    std::vector<size_t> indices;
+    const auto dimensions = tensorField->getDimensions();
+    for (size_t z = 0; z < dimensions.z; z += 4) {
+        for (size_t y = 0; y < dimensions.y; y += 4) {
+            for (size_t x = 0; x < dimensions.x; x += 4) {
+                indices.push_back(indexMapper(size3_t(x, y, z)));
+            }
+        }
+    }
+
+    for (auto _ : state) {
+        for (auto index : indices) {
+            benchmark::DoNotOptimize(glyphs.generateGlyph(
+                tensorField->at(index), vec3(indexMapper(index)), 1.0f));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * indices.size());
+}
+BENCHMARK(glyphGeneration)->Apply(fieldSizes);
+
+}  // namespace inviwo
@@ -0,0 +1,38 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/util/attributeutil.h>
+
+#include "tensorfieldtestutils.h"
+
+namespace inviwo {
+TEST(TensorUtilTests, addRemoveMetaData) {
+    auto tensorField = testutil::testField(size3_t(2));
+    ASSERT_FALSE(tensorField->hasMetaData<attributes::FrobeniusNorm>());
+
+    const auto id = util::constexpr_hash(attributes::FrobeniusNorm::identifier);
+
+    util::AddRemoveMetaData<3> add{tensorField};
+    add = util::for_each_type<attributes::types3D>{}(add, id, true);
+    add.calculatePending();
+
+    ASSERT_TRUE(tensorField->hasMetaData<attributes::FrobeniusNorm>());
+    const auto lazy = testutil::testField(size3_t(2), MetaDataPolicy::Lazy);
+    const auto& expected = lazy->getMetaDataContainer<attributes::FrobeniusNorm>();
+    const auto& norms = tensorField->getMetaDataContainer<attributes::FrobeniusNorm>();
+    ASSERT_EQ(expected.size(), norms.size());
+    for (size_t i = 0; i < norms.size(); ++i) {
+        EXPECT_FLOAT_EQ(expected[i], norms[i]);
+    }
+
+    util::AddRemoveMetaData<3> remove{tensorField};
+    remove = util::for_each_type<attributes::types3D>{}(remove, id, false);
+    remove.calculatePending();
+
+    EXPECT_FALSE(tensorField->hasMetaData<attributes::FrobeniusNorm>());
+    EXPECT_TRUE(tensorField->hasMetaData<attributes::MajorEigenValue>());
+}
+
+}  // namespace inviwo
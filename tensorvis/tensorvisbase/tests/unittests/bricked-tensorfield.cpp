@@ -0,0 +1,62 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/datastructures/brickedtensorfield3d.h>
+#include <inviwo/tensorvisbase/algorithm/tensorfieldsampling.h>
+
+#include "tensorfieldtestutils.h"
+
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+
+namespace inviwo {
+TEST(TensorUtilTests, brickedFieldMatchesField) {
+    const size3_t dimensions(5, 6, 7);
+    const auto tensors = testutil::testTensors(glm::compMul(dimensions));
+    const TensorField3D tensorField(dimensions, tensors, nullptr, MetaDataPolicy::Lazy);
+
+    const auto path =
+        (std::filesystem::temp_directory_path() / "bricked-tensorfield.tfbricks").string();
+    BrickedTensorField3D::write(path, tensorField, 4);
+
+    {
+        const BrickedTensorField3D bricked(path, 2);
+        EXPECT_EQ(dimensions, bricked.getDimensions());
+        EXPECT_EQ(size3_t(2, 2, 2), bricked.getNumberOfBricks());
+
+        for (size_t i = 0; i < tensors.size(); ++i) {
+            EXPECT_EQ(tensors[i], bricked.at(i));
+        }
+
+        std::atomic<size_t> visited{0};
+        bricked.forEachBrick([&](const BrickedTensorField3D::Brick& brick) {
+            visited += glm::compMul(brick.dimensions);
+        });
+        EXPECT_EQ(tensors.size(), visited);
+
+        // The accessor only switches bricks when leaving the current one, walk across them
+        auto accessor = bricked.accessor();
+        for (size_t i = 0; i < tensors.size(); ++i) {
+            EXPECT_EQ(tensors[i], accessor.at(i));
+        }
+
+        const auto denseField = std::make_shared<const TensorField3D>(tensorField);
+        for (const auto& position : {dvec3(0.1, 0.5, 0.9), dvec3(0.5), dvec3(0.9, 0.2, 0.4)}) {
+            EXPECT_EQ(
+                sample(denseField, position, tensorutil::InterpolationMethod::Linear).second,
+                sample(accessor, position, tensorutil::InterpolationMethod::Linear).second);
+        }
+
+        const auto region = bricked.extract(size3_t(1, 2, 3), size3_t(4, 5, 6));
+        EXPECT_EQ(size3_t(4), region->getDimensions());
+        EXPECT_EQ(tensorField.at(size3_t(1, 2, 3)), region->at(size3_t(0)));
+        EXPECT_EQ(tensorField.at(size3_t(4, 5, 6)), region->at(size3_t(3)));
+    }
+
+    std::remove(path.c_str());
+}
+
+}  // namespace inviwo
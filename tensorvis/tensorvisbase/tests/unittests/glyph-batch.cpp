@@ -0,0 +1,173 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/algorithm/glyphbatch.h>
+#include <inviwo/tensorvisbase/datastructures/glyphtemplate.h>
+#include <inviwo/tensorvisbase/properties/tensorglyphproperty.h>
+
+#include <atomic>
+
+#include "tensorfieldtestutils.h"
+
+namespace inviwo {
+TEST(TensorUtilTests, glyphBatchOffsets) {
+    const std::vector<tensorutil::GlyphExtent> extents{{3, 3}, {4, 6}, {0, 0}, {3, 3}};
+
+    const auto write = [](size_t glyph, tensorutil::GlyphSlot& slot) {
+        for (size_t i = 0; i < slot.extent.vertices; ++i) {
+            slot.positions[i] = vec3(static_cast<float>(glyph));
+            slot.normals[i] = vec3(0, 0, 1);
+            slot.colors[i] = vec4(1);
+        }
+        for (size_t i = 0; i < slot.extent.indices; ++i) {
+            slot.indices[i] = static_cast<std::uint32_t>(i % slot.extent.vertices);
+        }
+    };
+    const auto batch = tensorutil::batchGlyphs(extents, write);
+
+    ASSERT_EQ(4, batch.size());
+    EXPECT_EQ((std::vector<size_t>{0, 3, 7, 7, 10}), batch.vertexOffsets);
+    EXPECT_EQ((std::vector<size_t>{0, 3, 9, 9, 12}), batch.indexOffsets);
+
+    const auto& positions = batch.mesh->getVertices()->getRAMRepresentation()->getDataContainer();
+    const auto& texCoords = batch.mesh->getTexCoords()->getRAMRepresentation()->getDataContainer();
+    const auto& indices = batch.mesh->getIndices(0)->getRAMRepresentation()->getDataContainer();
+    ASSERT_EQ(10, positions.size());
+    ASSERT_EQ(12, indices.size());
+
+    for (size_t glyph = 0; glyph < batch.size(); ++glyph) {
+        for (auto v = batch.vertexOffsets[glyph]; v < batch.vertexOffsets[glyph + 1]; ++v) {
+            EXPECT_EQ(glyph, batch.glyphOfVertex(v));
+            EXPECT_EQ(static_cast<float>(glyph), positions[v].x);
+            EXPECT_EQ(static_cast<float>(glyph), texCoords[v].x);
+        }
+        // Indices are rebased onto the first vertex of their glyph
+        for (auto i = batch.indexOffsets[glyph]; i < batch.indexOffsets[glyph + 1]; ++i) {
+            EXPECT_EQ(glyph, batch.glyphOfVertex(indices[i]));
+        }
+    }
+
+    const auto glyph = batch.extract(1);
+    EXPECT_EQ(4, glyph->getVertices()->getSize());
+    EXPECT_EQ((std::vector<std::uint32_t>{0, 1, 2, 3, 0, 1}),
+              glyph->getIndices(0)->getRAMRepresentation()->getDataContainer());
+}
+
+TEST(TensorUtilTests, glyphBatchAppliesTransform) {
+    BasicMesh triangle;
+    triangle.addVertices({{vec3(0, 0, 0), vec3(0, 0, 1), vec3(0), vec4(1, 0, 0, 1)},
+                          {vec3(1, 0, 0), vec3(0, 0, 1), vec3(0), vec4(0, 1, 0, 1)},
+                          {vec3(0, 1, 0), vec3(0, 0, 1), vec3(0), vec4(0, 0, 1, 1)}});
+    triangle.addIndexBuffer(DrawType::Triangles, ConnectivityType::None)->add({0, 1, 2});
+    triangle.setWorldMatrix(glm::translate(vec3(1, 2, 3)) * glm::scale(vec3(2)));
+
+    const auto extent = tensorutil::glyphExtent(triangle);
+    EXPECT_EQ(3, extent.vertices);
+    EXPECT_EQ(3, extent.indices);
+
+    const auto batch = tensorutil::batchGlyphs(
+        {extent, extent},
+        [&](size_t, tensorutil::GlyphSlot& slot) { tensorutil::writeGlyph(triangle, slot); });
+
+    const auto& positions = batch.mesh->getVertices()->getRAMRepresentation()->getDataContainer();
+    const auto& normals = batch.mesh->getNormals()->getRAMRepresentation()->getDataContainer();
+    EXPECT_EQ(vec3(3, 2, 3), positions[1]);
+    EXPECT_EQ(vec3(1, 4, 3), positions[5]);
+    EXPECT_FLOAT_EQ(1.0f, glm::length(normals[4]));
+    EXPECT_EQ((std::vector<std::uint32_t>{0, 1, 2, 3, 4, 5}),
+              batch.mesh->getIndices(0)->getRAMRepresentation()->getDataContainer());
+}
+
+TEST(TensorUtilTests, glyphBatchLimitIsExactForPicking) {
+    // Every glyph number up to the limit is exact as a texture coordinate, the next one is not.
+    // Batches above the limit throw, they are not created here to keep the test small.
+    const auto last = static_cast<float>(tensorutil::GlyphBatch::maxGlyphs);
+    EXPECT_EQ(tensorutil::GlyphBatch::maxGlyphs, static_cast<size_t>(last));
+    EXPECT_EQ(last, last + 1.0f);
+}
+
+TEST(TensorUtilTests, glyphBatchCancellation) {
+    const std::vector<tensorutil::GlyphExtent> extents(1000, {3, 3});
+
+    std::atomic<size_t> written{0};
+    const auto batch = tensorutil::batchGlyphs(
+        extents, [&](size_t, tensorutil::GlyphSlot&) { ++written; },
+        [&]() { return written >= 10; });
+    EXPECT_FALSE(batch.mesh);
+    EXPECT_EQ(0u, batch.size());
+    EXPECT_LT(written, extents.size());
+}
+
+TEST(TensorUtilTests, glyphExtentMatchesGeneratedGlyphs) {
+    const auto tensorField = testutil::testField(size3_t(2, 1, 1));
+
+    TensorGlyphProperty glyphs("glyphs", "Glyphs");
+    for (auto type : {TensorGlyphProperty::GlyphType::Superquadric,
+                      TensorGlyphProperty::GlyphType::Reynolds,
+                      TensorGlyphProperty::GlyphType::CombinedReynoldsHYW}) {
+        static_cast<TemplateOptionProperty<TensorGlyphProperty::GlyphType>*>(
+            glyphs.getPropertyByIdentifier("glyphType"))
+            ->setSelectedValue(type);
+        const auto glyph = glyphs.generateGlyph(tensorField, 1, vec3(0));
+        const auto extent = tensorutil::glyphExtent(*glyph);
+        EXPECT_EQ(extent.vertices, glyphs.glyphExtent().vertices);
+        EXPECT_EQ(extent.indices, glyphs.glyphExtent().indices);
+    }
+}
+
+TEST(TensorUtilTests, glyphLevelsOfDetailReduceResolution) {
+    const auto tensorField = testutil::testField(size3_t(2, 1, 1));
+
+    TensorGlyphProperty glyphs("glyphs", "Glyphs");
+    for (size_t level = 1; level < 4; ++level) {
+        EXPECT_LT(glyphs.glyphExtent(level).indices, glyphs.glyphExtent(level - 1).indices);
+
+        const auto glyph = glyphs.generateGlyph(tensorField, 1, vec3(0), vec4(1.0f), 1.0f, level);
+        const auto extent = tensorutil::glyphExtent(*glyph);
+        EXPECT_EQ(extent.vertices, glyphs.glyphExtent(level).vertices);
+        EXPECT_EQ(extent.indices, glyphs.glyphExtent(level).indices);
+    }
+    // The resolution does not drop below four segments
+    EXPECT_EQ(glyphs.glyphExtent(16).indices, glyphs.glyphExtent(32).indices);
+}
+
+TEST(TensorUtilTests, glyphTemplatesAreShared) {
+    using Shape = GlyphTemplate::Shape;
+    const auto sphere = GlyphTemplate::get(Shape::Sphere, 8, 6);
+    EXPECT_EQ(sphere, GlyphTemplate::get(Shape::Sphere, 8, 6));
+    EXPECT_NE(sphere, GlyphTemplate::get(Shape::Sphere, 8, 7));
+    EXPECT_EQ(GlyphTemplate::get(Shape::Cube), GlyphTemplate::get(Shape::Cube, 8, 6));
+
+    // Templates are released once they are no longer referenced
+    std::weak_ptr<const GlyphTemplate> released = GlyphTemplate::get(Shape::Cylinder, 13);
+    EXPECT_TRUE(released.expired());
+    std::weak_ptr<const GlyphTemplate> held = sphere;
+    EXPECT_FALSE(held.expired());
+
+    ASSERT_EQ(sphere->getNumVertices(), sphere->getSphericalTable().size());
+    for (size_t i = 0; i < sphere->getNumVertices(); ++i) {
+        const auto& v = sphere->getPositions()[i];
+        const auto& trig = sphere->getSphericalTable()[i];
+        EXPECT_NEAR(v.z, trig.y, 1e-5f);
+        EXPECT_NEAR(v.x, trig.x * trig.w, 1e-5f);
+        EXPECT_NEAR(v.y, trig.x * trig.z, 1e-5f);
+    }
+
+    // An identity quadric is the undeformed template
+    TensorGlyphProperty glyphs("glyphs", "Glyphs");
+    static_cast<OrdinalProperty<size_t>*>(glyphs.getPropertyByIdentifier("resolutionTheta"))
+        ->set(8);
+    static_cast<OrdinalProperty<size_t>*>(glyphs.getPropertyByIdentifier("resolutionPhi"))->set(6);
+    const auto quadric = glyphs.generateQuadric(mat3(1.0f), vec3(0.0f), 1.0f);
+    const auto& positions = quadric->getVertices()->getRAMRepresentation()->getDataContainer();
+    const auto& normals = quadric->getNormals()->getRAMRepresentation()->getDataContainer();
+    ASSERT_EQ(sphere->getNumVertices(), positions.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        EXPECT_NEAR(0.0f, glm::distance(sphere->getPositions()[i], positions[i]), 1e-5f);
+        EXPECT_NEAR(0.0f, glm::distance(sphere->getNormals()[i], normals[i]), 1e-5f);
+    }
+}
+
+}  // namespace inviwo
@@ -0,0 +1,82 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/algorithm/glyphgeneration.h>
+#include <inviwo/tensorvisbase/properties/tensorglyphproperty.h>
+#include <inviwo/core/datastructures/geometry/basicmesh.h>
+
+#include <atomic>
+
+#include "tensorfieldtestutils.h"
+
+namespace inviwo {
+
+namespace {
+
+std::vector<std::vector<vec3>> meshPositions(const std::vector<std::shared_ptr<Mesh>>& meshes) {
+    std::vector<std::vector<vec3>> positions;
+    for (const auto& mesh : meshes) {
+        const auto basicMesh = std::dynamic_pointer_cast<const BasicMesh>(mesh);
+        EXPECT_TRUE(basicMesh);
+        if (!basicMesh) return positions;
+        positions.push_back(basicMesh->getVertices()->getRAMRepresentation()->getDataContainer());
+    }
+    return positions;
+}
+
+}  // namespace
+
+TEST(TensorUtilTests, glyphGenerationIsDeterministic) {
+    const auto tensorField = testutil::testField(size3_t(6, 5, 4), MetaDataPolicy::Lazy);
+    const TensorGlyphProperty glyphParameters("glyphs", "Glyphs");
+
+    tensorutil::GlyphPlacementSettings placement;
+    placement.placement = tensorutil::GlyphPlacement::Jittered;
+    placement.seed = 3;
+    tensorutil::GlyphLodSettings lod;
+    lod.levels = 3;
+    lod.detailSize = glyphParameters.size();
+    lod.scaleByNorm = true;
+
+    std::optional<tensorutil::GeneratedGlyphs> perMerged[2];
+    for (bool merged : {false, true}) {
+        const auto first =
+            tensorutil::generateGlyphs(tensorField, glyphParameters, merged, placement, lod);
+        const auto second =
+            tensorutil::generateGlyphs(tensorField, glyphParameters, merged, placement, lod);
+        ASSERT_TRUE(first);
+        ASSERT_TRUE(second);
+        ASSERT_FALSE(first->meshes->empty());
+        EXPECT_EQ(meshPositions(*first->meshes), meshPositions(*second->meshes));
+        EXPECT_EQ(first->triangles, second->triangles);
+        EXPECT_LT(first->triangles, first->fullDetailTriangles);
+        perMerged[merged] = first;
+    }
+
+    // Merged meshes hold one mesh per level, the statistics do not depend on the output
+    EXPECT_GT(perMerged[0]->meshes->size(), perMerged[1]->meshes->size());
+    EXPECT_EQ(perMerged[0]->culled, perMerged[1]->culled);
+    EXPECT_EQ(perMerged[0]->triangles, perMerged[1]->triangles);
+    EXPECT_EQ(perMerged[0]->fullDetailTriangles, perMerged[1]->fullDetailTriangles);
+}
+
+TEST(TensorUtilTests, cancelledGlyphGenerationReturnsNothing) {
+    const auto tensorField = testutil::testField(size3_t(6, 5, 4), MetaDataPolicy::Lazy);
+    const TensorGlyphProperty glyphParameters("glyphs", "Glyphs");
+    tensorutil::GlyphLodSettings lod;
+    lod.levels = 2;
+
+    for (bool merged : {false, true}) {
+        EXPECT_FALSE(tensorutil::generateGlyphs(tensorField, glyphParameters, merged, {}, lod,
+                                                []() { return true; }));
+
+        // Cancelled while the glyphs are generated
+        std::atomic<size_t> polls{0};
+        EXPECT_FALSE(tensorutil::generateGlyphs(tensorField, glyphParameters, merged, {}, lod,
+                                                [&polls]() { return ++polls > 2; }));
+    }
+}
+
+}  // namespace inviwo
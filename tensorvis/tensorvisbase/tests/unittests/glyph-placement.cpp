@@ -0,0 +1,206 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/algorithm/glyphplacement.h>
+#include <inviwo/dataframe/datastructures/column.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "tensorfieldtestutils.h"
+
+namespace inviwo {
+
+namespace {
+
+// 8x8x8 field of identity tensors, the first voxel is zero and the second one is masked out
+std::shared_ptr<TensorField3D> placementField() {
+    auto tensorField = testutil::constantField(size3_t(8), mat3(1.0f), MetaDataPolicy::Lazy);
+    tensorField->editableTensors().front() = mat3(0.0f);
+    std::vector<glm::uint8> mask(tensorField->getSize(), 1);
+    mask[1] = 0;
+    tensorField->setMask(mask);
+    return tensorField;
+}
+
+}  // namespace
+
+TEST(TensorUtilTests, regularGlyphPlacement) {
+    const auto tensorField = placementField();
+
+    tensorutil::GlyphPlacementSettings settings;
+    const auto all = tensorutil::placeGlyphs(*tensorField, settings);
+    ASSERT_EQ(tensorField->getSize() - 2, all.size());
+    EXPECT_EQ(2u, all.indices.front());
+
+    settings.stride = size3_t(2, 4, 8);
+    const auto strided = tensorutil::placeGlyphs(*tensorField, settings);
+    ASSERT_EQ(4u * 2u * 1u - 1u, strided.size());
+
+    const util::IndexMapper3D indexMapper(tensorField->getDimensions());
+    for (size_t i = 0; i < strided.size(); ++i) {
+        const auto voxel = indexMapper(strided.indices[i]);
+        EXPECT_EQ(size3_t(0), voxel % settings.stride);
+        EXPECT_EQ(tensorField->getSpacing() * vec3(voxel) + tensorField->getOffset(),
+                  strided.positions[i]);
+    }
+
+    // Masked fields are traversed by runs of defined voxels, the result matches the full grid
+    auto unmasked = testutil::constantField(size3_t(8), mat3(1.0f), MetaDataPolicy::Lazy);
+    unmasked->editableTensors()[1] = mat3(0.0f);
+    auto masked = std::make_shared<TensorField3D>(*unmasked);
+    masked->setMask(std::vector<glm::uint8>(masked->getSize(), 1));
+    for (const auto& stride : {size3_t(1), size3_t(3, 2, 5)}) {
+        settings.stride = stride;
+        const auto expected = tensorutil::placeGlyphs(*unmasked, settings);
+        const auto actual = tensorutil::placeGlyphs(*masked, settings);
+        EXPECT_EQ(expected.indices, actual.indices);
+        EXPECT_EQ(expected.positions, actual.positions);
+    }
+}
+
+TEST(TensorUtilTests, randomGlyphPlacementIsDeterministic) {
+    const auto tensorField = placementField();
+    const util::IndexMapper3D indexMapper(tensorField->getDimensions());
+
+    tensorutil::GlyphPlacementSettings settings;
+    settings.placement = tensorutil::GlyphPlacement::Jittered;
+    settings.stride = size3_t(2);
+    settings.seed = 7;
+    const auto jittered = tensorutil::placeGlyphs(*tensorField, settings);
+    EXPECT_EQ(jittered.positions, tensorutil::placeGlyphs(*tensorField, settings).positions);
+    EXPECT_GE(jittered.size(), 4u * 4u * 4u - 2u);
+
+    settings.seed = 8;
+    EXPECT_NE(jittered.positions, tensorutil::placeGlyphs(*tensorField, settings).positions);
+
+    settings.placement = tensorutil::GlyphPlacement::PoissonDisk;
+    settings.radius = 2.5f;
+    const auto poisson = tensorutil::placeGlyphs(*tensorField, settings);
+    EXPECT_EQ(poisson.indices, tensorutil::placeGlyphs(*tensorField, settings).indices);
+    ASSERT_GT(poisson.size(), 0u);
+    for (size_t i = 0; i < poisson.size(); ++i) {
+        for (size_t j = i + 1; j < poisson.size(); ++j) {
+            const auto d = vec3(indexMapper(poisson.indices[i])) -
+                           vec3(indexMapper(poisson.indices[j]));
+            EXPECT_GE(glm::length(d), settings.radius);
+        }
+    }
+}
+
+TEST(TensorUtilTests, importanceGlyphPlacement) {
+    const auto tensorField = placementField();
+
+    // Only the upper half of the field has a weight
+    std::vector<float> weights(tensorField->getSize(), 0.0f);
+    std::fill(weights.begin() + weights.size() / 2, weights.end(), 1.0f);
+    weights.back() = 1000.0f;
+
+    tensorutil::GlyphPlacementSettings settings;
+    settings.placement = tensorutil::GlyphPlacement::Importance;
+    settings.count = 50;
+    EXPECT_THROW(tensorutil::placeGlyphs(*tensorField, settings), Exception);
+
+    settings.importance = std::make_shared<TemplateColumn<float>>("Weight", weights);
+    const auto glyphs = tensorutil::placeGlyphs(*tensorField, settings);
+    ASSERT_EQ(settings.count, glyphs.size());
+    EXPECT_EQ(glyphs.indices, tensorutil::placeGlyphs(*tensorField, settings).indices);
+    EXPECT_TRUE(std::is_sorted(glyphs.indices.begin(), glyphs.indices.end()));
+    EXPECT_GE(glyphs.indices.front(), weights.size() / 2);
+    EXPECT_EQ(weights.size() - 1, glyphs.indices.back());
+}
+
+TEST(TensorUtilTests, importanceFromScalarAttributes) {
+    const auto name = std::string(attributes::FrobeniusNorm::identifier);
+
+    // Eager fields only hold the eigen system, the remaining scalar attributes are computable
+    const auto eager = testutil::testField(size3_t(4));
+    const auto names = tensorutil::scalarAttributes(*eager);
+    EXPECT_EQ(std::string(attributes::MajorEigenValue::identifier), names.front());
+    EXPECT_EQ(1, std::count(names.begin(), names.end(), name));
+    EXPECT_EQ(0, std::count(names.begin(), names.end(),
+                            std::string(attributes::MajorEigenVector3D::identifier)));
+
+    const auto column = tensorutil::scalarAttribute(*eager, name);
+    ASSERT_NE(nullptr, column);
+    EXPECT_EQ(eager->getSize(), column->getSize());
+    EXPECT_FALSE(eager->hasMetaData<attributes::FrobeniusNorm>());
+    EXPECT_EQ(nullptr, tensorutil::scalarAttribute(
+                           *eager, std::string(attributes::MajorEigenVector3D::identifier)));
+    EXPECT_EQ(nullptr, tensorutil::scalarAttribute(*eager, "Unknown"));
+
+    // Lazy fields keep the computed column
+    const auto lazy = testutil::testField(size3_t(4), MetaDataPolicy::Lazy);
+    EXPECT_EQ(tensorutil::scalarAttribute(*lazy, name),
+              *lazy->getMetaData<attributes::FrobeniusNorm>());
+
+    tensorutil::GlyphPlacementSettings settings;
+    settings.placement = tensorutil::GlyphPlacement::Importance;
+    settings.count = 10;
+    settings.importanceAttribute = name;
+    const auto byName = tensorutil::placeGlyphs(*eager, settings);
+    settings.importanceAttribute.clear();
+    settings.importance = column;
+    EXPECT_EQ(tensorutil::placeGlyphs(*eager, settings).indices, byName.indices);
+}
+
+TEST(TensorUtilTests, glyphLevelsOfDetail) {
+    // Scaled identity tensors with relative norms of 1/8 to 8/8
+    const size3_t dimensions(8);
+    std::vector<mat3> tensors(glm::compMul(dimensions));
+    for (size_t i = 0; i < tensors.size(); ++i) {
+        tensors[i] = mat3(static_cast<float>(i % 8 + 1));
+    }
+    auto tensorField =
+        std::make_shared<TensorField3D>(dimensions, tensors, nullptr, MetaDataPolicy::Lazy);
+    const auto glyphs = tensorutil::placeGlyphs(*tensorField, {});
+
+    tensorutil::GlyphLodSettings settings;
+    const auto single = tensorutil::selectGlyphLevels(*tensorField, glyphs, 1.0f, settings);
+    ASSERT_EQ(1u, single.levels.size());
+    EXPECT_EQ(glyphs.size(), single.levels[0].size());
+    EXPECT_EQ(0u, single.culled);
+
+    settings.levels = 4;
+    settings.scaleByNorm = true;
+    settings.minNorm = 0.2f;
+    const auto lod = tensorutil::selectGlyphLevels(*tensorField, glyphs, 1.0f, settings);
+    ASSERT_EQ(4u, lod.levels.size());
+    EXPECT_EQ(glyphs.size() / 8, lod.culled);
+
+    size_t selected = 0;
+    for (size_t level = 0; level < lod.levels.size(); ++level) {
+        ASSERT_EQ(lod.levels[level].size(), lod.sizes[level].size());
+        EXPECT_TRUE(std::is_sorted(lod.levels[level].begin(), lod.levels[level].end()));
+        for (const auto size : lod.sizes[level]) {
+            EXPECT_LE(size, std::ldexp(settings.detailSize, -static_cast<int>(level)) * 1.0001f);
+            if (level + 1 < lod.levels.size()) {
+                EXPECT_GE(size, std::ldexp(settings.detailSize, -static_cast<int>(level + 1)));
+            }
+        }
+        selected += lod.levels[level].size();
+    }
+    EXPECT_EQ(glyphs.size() - lod.culled, selected);
+    // Relative norms in [1/2, 1] are drawn at full detail, 1/2 itself falls on level 1
+    EXPECT_EQ(glyphs.size() / 2, lod.levels[0].size());
+
+    // Without the meta data columns the attributes are computed on the fly
+    const TensorField3D eager(dimensions, tensors);
+    ASSERT_FALSE(eager.hasMetaData<attributes::FrobeniusNorm>());
+    const auto computed = tensorutil::selectGlyphLevels(eager, glyphs, 1.0f, settings);
+    EXPECT_EQ(lod.culled, computed.culled);
+    EXPECT_EQ(lod.levels, computed.levels);
+    EXPECT_EQ(lod.sizes, computed.sizes);
+
+    // Scaled identities are isotropic
+    ASSERT_FALSE(eager.hasMetaData<attributes::Anisotropy>());
+    settings.minAnisotropy = 0.1f;
+    EXPECT_EQ(glyphs.size(),
+              tensorutil::selectGlyphLevels(eager, glyphs, 1.0f, settings).culled);
+}
+
+}  // namespace inviwo
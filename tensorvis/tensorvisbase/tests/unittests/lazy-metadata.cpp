@@ -0,0 +1,68 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+
+#include "tensorfieldtestutils.h"
+
+namespace inviwo {
+TEST(TensorUtilTests, lazyMetaDataIsComputedOnDemand) {
+    const auto tensors = testutil::testTensors(8);
+
+    const TensorField3D eager(size3_t(2), tensors);
+    const TensorField3D lazy(size3_t(2), tensors, nullptr, MetaDataPolicy::Lazy);
+
+    EXPECT_FALSE(lazy.hasMetaData<attributes::MajorEigenValue>());
+    EXPECT_FALSE(lazy.hasMetaData<attributes::FrobeniusNorm>());
+
+    const auto& norms = lazy.getMetaDataContainer<attributes::FrobeniusNorm>();
+    EXPECT_EQ(tensors.size(), norms.size());
+    EXPECT_TRUE(lazy.hasMetaData<attributes::FrobeniusNorm>());
+    EXPECT_FALSE(lazy.hasMetaData<attributes::MajorEigenValue>());
+
+    // Shallow copies share the columns computed on demand
+    const TensorField3D copy(lazy);
+    for (size_t i = 0; i < tensors.size(); ++i) {
+        EXPECT_FLOAT_EQ(eager.majorEigenValues()[i], copy.majorEigenValues()[i]);
+    }
+    EXPECT_TRUE(lazy.hasMetaData<attributes::MinorEigenVector3D>());
+}
+
+TEST(TensorUtilTests, editedTensorsDropDerivedMetaData) {
+    const auto tensors = testutil::testTensors(8);
+    const auto doubled = [&]() {
+        auto result = tensors;
+        for (auto& tensor : result) tensor *= 2.0f;
+        return result;
+    }();
+    const TensorField3D expected(size3_t(2), doubled);
+
+    TensorField3D eager(size3_t(2), tensors);
+    const TensorField3D copy(eager);
+    for (auto& tensor : eager.editableTensors()) tensor *= 2.0f;
+    EXPECT_FALSE(eager.hasMetaData<attributes::MajorEigenValue>());
+    // The copy shared the meta data and keeps its columns
+    EXPECT_TRUE(copy.hasMetaData<attributes::MajorEigenValue>());
+
+    eager.updateMetaData();
+    ASSERT_TRUE(eager.hasMetaData<attributes::MajorEigenValue>());
+    for (size_t i = 0; i < tensors.size(); ++i) {
+        EXPECT_FLOAT_EQ(expected.majorEigenValues()[i], eager.majorEigenValues()[i]);
+    }
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(expected.dataMapEigenValues_[i].dataRange,
+                  eager.dataMapEigenValues_[i].dataRange);
+    }
+
+    // Lazy fields recompute on demand, also when the columns came with the field
+    TensorField3D lazy(size3_t(2), tensors, std::make_shared<DataFrame>(*copy.metaData()),
+                       MetaDataPolicy::Lazy);
+    for (auto& tensor : lazy.editableTensors()) tensor *= 2.0f;
+    for (size_t i = 0; i < tensors.size(); ++i) {
+        EXPECT_FLOAT_EQ(expected.majorEigenValues()[i], lazy.majorEigenValues()[i]);
+    }
+}
+
+}  // namespace inviwo
@@ -0,0 +1,92 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+
+#include <algorithm>
+
+#include "tensorfieldtestutils.h"
+
+namespace inviwo {
+TEST(TensorUtilTests, packUnpackRoundTrip) {
+    const mat3 tensor(vec3(1, 2, 3), vec3(2, 4, 5), vec3(3, 5, 6));
+    const auto packed = TensorField3D::pack(tensor);
+
+    EXPECT_EQ((TensorField3D::packedN{1, 2, 3, 4, 5, 6}), packed);
+    EXPECT_EQ(tensor, TensorField3D::unpack(packed));
+}
+
+TEST(TensorUtilTests, packedStorageIsTransparent) {
+    const auto tensors = testutil::testTensors(8);
+
+    const TensorField3D full(size3_t(2), tensors);
+    const TensorField3D packed(size3_t(2), TensorField3D::pack(tensors));
+
+    EXPECT_EQ(TensorStorage::Full, full.storage());
+    EXPECT_EQ(TensorStorage::PackedSymmetric, packed.storage());
+
+    for (size_t i = 0; i < tensors.size(); ++i) {
+        EXPECT_EQ(full.at(i), packed.at(i));
+        EXPECT_FLOAT_EQ(full.majorEigenValues()[i], packed.majorEigenValues()[i]);
+    }
+    EXPECT_EQ(*full.tensors(), *packed.tensors());
+}
+
+TEST(TensorUtilTests, packedTensorsAreUnpackedOnAccess) {
+    const auto tensors = testutil::testTensors(8);
+
+    TensorField3D packed(size3_t(2), TensorField3D::pack(tensors), nullptr, MetaDataPolicy::Lazy);
+    packed.setMask(std::vector<glm::uint8>(tensors.size(), 1));
+    const TensorField3D copy(packed);
+
+    // Single tensors are unpacked by value, the field keeps no unpacked copy
+    EXPECT_EQ(tensors[3], packed.at(3));
+    EXPECT_EQ(std::make_pair(true, tensors[3]), packed.at<true>(3));
+    const auto unpacked = packed.tensors();
+    EXPECT_EQ(tensors, *unpacked);
+    EXPECT_NE(unpacked, packed.tensors());
+
+    // Meta data is computed from the packed tensors
+    const TensorField3D full(size3_t(2), tensors, nullptr, MetaDataPolicy::Lazy);
+    EXPECT_EQ(full.majorEigenValues(), packed.majorEigenValues());
+    EXPECT_EQ(TensorStorage::PackedSymmetric, packed.storage());
+
+    packed.editableTensors()[3] = mat3(0.0f);
+    EXPECT_EQ(TensorStorage::Full, packed.storage());
+    EXPECT_EQ(tensors[3], (*unpacked)[3]);
+    EXPECT_EQ(tensors[3], copy.at(3));
+    EXPECT_EQ(mat3(0.0f), packed.at(3));
+}
+
+TEST(TensorUtilTests, volumeRepresentationIsCached) {
+    const auto tensors = testutil::testTensors(8);
+
+    TensorField3D full(size3_t(2), tensors, nullptr, MetaDataPolicy::Lazy);
+    const TensorField3D packed(size3_t(2), TensorField3D::pack(tensors), nullptr,
+                               MetaDataPolicy::Lazy);
+
+    for (auto layout :
+         {TensorField3D::VolumeLayout::Columns, TensorField3D::VolumeLayout::Symmetric}) {
+        const auto fromFull = full.getVolumeRepresentation(layout);
+        const auto fromPacked = packed.getVolumeRepresentation(layout);
+        ASSERT_EQ(fromFull.size(), fromPacked.size());
+        for (size_t v = 0; v < fromFull.size(); ++v) {
+            const auto a = static_cast<const vec3*>(
+                fromFull[v]->getRepresentation<VolumeRAM>()->getData());
+            const auto b = static_cast<const vec3*>(
+                fromPacked[v]->getRepresentation<VolumeRAM>()->getData());
+            EXPECT_TRUE(std::equal(a, a + tensors.size(), b));
+        }
+    }
+
+    const auto volumes = full.getVolumeRepresentation();
+    EXPECT_EQ(volumes[1], full.getVolumeRepresentation()[1]);
+
+    full.editableTensors();
+    EXPECT_NE(volumes[1], full.getVolumeRepresentation()[1]);
+}
+
+}  // namespace inviwo
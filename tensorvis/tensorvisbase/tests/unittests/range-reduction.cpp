@@ -0,0 +1,46 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/util/rangereduction.h>
+
+namespace inviwo {
+TEST(TensorUtilTests, reduceRangesOfSeveralColumns) {
+    const size_t count = 5000;
+    std::vector<float> scalars(count);
+    std::vector<vec3> vectors(count);
+    for (size_t i = 0; i < count; ++i) {
+        const auto v = static_cast<float>(i);
+        scalars[i] = i % 2 == 0 ? 0.0f : v;
+        vectors[i] = vec3(-v, v, 0.5f * v);
+    }
+
+    const auto ranges = tensorutil::reduceRanges<float>(
+        {{scalars.data()},
+         {scalars.data(), 1, true},
+         {reinterpret_cast<const float*>(vectors.data()), 3}},
+        count, 4);
+
+    ASSERT_EQ(3u, ranges.size());
+    EXPECT_EQ(dvec2(0.0, 4999.0), ranges[0].range);
+    EXPECT_EQ(count, ranges[0].count);
+    EXPECT_EQ(dvec2(1.0, 4999.0), ranges[1].range);
+    EXPECT_EQ(count / 2, ranges[1].count);
+    EXPECT_EQ(dvec2(-4999.0, 4999.0), ranges[2].range);
+    EXPECT_EQ(3 * count, ranges[2].count);
+
+    for (const auto& range : ranges) {
+        ASSERT_EQ(4u, range.histogram.size());
+        size_t sum = 0;
+        for (auto bin : range.histogram) sum += bin;
+        EXPECT_EQ(range.count, sum);
+    }
+    // The zeros of the first column all end up in the lowest bin
+    EXPECT_EQ(count / 2 + 625, ranges[0].histogram[0]);
+
+    const auto empty = tensorutil::reduceRanges<float>({{scalars.data()}}, 0);
+    EXPECT_EQ(0u, empty[0].count);
+}
+
+}  // namespace inviwo
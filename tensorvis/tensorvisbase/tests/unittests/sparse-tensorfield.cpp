@@ -0,0 +1,100 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/datastructures/sparsetensorfield3d.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+
+#include "tensorfieldtestutils.h"
+
+namespace inviwo {
+TEST(TensorUtilTests, sparseFieldMatchesMaskedField) {
+    const size3_t dimensions(4, 3, 2);
+    std::vector<mat3> tensors(glm::compMul(dimensions), mat3(0.0f));
+    std::vector<glm::uint8> mask(tensors.size(), 0);
+    for (size_t i : {1, 2, 3, 7, 8, 20, 23}) {
+        tensors[i] = testutil::testTensor(static_cast<float>(i));
+        mask[i] = 1;
+    }
+
+    auto tensorField =
+        std::make_shared<TensorField3D>(dimensions, tensors, nullptr, MetaDataPolicy::Lazy);
+    tensorField->setMask(mask);
+
+    const SparseTensorField3D sparse(*tensorField);
+    EXPECT_EQ(7u, sparse.getNumberOfActive());
+    ASSERT_EQ(4u, sparse.runs().size());
+    EXPECT_EQ(3u, sparse.runs()[0].length);
+    EXPECT_EQ(5u, sparse.runs()[2].entry);
+
+    for (size_t i = 0; i < tensors.size(); ++i) {
+        EXPECT_EQ(mask[i] != 0, sparse.isActive(i));
+        EXPECT_EQ(tensors[i], sparse.at(i));
+    }
+
+    const auto metaData = sparse.metaData();
+    EXPECT_EQ(7u, metaData->getNumberOfRows());
+    const auto& majorEigenValues = tensorField->majorEigenValues();
+    const auto column = std::dynamic_pointer_cast<const TemplateColumn<float>>(
+        metaData->getColumn(std::string(attributes::MajorEigenValue::identifier)));
+    ASSERT_TRUE(column);
+    // forEachActive runs in parallel, every entry writes its own slot and the checks follow
+    std::vector<size_t> indices(sparse.getNumberOfActive(), tensors.size());
+    sparse.forEachActive([&](size_t index, size_t entry) { indices[entry] = index; });
+    ASSERT_EQ((std::vector<size_t>{1, 2, 3, 7, 8, 20, 23}), indices);
+    for (size_t entry = 0; entry < indices.size(); ++entry) {
+        EXPECT_FLOAT_EQ(majorEigenValues[indices[entry]], column->get(entry));
+    }
+
+    const auto dense = sparse.toDense();
+    EXPECT_EQ(*tensorField->tensors(), *dense->tensors());
+    EXPECT_EQ(mask, dense->getMask());
+
+    // Without a mask the non-zero tensors are active
+    const TensorField3D unmasked(dimensions, tensors, nullptr, MetaDataPolicy::Lazy);
+    EXPECT_EQ(7u, SparseTensorField3D(unmasked, MetaDataPolicy::Lazy).getNumberOfActive());
+}
+
+TEST(TensorUtilTests, sparseFieldFromRuns) {
+    using Run = SparseTensorField3D::Run;
+    const size3_t dimensions(4, 3, 2);
+    const std::vector<size_t> active{1, 2, 3, 7, 8, 20, 23};
+
+    std::vector<mat3> dense(glm::compMul(dimensions), mat3(0.0f));
+    auto tensors = std::make_shared<std::vector<mat3>>();
+    for (auto i : active) {
+        dense[i] = testutil::testTensor(static_cast<float>(i));
+        tensors->push_back(dense[i]);
+    }
+    auto runs = SparseTensorField3D::findRunsIf(
+        dense.size(), [&](size_t i) { return std::count(active.begin(), active.end(), i) != 0; });
+
+    const SparseTensorField3D sparse(dimensions, runs, tensors, MetaDataPolicy::Lazy);
+    const SparseTensorField3D fromDense(TensorField3D(dimensions, dense, nullptr,
+                                                      MetaDataPolicy::Lazy),
+                                        MetaDataPolicy::Lazy);
+    EXPECT_EQ(7u, sparse.getNumberOfActive());
+    ASSERT_EQ(fromDense.runs().size(), sparse.runs().size());
+    for (size_t i = 0; i < dense.size(); ++i) {
+        EXPECT_EQ(dense[i], sparse.at(i));
+    }
+    EXPECT_EQ(sparse.metaData()->getNumberOfRows(), fromDense.metaData()->getNumberOfRows());
+
+    const SparseTensorField3D packed(dimensions, runs, TensorField3D::pack(*tensors),
+                                     MetaDataPolicy::Lazy);
+    EXPECT_EQ(TensorStorage::PackedSymmetric, packed.storage());
+    EXPECT_EQ(dense[20], packed.at(20));
+
+    const auto invalid = [&](std::vector<Run> invalidRuns) {
+        EXPECT_THROW(SparseTensorField3D(dimensions, invalidRuns, tensors), Exception);
+    };
+    invalid({});                                              // fewer entries than tensors
+    invalid({{1, 3, 0}, {2, 4, 3}});                          // overlapping
+    invalid({{1, 3, 0}, {7, 2, 4}, {20, 1, 5}, {23, 1, 6}});  // gap in the entries
+    invalid({{1, 3, 0}, {7, 2, 3}, {20, 1, 5}, {24, 1, 6}});  // beyond the grid
+}
+
+}  // namespace inviwo
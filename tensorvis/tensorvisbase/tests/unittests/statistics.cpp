@@ -0,0 +1,96 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/util/statistics.h>
+
+#include <cmath>
+#include <map>
+
+#include "tensorfieldtestutils.h"
+
+namespace inviwo {
+TEST(TensorUtilTests, statisticsOfColumns) {
+    const size_t count = 10000;
+    std::vector<float> values(count);
+    std::vector<vec2> vectors(count);
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = static_cast<float>(i);
+        vectors[i] = vec2(1.0f, i % 2 == 0 ? -1.0f : 1.0f);
+    }
+    values[3] = std::numeric_limits<float>::quiet_NaN();
+
+    DataFrame dataFrame;
+    dataFrame.addColumn(std::make_shared<TemplateColumn<float>>("Value", values));
+    dataFrame.addColumn(std::make_shared<TemplateColumn<vec2>>("Vector", vectors));
+    dataFrame.updateIndexBuffer();
+
+    const auto statistics = tensorutil::computeStatistics(dataFrame, 1000);
+    ASSERT_EQ(3u, statistics.size());
+
+    const auto& value = statistics[0];
+    EXPECT_EQ("Value", value.name);
+    EXPECT_EQ(count - 1, value.count);
+    EXPECT_EQ(dvec2(0.0, count - 1.0), value.range);
+    EXPECT_NEAR((count * (count - 1) / 2 - 3) / (count - 1.0), value.mean, 1e-6);
+    EXPECT_NEAR(0.0, value.skewness, 1e-3);
+    EXPECT_NEAR(-1.2, value.kurtosis, 1e-3);
+    EXPECT_NEAR(count / 2.0, value.quantile(0.5), 10.0);
+    EXPECT_NEAR(count * 0.95, value.quantile(0.95), 10.0);
+
+    EXPECT_EQ("Vector.x", statistics[1].name);
+    EXPECT_DOUBLE_EQ(1.0, statistics[1].mean);
+    EXPECT_DOUBLE_EQ(0.0, statistics[1].variance);
+    EXPECT_EQ("Vector.y", statistics[2].name);
+    EXPECT_DOUBLE_EQ(0.0, statistics[2].mean);
+    EXPECT_DOUBLE_EQ(1.0, statistics[2].variance);
+
+    const auto table = tensorutil::statisticsToDataFrame(statistics);
+    EXPECT_EQ(3u, table->getNumberOfRows());
+    EXPECT_EQ(8u + tensorutil::defaultQuantiles().size() + 1, table->getNumberOfColumns());
+    EXPECT_EQ(3000u, tensorutil::histogramsToDataFrame(statistics)->getNumberOfRows());
+}
+
+TEST(TensorUtilTests, statisticsOfTensorField) {
+    auto means = [](const std::vector<tensorutil::ColumnStatistics>& statistics) {
+        std::map<std::string, double> result;
+        for (const auto& stats : statistics) result[stats.name] = stats.mean;
+        return result;
+    };
+
+    // Lazy fields cover the same columns as eager ones
+    const auto eager = testutil::testField(size3_t(4));
+    const auto lazy = testutil::testField(size3_t(4), MetaDataPolicy::Lazy);
+    const auto eagerStatistics = eager->statistics(16);
+    const auto lazyStatistics = lazy->statistics(16);
+    ASSERT_FALSE(eagerStatistics->empty());
+    const auto eagerMeans = means(*eagerStatistics);
+    const auto lazyMeans = means(*lazyStatistics);
+    ASSERT_EQ(eagerMeans.size(), lazyMeans.size());
+    for (const auto& [name, mean] : eagerMeans) {
+        ASSERT_EQ(1u, lazyMeans.count(name)) << name;
+        EXPECT_NEAR(mean, lazyMeans.at(name), 1e-5) << name;
+    }
+    EXPECT_EQ(lazyStatistics, lazy->statistics(16));
+
+    // Columns computed on demand later on are included
+    lazy->getMetaData<attributes::FrobeniusNorm>();
+    const auto withNorm = lazy->statistics(16);
+    EXPECT_NE(lazyStatistics, withNorm);
+    EXPECT_EQ(lazyStatistics->size() + 1, withNorm->size());
+    EXPECT_EQ(1u, means(*withNorm).count(std::string(attributes::FrobeniusNorm::identifier)));
+
+    // Replacing a column in place keeps the number of columns
+    const auto name = std::string(attributes::MajorEigenValue::identifier);
+    auto metaData = eager->editableMetaData();
+    metaData->dropColumn(name);
+    metaData->addColumn(
+        std::make_shared<TemplateColumn<float>>(name, std::vector<float>(eager->getSize(), 1.0f)));
+    const auto replaced = eager->statistics(16);
+    EXPECT_NE(eagerStatistics, replaced);
+    EXPECT_EQ(eagerStatistics->size(), replaced->size());
+    EXPECT_DOUBLE_EQ(1.0, means(*replaced).at(name));
+}
+
+}  // namespace inviwo
@@ -0,0 +1,63 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/util/symmetriceigensolver.h>
+
+namespace inviwo {
+TEST(TensorUtilTests, symmetricEigenSystemDiagonal) {
+    const auto eigenSystem = tensorutil::symmetricEigenSystem(dmat3(dvec3(1, 0, 0), dvec3(0, 3, 0),
+                                                                    dvec3(0, 0, -2)));
+
+    EXPECT_DOUBLE_EQ(3.0, eigenSystem[0].first);
+    EXPECT_DOUBLE_EQ(1.0, eigenSystem[1].first);
+    EXPECT_DOUBLE_EQ(-2.0, eigenSystem[2].first);
+    EXPECT_NEAR(1.0, std::abs(eigenSystem[0].second.y), 1e-12);
+    EXPECT_NEAR(1.0, std::abs(eigenSystem[1].second.x), 1e-12);
+    EXPECT_NEAR(1.0, std::abs(eigenSystem[2].second.z), 1e-12);
+}
+
+TEST(TensorUtilTests, symmetricEigenSystemResidual) {
+    // Two repeated eigenvalues trigger the Jacobi fallback
+    const std::array<dmat3, 3> tensors{
+        dmat3(dvec3(4, 1, -2), dvec3(1, 2, 0.5), dvec3(-2, 0.5, 3)),
+        dmat3(dvec3(2, 1, 1), dvec3(1, 2, 1), dvec3(1, 1, 2)),
+        dmat3(dvec3(1e6, 3e5, 0), dvec3(3e5, -2e6, 1e2), dvec3(0, 1e2, 5e5))};
+
+    for (const auto& tensor : tensors) {
+        const auto eigenSystem = tensorutil::symmetricEigenSystem(tensor);
+        const double scale = std::abs(eigenSystem[0].first) + std::abs(eigenSystem[2].first);
+
+        EXPECT_GE(eigenSystem[0].first, eigenSystem[1].first);
+        EXPECT_GE(eigenSystem[1].first, eigenSystem[2].first);
+        for (const auto& [value, vector] : eigenSystem) {
+            EXPECT_NEAR(1.0, glm::length(vector), 1e-12);
+            EXPECT_NEAR(0.0, glm::length(tensor * vector - value * vector) / scale, 1e-12);
+        }
+    }
+}
+
+TEST(TensorUtilTests, symmetricEigenSystemsBatched) {
+    std::vector<mat3> tensors(11, mat3(vec3(4, 1, -2), vec3(1, 2, 0.5), vec3(-2, 0.5, 3)));
+    tensors[3] = mat3(0.0f);
+    tensors[7] = mat3(vec3(1, 2, 0), vec3(0, 1, 0), vec3(0, 0, 1));  // not symmetric
+
+    std::vector<float> major(11), intermediate(11), minor(11);
+    std::vector<vec3> majorVec(11), intermediateVec(11), minorVec(11);
+    tensorutil::symmetricEigenSystems(tensors.data(), tensors.size(), major.data(),
+                                      intermediate.data(), minor.data(), majorVec.data(),
+                                      intermediateVec.data(), minorVec.data());
+
+    const auto reference = tensorutil::symmetricEigenSystem(dmat3(tensors[0]));
+    for (size_t i : {0, 1, 2, 4, 5, 6, 8, 9, 10}) {
+        EXPECT_NEAR(reference[0].first, major[i], 1e-5);
+        EXPECT_NEAR(reference[1].first, intermediate[i], 1e-5);
+        EXPECT_NEAR(reference[2].first, minor[i], 1e-5);
+    }
+    EXPECT_EQ(0.0f, major[3]);
+    EXPECT_EQ(vec3(0.0f), majorVec[3]);
+    EXPECT_NEAR(1.0f, major[7], 1e-4);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,56 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include "tensorfieldtestutils.h"
+
+namespace inviwo {
+
+TEST(TensorUtilTests, batchedImagePositionsMatchPerIndex) {
+    for (const auto& dimensions : {size2_t(7, 5), size2_t(1, 4), size2_t(6, 1)}) {
+        const auto tensorField = testutil::testField2D(dimensions, MetaDataPolicy::Lazy);
+        const auto positions = tensorField->normalizedImagePositions();
+        ASSERT_EQ(tensorField->getSize(), positions.size());
+        for (size_t i = 0; i < positions.size(); ++i) {
+            const auto expected = tensorField->getNormalizedImagePosition(i);
+            EXPECT_NEAR(expected.x, positions[i].x, 1e-12) << "index " << i;
+            EXPECT_NEAR(expected.y, positions[i].y, 1e-12) << "index " << i;
+        }
+
+        // A range starting within a row and wrapping over rows
+        const size_t first = tensorField->getSize() / 3;
+        const size_t count = tensorField->getSize() - first;
+        std::vector<dvec2> range(count);
+        tensorField->normalizedImagePositions(first, count, range.data());
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(positions[first + i], range[i]) << "index " << first + i;
+        }
+    }
+}
+
+TEST(TensorUtilTests, batchedVolumePositionsMatchPerIndex) {
+    constexpr double sliceCoord = 0.25;
+    for (const auto& dimensions : {size3_t(5, 4, 3), size3_t(4, 1, 3), size3_t(1, 1, 6)}) {
+        auto tensorField = testutil::testField(dimensions, MetaDataPolicy::Lazy);
+        tensorField->setExtents(vec3(2.0f, 3.0f, 5.0f));
+
+        const auto positions = tensorField->getNormalizedScreenCoordinates(sliceCoord);
+        ASSERT_TRUE(positions);
+        ASSERT_EQ(tensorField->getSize(), positions->size());
+        for (size_t i = 0; i < positions->size(); ++i) {
+            EXPECT_EQ(tensorField->getNormalizedVolumePosition(i, sliceCoord), (*positions)[i])
+                << "index " << i;
+        }
+
+        const size_t first = tensorField->getSize() / 3;
+        const size_t count = tensorField->getSize() - first;
+        std::vector<vec3> range(count);
+        tensorField->getNormalizedVolumePositions(first, count, sliceCoord, range.data());
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ((*positions)[first + i], range[i]) << "index " << first + i;
+        }
+    }
+}
+
+}  // namespace inviwo
@@ -0,0 +1,60 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+
+namespace inviwo {
+TEST(TensorUtilTests, logEuclideanMeanPreservesDeterminant) {
+    const std::array<mat3, 2> tensors{mat3(2.0f), mat3(8.0f)};
+
+    const auto mean = tensorutil::logEuclideanMean(tensors.data(), tensors.size());
+    ASSERT_TRUE(mean.has_value());
+    for (glm::length_t i = 0; i < 3; ++i) {
+        for (glm::length_t j = 0; j < 3; ++j) {
+            EXPECT_NEAR(i == j ? 4.0f : 0.0f, (*mean)[i][j], 1e-4f);
+        }
+    }
+
+    const std::array<mat3, 2> indefinite{mat3(2.0f), mat3(-1.0f)};
+    EXPECT_FALSE(tensorutil::logEuclideanMean(indefinite.data(), indefinite.size()).has_value());
+}
+
+TEST(TensorUtilTests, pyramidHalvesDimensions) {
+    const size3_t dimensions(5, 4, 3);
+    std::vector<mat3> tensors(glm::compMul(dimensions));
+    for (size_t i = 0; i < tensors.size(); ++i) {
+        tensors[i] = mat3(static_cast<float>(i + 1));
+    }
+
+    auto tensorField =
+        std::make_shared<TensorField3D>(dimensions, tensors, nullptr, MetaDataPolicy::Lazy);
+    EXPECT_EQ(1u, tensorField->getNumberOfLevels());
+
+    tensorField->buildPyramid(PyramidFilter::Linear);
+    ASSERT_EQ(4u, tensorField->getNumberOfLevels());
+    EXPECT_EQ(size3_t(3, 2, 2), tensorField->getLevel(1)->getDimensions());
+    EXPECT_EQ(size3_t(2, 1, 1), tensorField->getLevel(2)->getDimensions());
+    EXPECT_EQ(size3_t(1, 1, 1), tensorField->getLevel(3)->getDimensions());
+
+    // The last tensor along x only covers a single tensor in x
+    const auto& indexMapper = tensorField->indexMapper();
+    float sum = 0.0f;
+    for (size_t z = 0; z < 2; ++z) {
+        for (size_t y = 0; y < 2; ++y) sum += tensors[indexMapper(size3_t(4, y, z))][0][0];
+    }
+    EXPECT_FLOAT_EQ(sum / 4.0f, tensorField->getLevel(1)->at(size3_t(2, 0, 0))[0][0]);
+
+    EXPECT_EQ(1u, tensorField->getLevelFor(size3_t(3, 2, 2)));
+    EXPECT_EQ(0u, tensorField->getLevelFor(size3_t(4, 2, 2)));
+
+    // Shallow copies share the pyramid, modifying the tensors discards it
+    TensorField3D copy(*tensorField);
+    EXPECT_EQ(4u, copy.getNumberOfLevels());
+    copy.editableTensors();
+    EXPECT_EQ(1u, copy.getNumberOfLevels());
+    EXPECT_EQ(4u, tensorField->getNumberOfLevels());
+}
+
+}  // namespace inviwo
@@ -0,0 +1,114 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/util/tensorfieldutil.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include <cmath>
+
+#include "tensorfieldtestutils.h"
+
+namespace inviwo {
+
+namespace {
+
+// Tensors that only depend on x, mat3(x) at voxel x
+std::shared_ptr<TensorField3D> rampField(const size3_t& dimensions) {
+    const util::IndexMapper3D indexMapper(dimensions);
+    std::vector<mat3> tensors(glm::compMul(dimensions));
+    for (size_t i = 0; i < tensors.size(); ++i) {
+        tensors[i] = mat3(static_cast<float>(indexMapper(i).x));
+    }
+    return std::make_shared<TensorField3D>(dimensions, tensors, nullptr, MetaDataPolicy::Lazy);
+}
+
+}  // namespace
+
+TEST(TensorUtilTests, resampleToSameDimensionsIsIdentity) {
+    const auto tensorField = testutil::testField(size3_t(5, 4, 3), MetaDataPolicy::Lazy);
+    for (auto method : {tensorutil::InterpolationMethod::Linear,
+                        tensorutil::InterpolationMethod::Nearest}) {
+        const auto resampled =
+            tensorutil::subsample3D(tensorField, tensorField->getDimensions(), method);
+        ASSERT_NE(nullptr, resampled);
+        EXPECT_EQ(*tensorField->tensors(), *resampled->tensors());
+    }
+
+    const auto tensorField2D = testutil::testField2D(size2_t(7, 5), MetaDataPolicy::Lazy);
+    for (auto method :
+         {tensorutil::InterpolationMethod::Linear, tensorutil::InterpolationMethod::Nearest,
+          tensorutil::InterpolationMethod::Barycentric}) {
+        const auto resampled =
+            tensorutil::subsample2D(tensorField2D, tensorField2D->getDimensions(), method);
+        ASSERT_NE(nullptr, resampled);
+        EXPECT_EQ(*tensorField2D->tensors(), *resampled->tensors());
+    }
+}
+
+TEST(TensorUtilTests, resampleInterpolatesLinearRamp) {
+    // Voxel x of the output lies at x / 2 in the input
+    const auto tensorField = rampField(size3_t(5, 2, 3));
+    const size3_t newDimensions(9, 3, 2);
+
+    const auto linear = tensorutil::subsample3D(tensorField, newDimensions,
+                                                tensorutil::InterpolationMethod::Linear);
+    const auto nearest = tensorutil::subsample3D(tensorField, newDimensions,
+                                                 tensorutil::InterpolationMethod::Nearest);
+    ASSERT_EQ(newDimensions, linear->getDimensions());
+    ASSERT_EQ(newDimensions, nearest->getDimensions());
+
+    const util::IndexMapper3D indexMapper(newDimensions);
+    for (size_t i = 0; i < linear->getSize(); ++i) {
+        const auto x = static_cast<float>(indexMapper(i).x);
+        EXPECT_EQ(mat3(x / 2.0f), linear->at(i));
+        EXPECT_EQ(mat3(std::round(x / 2.0f)), nearest->at(i));
+    }
+}
+
+TEST(TensorUtilTests, resampleSingleElementAxis) {
+    const auto tensorField = rampField(size3_t(5, 1, 2));
+
+    // Growing an axis of one voxel repeats it
+    const auto grown = tensorutil::subsample3D(tensorField, size3_t(5, 4, 2));
+    const util::IndexMapper3D grownMapper(grown->getDimensions());
+    for (size_t i = 0; i < grown->getSize(); ++i) {
+        EXPECT_EQ(mat3(static_cast<float>(grownMapper(i).x)), grown->at(i));
+    }
+
+    // Shrinking an axis to one voxel keeps the first one
+    const auto shrunk = tensorutil::subsample3D(tensorField, size3_t(1, 1, 2));
+    ASSERT_EQ(2u, shrunk->getSize());
+    EXPECT_EQ(mat3(0.0f), shrunk->at(0));
+    EXPECT_EQ(mat3(0.0f), shrunk->at(1));
+}
+
+TEST(TensorUtilTests, resampleKeepsBasisAndOffset) {
+    auto tensorField = testutil::testField(size3_t(4), MetaDataPolicy::Lazy);
+    const mat3 basis(vec3(2, 0, 0), vec3(0, 3, 0), vec3(1, 0, 4));
+    const vec3 offset(-1.0f, 0.5f, 2.0f);
+    tensorField->setBasis(basis);
+    tensorField->setOffset(offset);
+
+    const auto resampled = tensorutil::subsample3D(tensorField, size3_t(7, 3, 2));
+    EXPECT_EQ(basis, resampled->getBasis());
+    EXPECT_EQ(offset, resampled->getOffset());
+}
+
+TEST(TensorUtilTests, cancelledResampleReturnsNull) {
+    const auto tensorField = testutil::testField(size3_t(8), MetaDataPolicy::Lazy);
+
+    float lastProgress = 0.0f;
+    const auto resampled = tensorutil::subsample3D(
+        tensorField, size3_t(40), tensorutil::InterpolationMethod::Linear,
+        [&](float progress) { lastProgress = progress; }, []() { return false; });
+    ASSERT_NE(nullptr, resampled);
+    EXPECT_FLOAT_EQ(1.0f, lastProgress);
+
+    EXPECT_EQ(nullptr, tensorutil::subsample3D(tensorField, size3_t(40),
+                                               tensorutil::InterpolationMethod::Linear, nullptr,
+                                               []() { return true; }));
+}
+
+}  // namespace inviwo
@@ -0,0 +1,53 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/datastructures/tensorfield3dsequence.h>
+#include <inviwo/core/util/exception.h>
+
+namespace inviwo {
+TEST(TensorUtilTests, sequenceCachesWithinBudget) {
+    const size3_t dimensions(4, 3, 2);
+    std::vector<glm::uint8> mask(glm::compMul(dimensions), 1);
+    mask[5] = 0;
+
+    size_t loads = 0;
+    auto loader = [&](size_t timestep, const std::function<bool()>&) {
+        ++loads;
+        std::vector<mat3> tensors(glm::compMul(dimensions), mat3(static_cast<float>(timestep)));
+        auto tensorField =
+            std::make_shared<TensorField3D>(dimensions, tensors, nullptr, MetaDataPolicy::Lazy);
+        tensorField->setMask(mask);
+        return tensorField;
+    };
+
+    TensorField3DSequence sequence(4, loader, 0, 0);
+    const auto bytes = TensorField3DSequence::estimateMemory(*sequence.get(0));
+    sequence.setMemoryBudget(2 * bytes);
+
+    const auto first = sequence.get(0);
+    const auto second = sequence.get(1);
+    EXPECT_EQ(2u, loads);
+    EXPECT_EQ(mat3(1.0f), second->at(size3_t(0)));
+    EXPECT_EQ(first, sequence.tryGet(0));
+    EXPECT_EQ(2 * bytes, sequence.getMemoryUsage());
+
+    // Equal masks are shared between timesteps
+    EXPECT_EQ(first->sharedMask(), second->sharedMask());
+
+    // The least recently used timestep is evicted, returned fields stay valid
+    sequence.get(0);
+    sequence.get(2);
+    EXPECT_EQ(3u, loads);
+    EXPECT_EQ(2 * bytes, sequence.getMemoryUsage());
+    EXPECT_EQ(first, sequence.get(0));
+    EXPECT_EQ(3u, loads);
+    sequence.get(1);
+    EXPECT_EQ(4u, loads);
+    EXPECT_EQ(mat3(1.0f), second->at(size3_t(0)));
+
+    EXPECT_THROW(sequence.get(4), Exception);
+}
+
+}  // namespace inviwo
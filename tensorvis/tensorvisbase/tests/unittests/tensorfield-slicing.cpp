@@ -0,0 +1,102 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/algorithm/tensorfieldslicing.h>
+#include <inviwo/tensorvisbase/util/tensorutil.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include "tensorfieldtestutils.h"
+
+namespace inviwo {
+
+namespace {
+
+// Position in the field of a position in the slice
+size3_t fieldPosition(CartesianCoordinateAxis axis, size_t sliceNumber, const size2_t& pos) {
+    switch (axis) {
+        case CartesianCoordinateAxis::X:
+            return size3_t(sliceNumber, pos.x, pos.y);
+        case CartesianCoordinateAxis::Y:
+            return size3_t(pos.x, sliceNumber, pos.y);
+        case CartesianCoordinateAxis::Z:
+        default:
+            return size3_t(pos.x, pos.y, sliceNumber);
+    }
+}
+
+size_t normalAxis(CartesianCoordinateAxis axis) {
+    switch (axis) {
+        case CartesianCoordinateAxis::X:
+            return 0;
+        case CartesianCoordinateAxis::Y:
+            return 1;
+        case CartesianCoordinateAxis::Z:
+        default:
+            return 2;
+    }
+}
+
+void expectSlicesMatchField(std::shared_ptr<const TensorField3D> tensorField) {
+    const auto dimensions = tensorField->getDimensions();
+    const util::IndexMapper3D fieldMapper(dimensions);
+
+    for (auto axis : {CartesianCoordinateAxis::X, CartesianCoordinateAxis::Y,
+                      CartesianCoordinateAxis::Z}) {
+        const auto normal = normalAxis(axis);
+        for (size_t sliceNumber = 0; sliceNumber < dimensions[normal]; ++sliceNumber) {
+            const TensorField3DSliceView view(tensorField, axis, sliceNumber);
+            const auto slice2D = view.materialize2D();
+            const auto slice3D = view.materialize3D();
+
+            size3_t expectedDimensions = dimensions;
+            expectedDimensions[normal] = 1;
+            ASSERT_EQ(view.getDimensions(), slice2D->getDimensions());
+            ASSERT_EQ(expectedDimensions, slice3D->getDimensions());
+            ASSERT_EQ(view.getSize(), slice3D->getSize());
+
+            const util::IndexMapper2D sliceMapper(view.getDimensions());
+            for (size_t i = 0; i < view.getSize(); ++i) {
+                const auto pos = sliceMapper(i);
+                const auto fieldPos = fieldPosition(axis, sliceNumber, pos);
+                const auto tensor = tensorField->at(fieldPos);
+                const auto projected = mat2(tensorutil::getProjectedTensor(dmat3(tensor), axis));
+
+                EXPECT_EQ(fieldMapper(fieldPos), view.index(pos));
+                EXPECT_EQ(tensor, view.at(pos));
+                EXPECT_EQ(projected, view.projectedAt(pos));
+                EXPECT_EQ(projected, slice2D->at(i));
+                EXPECT_EQ(tensor, slice3D->at(i));
+            }
+        }
+    }
+}
+
+}  // namespace
+
+TEST(TensorUtilTests, sliceViewMatchesField) {
+    const auto tensorField = testutil::testField(size3_t(5, 4, 3), MetaDataPolicy::Lazy);
+    const auto packed = std::make_shared<TensorField3D>(
+        tensorField->getDimensions(), TensorField3D::pack(*tensorField->tensors()), nullptr,
+        MetaDataPolicy::Lazy);
+    ASSERT_EQ(TensorStorage::PackedSymmetric, packed->storage());
+
+    expectSlicesMatchField(tensorField);
+    expectSlicesMatchField(packed);
+}
+
+TEST(TensorUtilTests, sliceViewPlacesSlice) {
+    auto tensorField = testutil::testField(size3_t(5, 4, 3), MetaDataPolicy::Lazy);
+    tensorField->setExtents(vec3(8.0f, 6.0f, 4.0f));
+
+    const auto sliceField = slice<3>(tensorField, CartesianCoordinateAxis::Y, 2);
+    EXPECT_EQ(tensorField->getExtents(), sliceField->getExtents());
+    EXPECT_EQ(vec3(0.0f, 4.0f, 0.0f), sliceField->getOffset());
+
+    EXPECT_THROW(TensorField3DSliceView(tensorField, CartesianCoordinateAxis::X, 5), Exception);
+    EXPECT_THROW(TensorField3DSliceView(tensorField, CartesianCoordinateAxis::Z, 3), Exception);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,137 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/algorithm/tensorfieldsubset.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include "tensorfieldtestutils.h"
+
+namespace inviwo {
+
+namespace {
+
+std::vector<glm::uint8> testMask(size_t size) {
+    std::vector<glm::uint8> mask(size);
+    for (size_t i = 0; i < mask.size(); ++i) mask[i] = static_cast<glm::uint8>(i % 3 != 0);
+    return mask;
+}
+
+}  // namespace
+
+TEST(TensorUtilTests, subsetKeepsMaskAndMetaData) {
+    const size3_t dimensions(5, 4, 3);
+    auto tensorField = testutil::testField(dimensions);
+    const auto mask = testMask(tensorField->getSize());
+    tensorField->setMask(mask);
+
+    const size3_t origin(1, 2, 1);
+    const size3_t subDimensions(3, 2, 2);
+    const TensorField3DSubsetView view(tensorField, origin, subDimensions);
+    const auto subset = view.materialize();
+
+    ASSERT_EQ(subDimensions, subset->getDimensions());
+    ASSERT_TRUE(subset->hasMask());
+    const auto& majorEigenValues = tensorField->majorEigenValues();
+    const auto& subsetEigenValues = subset->majorEigenValues();
+    const util::IndexMapper3D indexMapper(subDimensions);
+    for (size_t i = 0; i < subset->getSize(); ++i) {
+        const auto pos = indexMapper(i);
+        EXPECT_EQ(tensorField->at(origin + pos), subset->at(i));
+        EXPECT_EQ(tensorField->at(origin + pos), view.at(pos));
+        EXPECT_EQ(mask[view.index(pos)] != 0, view.isDefined(pos));
+        EXPECT_EQ(mask[view.index(pos)], subset->getMask()[i]);
+        EXPECT_EQ(majorEigenValues[view.index(pos)], subsetEigenValues[i]);
+    }
+
+    EXPECT_THROW(tensorutil::subset(tensorField, origin, size3_t(5, 2, 2)), Exception);
+    EXPECT_THROW(tensorutil::subset(tensorField, origin, size3_t(3, 0, 2)), Exception);
+}
+
+TEST(TensorUtilTests, subsetKeepsPositionInSpace) {
+    // Spacing of 2 along every axis
+    const size3_t dimensions(5, 4, 3);
+    auto tensorField = testutil::testField(dimensions, MetaDataPolicy::Lazy);
+    tensorField->setExtents(vec3(8.0f, 6.0f, 4.0f));
+    tensorField->setOffset(vec3(-1.0f, 0.5f, 2.0f));
+
+    const auto subset = tensorutil::subset(tensorField, size3_t(1, 2, 1), size3_t(3, 2, 2));
+    EXPECT_EQ(vec3(4.0f, 2.0f, 2.0f), subset->getExtents());
+    EXPECT_EQ(vec3(1.0f, 4.5f, 4.0f), subset->getOffset());
+    EXPECT_EQ(tensorField->getSpacing(), subset->getSpacing());
+    EXPECT_FALSE(subset->hasMask());
+
+    // The whole field is an identical copy
+    const auto copy = tensorutil::subset(tensorField, size3_t(0), dimensions);
+    EXPECT_EQ(*tensorField->tensors(), *copy->tensors());
+    EXPECT_EQ(tensorField->getBasis(), copy->getBasis());
+    EXPECT_EQ(tensorField->getOffset(), copy->getOffset());
+}
+
+TEST(TensorUtilTests, subsetOfPackedField) {
+    const size3_t dimensions(5, 4, 3);
+    const auto full = testutil::testField(dimensions, MetaDataPolicy::Lazy);
+    auto packed = std::make_shared<TensorField3D>(
+        dimensions, TensorField3D::pack(*full->tensors()), nullptr, MetaDataPolicy::Lazy);
+    const auto mask = testMask(packed->getSize());
+    packed->setMask(mask);
+
+    const size3_t origin(2, 1, 0);
+    const size3_t subDimensions(2, 3, 3);
+    const TensorField3DSubsetView view(packed, origin, subDimensions);
+    const auto subset = view.materialize();
+
+    ASSERT_EQ(TensorStorage::PackedSymmetric, subset->storage());
+    ASSERT_EQ(subDimensions, subset->getDimensions());
+    ASSERT_TRUE(subset->hasMask());
+    const util::IndexMapper3D indexMapper(subDimensions);
+    for (size_t i = 0; i < subset->getSize(); ++i) {
+        const auto pos = indexMapper(i);
+        EXPECT_EQ(full->at(origin + pos), subset->at(i));
+        EXPECT_EQ(full->at(origin + pos), view.at(pos));
+        EXPECT_EQ((*packed->packedTensors())[view.index(pos)], (*subset->packedTensors())[i]);
+        EXPECT_EQ(mask[view.index(pos)] != 0, view.isDefined(pos));
+        EXPECT_EQ(mask[view.index(pos)], subset->getMask()[i]);
+    }
+}
+
+TEST(TensorUtilTests, subsetOf2DField) {
+    const size2_t dimensions(6, 5);
+    auto tensorField = testutil::testField2D(dimensions);
+    const auto mask = testMask(tensorField->getSize());
+    tensorField->setMask(mask);
+    tensorField->setExtents(vec2(10.0f, 8.0f));
+    tensorField->setOffset(vec2(1.0f, -2.0f));
+
+    const size2_t origin(2, 1);
+    const size2_t subDimensions(3, 4);
+    const auto subset = tensorutil::subset(tensorField, origin, subDimensions);
+
+    ASSERT_EQ(subDimensions, subset->getDimensions());
+    ASSERT_TRUE(subset->hasMask());
+    EXPECT_EQ(vec2(4.0f, 6.0f), subset->getExtents());
+    EXPECT_EQ(vec2(5.0f, 0.0f), subset->getOffset());
+
+    const auto& majorEigenValues = tensorField->majorEigenValues();
+    const auto& subsetEigenValues = subset->majorEigenValues();
+    const util::IndexMapper2D indexMapper(subDimensions);
+    const util::IndexMapper2D fieldMapper(dimensions);
+    for (size_t i = 0; i < subset->getSize(); ++i) {
+        const auto index = fieldMapper(origin + indexMapper(i));
+        EXPECT_EQ(tensorField->at(index), subset->at(i));
+        EXPECT_EQ(mask[index], subset->getMask()[i]);
+        EXPECT_EQ(majorEigenValues[index], subsetEigenValues[i]);
+    }
+
+    const auto packed = std::make_shared<TensorField2D>(
+        dimensions, TensorField2D::pack(*tensorField->tensors()), nullptr, MetaDataPolicy::Lazy);
+    const auto packedSubset = tensorutil::subset(packed, origin, subDimensions);
+    ASSERT_EQ(TensorStorage::PackedSymmetric, packedSubset->storage());
+    EXPECT_EQ(*subset->tensors(), *packedSubset->tensors());
+
+    EXPECT_THROW(tensorutil::subset(tensorField, origin, size2_t(5, 4)), Exception);
+}
+
+}  // namespace inviwo
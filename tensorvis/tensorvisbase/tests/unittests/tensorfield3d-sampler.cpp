@@ -0,0 +1,71 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/algorithm/tensorfield3dsampler.h>
+
+#include "tensorfieldtestutils.h"
+
+namespace inviwo {
+
+namespace {
+
+// Lattice of 11^3 positions in [0,1]^3, including the faces, edges and corners
+std::vector<dvec3> samplePositions() {
+    std::vector<dvec3> positions;
+    for (int z = 0; z <= 10; ++z) {
+        for (int y = 0; y <= 10; ++y) {
+            for (int x = 0; x <= 10; ++x) positions.emplace_back(dvec3(x, y, z) / 10.0);
+        }
+    }
+    positions.emplace_back(0.0, 1.0, 0.5);
+    positions.emplace_back(1.0 / 3.0, 2.0 / 3.0, 0.99);
+    return positions;
+}
+
+template <tensorutil::InterpolationMethod method>
+void expectBatchedMatchesSample(std::shared_ptr<const TensorField3D> tensorField) {
+    const TensorField3DSampler sampler(tensorField, TensorField3DSampler::EigenVector::Major,
+                                       method);
+    const auto positions = samplePositions();
+    const auto tensors = sampler.sampleTensors(positions);
+    ASSERT_EQ(positions.size(), tensors.size());
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const auto expected = sample<method>(tensorField, positions[i]).second;
+        const auto single = sampler.sampleTensor(positions[i]);
+        for (glm::length_t col = 0; col < 3; ++col) {
+            for (glm::length_t row = 0; row < 3; ++row) {
+                EXPECT_NEAR(expected[col][row], tensors[i][col][row], 1e-4) << "position " << i;
+                EXPECT_EQ(single[col][row], tensors[i][col][row]) << "position " << i;
+            }
+        }
+    }
+}
+
+}  // namespace
+
+TEST(TensorUtilTests, batchedSamplingMatchesSample) {
+    const auto tensorField = testutil::testField(size3_t(5, 4, 3), MetaDataPolicy::Lazy);
+    const auto packed = std::make_shared<TensorField3D>(
+        tensorField->getDimensions(), TensorField3D::pack(*tensorField->tensors()), nullptr,
+        MetaDataPolicy::Lazy);
+    ASSERT_EQ(TensorStorage::PackedSymmetric, packed->storage());
+
+    for (const auto& field : {std::shared_ptr<const TensorField3D>(tensorField),
+                              std::shared_ptr<const TensorField3D>(packed)}) {
+        expectBatchedMatchesSample<tensorutil::InterpolationMethod::Linear>(field);
+        expectBatchedMatchesSample<tensorutil::InterpolationMethod::Nearest>(field);
+    }
+}
+
+TEST(TensorUtilTests, samplingFlatField) {
+    // Axes of a single voxel are constant
+    const auto tensorField = testutil::testField(size3_t(4, 1, 1), MetaDataPolicy::Lazy);
+    const TensorField3DSampler sampler(tensorField);
+    EXPECT_EQ(dmat3(testutil::testTensor(0.0f)), sampler.sampleTensor(dvec3(0.0, 0.3, 1.0)));
+    EXPECT_EQ(dmat3(testutil::testTensor(3.0f)), sampler.sampleTensor(dvec3(1.0, 0.7, 0.0)));
+}
+
+}  // namespace inviwo
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <inviwo/tensorvisbase/datastructures/tensorfield2d.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+
+namespace inviwo {
+
+namespace testutil {
+
+/**
+ * Symmetric tensor with three distinct eigen values for v > 0.
+ */
+inline mat3 testTensor(float v) {
+    return mat3(vec3(v, 1, 2), vec3(1, -v, 3), vec3(2, 3, 2 * v));
+}
+
+inline mat2 testTensor2D(float v) { return mat2(vec2(v, 1), vec2(1, -v)); }
+
+/**
+ * testTensor(i) for i in [0, count).
+ */
+inline std::vector<mat3> testTensors(size_t count) {
+    std::vector<mat3> tensors(count);
+    for (size_t i = 0; i < count; ++i) tensors[i] = testTensor(static_cast<float>(i));
+    return tensors;
+}
+
+inline std::vector<mat2> testTensors2D(size_t count) {
+    std::vector<mat2> tensors(count);
+    for (size_t i = 0; i < count; ++i) tensors[i] = testTensor2D(static_cast<float>(i));
+    return tensors;
+}
+
+/**
+ * Field with testTensor(i) at voxel i.
+ */
+inline std::shared_ptr<TensorField3D> testField(const size3_t& dimensions,
+                                                MetaDataPolicy policy = MetaDataPolicy::Eager) {
+    return std::make_shared<TensorField3D>(dimensions, testTensors(glm::compMul(dimensions)),
+                                           nullptr, policy);
+}
+
+inline std::shared_ptr<TensorField2D> testField2D(const size2_t& dimensions,
+                                                  MetaDataPolicy policy = MetaDataPolicy::Eager) {
+    return std::make_shared<TensorField2D>(dimensions, testTensors2D(glm::compMul(dimensions)),
+                                           nullptr, policy);
+}
+
+/**
+ * Field with the same tensor at every voxel.
+ */
+inline std::shared_ptr<TensorField3D> constantField(const size3_t& dimensions, const mat3& tensor,
+                                                    MetaDataPolicy policy = MetaDataPolicy::Eager) {
+    return std::make_shared<TensorField3D>(
+        dimensions, std::vector<mat3>(glm::compMul(dimensions), tensor), nullptr, policy);
+}
+
+}  // namespace testutil
+
+}  // namespace inviwo
@@ -0,0 +1,75 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/fileproperty.h>
+#include <inviwo/tensorvisbase/ports/tensorfieldport.h>
+#include <inviwo/tensorvisio/tensorvisiomoduledefine.h>
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.SparseTensorField3DImport, Sparse Tensor Field 3D Import}
+ * ![](org.inviwo.SparseTensorField3DImport.png?classIdentifier=org.inviwo.SparseTensorField3DImport)
+ * Reads a tfb file as a sparse tensor field, see tfb::readSparse(). Only the tensors of the
+ * active voxels are kept in memory.
+ *
+ * ### Outports
+ *   * __outport__ Sparse tensor field.
+ *
+ * ### Properties
+ *   * __File__ Tfb file, version 6 or 7.
+ *   * __Normalize extents__ Scale the extents so that the largest one is 1.
+ *   * __Packed symmetric storage__ Store the tensors packed if all of them are symmetric.
+ *   * __Compute meta data on demand__ Use MetaDataPolicy::Lazy for the eigen systems.
+ */
+class IVW_MODULE_TENSORVISIO_API SparseTensorField3DImport : public Processor {
+public:
+    SparseTensorField3DImport();
+    virtual ~SparseTensorField3DImport() = default;
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    FileProperty inFile_;
+
+    SparseTensorField3DOutport outport_;
+
+    BoolProperty normalizeExtents_;
+    BoolProperty packedStorage_;
+    BoolProperty lazyMetaData_;
+};
+
+}  // namespace inviwo
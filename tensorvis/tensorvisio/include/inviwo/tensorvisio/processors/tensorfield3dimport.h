@@ -31,12 +31,17 @@
 
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/activityindicator.h>
+#include <inviwo/core/processors/progressbarowner.h>
 #include <inviwo/core/properties/boolproperty.h>
 #include <inviwo/core/properties/fileproperty.h>
 #include <inviwo/core/properties/ordinalproperty.h>
 #include <inviwo/tensorvisbase/ports/tensorfieldport.h>
 #include <inviwo/tensorvisio/tensorvisiomoduledefine.h>
 
+#include <atomic>
+#include <memory>
+
 namespace inviwo {
 
 /** \docpage{org.inviwo.TensorField3DImport, Tensor Field 3D Import}
@@ -53,10 +58,12 @@ namespace inviwo {
  *   * __<Prop1>__ <description>.
  *   * __<Prop2>__ <description>
  */
-class IVW_MODULE_TENSORVISIO_API TensorField3DImport : public Processor {
+class IVW_MODULE_TENSORVISIO_API TensorField3DImport : public Processor,
+                                                       public ActivityIndicatorOwner,
+                                                       public ProgressBarOwner {
 public:
     TensorField3DImport();
-    virtual ~TensorField3DImport() = default;
+    virtual ~TensorField3DImport();
 
     virtual void initializeResources() override;
     virtual void process() override;
@@ -65,18 +72,31 @@ public:
     static const ProcessorInfo processorInfo_;
 
 private:
+    /**
+     * Reads the header of the file and updates the dimensions, extents and offset properties. If
+     * the header cannot be read, the outport is cleared.
+     */
+    void probe();
+    /**
+     * Reads the tensors on the pool. A load already in flight is cancelled.
+     */
+    void load();
+
     FileProperty inFile_;
 
     TensorField3DOutport outport_;
 
     BoolProperty normalizeExtents_;
+    BoolProperty packedStorage_;
+    BoolProperty lazyMetaData_;
 
     FloatVec3Property extents_;
     FloatVec3Property offset_;
     IntVec3Property dimensions_;
 
-    void buildTensors(const std::vector<TensorField3D::value_type> &data,
-                      std::shared_ptr<std::vector<TensorField3D::matN>> tensors) const;
+    std::shared_ptr<TensorField3D> tensorField_;
+    std::shared_ptr<std::atomic<bool>> cancelLoad_;
+    bool needsLoad_;
 };
 
 }  // namespace inviwo
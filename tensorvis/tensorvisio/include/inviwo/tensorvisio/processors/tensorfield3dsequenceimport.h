@@ -0,0 +1,84 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/directoryproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/tensorvisbase/ports/tensorfieldport.h>
+#include <inviwo/tensorvisio/tensorvisiomoduledefine.h>
+
+#include <memory>
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.TensorField3DSequenceImport, Tensor Field 3D Sequence Import}
+ * ![](org.inviwo.TensorField3DSequenceImport.png?classIdentifier=org.inviwo.TensorField3DSequenceImport)
+ * Reads a time-varying tensor field from a directory holding one tfb file per timestep, ordered
+ * by file name. Timesteps are read on demand, see TensorField3DSequence.
+ *
+ * ### Outports
+ *   * __outport__ The tensor field sequence.
+ *
+ * ### Properties
+ *   * __Directory__ Directory containing the tfb files.
+ *   * __Prefetched timesteps__ Number of timesteps read ahead of the requested one.
+ *   * __Memory budget__ Upper limit for the cached timesteps in MB.
+ *   * __Normalize extents__ Scales the extents of every timestep to a largest side of 1.
+ *   * __Packed symmetric storage__ See TensorField3DImport.
+ *   * __Compute meta data on demand__ See TensorField3DImport.
+ */
+class IVW_MODULE_TENSORVISIO_API TensorField3DSequenceImport : public Processor {
+public:
+    TensorField3DSequenceImport();
+    virtual ~TensorField3DSequenceImport() = default;
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    DirectoryProperty directory_;
+
+    TensorField3DSequenceOutport outport_;
+
+    IntSizeTProperty prefetchCount_;
+    IntSizeTProperty memoryBudget_;
+    BoolProperty normalizeExtents_;
+    BoolProperty packedStorage_;
+    BoolProperty lazyMetaData_;
+
+    std::shared_ptr<TensorField3DSequence> sequence_;
+};
+
+}  // namespace inviwo
@@ -0,0 +1,175 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/tensorvisio/tensorvisiomoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/tensorvisbase/datastructures/brickedtensorfield3d.h>
+#include <inviwo/tensorvisbase/datastructures/sparsetensorfield3d.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace inviwo {
+namespace tfb {
+
+/**
+ * Version of the chunked tfb layout written by write(). Files are laid out as follows, all offsets
+ * are absolute and aligned to tfb::alignment bytes:
+ *
+ *   - Preamble: size_t length, "TFBVersion:", size_t version (shared with older versions)
+ *   - Header at headerOffset
+ *   - Chunk index, Header::numChunks entries of ChunkEntry
+ *   - Chunks of Header::tensorsPerChunk tensors each (the last one might be smaller), 9 floats per
+ *     tensor in glm (column-major) order
+ *   - Optional mask, one byte per tensor
+ *   - Optional meta data directory, Header::numColumns entries of ColumnEntry, followed by the
+ *     column data
+ *
+ * Version 6 files (TFB_CURRENT_VERSION) are still supported by read().
+ */
+constexpr size_t version = 7;
+constexpr size_t alignment = 64;
+constexpr size_t headerOffset = alignment;
+constexpr size_t defaultTensorsPerChunk = size_t{1} << 16;
+
+/**
+ * Compression codec of a chunk. Only uncompressed chunks are written for now, the field is
+ * reserved so that codecs can be added without changing the layout.
+ */
+enum class Codec : std::uint32_t { None = 0 };
+
+struct Header {
+    std::uint64_t dimensions[3];
+    float extents[3];
+    float offset[3];
+    double eigenValueRanges[3][2];
+    double eigenVectorRanges[3][2];
+    std::uint64_t tensorsPerChunk;
+    std::uint64_t numChunks;
+    std::uint64_t chunkIndexOffset;
+    std::uint64_t maskOffset;  // 0 if the field has no mask
+    std::uint64_t columnDirectoryOffset;
+    std::uint64_t numColumns;
+};
+
+struct ChunkEntry {
+    std::uint64_t offset;
+    std::uint64_t storedSize;  // Size in the file, after encoding with codec
+    Codec codec;
+    std::uint32_t reserved;
+};
+
+struct ColumnEntry {
+    std::uint64_t id;  // util::constexpr_hash of the column header
+    std::uint64_t offset;
+    std::uint64_t numItems;
+    std::uint64_t byteSize;
+};
+
+static_assert(std::is_trivially_copyable_v<Header> && sizeof(Header) % 8 == 0);
+static_assert(std::is_trivially_copyable_v<ChunkEntry> && sizeof(ChunkEntry) == 24);
+static_assert(std::is_trivially_copyable_v<ColumnEntry> && sizeof(ColumnEntry) == 32);
+
+/**
+ * Summary of a tfb file, see readInfo().
+ */
+struct Info {
+    size_t version;
+    size3_t dimensions;
+    vec3 extents;
+    vec3 offset;
+};
+
+/**
+ * Reads the preamble and header of a tfb file, version 6 or 7, without touching the tensors.
+ * Throws an Exception if the file is not a valid tfb file.
+ */
+IVW_MODULE_TENSORVISIO_API Info readInfo(const std::string& path);
+
+struct ReadOptions {
+    /**
+     * Use TensorStorage::PackedSymmetric if all tensors are symmetric
+     */
+    bool packedStorage = false;
+    MetaDataPolicy policy = MetaDataPolicy::Eager;
+    /**
+     * Called with the fraction of the tensors read so far, from the calling thread
+     */
+    std::function<void(float)> progress;
+    /**
+     * Polled between batches, read() and readSparse() stop and return nullptr once it returns true
+     */
+    std::function<bool()> cancelled;
+};
+
+/**
+ * Reads a 3D tensor field from a tfb file, version 6 or 7. Version 7 files are memory mapped and
+ * the chunks are copied straight into the tensor storage of the field. Meta data stored in the
+ * file is handed to the field on construction, so eigen system columns present in the file are
+ * not recomputed. Throws an Exception if the file cannot be read.
+ */
+IVW_MODULE_TENSORVISIO_API std::shared_ptr<TensorField3D> read(const std::string& path,
+                                                               const ReadOptions& options = {});
+
+/**
+ * Reads a 3D tensor field from a tfb file, version 6 or 7, as a SparseTensorField3D. Only the
+ * tensors of the active voxels are copied out of the memory mapped file, the dense field is never
+ * created. Voxels with a non-zero mask value are active, or voxels with a non-zero tensor if the
+ * file has no mask. Meta data stored in the file is ignored since it holds rows for all voxels.
+ * Throws an Exception if the file cannot be read.
+ */
+IVW_MODULE_TENSORVISIO_API std::shared_ptr<SparseTensorField3D> readSparse(
+    const std::string& path, const ReadOptions& options = {});
+
+/**
+ * Writes the tensor field in the chunked version 7 layout. Chunks that have to be converted
+ * (packed symmetric storage) are encoded in parallel. Throws an Exception if the file cannot be
+ * written.
+ */
+IVW_MODULE_TENSORVISIO_API void write(const std::string& path, const TensorField3D& tensorField,
+                                      bool includeMetaData,
+                                      size_t tensorsPerChunk = defaultTensorsPerChunk);
+
+/**
+ * Converts a tfb file, version 6 or 7, into a brick file for BrickedTensorField3D. The tfb file
+ * is memory mapped and streamed brick by brick, so the field does not have to fit into memory.
+ * Meta data and mask are not converted. Throws an Exception if either file cannot be accessed.
+ */
+IVW_MODULE_TENSORVISIO_API void writeBricked(
+    const std::string& path, const std::string& brickPath,
+    size_t brickSize = BrickedTensorField3D::defaultBrickSize);
+
+}  // namespace tfb
+}  // namespace inviwo
@@ -40,7 +40,7 @@ std::basic_ostream<Elem, Traits>& operator<<(std::basic_ostream<Elem, Traits>& o
     return os;
 }
 
-inline std::string getFileSizeAsString(const std::string&, const FileSizeOrder order,
+inline std::string getFileSizeAsString(const std::string& file, const FileSizeOrder order,
                                        const long long precision = 2) {
     const auto fileSize = std::filesystem::file_size(file);
 
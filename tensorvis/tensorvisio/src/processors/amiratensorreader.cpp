@@ -136,7 +136,8 @@ void AmiraTensorReader::process() {
 
             delete[] pData;
 
-            auto newTF = std::make_shared<TensorField3D>(size3_t(xDim, yDim, zDim), data);
+            auto newTF =
+                std::make_shared<TensorField3D>(size3_t(xDim, yDim, zDim), std::move(data));
             newTF->setExtents(extents);
 
             outport_.setData(newTF);
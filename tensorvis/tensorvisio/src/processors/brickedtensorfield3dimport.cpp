@@ -0,0 +1,70 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisio/processors/brickedtensorfield3dimport.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/tensorvisbase/tensorvisbasemodule.h>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming
+// scheme
+const ProcessorInfo BrickedTensorField3DImport::processorInfo_{
+    "org.inviwo.BrickedTensorField3DImport",  // Class identifier
+    "Bricked Tensor Field 3D Import",         // Display name
+    "Data Input",                             // Category
+    CodeState::Experimental,                  // Code state
+    tag::OpenTensorVis | Tag::CPU,            // Tags
+};
+const ProcessorInfo BrickedTensorField3DImport::getProcessorInfo() const { return processorInfo_; }
+
+BrickedTensorField3DImport::BrickedTensorField3DImport()
+    : Processor()
+    , inFile_("inFile", "File", "", "tensorbricks")
+    , outport_("outport")
+    , cacheSize_("cacheSize", "Cache size", BrickedTensorField3D::defaultCacheSize, 1, 4096) {
+    addPort(outport_);
+
+    addProperties(inFile_, cacheSize_);
+}
+
+void BrickedTensorField3DImport::process() {
+    std::shared_ptr<BrickedTensorField3D> tensorField;
+    try {
+        tensorField = std::make_shared<BrickedTensorField3D>(inFile_.get(), cacheSize_.get());
+    } catch (const Exception &e) {
+        LogError(e.getMessage());
+        outport_.clear();
+        return;
+    }
+
+    outport_.setData(tensorField);
+}
+
+}  // namespace inviwo
@@ -212,7 +212,7 @@ void NRRDReader::process() {
     vol->dataMap_.valueRange = vec2(0, 1);
     volumeOutport_.setData(vol);
 
-    auto outField = std::make_shared<TensorField3D>(dimensions, dataForTensorField);
+    auto outField = std::make_shared<TensorField3D>(dimensions, std::move(dataForTensorField));
     outField->setBasis(vol->getBasis());
     outField->setOffset(vol->getOffset());
     outport3D_.setData(outField);
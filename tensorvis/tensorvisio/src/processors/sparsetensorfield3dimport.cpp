@@ -0,0 +1,83 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisio/processors/sparsetensorfield3dimport.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/tensorvisbase/tensorvisbasemodule.h>
+#include <inviwo/tensorvisio/util/tfbformat.h>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming
+// scheme
+const ProcessorInfo SparseTensorField3DImport::processorInfo_{
+    "org.inviwo.SparseTensorField3DImport",  // Class identifier
+    "Sparse Tensor Field 3D Import",         // Display name
+    "Data Input",                            // Category
+    CodeState::Experimental,                 // Code state
+    tag::OpenTensorVis | Tag::CPU,           // Tags
+};
+const ProcessorInfo SparseTensorField3DImport::getProcessorInfo() const { return processorInfo_; }
+
+SparseTensorField3DImport::SparseTensorField3DImport()
+    : Processor()
+    , inFile_("inFile", "File", "", "tensorfield")
+    , outport_("outport")
+    , normalizeExtents_("normalizeExtents", "Normalize extents", true)
+    , packedStorage_("packedStorage", "Packed symmetric storage", false)
+    , lazyMetaData_("lazyMetaData", "Compute meta data on demand", true) {
+    addPort(outport_);
+
+    addProperties(inFile_, normalizeExtents_, packedStorage_, lazyMetaData_);
+}
+
+void SparseTensorField3DImport::process() {
+    tfb::ReadOptions options;
+    options.packedStorage = packedStorage_.get();
+    options.policy = lazyMetaData_.get() ? MetaDataPolicy::Lazy : MetaDataPolicy::Eager;
+
+    std::shared_ptr<SparseTensorField3D> tensorField;
+    try {
+        tensorField = tfb::readSparse(inFile_.get(), options);
+    } catch (const Exception &e) {
+        LogError(e.getMessage());
+        outport_.clear();
+        return;
+    }
+
+    if (normalizeExtents_.get()) {
+        const auto extents = tensorField->getExtents();
+        tensorField->setBasis(tensorField->getBasis() /
+                              std::max(std::max(extents.x, extents.y), extents.z));
+    }
+
+    outport_.setData(tensorField);
+}
+
+}  // namespace inviwo
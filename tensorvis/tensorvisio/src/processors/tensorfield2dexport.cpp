@@ -76,7 +76,13 @@ void TensorField2DExport::exportBinary() const {
 
     LogInfo("Exporting...");
 
-    auto tensorField = inport_.getData();
+    std::shared_ptr<const TensorField2D> tensorField = inport_.getData();
+    if (tensorField->metaDataPolicy() == MetaDataPolicy::Lazy) {
+        // The data maps are written to the file, compute them on a shallow copy
+        auto eagerField = std::shared_ptr<TensorField2D>(tensorField->clone());
+        eagerField->setMetaDataPolicy(MetaDataPolicy::Eager);
+        tensorField = eagerField;
+    }
 
     std::ofstream outFile;
     outFile.open(exportFile_.get(), std::ios::out | std::ios::binary);
@@ -113,9 +119,9 @@ void TensorField2DExport::exportBinary() const {
     outFile.write(reinterpret_cast<const char *>(&eigenVectorDataMaps[1].dataRange),
                   sizeof(double) * 2);
 
-    const auto &data = *tensorField->tensors();
-
-    for (const auto &val : data) {
+    // at() reconstructs the full tensor if the field uses packed symmetric storage
+    for (size_t i{0}; i < tensorField->getSize(); ++i) {
+        const auto val = tensorField->at(i);
         outFile.write(reinterpret_cast<const char *>(glm::value_ptr(val)),
                       sizeof(TensorField2D::value_type) * 4);
     }
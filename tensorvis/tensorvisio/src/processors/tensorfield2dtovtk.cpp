@@ -67,7 +67,8 @@ TensorField2DToVTK::TensorField2DToVTK()
 void TensorField2DToVTK::process() {
     const auto tensorField = tensorFieldInport_.getData();
     const auto dimensions = ivec3{tensorField->getDimensionsAs<int>(), 1};
-    const auto &tensors = *tensorField->tensors();
+    const auto tensorData = tensorField->tensors();
+    const auto &tensors = *tensorData;
 
     auto structuredGrid = vtkSmartPointer<vtkStructuredGrid>::New();
     auto points = vtkSmartPointer<vtkPoints>::New();
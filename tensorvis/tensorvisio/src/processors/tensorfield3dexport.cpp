@@ -31,6 +31,8 @@
 #include <inviwo/tensorvisbase/ports/tensorfieldport.h>
 #include <inviwo/tensorvisbase/tensorvisbasemodule.h>
 #include <inviwo/tensorvisio/util/util.h>
+#include <inviwo/tensorvisio/util/tfbformat.h>
+#include <inviwo/core/util/exception.h>
 
 namespace inviwo {
 
@@ -78,77 +80,21 @@ void TensorField3DExport::exportBinary() const {
 
     LogInfo("Exporting...");
 
-    auto tensorField = inport_.getData();
-
-    std::ofstream outFile;
-    outFile.open(exportFile_.get(), std::ios::out | std::ios::binary);
-
-    std::string versionStr("TFBVersion:");
-    size_t size = versionStr.size();
-    outFile.write(reinterpret_cast<const char *>(&size), sizeof(size_t));
-    outFile.write(&versionStr[0], size);
-
-    size_t version = TFB_CURRENT_VERSION;
-    outFile.write(reinterpret_cast<const char *>(&version), sizeof(size_t));
-
-    auto hasMetaData = glm::uint8(includeMetaData_.get());
-    outFile.write(reinterpret_cast<const char *>(&hasMetaData), sizeof(glm::uint8));
-
-    auto dimensions = tensorField->getDimensions();
-    outFile.write(reinterpret_cast<const char *>(&dimensions), sizeof(size_t) * 3);
-
-    auto extents = tensorField->getExtents();
-    outFile.write(reinterpret_cast<const char *>(&extents), sizeof(float) * 3);
-
-    auto offset = tensorField->getOffset();
-    outFile.write(reinterpret_cast<const char *>(&offset), sizeof(float) * 3);
-
-    auto &eigenValueDataMaps = tensorField->dataMapEigenValues_;
-    outFile.write(reinterpret_cast<const char *>(&eigenValueDataMaps[0].dataRange),
-                  sizeof(double) * 2);
-    outFile.write(reinterpret_cast<const char *>(&eigenValueDataMaps[1].dataRange),
-                  sizeof(double) * 2);
-    outFile.write(reinterpret_cast<const char *>(&eigenValueDataMaps[2].dataRange),
-                  sizeof(double) * 2);
-
-    auto &eigenVectorDataMaps = tensorField->dataMapEigenVectors_;
-    outFile.write(reinterpret_cast<const char *>(&eigenVectorDataMaps[0].dataRange),
-                  sizeof(double) * 2);
-    outFile.write(reinterpret_cast<const char *>(&eigenVectorDataMaps[1].dataRange),
-                  sizeof(double) * 2);
-    outFile.write(reinterpret_cast<const char *>(&eigenVectorDataMaps[2].dataRange),
-                  sizeof(double) * 2);
-
-    const auto &data = *tensorField->tensors();
-
-    for (const auto &val : data) {
-        outFile.write(reinterpret_cast<const char *>(glm::value_ptr(val)),
-                      sizeof(TensorField3D::value_type) * 9);
-    }
-
-    auto hasMask = glm::uint8(tensorField->hasMask());
-    outFile.write(reinterpret_cast<char *>(&hasMask), sizeof(glm::uint8));
-
-    if (hasMask) {
-        auto &mask = tensorField->getMask();
-        auto maskData = mask.data();
-        outFile.write(reinterpret_cast<const char *>(maskData), sizeof(glm::uint8) * mask.size());
+    std::shared_ptr<const TensorField3D> tensorField = inport_.getData();
+    if (tensorField->metaDataPolicy() == MetaDataPolicy::Lazy) {
+        // The data maps are written to the file, compute them on a shallow copy
+        auto eagerField = std::shared_ptr<TensorField3D>(tensorField->clone());
+        eagerField->setMetaDataPolicy(MetaDataPolicy::Eager);
+        tensorField = eagerField;
     }
 
-    if (includeMetaData_.get()) {
-        const size_t numMetaDataEntries =
-            tensorField->metaData()->getNumberOfColumns() - 1;  // omit index buffer
-        outFile.write(reinterpret_cast<const char *>(&numMetaDataEntries), sizeof(size_t));
-        util::serializeDataFrame(tensorField->metaData(), outFile);
+    try {
+        tfb::write(exportFile_.get(), *tensorField, includeMetaData_.get());
+    } catch (const Exception &e) {
+        LogError(e.getMessage());
+        return;
     }
 
-    std::string str("EOFreached");
-    size = str.size();
-    outFile.write(reinterpret_cast<const char *>(&size), sizeof(size_t));
-    outFile.write(&str[0], size);
-
-    outFile.close();
-
     LogInfo(exportFile_.get() << " successfully exported. (roughly "
                               << util::getFileSizeAsString(exportFile_.get(),
                                                            util::FileSizeOrder::GiB));
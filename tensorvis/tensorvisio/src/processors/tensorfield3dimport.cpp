@@ -27,15 +27,11 @@
  *
  *********************************************************************************/
 
-#include <fstream>
-#include <inviwo/core/datastructures/datamapper.h>
-#include <ios>
 #include <inviwo/tensorvisio/processors/tensorfield3dimport.h>
-#include <unordered_map>
-#include <inviwo/tensorvisbase/datastructures/attributes.h>
+#include <inviwo/core/network/networklock.h>
+#include <inviwo/core/util/exception.h>
 #include <inviwo/tensorvisbase/tensorvisbasemodule.h>
-#include <inviwo/core/util/constexprhash.h>
-#include <inviwo/tensorvisio/util/util.h>
+#include <inviwo/tensorvisio/util/tfbformat.h>
 
 namespace inviwo {
 
@@ -55,12 +51,15 @@ TensorField3DImport::TensorField3DImport()
     , inFile_("inFile", "File", "", "tensorfield")
     , outport_("outport")
     , normalizeExtents_("normalizeExtents", "Normalize extents", true)
+    , packedStorage_("packedStorage", "Packed symmetric storage", false)
+    , lazyMetaData_("lazyMetaData", "Compute meta data on demand", false)
     , extents_("extents", "Extents", vec3(1.f), vec3(0.f), vec3(1000.f), vec3(0.0001f),
                InvalidationLevel::Valid)
     , offset_("offset", "Offset", vec3(1.f), vec3(-1000.f), vec3(1000.f), vec3(0.0001f),
               InvalidationLevel::Valid)
     , dimensions_("dimensions", "Dimensions", ivec3(0), ivec3(0), ivec3(1024), ivec3(1),
-                  InvalidationLevel::Valid) {
+                  InvalidationLevel::Valid)
+    , needsLoad_(true) {
     addPort(outport_);
 
     extents_.setReadOnly(true);
@@ -72,9 +71,19 @@ TensorField3DImport::TensorField3DImport()
     dimensions_.setReadOnly(true);
     dimensions_.setCurrentStateAsDefault();
 
-    addProperties(inFile_, normalizeExtents_, extents_, offset_, dimensions_);
+    addProperties(inFile_, normalizeExtents_, packedStorage_, lazyMetaData_, extents_, offset_,
+                  dimensions_);
 
-    inFile_.onChange([this]() { invalidate(InvalidationLevel::InvalidOutput); });
+    // The extents shown depend on the normalization, hence it probes the file again
+    inFile_.onChange([this]() { probe(); });
+    normalizeExtents_.onChange([this]() { probe(); });
+
+    const auto reload = [this]() {
+        needsLoad_ = true;
+        invalidate(InvalidationLevel::InvalidOutput);
+    };
+    packedStorage_.onChange(reload);
+    lazyMetaData_.onChange(reload);
 
     inFile_.set(InviwoApplication::getPtr()->getModuleByType<TensorVisBaseModule>()->getPath(
                     ModulePath::Data) +
@@ -83,159 +92,111 @@ TensorField3DImport::TensorField3DImport()
 
 void TensorField3DImport::initializeResources() {}
 
-void TensorField3DImport::process() {
-    std::ifstream inFile(inFile_.get(), std::ios::in | std::ios::binary);
-
-    if (!inFile) {
-        LogError("Couldn't open file");
-        return;
-    }
+TensorField3DImport::~TensorField3DImport() {
+    if (cancelLoad_) *cancelLoad_ = true;
+}
 
-    size_t version;
-    size3_t dimensions;
-    auto extents = vec3{};
-    auto offset = vec3{};
-    glm::uint8 hasMetaData;
-    std::array<DataMapper, 3> dataMapperEigenValues;
-    std::array<DataMapper, 3> dataMapperEigenVectors;
-    std::vector<glm::uint8> mask;
-
-    std::string versionStr;
-    size_t size;
-    inFile.read(reinterpret_cast<char *>(&size), sizeof(size_t));
-    versionStr.resize(size);
-    inFile.read(&versionStr[0], size);
-
-    if (versionStr != "TFBVersion:") {
-        LogError("No valid tfb file!");
-        return;
+void TensorField3DImport::process() {
+    if (needsLoad_) {
+        needsLoad_ = false;
+        load();
+    } else if (tensorField_) {
+        outport_.setData(tensorField_);
     }
+}
 
-    inFile.read(reinterpret_cast<char *>(&version), sizeof(size_t));
-
-    if (version < TFB_CURRENT_VERSION) {
-        LogError("Please update the tfb file.");
-        LogError("Current version is " << TFB_CURRENT_VERSION << ", file has " << version);
+void TensorField3DImport::probe() {
+    tfb::Info info;
+    try {
+        info = tfb::readInfo(inFile_.get());
+    } catch (const Exception &e) {
+        LogError(e.getMessage());
+
+        // Do not keep showing the previous file
+        if (cancelLoad_) *cancelLoad_ = true;
+        tensorField_.reset();
+        needsLoad_ = false;
+        getActivityIndicator().setActive(false);
+        progressBar_.hide();
+        {
+            NetworkLock lock;
+            extents_.resetToDefaultState();
+            offset_.resetToDefaultState();
+            dimensions_.resetToDefaultState();
+        }
+        outport_.clear();
+        invalidate(InvalidationLevel::InvalidOutput);
         return;
     }
 
-    inFile.read(reinterpret_cast<char *>(&hasMetaData), sizeof(glm::uint8));
-
-    inFile.read(reinterpret_cast<char *>(&dimensions.x), sizeof(size_t));
-    inFile.read(reinterpret_cast<char *>(&dimensions.y), sizeof(size_t));
-    inFile.read(reinterpret_cast<char *>(&dimensions.z), sizeof(size_t));
-
-    // Read the extents
-
-    inFile.read(reinterpret_cast<char *>(&extents.x), sizeof(float));
-    inFile.read(reinterpret_cast<char *>(&extents.y), sizeof(float));
-    inFile.read(reinterpret_cast<char *>(&extents.z), sizeof(float));
-
-    inFile.read(reinterpret_cast<char *>(&offset.x), sizeof(float));
-    inFile.read(reinterpret_cast<char *>(&offset.y), sizeof(float));
-    inFile.read(reinterpret_cast<char *>(&offset.z), sizeof(float));
-
-    // Read the data maps
-
-    inFile.read(reinterpret_cast<char *>(&dataMapperEigenValues[0].dataRange), sizeof(double) * 2);
-    inFile.read(reinterpret_cast<char *>(&dataMapperEigenValues[1].dataRange), sizeof(double) * 2);
-    inFile.read(reinterpret_cast<char *>(&dataMapperEigenValues[2].dataRange), sizeof(double) * 2);
-    dataMapperEigenValues[0].valueRange = dataMapperEigenValues[0].dataRange;
-    dataMapperEigenValues[1].valueRange = dataMapperEigenValues[1].dataRange;
-    dataMapperEigenValues[2].valueRange = dataMapperEigenValues[2].dataRange;
-
-    inFile.read(reinterpret_cast<char *>(&dataMapperEigenVectors[0].dataRange), sizeof(double) * 2);
-    inFile.read(reinterpret_cast<char *>(&dataMapperEigenVectors[1].dataRange), sizeof(double) * 2);
-    inFile.read(reinterpret_cast<char *>(&dataMapperEigenVectors[2].dataRange), sizeof(double) * 2);
-    dataMapperEigenVectors[0].valueRange = dataMapperEigenVectors[0].dataRange;
-    dataMapperEigenVectors[1].valueRange = dataMapperEigenVectors[1].dataRange;
-    dataMapperEigenVectors[2].valueRange = dataMapperEigenVectors[2].dataRange;
-
-    auto numElements = dimensions.x * dimensions.y * dimensions.z;
-    auto numValues = numElements * 9;
-
-    std::vector<TensorField3D::value_type> data;
-    data.resize(numValues);
-    auto dataRaw = data.data();
-
-    inFile.read(reinterpret_cast<char *>(dataRaw), sizeof(TensorField3D::value_type) * numValues);
-
-    auto tensors = std::make_shared<std::vector<TensorField3D::matN>>();
-    buildTensors(data, tensors);
-
-    glm::uint8 hasMask;
-    inFile.read(reinterpret_cast<char *>(&hasMask), sizeof(glm::uint8));
-
-    if (hasMask) {
-        mask.resize(numElements);
-        auto maskData = mask.data();
-        inFile.read(reinterpret_cast<char *>(maskData), sizeof(glm::uint8) * numElements);
-    }
-
-    auto tensorFieldOut = std::make_shared<TensorField3D>(dimensions, tensors);
-
-    tensorFieldOut->dataMapEigenValues_ = dataMapperEigenValues;
-    tensorFieldOut->dataMapEigenVectors_ = dataMapperEigenVectors;
-
+    auto extents = info.extents;
     if (normalizeExtents_.get()) {
         extents /= std::max(std::max(extents.x, extents.y), extents.z);
     }
 
-    tensorFieldOut->setExtents(extents);
-    tensorFieldOut->setOffset(offset);
-    tensorFieldOut->setMask(mask);
-
-    extents_.set(extents);
-    offset_.set(offset);
-    dimensions_.set(dimensions);
-
-    std::shared_ptr<DataFrame> dataFrame;
-
-    if (hasMetaData) {
-        dataFrame = std::make_shared<DataFrame>();
-        size_t numMetaDataEntries;
-        inFile.read(reinterpret_cast<char *>(&numMetaDataEntries), sizeof(size_t));
-
-        for (size_t i = 0; i < numMetaDataEntries; i++) {
-            size_t id{0};
-            inFile.read(reinterpret_cast<char *>(&id), sizeof(size_t));
-            size_t numItems{0};
-            inFile.read(reinterpret_cast<char *>(&numItems), sizeof(size_t));
-
-            util::for_each_type<attributes::types3D>{}(util::DeserializeColumn{}, id,
-                                                       std::ref(inFile), dataFrame, numItems);
-        }
-
-        dataFrame->updateIndexBuffer();
-
-        tensorFieldOut->setMetaData(dataFrame);
+    {
+        NetworkLock lock;
+        extents_.set(extents);
+        offset_.set(info.offset);
+        dimensions_.set(info.dimensions);
     }
 
-    std::string str;
-    inFile.read(reinterpret_cast<char *>(&size), sizeof(size_t));
-    str.resize(size);
-    inFile.read(&str[0], size);
-
-    if (str != "EOFreached") {
-        LogError("EOF not reached");
-        return;
-    }
+    needsLoad_ = true;
+    invalidate(InvalidationLevel::InvalidOutput);
+}
 
-    inFile.close();
+void TensorField3DImport::load() {
+    if (cancelLoad_) *cancelLoad_ = true;
+    cancelLoad_ = std::make_shared<std::atomic<bool>>(false);
+
+    tensorField_.reset();
+    outport_.clear();
+
+    tfb::ReadOptions options;
+    options.packedStorage = packedStorage_.get();
+    options.policy = lazyMetaData_.get() ? MetaDataPolicy::Lazy : MetaDataPolicy::Eager;
+    // The processor might be gone by the time these run, hence the token is checked before
+    // touching it, and only on the front thread, which is where the destructor sets it.
+    options.progress = [this, cancel = cancelLoad_](float progress) {
+        dispatchFront([this, cancel, progress]() {
+            if (!*cancel) progressBar_.updateProgress(progress);
+        });
+    };
+    options.cancelled = [cancel = cancelLoad_]() -> bool { return *cancel; };
+
+    getActivityIndicator().setActive(true);
+    progressBar_.show();
+    progressBar_.updateProgress(0.f);
+
+    dispatchPool([this, cancel = cancelLoad_, file = inFile_.get(), options,
+                  normalizeExtents = normalizeExtents_.get()]() {
+        std::shared_ptr<TensorField3D> tensorField;
+        try {
+            tensorField = tfb::read(file, options);
+        } catch (const Exception &e) {
+            dispatchFront([this, cancel, message = e.getMessage()]() {
+                if (*cancel) return;
+                LogError(message);
+                getActivityIndicator().setActive(false);
+                progressBar_.hide();
+            });
+            return;
+        }
 
-    outport_.setData(tensorFieldOut);
-}
+        if (tensorField && normalizeExtents) {
+            auto extents = tensorField->getExtents();
+            extents /= std::max(std::max(extents.x, extents.y), extents.z);
+            tensorField->setExtents(extents);
+        }
 
-void TensorField3DImport::buildTensors(
-    const std::vector<TensorField3D::value_type> &data,
-    std::shared_ptr<std::vector<TensorField3D::matN>> tensors) const {
-    for (size_t i{0}; i < data.size() / 9; i++) {
-        size_t offset = i * 9;
-        tensors->emplace_back(
-            TensorField3D::vecN(data[offset + 0], data[offset + 3], data[offset + 6]),
-            TensorField3D::vecN(data[offset + 1], data[offset + 4], data[offset + 7]),
-            TensorField3D::vecN(data[offset + 2], data[offset + 5], data[offset + 8]));
-    }
+        dispatchFront([this, cancel, tensorField]() {
+            if (*cancel) return;
+            tensorField_ = tensorField;
+            getActivityIndicator().setActive(false);
+            progressBar_.hide();
+            invalidate(InvalidationLevel::InvalidOutput);
+        });
+    });
 }
 
 }  // namespace inviwo
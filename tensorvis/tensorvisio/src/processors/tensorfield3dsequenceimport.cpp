@@ -0,0 +1,127 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisio/processors/tensorfield3dsequenceimport.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/stringconversion.h>
+#include <inviwo/tensorvisbase/tensorvisbasemodule.h>
+#include <inviwo/tensorvisio/util/tfbformat.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming
+// scheme
+const ProcessorInfo TensorField3DSequenceImport::processorInfo_{
+    "org.inviwo.TensorField3DSequenceImport",  // Class identifier
+    "Tensor Field 3D Sequence Import",         // Display name
+    "Data Input",                              // Category
+    CodeState::Experimental,                   // Code state
+    tag::OpenTensorVis | Tag::CPU,             // Tags
+};
+const ProcessorInfo TensorField3DSequenceImport::getProcessorInfo() const {
+    return processorInfo_;
+}
+
+TensorField3DSequenceImport::TensorField3DSequenceImport()
+    : Processor()
+    , directory_("directory", "Directory")
+    , outport_("outport")
+    , prefetchCount_("prefetchCount", "Prefetched timesteps",
+                     TensorField3DSequence::defaultPrefetchCount, 0, 16, 1,
+                     InvalidationLevel::Valid)
+    , memoryBudget_("memoryBudget", "Memory budget (MB)",
+                    TensorField3DSequence::defaultMemoryBudget >> 20, 64, 65536, 64,
+                    InvalidationLevel::Valid)
+    , normalizeExtents_("normalizeExtents", "Normalize extents", true)
+    , packedStorage_("packedStorage", "Packed symmetric storage", false)
+    , lazyMetaData_("lazyMetaData", "Compute meta data on demand", false) {
+    addPort(outport_);
+    addProperties(directory_, prefetchCount_, memoryBudget_, normalizeExtents_, packedStorage_,
+                  lazyMetaData_);
+
+    // Changing the cache parameters keeps the loaded timesteps
+    prefetchCount_.onChange([this]() {
+        if (sequence_) sequence_->setPrefetchCount(prefetchCount_.get());
+    });
+    memoryBudget_.onChange([this]() {
+        if (sequence_) sequence_->setMemoryBudget(memoryBudget_.get() << 20);
+    });
+
+    const auto reload = [this]() { sequence_.reset(); };
+    directory_.onChange(reload);
+    normalizeExtents_.onChange(reload);
+    packedStorage_.onChange(reload);
+    lazyMetaData_.onChange(reload);
+}
+
+void TensorField3DSequenceImport::process() {
+    if (!sequence_) {
+        const auto directory = directory_.get();
+        std::vector<std::string> files;
+        for (const auto& file :
+             filesystem::getDirectoryContents(directory, filesystem::ListMode::Files)) {
+            if (toLower(filesystem::getFileExtension(file)) == "tfb") {
+                files.push_back(directory + "/" + file);
+            }
+        }
+        std::sort(files.begin(), files.end());
+
+        if (files.empty()) {
+            outport_.clear();
+            if (!directory.empty()) LogWarn("No tfb files found in " << directory);
+            return;
+        }
+
+        tfb::ReadOptions options;
+        options.packedStorage = packedStorage_.get();
+        options.policy = lazyMetaData_.get() ? MetaDataPolicy::Lazy : MetaDataPolicy::Eager;
+
+        auto loader = [files, options, normalizeExtents = normalizeExtents_.get()](
+                          size_t timestep, const std::function<bool()>& cancelled) {
+            auto timestepOptions = options;
+            timestepOptions.cancelled = cancelled;
+            auto tensorField = tfb::read(files[timestep], timestepOptions);
+            if (tensorField && normalizeExtents) {
+                auto extents = tensorField->getExtents();
+                extents /= std::max(std::max(extents.x, extents.y), extents.z);
+                tensorField->setExtents(extents);
+            }
+            return tensorField;
+        };
+
+        sequence_ = std::make_shared<TensorField3DSequence>(
+            files.size(), std::move(loader), memoryBudget_.get() << 20, prefetchCount_.get());
+        sequence_->prefetch(0);
+    }
+    outport_.setData(sequence_);
+}
+
+}  // namespace inviwo
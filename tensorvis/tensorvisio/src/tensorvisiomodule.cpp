@@ -30,12 +30,15 @@
 #include <inviwo/tensorvisio/tensorvisiomodule.h>
 
 #include <inviwo/tensorvisio/processors/amiratensorreader.h>
+#include <inviwo/tensorvisio/processors/brickedtensorfield3dimport.h>
 #include <inviwo/tensorvisio/processors/nrrdreader.h>
+#include <inviwo/tensorvisio/processors/sparsetensorfield3dimport.h>
 #include <inviwo/tensorvisio/processors/tensorfield2dexport.h>
 #include <inviwo/tensorvisio/processors/tensorfield2dimport.h>
 #include <inviwo/tensorvisio/processors/tensorfield2dtovtk.h>
 #include <inviwo/tensorvisio/processors/tensorfield3dexport.h>
 #include <inviwo/tensorvisio/processors/tensorfield3dimport.h>
+#include <inviwo/tensorvisio/processors/tensorfield3dsequenceimport.h>
 #include <inviwo/tensorvisio/processors/vtkdatasettotensorfield3d.h>
 #include <inviwo/tensorvisio/processors/flowguifilereader.h>
 #include <inviwo/tensorvisio/processors/vtktotensorfield2d.h>
@@ -45,12 +48,15 @@ namespace inviwo {
 TensorVisIOModule::TensorVisIOModule(InviwoApplication* app) : InviwoModule{app, "TensorVisIO"} {
 
     registerProcessor<AmiraTensorReader>();
+    registerProcessor<BrickedTensorField3DImport>();
     registerProcessor<NRRDReader>();
+    registerProcessor<SparseTensorField3DImport>();
     registerProcessor<TensorField2DExport>();
     registerProcessor<TensorField2DImport>();
     registerProcessor<TensorField2DToVTK>();
     registerProcessor<TensorField3DExport>();
     registerProcessor<TensorField3DImport>();
+    registerProcessor<TensorField3DSequenceImport>();
     registerProcessor<VTKDataSetToTensorField3D>();
     registerProcessor<FlowGUIFileReader>();
     registerProcessor<VTKDataSetToTensorField2D>();
@@ -0,0 +1,684 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ *FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisio/util/tfbformat.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/datastructures/datamapper.h>
+#include <inviwo/core/util/constexprhash.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/util/logcentral.h>
+#include <inviwo/core/util/stdextensions.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/tensorvisbase/util/memorymappedfile.h>
+#include <inviwo/tensorvisbase/util/symmetriceigensolver.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace inviwo {
+namespace tfb {
+
+namespace {
+constexpr std::string_view magic{"TFBVersion:"};
+// Version 6 is the unchunked layout, still used for 2D tensor fields
+constexpr size_t legacyVersion = TFB_CURRENT_VERSION;
+
+using matN = TensorField3D::matN;
+static_assert(sizeof(matN) == 9 * sizeof(TensorField3D::value_type),
+              "Chunks are copied straight into the tensor storage");
+
+size_t align(size_t offset) { return (offset + alignment - 1) / alignment * alignment; }
+
+/**
+ * Sequential, bounds checked reads from a memory mapped file. The version 6 layout is not
+ * aligned, hence all values are copied out.
+ */
+class Cursor {
+public:
+    explicit Cursor(const MemoryMappedFile& file, size_t offset = 0)
+        : file_(file), offset_(offset) {}
+
+    template <typename T>
+    T read() {
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    const std::byte* take(size_t bytes) {
+        const auto data = file_.at<std::byte>(offset_, bytes);
+        offset_ += bytes;
+        return data;
+    }
+
+private:
+    const MemoryMappedFile& file_;
+    size_t offset_;
+};
+
+struct DeserializeColumn {
+    template <typename T>
+    void operator()(size_t id, Cursor& cursor, size_t numItems, DataFrame& dataFrame) {
+        using ValueType = typename T::value_type;
+
+        if (id == util::constexpr_hash(T::identifier)) {
+            byteSize = sizeof(ValueType) * numItems;
+            std::vector<ValueType> values(numItems);
+            std::memcpy(values.data(), cursor.take(byteSize), byteSize);
+            dataFrame.addColumn(std::make_shared<TemplateColumn<ValueType>>(
+                std::string(T::identifier), std::move(values)));
+            found = true;
+        }
+    }
+
+    bool found = false;
+    size_t byteSize = 0;
+};
+
+std::array<DataMapper, 3> toDataMaps(const double (&ranges)[3][2]) {
+    std::array<DataMapper, 3> dataMaps;
+    for (size_t i = 0; i < 3; ++i) {
+        dataMaps[i].dataRange = dvec2(ranges[i][0], ranges[i][1]);
+        dataMaps[i].valueRange = dataMaps[i].dataRange;
+    }
+    return dataMaps;
+}
+
+std::shared_ptr<TensorField3D> createField(const size3_t& dimensions, std::vector<matN>&& tensors,
+                                           std::shared_ptr<DataFrame> metaData,
+                                           const ReadOptions& options) {
+    if (metaData) metaData->updateIndexBuffer();
+
+    const auto policy = options.policy;
+    if (options.packedStorage) {
+        if (std::all_of(tensors.begin(), tensors.end(),
+                        [](const auto& tensor) { return tensorutil::isSymmetric(tensor); })) {
+            return std::make_shared<TensorField3D>(dimensions, TensorField3D::pack(tensors),
+                                                   metaData, policy);
+        }
+        LogWarnCustom("tfb::read", "Tensor field is not symmetric, falling back to full storage.");
+    }
+    return std::make_shared<TensorField3D>(dimensions, std::move(tensors), metaData, policy);
+}
+
+/**
+ * Calls func(i) for all i in [0, count) in parallel. The range is processed in batches, progress
+ * is reported and cancellation checked in between. Returns false if cancelled.
+ */
+template <typename F>
+bool forEachInBatches(size_t count, const ReadOptions& options, F func) {
+    const auto batchSize =
+        4 * static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency()));
+    for (size_t batch = 0; batch < count; batch += batchSize) {
+        if (options.cancelled && options.cancelled()) return false;
+
+        const auto batchEnd = std::min(count, batch + batchSize);
+#pragma omp parallel for
+        for (long long i = batch; i < static_cast<long long>(batchEnd); ++i) {
+            func(static_cast<size_t>(i));
+        }
+
+        if (options.progress) options.progress(static_cast<float>(batchEnd) / count);
+    }
+    return true;
+}
+
+size_t readPreamble(Cursor& cursor, const std::string& path) {
+    const auto length = cursor.read<size_t>();
+    if (length != magic.size() ||
+        std::string_view(reinterpret_cast<const char*>(cursor.take(length)), length) != magic) {
+        throw Exception("No valid tfb file: " + path, IVW_CONTEXT_CUSTOM("tfb::read"));
+    }
+
+    const auto fileVersion = cursor.read<size_t>();
+    if (fileVersion != legacyVersion && fileVersion != version) {
+        throw Exception("Please update the tfb file. Supported versions are " +
+                            std::to_string(legacyVersion) + " and " + std::to_string(version) +
+                            ", file has " + std::to_string(fileVersion),
+                        IVW_CONTEXT_CUSTOM("tfb::read"));
+    }
+    return fileVersion;
+}
+
+// Reads the part of the version 6 layout following the meta data flag
+Info readVersion6Info(Cursor& cursor) {
+    Info info{legacyVersion};
+    for (glm::length_t i = 0; i < 3; ++i) info.dimensions[i] = cursor.read<size_t>();
+    for (glm::length_t i = 0; i < 3; ++i) info.extents[i] = cursor.read<float>();
+    for (glm::length_t i = 0; i < 3; ++i) info.offset[i] = cursor.read<float>();
+    return info;
+}
+
+Info readVersion7Info(const Header& header) {
+    Info info{version};
+    for (glm::length_t i = 0; i < 3; ++i) {
+        info.dimensions[i] = static_cast<size_t>(header.dimensions[i]);
+        info.extents[i] = header.extents[i];
+        info.offset[i] = header.offset[i];
+    }
+    return info;
+}
+
+std::shared_ptr<TensorField3D> readVersion6(Cursor& cursor, const ReadOptions& options) {
+    const auto hasMetaData = cursor.read<glm::uint8>();
+    const auto info = readVersion6Info(cursor);
+    const auto dimensions = info.dimensions;
+
+    double eigenValueRanges[3][2];
+    double eigenVectorRanges[3][2];
+    std::memcpy(eigenValueRanges, cursor.take(sizeof(eigenValueRanges)), sizeof(eigenValueRanges));
+    std::memcpy(eigenVectorRanges, cursor.take(sizeof(eigenVectorRanges)),
+                sizeof(eigenVectorRanges));
+
+    // Version 6 stores the tensors transposed with respect to glm. Copy them straight into the
+    // tensor storage and transpose in place, in blocks of the default chunk size.
+    const auto numTensors = glm::compMul(dimensions);
+    const auto source = cursor.take(sizeof(matN) * numTensors);
+    std::vector<matN> tensors(numTensors);
+    const auto numBlocks = (numTensors + defaultTensorsPerChunk - 1) / defaultTensorsPerChunk;
+    const bool completed = forEachInBatches(numBlocks, options, [&](size_t block) {
+        const auto first = block * defaultTensorsPerChunk;
+        const auto count = std::min(defaultTensorsPerChunk, numTensors - first);
+        std::memcpy(tensors.data() + first, source + first * sizeof(matN), count * sizeof(matN));
+        for (auto i = first; i < first + count; ++i) {
+            tensors[i] = glm::transpose(tensors[i]);
+        }
+    });
+    if (!completed) return nullptr;
+
+    std::vector<glm::uint8> mask;
+    if (cursor.read<glm::uint8>()) {
+        const auto maskData = reinterpret_cast<const glm::uint8*>(cursor.take(numTensors));
+        mask.assign(maskData, maskData + numTensors);
+    }
+
+    std::shared_ptr<DataFrame> metaData;
+    if (hasMetaData) {
+        metaData = std::make_shared<DataFrame>();
+        const auto numColumns = cursor.read<size_t>();
+        for (size_t i = 0; i < numColumns; ++i) {
+            const auto id = cursor.read<size_t>();
+            const auto numItems = cursor.read<size_t>();
+            if (numItems != numTensors) {
+                throw Exception("Meta data column with " + std::to_string(numItems) +
+                                    " items for " + std::to_string(numTensors) +
+                                    " tensors in tfb file",
+                                IVW_CONTEXT_CUSTOM("tfb::read"));
+            }
+            // Columns are not prefixed with their size, unknown columns cannot be skipped
+            if (!util::for_each_type<attributes::types3D>{}(DeserializeColumn{}, id,
+                                                            std::ref(cursor), numItems,
+                                                            std::ref(*metaData))
+                     .found) {
+                throw Exception("Unknown meta data column in tfb file",
+                                IVW_CONTEXT_CUSTOM("tfb::read"));
+            }
+        }
+    }
+
+    const auto eofLength = cursor.read<size_t>();
+    const auto eof = cursor.take(eofLength);
+    if (std::string_view(reinterpret_cast<const char*>(eof), eofLength) != "EOFreached") {
+        throw Exception("EOF not reached", IVW_CONTEXT_CUSTOM("tfb::read"));
+    }
+
+    auto tensorField = createField(dimensions, std::move(tensors), metaData, options);
+    tensorField->dataMapEigenValues_ = toDataMaps(eigenValueRanges);
+    tensorField->dataMapEigenVectors_ = toDataMaps(eigenVectorRanges);
+    tensorField->setExtents(info.extents);
+    tensorField->setOffset(info.offset);
+    tensorField->setMask(mask);
+    return tensorField;
+}
+
+/**
+ * Validates the chunk index of a version 7 file, all chunks are inside the file afterwards.
+ */
+const ChunkEntry* readChunkIndex(const MemoryMappedFile& file, const Header& header) {
+    const auto numTensors = static_cast<size_t>(header.dimensions[0] * header.dimensions[1] *
+                                                header.dimensions[2]);
+    const auto tensorsPerChunk = static_cast<size_t>(header.tensorsPerChunk);
+    if (tensorsPerChunk == 0 ||
+        header.numChunks != (numTensors + tensorsPerChunk - 1) / tensorsPerChunk) {
+        throw Exception("Invalid chunk index in tfb file", IVW_CONTEXT_CUSTOM("tfb::read"));
+    }
+
+    const auto numChunks = static_cast<size_t>(header.numChunks);
+    const auto chunks = file.at<ChunkEntry>(header.chunkIndexOffset, numChunks);
+    for (size_t i = 0; i < numChunks; ++i) {
+        const auto count = std::min(tensorsPerChunk, numTensors - i * tensorsPerChunk);
+        if (chunks[i].codec != Codec::None) {
+            throw Exception("Unsupported codec " +
+                                std::to_string(static_cast<std::uint32_t>(chunks[i].codec)) +
+                                " in tfb file",
+                            IVW_CONTEXT_CUSTOM("tfb::read"));
+        }
+        if (chunks[i].storedSize != count * sizeof(matN)) {
+            throw Exception("Invalid chunk size in tfb file", IVW_CONTEXT_CUSTOM("tfb::read"));
+        }
+        file.at<std::byte>(chunks[i].offset, chunks[i].storedSize);
+    }
+    return chunks;
+}
+
+std::shared_ptr<TensorField3D> readVersion7(const MemoryMappedFile& file,
+                                            const ReadOptions& options) {
+    const auto& header = *file.at<Header>(headerOffset);
+    const auto info = readVersion7Info(header);
+    const auto dimensions = info.dimensions;
+    const auto numTensors = glm::compMul(dimensions);
+    const auto tensorsPerChunk = static_cast<size_t>(header.tensorsPerChunk);
+    const auto numChunks = static_cast<size_t>(header.numChunks);
+
+    // Validate all chunks up front, the parallel copy below must not throw
+    const auto chunks = readChunkIndex(file, header);
+
+    std::vector<matN> tensors(numTensors);
+    const bool completed = forEachInBatches(numChunks, options, [&](size_t i) {
+        std::memcpy(tensors.data() + i * tensorsPerChunk, file.data() + chunks[i].offset,
+                    chunks[i].storedSize);
+    });
+    if (!completed) return nullptr;
+
+    std::vector<glm::uint8> mask;
+    if (header.maskOffset != 0) {
+        const auto maskData = file.at<glm::uint8>(header.maskOffset, numTensors);
+        mask.assign(maskData, maskData + numTensors);
+    }
+
+    std::shared_ptr<DataFrame> metaData;
+    if (header.numColumns != 0) {
+        metaData = std::make_shared<DataFrame>();
+        const auto columns = file.at<ColumnEntry>(header.columnDirectoryOffset, header.numColumns);
+        for (size_t i = 0; i < header.numColumns; ++i) {
+            // Meta data is accessed per tensor, every column needs one item per tensor
+            if (columns[i].numItems != numTensors) {
+                throw Exception("Meta data column with " + std::to_string(columns[i].numItems) +
+                                    " items for " + std::to_string(numTensors) +
+                                    " tensors in tfb file",
+                                IVW_CONTEXT_CUSTOM("tfb::read"));
+            }
+            Cursor cursor(file, columns[i].offset);
+            const auto column = util::for_each_type<attributes::types3D>{}(
+                DeserializeColumn{}, static_cast<size_t>(columns[i].id), std::ref(cursor),
+                static_cast<size_t>(columns[i].numItems), std::ref(*metaData));
+            if (!column.found) {
+                LogWarnCustom("tfb::read", "Skipping unknown meta data column");
+            } else if (column.byteSize != columns[i].byteSize) {
+                throw Exception("Invalid meta data column in tfb file",
+                                IVW_CONTEXT_CUSTOM("tfb::read"));
+            }
+        }
+    }
+
+    auto tensorField = createField(dimensions, std::move(tensors), metaData, options);
+    tensorField->dataMapEigenValues_ = toDataMaps(header.eigenValueRanges);
+    tensorField->dataMapEigenVectors_ = toDataMaps(header.eigenVectorRanges);
+    tensorField->setExtents(info.extents);
+    tensorField->setOffset(info.offset);
+    tensorField->setMask(mask);
+    return tensorField;
+}
+
+/**
+ * Creates a sparse field from the tensors of a mapped tfb file without creating the dense field,
+ * locate(i) returns the address of the i-th tensor in the mapping. Voxels with a non-zero mask
+ * value are active, or voxels with a non-zero tensor if mask is null.
+ */
+template <typename Locate>
+std::shared_ptr<SparseTensorField3D> readSparseTensors(const Info& info, bool transposed,
+                                                       Locate locate, size_t tensorsPerChunk,
+                                                       const glm::uint8* mask,
+                                                       const ReadOptions& options) {
+    using Run = SparseTensorField3D::Run;
+
+    const auto numTensors = glm::compMul(info.dimensions);
+    const auto tensorAt = [&](size_t i) {
+        matN tensor;
+        std::memcpy(&tensor, locate(i), sizeof(matN));
+        return transposed ? glm::transpose(tensor) : tensor;
+    };
+
+    auto runs = mask ? SparseTensorField3D::findRunsIf(numTensors,
+                                                       [&](size_t i) { return mask[i] != 0; })
+                     : SparseTensorField3D::findRunsIf(
+                           numTensors, [&](size_t i) { return tensorAt(i) != matN(0.0f); });
+    const auto numActive = runs.empty() ? 0 : runs.back().entry + runs.back().length;
+
+    // Runs can span several chunks, which are not contiguous in the mapping
+    std::vector<matN> tensors(numActive);
+    const bool completed = forEachInBatches(runs.size(), options, [&](size_t r) {
+        const Run& run = runs[r];
+        const auto end = run.begin + run.length;
+        for (auto i = run.begin; i < end;) {
+            const auto count = std::min(end, (i / tensorsPerChunk + 1) * tensorsPerChunk) - i;
+            auto out = tensors.data() + run.entry + (i - run.begin);
+            std::memcpy(out, locate(i), count * sizeof(matN));
+            if (transposed) {
+                for (size_t j = 0; j < count; ++j) out[j] = glm::transpose(out[j]);
+            }
+            i += count;
+        }
+    });
+    if (!completed) return nullptr;
+
+    std::shared_ptr<SparseTensorField3D> tensorField;
+    if (options.packedStorage &&
+        std::all_of(tensors.begin(), tensors.end(),
+                    [](const auto& tensor) { return tensorutil::isSymmetric(tensor); })) {
+        tensorField = std::make_shared<SparseTensorField3D>(
+            info.dimensions, std::move(runs), TensorField3D::pack(tensors), options.policy);
+    } else {
+        if (options.packedStorage) {
+            LogWarnCustom("tfb::readSparse",
+                          "Tensor field is not symmetric, falling back to full storage.");
+        }
+        tensorField = std::make_shared<SparseTensorField3D>(
+            info.dimensions, std::move(runs),
+            std::make_shared<const std::vector<matN>>(std::move(tensors)), options.policy);
+    }
+    tensorField->setBasis(mat3(vec3(info.extents.x, 0.f, 0.f), vec3(0.f, info.extents.y, 0.f),
+                               vec3(0.f, 0.f, info.extents.z)));
+    tensorField->setOffset(info.offset);
+    return tensorField;
+}
+
+/**
+ * Writes the tensors of a mapped tfb file as a brick file, locate(i) returns the address of the
+ * i-th tensor in the mapping.
+ */
+template <typename Locate>
+void writeBricks(const std::string& brickPath, const Info& info, bool transposed, Locate locate,
+                 size_t brickSize) {
+    util::IndexMapper3D indexMapper(info.dimensions);
+    const auto source = [&](const size3_t& origin, const size3_t& dimensions, matN* out) {
+        for (size_t z = 0; z < dimensions.z; ++z) {
+            for (size_t y = 0; y < dimensions.y; ++y) {
+                // Rows of a brick are contiguous in the file
+                const auto first = indexMapper(origin + size3_t(0, y, z));
+                auto row = out + dimensions.x * (y + dimensions.y * z);
+                for (size_t x = 0; x < dimensions.x; ++x) {
+                    std::memcpy(row + x, locate(first + x), sizeof(matN));
+                    if (transposed) row[x] = glm::transpose(row[x]);
+                }
+            }
+        }
+    };
+
+    BrickedTensorField3D::write(brickPath, info.dimensions,
+                                mat3(vec3(info.extents.x, 0.f, 0.f), vec3(0.f, info.extents.y, 0.f),
+                                     vec3(0.f, 0.f, info.extents.z)),
+                                info.offset, TensorStorage::Full, source, brickSize);
+}
+
+void pad(std::ofstream& outFile, size_t offset) {
+    static constexpr std::array<char, alignment> zeros{};
+    auto position = static_cast<size_t>(outFile.tellp());
+    while (position < offset) {
+        const auto count = std::min(zeros.size(), offset - position);
+        outFile.write(zeros.data(), count);
+        position += count;
+    }
+}
+
+template <typename T>
+void writeAt(std::ofstream& outFile, size_t offset, const T* data, size_t count) {
+    pad(outFile, offset);
+    outFile.write(reinterpret_cast<const char*>(data), sizeof(T) * count);
+}
+
+struct ColumnData {
+    ColumnEntry entry;
+    const void* data;
+};
+}  // namespace
+
+Info readInfo(const std::string& path) {
+    MemoryMappedFile file(path);
+    Cursor cursor(file);
+
+    if (readPreamble(cursor, path) == legacyVersion) {
+        cursor.read<glm::uint8>();  // meta data flag
+        return readVersion6Info(cursor);
+    }
+    return readVersion7Info(*file.at<Header>(headerOffset));
+}
+
+std::shared_ptr<TensorField3D> read(const std::string& path, const ReadOptions& options) {
+    MemoryMappedFile file(path);
+    Cursor cursor(file);
+
+    if (readPreamble(cursor, path) == legacyVersion) {
+        return readVersion6(cursor, options);
+    }
+    return readVersion7(file, options);
+}
+
+std::shared_ptr<SparseTensorField3D> readSparse(const std::string& path,
+                                                const ReadOptions& options) {
+    MemoryMappedFile file(path);
+    Cursor cursor(file);
+
+    if (readPreamble(cursor, path) == legacyVersion) {
+        cursor.read<glm::uint8>();  // meta data flag
+        const auto info = readVersion6Info(cursor);
+        const auto numTensors = glm::compMul(info.dimensions);
+        cursor.take(2 * sizeof(double[3][2]));  // eigen value and eigen vector ranges
+        const auto tensors = cursor.take(sizeof(matN) * numTensors);
+        const auto mask = cursor.read<glm::uint8>()
+                              ? reinterpret_cast<const glm::uint8*>(cursor.take(numTensors))
+                              : nullptr;
+        return readSparseTensors(
+            info, true, [&](size_t i) { return tensors + i * sizeof(matN); },
+            std::max(numTensors, size_t{1}), mask, options);
+    }
+
+    const auto& header = *file.at<Header>(headerOffset);
+    const auto info = readVersion7Info(header);
+    const auto chunks = readChunkIndex(file, header);
+    const auto tensorsPerChunk = static_cast<size_t>(header.tensorsPerChunk);
+    const auto mask = header.maskOffset != 0
+                          ? file.at<glm::uint8>(header.maskOffset, glm::compMul(info.dimensions))
+                          : nullptr;
+    return readSparseTensors(
+        info, false,
+        [&](size_t i) {
+            return file.data() + chunks[i / tensorsPerChunk].offset +
+                   (i % tensorsPerChunk) * sizeof(matN);
+        },
+        tensorsPerChunk, mask, options);
+}
+
+void writeBricked(const std::string& path, const std::string& brickPath, size_t brickSize) {
+    MemoryMappedFile file(path);
+    Cursor cursor(file);
+
+    if (readPreamble(cursor, path) == legacyVersion) {
+        cursor.read<glm::uint8>();  // meta data flag
+        const auto info = readVersion6Info(cursor);
+        cursor.take(2 * sizeof(double[3][2]));  // eigen value and eigen vector ranges
+        const auto tensors = cursor.take(sizeof(matN) * glm::compMul(info.dimensions));
+        writeBricks(
+            brickPath, info, true, [&](size_t i) { return tensors + i * sizeof(matN); },
+            brickSize);
+    } else {
+        const auto& header = *file.at<Header>(headerOffset);
+        const auto chunks = readChunkIndex(file, header);
+        const auto tensorsPerChunk = static_cast<size_t>(header.tensorsPerChunk);
+        writeBricks(
+            brickPath, readVersion7Info(header), false,
+            [&](size_t i) {
+                return file.data() + chunks[i / tensorsPerChunk].offset +
+                       (i % tensorsPerChunk) * sizeof(matN);
+            },
+            brickSize);
+    }
+}
+
+void write(const std::string& path, const TensorField3D& tensorField, bool includeMetaData,
+           size_t tensorsPerChunk) {
+    if (tensorsPerChunk == 0) {
+        throw Exception("Chunks need to contain at least one tensor",
+                        IVW_CONTEXT_CUSTOM("tfb::write"));
+    }
+
+    const auto numTensors = tensorField.getSize();
+    const auto dimensions = tensorField.getDimensions();
+    const auto extents = tensorField.getExtents();
+    const auto offset = tensorField.getOffset();
+
+    Header header{};
+    for (glm::length_t i = 0; i < 3; ++i) {
+        header.dimensions[i] = dimensions[i];
+        header.extents[i] = extents[i];
+        header.offset[i] = offset[i];
+        header.eigenValueRanges[i][0] = tensorField.dataMapEigenValues_[i].dataRange.x;
+        header.eigenValueRanges[i][1] = tensorField.dataMapEigenValues_[i].dataRange.y;
+        header.eigenVectorRanges[i][0] = tensorField.dataMapEigenVectors_[i].dataRange.x;
+        header.eigenVectorRanges[i][1] = tensorField.dataMapEigenVectors_[i].dataRange.y;
+    }
+
+    // Lay out the file up front, chunks are not compressed so all sizes are known
+    header.tensorsPerChunk = tensorsPerChunk;
+    header.numChunks = (numTensors + tensorsPerChunk - 1) / tensorsPerChunk;
+    header.chunkIndexOffset = align(headerOffset + sizeof(Header));
+
+    const auto numChunks = static_cast<size_t>(header.numChunks);
+    std::vector<ChunkEntry> chunks(numChunks);
+    auto position = align(header.chunkIndexOffset + numChunks * sizeof(ChunkEntry));
+    for (size_t i = 0; i < numChunks; ++i) {
+        const auto count = std::min(tensorsPerChunk, numTensors - i * tensorsPerChunk);
+        chunks[i] = ChunkEntry{position, count * sizeof(matN), Codec::None, 0};
+        position = align(position + chunks[i].storedSize);
+    }
+
+    if (tensorField.hasMask()) {
+        header.maskOffset = position;
+        position = align(position + numTensors);
+    }
+
+    std::vector<ColumnData> columns;
+    if (includeMetaData) {
+        for (auto column : *tensorField.metaData()) {
+            if (column->getHeader() == "index") continue;
+
+            const auto id = util::constexpr_hash(std::string_view(column->getHeader()));
+            auto bufferRAM = column->getBuffer()->getRepresentation<BufferRAM>();
+            bufferRAM->dispatch<void, dispatching::filter::All>([&](auto brprecision) {
+                using ValueType = util::PrecisionValueType<decltype(brprecision)>;
+                const auto& data = brprecision->getDataContainer();
+                columns.push_back(
+                    ColumnData{ColumnEntry{id, 0, data.size(), sizeof(ValueType) * data.size()},
+                               data.data()});
+            });
+        }
+
+        header.columnDirectoryOffset = position;
+        header.numColumns = columns.size();
+        position = align(position + columns.size() * sizeof(ColumnEntry));
+        for (auto& column : columns) {
+            column.entry.offset = position;
+            position = align(position + column.entry.byteSize);
+        }
+    }
+
+    std::ofstream outFile(path, std::ios::out | std::ios::binary);
+    if (!outFile) {
+        throw FileException("Could not open " + path + " for writing",
+                            IVW_CONTEXT_CUSTOM("tfb::write"));
+    }
+
+    const size_t length = magic.size();
+    outFile.write(reinterpret_cast<const char*>(&length), sizeof(size_t));
+    outFile.write(magic.data(), length);
+    outFile.write(reinterpret_cast<const char*>(&version), sizeof(size_t));
+
+    writeAt(outFile, headerOffset, &header, 1);
+    writeAt(outFile, header.chunkIndexOffset, chunks.data(), chunks.size());
+
+    if (tensorField.storage() == TensorStorage::Full) {
+        const auto tensors = tensorField.tensors();
+        for (size_t i = 0; i < numChunks; ++i) {
+            writeAt(outFile, chunks[i].offset, tensors->data() + i * tensorsPerChunk,
+                    chunks[i].storedSize / sizeof(matN));
+        }
+    } else {
+        // Packed tensors have to be expanded. Expand a batch of chunks in parallel and write them
+        // in order, which bounds the extra memory to one chunk per thread.
+        const auto& packed = *tensorField.packedTensors();
+        const auto batchSize =
+            static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency()));
+        std::vector<std::vector<matN>> buffers(batchSize);
+        for (size_t batch = 0; batch < numChunks; batch += batchSize) {
+            const auto batchEnd = std::min(numChunks, batch + batchSize);
+#pragma omp parallel for
+            for (long long i = batch; i < static_cast<long long>(batchEnd); ++i) {
+                auto& buffer = buffers[i - batch];
+                const auto first = i * tensorsPerChunk;
+                buffer.resize(chunks[i].storedSize / sizeof(matN));
+                for (size_t j = 0; j < buffer.size(); ++j) {
+                    buffer[j] = TensorField3D::unpack(packed[first + j]);
+                }
+            }
+            for (auto i = batch; i < batchEnd; ++i) {
+                writeAt(outFile, chunks[i].offset, buffers[i - batch].data(),
+                        buffers[i - batch].size());
+            }
+        }
+    }
+
+    if (tensorField.hasMask()) {
+        writeAt(outFile, header.maskOffset, tensorField.getMask().data(), numTensors);
+    }
+
+    if (!columns.empty()) {
+        pad(outFile, header.columnDirectoryOffset);
+        for (const auto& column : columns) {
+            outFile.write(reinterpret_cast<const char*>(&column.entry), sizeof(ColumnEntry));
+        }
+        for (const auto& column : columns) {
+            writeAt(outFile, column.entry.offset, static_cast<const char*>(column.data),
+                    column.entry.byteSize);
+        }
+    }
+
+    if (!outFile) {
+        throw FileException("Could not write " + path, IVW_CONTEXT_CUSTOM("tfb::write"));
+    }
+}
+
+}  // namespace tfb
+}  // namespace inviwo
@@ -0,0 +1,84 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <benchmark/benchmark.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisio/util/tfbformat.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <random>
+
+/**
+ * Benchmarks of tfb import and export on synthetic fields of n^3 random symmetric tensors, see
+ * the TensorVisBase benchmarks for the sizes. Files are written to the temporary directory.
+ */
+
+#ifndef TENSORVIS_BENCHMARK_MAX_SIZE
+#define TENSORVIS_BENCHMARK_MAX_SIZE 128
+#endif
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<TensorField3D> randomField(size_t n, MetaDataPolicy policy) {
+    std::mt19937 gen(n);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<mat3> tensors(n * n * n);
+    for (auto& tensor : tensors) {
+        for (glm::length_t col = 0; col < 3; ++col) {
+            for (glm::length_t row = col; row < 3; ++row) {
+                tensor[col][row] = tensor[row][col] = dist(gen);
+            }
+        }
+    }
+    return std::make_shared<TensorField3D>(size3_t(n), std::move(tensors), nullptr, policy);
+}
+
+std::string benchmarkFile(size_t n) {
+    return (std::filesystem::temp_directory_path() /
+            ("tensorvisio-benchmark-" + std::to_string(n) + ".tfb"))
+        .string();
+}
+
+void fieldSizes(benchmark::internal::Benchmark* b) {
+    for (int n = 16; n <= TENSORVIS_BENCHMARK_MAX_SIZE; n *= 2) b->Arg(n);
+    b->Unit(benchmark::kMillisecond);
+}
+
+}  // namespace
+
+void tfbExport(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    const auto tensorField = randomField(n, MetaDataPolicy::Eager);
+    const auto file = benchmarkFile(n);
+
+    for (auto _ : state) {
+        tfb::write(file, *tensorField, true);
+    }
+    state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(file));
+    std::remove(file.c_str());
+}
+BENCHMARK(tfbExport)->Apply(fieldSizes);
+
+void tfbImport(benchmark::State& state, bool packedStorage, MetaDataPolicy policy) {
+    const auto n = static_cast<size_t>(state.range(0));
+    const auto file = benchmarkFile(n);
+    tfb::write(file, *randomField(n, MetaDataPolicy::Eager), true);
+
+    tfb::ReadOptions options;
+    options.packedStorage = packedStorage;
+    options.policy = policy;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tfb::read(file, options));
+    }
+    state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(file));
+    std::remove(file.c_str());
+}
+BENCHMARK_CAPTURE(tfbImport, full, false, MetaDataPolicy::Eager)->Apply(fieldSizes);
+BENCHMARK_CAPTURE(tfbImport, packed, true, MetaDataPolicy::Eager)->Apply(fieldSizes);
+BENCHMARK_CAPTURE(tfbImport, lazy, false, MetaDataPolicy::Lazy)->Apply(fieldSizes);
+
+}  // namespace inviwo